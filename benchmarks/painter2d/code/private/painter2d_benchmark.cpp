@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "klgl/rendering/painter2d.hpp"
+
+// Recording cost only: command lists do not call OpenGL, so no context is needed
+
+constexpr size_t kNumPrimitives = 100'000;
+
+template <typename Primitive, typename Init>
+static std::vector<Primitive> MakeRandomPrimitives(Init init)
+{
+    std::mt19937 gen(0);  // NOLINT
+    std::uniform_real_distribution<float> distr(-1.f, 1.f);
+    std::vector<Primitive> primitives;
+    primitives.reserve(kNumPrimitives);
+    for (size_t i = 0; i != kNumPrimitives; ++i)
+    {
+        primitives.push_back(init([&] { return distr(gen); }));
+    }
+
+    return primitives;
+}
+
+template <bool rotated>
+static std::vector<klgl::Painter2d::Rect2d> MakeRects()
+{
+    return MakeRandomPrimitives<klgl::Painter2d::Rect2d>(
+        [](auto random)
+        {
+            return klgl::Painter2d::Rect2d{
+                .center = {random(), random()},
+                .size = {random(), random()},
+                .rotation_degrees = rotated ? random() * 180.f : 0.f,
+            };
+        });
+}
+
+static std::vector<klgl::Painter2d::Line2d> MakeLines()
+{
+    return MakeRandomPrimitives<klgl::Painter2d::Line2d>(
+        [](auto random)
+        {
+            return klgl::Painter2d::Line2d{
+                .a = {random(), random()},
+                .b = {random(), random()},
+            };
+        });
+}
+
+template <bool rotated>
+static void BM_FillRect(benchmark::State& state)
+{
+    const auto rects = MakeRects<rotated>();
+    klgl::Painter2d::CommandList list;
+
+    for (auto _ : state)
+    {
+        list.Clear();
+        for (const auto& rect : rects) list.FillRect(rect);
+        benchmark::DoNotOptimize(list.GetInstances().data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kNumPrimitives));
+}
+
+template <bool rotated>
+static void BM_FillRects(benchmark::State& state)
+{
+    const auto rects = MakeRects<rotated>();
+    klgl::Painter2d::CommandList list;
+
+    for (auto _ : state)
+    {
+        list.Clear();
+        list.FillRects(rects);
+        benchmark::DoNotOptimize(list.GetInstances().data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kNumPrimitives));
+}
+
+static void BM_DrawLine(benchmark::State& state)
+{
+    const auto lines = MakeLines();
+    klgl::Painter2d::CommandList list;
+
+    for (auto _ : state)
+    {
+        list.Clear();
+        for (const auto& line : lines) list.DrawLine(line);
+        benchmark::DoNotOptimize(list.GetInstances().data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kNumPrimitives));
+}
+
+static void BM_DrawLines(benchmark::State& state)
+{
+    const auto lines = MakeLines();
+    klgl::Painter2d::CommandList list;
+
+    for (auto _ : state)
+    {
+        list.Clear();
+        list.DrawLines(lines);
+        benchmark::DoNotOptimize(list.GetInstances().data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kNumPrimitives));
+}
+
+static void BM_FillRect_Axis(benchmark::State& state)
+{
+    BM_FillRect<false>(state);
+}
+
+static void BM_FillRect_Rotated(benchmark::State& state)
+{
+    BM_FillRect<true>(state);
+}
+
+static void BM_FillRects_Axis(benchmark::State& state)
+{
+    BM_FillRects<false>(state);
+}
+
+static void BM_FillRects_Rotated(benchmark::State& state)
+{
+    BM_FillRects<true>(state);
+}
+
+BENCHMARK(BM_FillRect_Axis);
+BENCHMARK(BM_FillRects_Axis);
+BENCHMARK(BM_FillRect_Rotated);
+BENCHMARK(BM_FillRects_Rotated);
+BENCHMARK(BM_DrawLine);
+BENCHMARK(BM_DrawLines);
+
+// Run the benchmark
+BENCHMARK_MAIN();  // NOLINT
@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "klgl/rendering/software_rasterizer_2d.hpp"
+#include "klgl/texture/image.hpp"
+
+// Rasterization cost per primitive type. The argument is the number of threads, zero means all hardware threads
+
+constexpr size_t kNumPrimitives = 10'000;
+constexpr size_t kImageSize = 1024;
+
+template <typename Record>
+static klgl::Painter2d::CommandList MakeRandomPrimitives(Record record)
+{
+    std::mt19937 gen(0);  // NOLINT
+    std::uniform_real_distribution<float> distr(-1.f, 1.f);
+    const auto random = [&] { return distr(gen); };
+    const auto random_color = [&]
+    {
+        const auto channel = [&] { return static_cast<uint8_t>((random() + 1.f) * 127.f); };
+        return klgl::Vec4u8{channel(), channel(), channel(), 200};
+    };
+
+    klgl::Painter2d::CommandList list;
+    for (size_t i = 0; i != kNumPrimitives; ++i)
+    {
+        record(list, random, random_color());
+    }
+
+    return list;
+}
+
+template <typename Record>
+static void BM_Rasterize(benchmark::State& state, Record record)
+{
+    const auto list = MakeRandomPrimitives(record);
+    klgl::Image image({kImageSize, kImageSize});
+    klgl::SoftwareRasterizer2d rasterizer({.threads_count = static_cast<size_t>(state.range(0))});
+
+    for (auto _ : state)
+    {
+        rasterizer.Draw(image, list);
+        benchmark::DoNotOptimize(image.GetPixels().data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kNumPrimitives));
+}
+
+static void BM_FillRect(benchmark::State& state)
+{
+    BM_Rasterize(
+        state,
+        [](auto& list, auto random, const klgl::Vec4u8& color)
+        {
+            list.FillRect({
+                .center = {random(), random()},
+                .size = {random() * 0.1f, random() * 0.1f},
+                .color = color,
+                .rotation_degrees = random() * 180.f,
+            });
+        });
+}
+
+static void BM_FillCircle(benchmark::State& state)
+{
+    BM_Rasterize(
+        state,
+        [](auto& list, auto random, const klgl::Vec4u8& color)
+        {
+            list.FillCircle({
+                .center = {random(), random()},
+                .size = {random() * 0.1f, random() * 0.1f},
+                .color = color,
+            });
+        });
+}
+
+// Right triangles: random ones are often so thin that miters of their outlines cross the whole image
+template <typename Random>
+static klgl::Painter2d::Triangle2d MakeTriangle(Random random, const klgl::Vec4u8& color)
+{
+    const klgl::Vec2f a{random(), random()};
+    const float size = (random() + 1.f) * 0.05f;
+    return {.a = a, .b = {a.x() + size, a.y()}, .c = {a.x(), a.y() + size}, .color = color};
+}
+
+static void BM_FillTriangle(benchmark::State& state)
+{
+    BM_Rasterize(
+        state,
+        [](auto& list, auto random, const klgl::Vec4u8& color) { list.FillTriangle(MakeTriangle(random, color)); });
+}
+
+static void BM_DrawLine(benchmark::State& state)
+{
+    BM_Rasterize(
+        state,
+        [](auto& list, auto random, const klgl::Vec4u8& color)
+        {
+            const klgl::Vec2f a{random(), random()};
+            list.DrawLine({
+                .a = a,
+                .b = {a.x() + random() * 0.2f, a.y() + random() * 0.2f},
+                .color = color,
+                .width = 0.005f,
+            });
+        });
+}
+
+static void BM_RectLines(benchmark::State& state)
+{
+    BM_Rasterize(
+        state,
+        [](auto& list, auto random, const klgl::Vec4u8& color)
+        {
+            list.RectLines(
+                {
+                    .center = {random(), random()},
+                    .size = {random() * 0.1f, random() * 0.1f},
+                    .color = color,
+                    .rotation_degrees = random() * 180.f,
+                },
+                {.inner = 0.005f, .outer = 0.005f});
+        });
+}
+
+static void BM_TriangleLines(benchmark::State& state)
+{
+    BM_Rasterize(
+        state,
+        [](auto& list, auto random, const klgl::Vec4u8& color)
+        { list.TriangleLines(MakeTriangle(random, color), {.inner = 0.005f, .outer = 0.f}); });
+}
+
+BENCHMARK(BM_FillRect)->Arg(1)->Arg(0)->UseRealTime();
+BENCHMARK(BM_FillCircle)->Arg(1)->Arg(0)->UseRealTime();
+BENCHMARK(BM_FillTriangle)->Arg(1)->Arg(0)->UseRealTime();
+BENCHMARK(BM_DrawLine)->Arg(1)->Arg(0)->UseRealTime();
+BENCHMARK(BM_RectLines)->Arg(1)->Arg(0)->UseRealTime();
+BENCHMARK(BM_TriangleLines)->Arg(1)->Arg(0)->UseRealTime();
+
+// Run the benchmark
+BENCHMARK_MAIN();  // NOLINT
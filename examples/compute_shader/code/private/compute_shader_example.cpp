@@ -14,6 +14,8 @@
 #include "klgl/events/mouse_events.hpp"
 #include "klgl/math/rotator.hpp"
 #include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/program_info.hpp"
+#include "klgl/opengl/storage_buffer.hpp"
 #include "klgl/opengl/vertex_attribute_helper.hpp"
 #include "klgl/reflection/matrix_reflect.hpp"  // IWYU pragma: keep
 #include "klgl/shader/shader.hpp"
@@ -58,11 +60,11 @@ class ComputeShaderExampleApp : public Application
         {
             const size_t a_particle_shader_position =
                 particle_shader_->GetInfo().VerifyAndGetVertexAttributeLocation<edt::Vec3f>("a_position");
-            particels_positions_buffer_ = OpenGl::GenBuffer();
             const auto positions = CalculateInitialParticePositions();
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, particels_positions_buffer_.GetValue());
-            OpenGl::BufferData(GlBufferType::ShaderStorage, std::span{positions}, GlUsage::DynamicDraw);
-            OpenGl::BindBuffer(GlBufferType::Array, particels_positions_buffer_);
+            particles_positions_buffer_ = StorageBuffer<Vec4f>::Create(positions);
+            particles_positions_buffer_.EnsureCompatible(GetStorageBlock(*compute_shader_, "Pos"));
+            particles_positions_buffer_.Bind(0);
+            OpenGl::BindBuffer(GlBufferType::Array, particles_positions_buffer_.GetBuffer());
             OpenGl::EnableVertexAttribArray(a_particle_shader_position);
             VertexBufferHelperStatic<edt::Vec4f, false>::AttributePointer(a_particle_shader_position);
         }
@@ -73,11 +75,10 @@ class ComputeShaderExampleApp : public Application
             // looked up by name here. The shader declares it with an explicit location,
             // which stays valid whenever the attribute is active (COLOR_FUNCTION 1 and 2).
             constexpr size_t a_particle_shader_velocity = 1;
-            particles_velocities_buffer_ = OpenGl::GenBuffer();
-            std::vector<Vec3f> velocities(kTotalParticles, Vec3f{});
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, particles_velocities_buffer_.GetValue());
-            OpenGl::BufferData(GlBufferType::ShaderStorage, std::span{velocities}, GlUsage::DynamicCopy);
-            OpenGl::BindBuffer(GlBufferType::Array, particles_velocities_buffer_);
+            particles_velocities_buffer_ = StorageBuffer<Vec4f>::Create(kTotalParticles);
+            particles_velocities_buffer_.EnsureCompatible(GetStorageBlock(*compute_shader_, "Vel"));
+            particles_velocities_buffer_.Bind(1);
+            OpenGl::BindBuffer(GlBufferType::Array, particles_velocities_buffer_.GetBuffer());
             OpenGl::EnableVertexAttribArray(a_particle_shader_velocity);
             VertexBufferHelperStatic<edt::Vec4f, false>::AttributePointer(a_particle_shader_velocity);
         }
@@ -111,9 +112,17 @@ class ComputeShaderExampleApp : public Application
         }
     }
 
-    static std::vector<Vec3f> CalculateInitialParticePositions()
+    static const GlStorageBlockInfo& GetStorageBlock(const Shader& shader, std::string_view name)
     {
-        std::vector<Vec3f> positions(kTotalParticles);
+        const GlStorageBlockInfo* block = shader.GetInfo().FindStorageBlock(name);
+        ErrorHandling::Ensure(block != nullptr, "Storage block {} not found in the compute shader", name);
+        return *block;
+    }
+
+    // Positions are stored as vec4 because arrays of vec3 in std430 blocks have 16 bytes stride
+    static std::vector<Vec4f> CalculateInitialParticePositions()
+    {
+        std::vector<Vec4f> positions(kTotalParticles);
 
         const size_t s = static_cast<size_t>(std::round(std::pow(static_cast<float>(kTotalParticles), 1.f / 3)));
         auto delta = Vec3f{} + 2.f / static_cast<float>(s);
@@ -127,7 +136,8 @@ class ComputeShaderExampleApp : public Application
                 {
                     for (size_t z = 0; z < s; z++)
                     {
-                        positions[i] = (Vec3<size_t>{x, y, z}.Cast<float>() * delta - 1);
+                        const Vec3f position = Vec3<size_t>{x, y, z}.Cast<float>() * delta - 1;
+                        positions[i] = Vec4f{position.x(), position.y(), position.z(), 1.f};
                         if (++i == kTotalParticles)
                         {
                             return;
@@ -174,11 +184,11 @@ class ComputeShaderExampleApp : public Application
             compute_shader_->SetUniform(u_delta_t_, time_step_);
             compute_shader_->SendUniforms();
             glDispatchCompute(kTotalParticles, 1, 1);
-            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+            OpenGl::InsertMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
         }
 
         OpenGl::EnableBlending();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        OpenGl::SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         const auto mvp = camera_.GetViewMatrix().MatMul(camera_.GetProjectionMatrix(GetWindow().GetAspect()));
 
@@ -304,8 +314,8 @@ class ComputeShaderExampleApp : public Application
     Camera3d camera_{Vec3f{0, 15, 0}, {.yaw = -90, .pitch = 0}};
 
     GlVertexArrayId particles_vao_;
-    GlBufferId particels_positions_buffer_;
-    GlBufferId particles_velocities_buffer_;
+    StorageBuffer<Vec4f> particles_positions_buffer_;
+    StorageBuffer<Vec4f> particles_velocities_buffer_;
 
     GlVertexArrayId bodies_vao_;
     GlBufferId bodies_positions_buffer_;
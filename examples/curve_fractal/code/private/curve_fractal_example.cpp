@@ -111,7 +111,7 @@ class CurveFractalApp : public Application
         GetWindow().SetTitle("Curve Fractal");
 
         OpenGl::EnableBlending();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        OpenGl::SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         constexpr Vec2f eye{0, 0};
         constexpr float sample_extent = 3.f;
@@ -243,7 +243,7 @@ class CurveFractalApp : public Application
         framebuffer_.Bind();
         klgl::OpenGl::SetViewport(klgl::Viewport::FromWindowSize(kFramebufferResolution.Cast<uint32_t>()));
 
-        glDisable(GL_DEPTH_TEST);
+        OpenGl::SetDepthTestEnabled(false);
         if (first_clear_)
         {
             OpenGl::Clear(GL_COLOR_BUFFER_BIT);
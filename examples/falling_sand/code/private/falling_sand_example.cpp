@@ -235,6 +235,7 @@ class Painter2dApp : public Application
         auto viewport = Viewport::FromWindowSize(GetWindow().GetSize());
         render_transforms.Update(camera, viewport, AspectRatioPolicy::ShrinkToFit);
 
+        painter_->NextFrame();
         painter_->BeginDraw();
         painter_->SetViewMatrix(render_transforms.world_to_view.Transposed());
 
@@ -28,12 +28,7 @@ InterpolationWidget::InterpolationWidget(size_t num_colors)
     shader_->SetDefineValue(def_colors_count, static_cast<int>(num_colors));
     shader_->Compile();
 
-    u_color_table.resize(num_colors);
-    for (size_t i = 0; i != u_color_table.size(); ++i)
-    {
-        auto uniform_name = klgl::Name(fmt::format("uColorTable[{}]", i));
-        u_color_table[i] = shader_->GetUniform(uniform_name);
-    }
+    color_table.resize(num_colors);
 }
 
 InterpolationWidget::~InterpolationWidget() noexcept = default;
@@ -42,9 +37,8 @@ void InterpolationWidget::Render(const klgl::Viewport& viewport, const FractalSe
 {
     klgl::OpenGl::SetViewport(viewport);
     shader_->Use();
-    settings.ComputeColors(
-        u_color_table.size(),
-        [&](size_t i, const edt::Vec3f& color) { shader_->SetUniform(u_color_table[i], color); });
+    settings.ComputeColors(color_table.size(), [&](size_t i, const edt::Vec3f& color) { color_table[i] = color; });
+    shader_->SetUniformArray(u_color_table, std::span<const edt::Vec3f>(color_table));
 
     shader_->SendUniforms();
     mesh_->BindAndDraw();
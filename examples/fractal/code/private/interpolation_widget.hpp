@@ -25,6 +25,7 @@ public:
 
     std::shared_ptr<klgl::Shader> shader_;
     std::shared_ptr<klgl::MeshOpenGL> mesh_;
-    std::vector<klgl::UniformHandle> u_color_table;
+    klgl::UniformHandle u_color_table = klgl::UniformHandle("uColorTable");
+    std::vector<edt::Vec3f> color_table;
     klgl::DefineHandle def_colors_count{klgl::Name("COLORS_COUNT")};
 };
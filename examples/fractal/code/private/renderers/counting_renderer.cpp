@@ -1,11 +1,12 @@
 #include "counting_renderer.hpp"
 
-#include <klgl/opengl/detail/maps/to_gl_value/buffer_type.hpp>
 #include <klgl/opengl/vertex_attribute_helper.hpp>
 
 #include "fractal_settings.hpp"
+#include "klgl/error_handling.hpp"
 #include "klgl/mesh/mesh_data.hpp"
 #include "klgl/mesh/procedural_mesh_generator.hpp"
+#include "klgl/opengl/program_info.hpp"
 #include "klgl/reflection/matrix_reflect.hpp"  // IWYU pragma: keep
 #include "klgl/shader/shader.hpp"
 
@@ -31,14 +32,7 @@ CountingRenderer::CountingRenderer(size_t max_iterations_) : max_iterations(max_
     counters_vao_ = klgl::GlObject<klgl::GlVertexArrayId>::CreateFrom(klgl::OpenGl::GenVertexArray());
 
     draw_shader_ = std::make_unique<klgl::Shader>("fractal_example/counting_fractal");
-
-    u_color_table.resize(max_iterations + 1);
-
-    for (size_t i = 0; i != u_color_table.size(); ++i)
-    {
-        auto uniform_name = klgl::Name(fmt::format("u_color_table[{}]", i));
-        u_color_table[i] = draw_shader_->GetUniform(uniform_name);
-    }
+    draw_shader_->SetUniformBlockBinding("ColorTable", kColorTableBinding);
 }
 
 CountingRenderer::~CountingRenderer() noexcept = default;
@@ -59,24 +53,18 @@ void CountingRenderer::Render(const FractalSettings& settings)
     compute_shader_->SetUniform(u_compute_julia_constant_, settings.fractal_constant);
     compute_shader_->SendUniforms();
 
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, counters_buffer_.GetId().GetValue());
-    klgl::OpenGl::BindBuffer(klgl::GlBufferType::ShaderStorage, counters_buffer_);
-    glClearBufferData(
-        klgl::ToGlValue(klgl::GlBufferType::ShaderStorage),
-        GL_R32UI,  // must match your buffer format
-        GL_RED_INTEGER,
-        GL_UNSIGNED_INT,
-        nullptr  // NULL = zero-filled
-    );
+    counters_buffer_.Bind(kCountersBinding);
+    counters_buffer_.Clear();
 
     int groupSize = 16;
     auto resolution = settings.viewport.size.Cast<int>();
     glDispatchCompute((resolution.x() + groupSize - 1) / groupSize, (resolution.y() + groupSize - 1) / groupSize, 1);
-    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+    klgl::OpenGl::InsertMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
 
     draw_shader_->Use();
     draw_shader_->SetUniform(u_draw_resolution_, settings.viewport.size.Cast<float>());
     draw_shader_->SendUniforms();
+    color_table_->Bind(kColorTableBinding);
     mesh_->BindAndDraw();
 }
 
@@ -91,18 +79,32 @@ void CountingRenderer::ApplySettings(const FractalSettings& settings)
     klgl::OpenGl::BindVertexArray(counters_vao_);
     auto resolution = settings.viewport.size.Cast<size_t>();
     size_t num_pixels = resolution.x() * resolution.y();
-    if (current_counters_vao_size_ != num_pixels)
+    if (counters_buffer_.GetCount() != num_pixels)
     {
-        counters_buffer_ = klgl::GlObject<klgl::GlBufferId>::CreateFrom(klgl::OpenGl::GenBuffer());
-        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, counters_buffer_.GetId().GetValue());
-        std::vector<uint32_t> counters(num_pixels, 0);
-        klgl::OpenGl::BufferData(klgl::GlBufferType::ShaderStorage, std::span{counters}, klgl::GlUsage::DynamicDraw);
-        current_counters_vao_size_ = num_pixels;
+        counters_buffer_ = klgl::StorageBuffer<uint32_t>::Create(num_pixels);
     }
 
     draw_shader_->SetDefineValue(def_draw_max_iterations, static_cast<int>(max_iterations));
     draw_shader_->Compile();
+
+    for (const auto& shader : {compute_shader_, draw_shader_})
+    {
+        const klgl::GlStorageBlockInfo* pixel_buffer = shader->GetInfo().FindStorageBlock("PixelBuffer");
+        klgl::ErrorHandling::Ensure(pixel_buffer != nullptr, "PixelBuffer storage block is not active");
+        counters_buffer_.EnsureCompatible(*pixel_buffer);
+    }
+
+    // The whole table is uploaded with a single call instead of one glUniform call per color
+    const klgl::GlUniformBlockInfo* block = draw_shader_->GetInfo().FindUniformBlock("ColorTable");
+    klgl::ErrorHandling::Ensure(block != nullptr, "ColorTable uniform block is not active in counting_fractal");
+    if (!color_table_ || color_table_->GetData().size() != block->data_size)
+    {
+        color_table_ = klgl::UniformBuffer::CreateFromBlock(*block);
+        color_table_member_ = color_table_->GetMember("u_color_table");
+    }
+
     settings.ComputeColors(
-        u_color_table.size(),
-        [&](size_t index, const edt::Vec3f& color) { draw_shader_->SetUniform(u_color_table[index], color); });
+        max_iterations + 1,
+        [&](size_t index, const edt::Vec3f& color) { color_table_->Set(color_table_member_, color, index); });
+    color_table_->Upload();
 }
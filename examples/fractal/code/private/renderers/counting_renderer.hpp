@@ -2,8 +2,10 @@
 
 #include <klgl/opengl/identifiers.hpp>
 #include <klgl/opengl/object.hpp>
+#include <klgl/opengl/storage_buffer.hpp>
+#include <klgl/opengl/uniform_buffer.hpp>
 #include <memory>
-#include <vector>
+#include <optional>
 
 #include "fractal_renderer.hpp"
 #include "klgl/camera/camera_2d.hpp"
@@ -36,7 +38,10 @@ public:
 
     klgl::DefineHandle def_draw_max_iterations{klgl::Name("MAX_ITERATIONS")};
     klgl::UniformHandle u_draw_resolution_{"u_resolution"};
-    std::vector<klgl::UniformHandle> u_color_table;
+
+    static constexpr uint32_t kColorTableBinding = 0;
+    std::optional<klgl::UniformBuffer> color_table_;
+    size_t color_table_member_ = 0;
 
     std::shared_ptr<klgl::MeshOpenGL> mesh_;
     klgl::RenderTransforms2d render_transforms_;
@@ -45,6 +50,6 @@ public:
     std::shared_ptr<klgl::Shader> compute_shader_;
 
     klgl::GlObject<klgl::GlVertexArrayId> counters_vao_;
-    klgl::GlObject<klgl::GlBufferId> counters_buffer_;
-    size_t current_counters_vao_size_ = 0;
+    static constexpr uint32_t kCountersBinding = 0;
+    klgl::StorageBuffer<uint32_t> counters_buffer_;
 };
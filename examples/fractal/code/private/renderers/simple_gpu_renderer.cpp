@@ -27,13 +27,7 @@ SimpleGpuRenderer::SimpleGpuRenderer(size_t max_iterations_) : max_iterations(ma
     fractal_shader_ = std::make_unique<klgl::Shader>("fractal_example/fractal");
     fractal_shader_->SetDefineValue(def_max_iterations, static_cast<int>(max_iterations));
 
-    u_color_table.resize(max_iterations + 1);
-
-    for (size_t i = 0; i != u_color_table.size(); ++i)
-    {
-        auto uniform_name = klgl::Name(fmt::format("uColorTable[{}]", i));
-        u_color_table[i] = fractal_shader_->GetUniform(uniform_name);
-    }
+    color_table.resize(max_iterations + 1);
 }
 
 SimpleGpuRenderer::~SimpleGpuRenderer() noexcept = default;
@@ -65,6 +59,7 @@ void SimpleGpuRenderer::ApplySettings(const FractalSettings& settings)
     u_time_ = fractal_shader_->FindUniform(klgl::Name("u_time"));
 
     settings.ComputeColors(
-        u_color_table.size(),
-        [&](size_t index, const edt::Vec3f& color) { fractal_shader_->SetUniform(u_color_table[index], color); });
+        color_table.size(),
+        [&](size_t index, const edt::Vec3f& color) { color_table[index] = color; });
+    fractal_shader_->SetUniformArray(u_color_table, std::span<const edt::Vec3f>(color_table));
 }
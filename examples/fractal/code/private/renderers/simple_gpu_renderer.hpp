@@ -33,7 +33,8 @@ public:
     klgl::UniformHandle u_screen_to_world_ = klgl::UniformHandle("u_screen_to_world");
     klgl::UniformHandle u_julia_constant = klgl::UniformHandle("u_julia_constant");
     klgl::UniformHandle u_fractal_power = klgl::UniformHandle("u_fractal_power");
-    std::vector<klgl::UniformHandle> u_color_table;
+    klgl::UniformHandle u_color_table = klgl::UniformHandle("uColorTable");
+    std::vector<edt::Vec3f> color_table;
 
     size_t max_iterations{};
 
@@ -0,0 +1,19 @@
+vec2 complexMult(vec2 a, vec2 b) {
+    return vec2(
+        a.x * b.x - a.y * b.y,
+        a.x * b.y + a.y * b.x
+    );
+}
+
+vec2 complexExp(vec2 z)
+{
+    return exp(z.x) * vec2(cos(z.y), sin(z.y));
+}
+
+vec2 complexPower(vec2 base, vec2 power) {
+    float r = length(base);
+    float theta = atan(base.x, base.y);
+    vec2 log_z = vec2(log(r), theta);
+    vec2 exponent = complexMult(power, log_z);
+    return complexExp(exponent);
+}
@@ -0,0 +1,20 @@
+uniform mat3 u_screen_to_world;
+
+#if INSIDE_OUT_SPACE
+vec2 insideOutWarp(vec2 pos, vec2 center, float strength) {
+    vec2 dir = pos - center;
+    float dist = length(dir);
+
+    // Avoid division by zero
+    if (dist < 0.001) return pos;
+
+    // Inversion formula: radius squared over distance
+    float invertedDist = strength / dist;
+
+    return center + normalize(dir) * invertedDist;
+}
+#endif
+
+vec2 screen_point_to_world(vec2 screen) {
+    return (u_screen_to_world * vec3(screen, 1)).xy;
+}
@@ -1,7 +1,10 @@
 out vec4 FragColor;
 
 uniform vec2 u_resolution;
-uniform vec3 u_color_table[MAX_ITERATIONS + 1];
+
+layout(std140) uniform ColorTable {
+    vec3 u_color_table[MAX_ITERATIONS + 1];
+};
 
 layout(std430, binding = 0) buffer PixelBuffer {
     uint visitCounts[];
@@ -1,49 +1,12 @@
 out vec4 FragColor;
 
-uniform mat3 u_screen_to_world;
 uniform vec2 u_resolution;
 uniform vec2 u_julia_constant;
 uniform vec3 uColorTable[MAX_ITERATIONS + 1];
 uniform vec2 u_fractal_power;
 
-#if INSIDE_OUT_SPACE
-vec2 insideOutWarp(vec2 pos, vec2 center, float strength) {
-    vec2 dir = pos - center;
-    float dist = length(dir);
-    
-    // Avoid division by zero
-    if (dist < 0.001) return pos;
-
-    // Inversion formula: radius squared over distance
-    float invertedDist = strength / dist;
-
-    return center + normalize(dir) * invertedDist;
-}
-#endif
-
-vec2 screen_point_to_world(vec2 screen) {
-    return (u_screen_to_world * vec3(screen, 1)).xy;
-}
-
-vec2 complexMult(vec2 a, vec2 b) {
-    return vec2(
-        a.x * b.x - a.y * b.y,
-        a.x * b.y + a.y * b.x
-    );
-}
-
-vec2 complexExp(vec2 z)
-{
-    return exp(z.x) * vec2(cos(z.y), sin(z.y));
-}
-
-vec2 complexPower(vec2 base, vec2 power) {
-    float r = length(base);
-    float theta = atan(base.x, base.y);
-    vec2 log_z = vec2(log(r), theta);
-    vec2 exponent = complexMult(power, log_z);
-    return complexExp(exponent);
-}
+#include "../common/screen_space.glsl"
+#include "../common/complex.glsl"
 
 vec3 getColor(float smoothIteration) {
     float index = clamp(smoothIteration, 0.0, float(MAX_ITERATIONS));
@@ -36,7 +36,7 @@ class GeometryShaderApp : public klgl::Application
         GetWindow().SetTitle("Geometry Shader Quads");
 
         klgl::OpenGl::EnableBlending();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        klgl::OpenGl::SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         shader_ = std::make_unique<klgl::Shader>("points_to_quads_2d");
         shader_->Use();
@@ -30,6 +30,7 @@ class Painter2dApp : public Application
         // constexpr edt::Vec4u8 blue{0, 0, 255, 255};
         constexpr edt::Vec4u8 white{255, 255, 255, 255};
 
+        painter_->NextFrame();
         painter_->BeginDraw();
         painter_->FillRect({.center = {}, .size = {1, 1}, .color = red});
         painter_->RectLines({.center = {}, .size = {1, 1}, .color = white}, {0.01f});
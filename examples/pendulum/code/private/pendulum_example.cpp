@@ -195,6 +195,7 @@ class PendulumApp : public Application
 
         ImGui::SliderFloat("Time scale", &time_scale, 0.1f, 10.f);
 
+        painter_->NextFrame();
         painter_->BeginDraw();
         double target_time = static_cast<double>(GetTimeSeconds() * time_scale);
 
@@ -138,7 +138,7 @@ public:
 
         UpdateFramebuffer();
 
-        glDisable(GL_DEPTH_TEST);
+        OpenGl::SetDepthTestEnabled(false);
 
         auto render_scene = [&]
         {
@@ -111,7 +111,7 @@ public:
 
         UpdateFramebuffer();
 
-        glDisable(GL_DEPTH_TEST);
+        OpenGl::SetDepthTestEnabled(false);
 
         // Render to texture
         {
@@ -517,6 +517,7 @@ class Painter2dApp : public klgl::Application
             last_handled_time_step_ = current_time_step;
         }
 
+        painter_->NextFrame();
         painter_->BeginDraw();
 
         for (auto coords : tetris_grid_.AllCoords())
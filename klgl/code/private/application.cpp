@@ -12,10 +12,18 @@
 #include "klgl/camera/viewport.hpp"
 #include "klgl/events/event_manager.hpp"
 #include "klgl/opengl/debug/annotations.hpp"
-#include "klgl/opengl/debug/gl_debug_messenger.hpp"
+#include "klgl/opengl/debug/gl_frame_stats.hpp"
+#include "klgl/opengl/debug/gl_memory_tracker.hpp"
+#include "klgl/opengl/debug/gl_trace.hpp"
+#include "klgl/opengl/deletion_queue.hpp"
+#include "klgl/opengl/fence.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/name_pool.hpp"
 #include "klgl/platform/os/os.hpp"
+#include "klgl/rendering/resource_uploader.hpp"
 #include "klgl/reflection/register_types.hpp"
 #include "klgl/shader/shader.hpp"
+#include "klgl/ui/gl_frame_stats_overlay.hpp"
 #include "klgl/window.hpp"
 #include "platform/glfw/glfw_state.hpp"
 
@@ -83,6 +91,7 @@ struct Application::State
     }
 
     bool auto_clear_ = true;
+    bool show_frame_stats_ = false;
     TimePoint app_start_time_{};
     static constexpr size_t kFrameTimeHistorySize = 128;
     std::array<TimePoint, kFrameTimeHistorySize> frame_start_time_history_{};
@@ -91,6 +100,10 @@ struct Application::State
     uint8_t current_frame_time_index_ = kFrameTimeHistorySize - 1;
     std::optional<float> target_framerate_;
     events::EventManager event_manager_;
+    GlFenceRing frame_fences_;
+
+    // Created on first use. Declared after the window, so its shared context is destroyed first
+    std::unique_ptr<ResourceUploader> resource_uploader_;
 };
 
 Application::Application()
@@ -98,7 +111,18 @@ Application::Application()
     state_ = std::make_unique<State>();
 }
 
-Application::~Application() = default;
+Application::~Application()
+{
+    // Queued objects and unused pooled names must be deleted while the context is alive
+    state_->resource_uploader_.reset();
+    GlDeletionQueue::SetMode(GlDeletionMode::Immediate);
+    GlNamePool::Clear();
+
+    // Objects owned by the derived class are destroyed by now, so anything still alive has leaked
+    state_.reset();
+    GlMemoryTracker::ReportLeaks();
+    GlMemoryTracker::Reset();
+}
 
 int InitializeGLAD_impl()
 {
@@ -131,6 +155,12 @@ void Application::Initialize()
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #ifndef NDEBUG
         glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#else
+        // Some drivers send debug messages only to debug contexts
+        if (GetGlErrorCheckMode() == GlErrorCheckMode::DebugCallback)
+        {
+            glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+        }
 #endif
     }
 
@@ -151,7 +181,8 @@ void Application::Initialize()
     // GLAD can be initialized only when glfw has window context
     state_->window_->MakeContextCurrent();
     InitializeGLAD();
-    GlDebugMessenger::Start();
+    OpenGl::SetErrorCheckMode(GetGlErrorCheckMode());
+    GlDeletionQueue::SetMode(GetGlDeletionMode());
 
     glfwSwapInterval(0);
     ImGui::CreateContext();
@@ -196,19 +227,32 @@ void Application::PreTick()
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
+
+    // ImGui backend creates its objects with raw OpenGL calls
+    OpenGl::InvalidateStateCache();
 }
 
 void Application::Tick() {}
 
 void Application::PostTick()
 {
+    if (state_->show_frame_stats_)
+    {
+        GlFrameStatsOverlay{}.Draw();
+    }
+
     {
         ScopeAnnotation imgui_render("ImGUI");
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        OpenGl::InvalidateStateCache();
     }
 
+    OpenGl::CheckFrameErrors();
+    GlTraceRecorder::Record(GlTraceOpcode::FrameEnd);
     state_->window_->SwapBuffers();
+    state_->frame_fences_.NextFrame();
+    GlDeletionQueue::OnFrameEnd();
     glfwPollEvents();
 }
 
@@ -222,6 +266,7 @@ void Application::MainLoop()
         PreTick();
         Tick();
         PostTick();
+        GlFrameStatsRegistry::EndFrame();
         state_->AlignWithFramerate();
     }
 }
@@ -236,11 +281,45 @@ void Application::SetAutoClear(bool enabled)
     state_->auto_clear_ = enabled;
 }
 
+void Application::SetFrameStatsOverlayVisible(bool visible)
+{
+    state_->show_frame_stats_ = visible;
+}
+
+GlFrameStats Application::GetFrameStats() const
+{
+    return GlFrameStatsRegistry::GetLastFrame();
+}
+
+GlErrorCheckMode Application::GetGlErrorCheckMode() const
+{
+#ifdef NDEBUG
+    return GlErrorCheckMode::PerFrame;
+#else
+    return GlErrorCheckMode::PerCall;
+#endif
+}
+
+GlDeletionMode Application::GetGlDeletionMode() const
+{
+    return GlDeletionMode::Fence;
+}
+
 bool Application::WantsToClose() const
 {
     return state_->window_->ShouldClose();
 }
 
+ResourceUploader& Application::GetResourceUploader()
+{
+    if (!state_->resource_uploader_)
+    {
+        state_->resource_uploader_ = std::make_unique<ResourceUploader>(GetWindow());
+    }
+
+    return *state_->resource_uploader_;
+}
+
 Window& Application::GetWindow()
 {
     return *state_->window_;
@@ -291,6 +370,21 @@ void Application::SetTargetFramerate(std::optional<float> framerate)
     state_->target_framerate_ = framerate;
 }
 
+void Application::SetMaxFramesInFlight(size_t frames)
+{
+    state_->frame_fences_.Resize(frames);
+}
+
+size_t Application::GetMaxFramesInFlight() const
+{
+    return state_->frame_fences_.GetSize();
+}
+
+size_t Application::GetFrameInFlightIndex() const
+{
+    return state_->frame_fences_.GetCurrentIndex();
+}
+
 events::EventManager& Application::GetEventManager()
 {
     return state_->event_manager_;
@@ -50,6 +50,24 @@ void MeshOpenGL::ValidateIndicesCountForTopology(const GlPrimitiveType topology,
     }
 }
 
+void MeshOpenGL::CreateVertexArray()
+{
+    if (OpenGl::HasDirectStateAccess())
+    {
+        vao = GlObject<GlVertexArrayId>::CreateFrom(GlNamePool::CreateVertexArray());
+        OpenGl::VertexArrayElementBuffer(vao, ebo);
+        Bind();
+    }
+    else
+    {
+        vao = GlObject<GlVertexArrayId>::CreateFrom(GlNamePool::GenVertexArray());
+        Bind();
+        OpenGl::BindBuffer(GlBufferType::ElementArray, ebo);
+    }
+
+    OpenGl::BindBuffer(GlBufferType::Array, vbo);
+}
+
 void MeshOpenGL::Bind() const
 {
     OpenGl::BindVertexArray(vao);
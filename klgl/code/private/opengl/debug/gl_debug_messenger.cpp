@@ -1,18 +1,15 @@
 #include "klgl/opengl/debug/gl_debug_messenger.hpp"
 
+#include <mutex>
+#include <utility>
+
 #include "EverydayTools/Preprocessor/Stringify.hpp"
+#include "ankerl/unordered_dense.h"
 #include "fmt/core.h"
 
 namespace klgl
 {
 
-void GlDebugMessenger::Start()
-{
-    // glEnable(GL_DEBUG_OUTPUT);
-    // glDebugMessageCallback(GlDebugMessenger::DebugProc, nullptr);
-    // glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
-}
-
 #define CASE_RET_STR(val, name) \
     case val:                   \
         return TOSTRING(name);  \
@@ -29,7 +26,6 @@ static std::string_view SourceToString(GLenum source)
         CASE_RET_STR(GL_DEBUG_SOURCE_APPLICATION, APPLICATION);
         CASE_RET_STR(GL_DEBUG_SOURCE_OTHER, OTHER);
     default:
-        assert(false);
         return "unknown";
         break;
     }
@@ -44,26 +40,242 @@ static std::string_view TypeToString(GLenum type)
         CASE_RET_STR(GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR, UNDEFINED_BEHAVIOR);
         CASE_RET_STR(GL_DEBUG_TYPE_PORTABILITY, PORTABILITY);
         CASE_RET_STR(GL_DEBUG_TYPE_PERFORMANCE, PERFORMANCE);
+        CASE_RET_STR(GL_DEBUG_TYPE_MARKER, MARKER);
         CASE_RET_STR(GL_DEBUG_TYPE_PUSH_GROUP, PUSH_GROUP);
         CASE_RET_STR(GL_DEBUG_TYPE_POP_GROUP, POP_GROUP);
         CASE_RET_STR(GL_DEBUG_TYPE_OTHER, OTHER);
     default:
-        assert(false);
         return "unknown";
         break;
     }
 }
 
+static std::string_view SeverityToString(GlDebugSeverity severity)
+{
+    switch (severity)
+    {
+        CASE_RET_STR(GlDebugSeverity::Notification, NOTIFICATION);
+        CASE_RET_STR(GlDebugSeverity::Low, LOW);
+        CASE_RET_STR(GlDebugSeverity::Medium, MEDIUM);
+        CASE_RET_STR(GlDebugSeverity::High, HIGH);
+    default:
+        return "unknown";
+        break;
+    }
+}
+
+#undef CASE_RET_STR
+
+static GlDebugSeverity ToDebugSeverity(GLenum severity)
+{
+    switch (severity)
+    {
+    case GL_DEBUG_SEVERITY_HIGH:
+        return GlDebugSeverity::High;
+    case GL_DEBUG_SEVERITY_MEDIUM:
+        return GlDebugSeverity::Medium;
+    case GL_DEBUG_SEVERITY_LOW:
+        return GlDebugSeverity::Low;
+    default:
+        return GlDebugSeverity::Notification;
+    }
+}
+
+static GLenum FromDebugSeverity(GlDebugSeverity severity)
+{
+    switch (severity)
+    {
+    case GlDebugSeverity::High:
+        return GL_DEBUG_SEVERITY_HIGH;
+    case GlDebugSeverity::Medium:
+        return GL_DEBUG_SEVERITY_MEDIUM;
+    case GlDebugSeverity::Low:
+        return GL_DEBUG_SEVERITY_LOW;
+    default:
+        return GL_DEBUG_SEVERITY_NOTIFICATION;
+    }
+}
+
+namespace
+{
+struct MessengerState
+{
+    static MessengerState& Get()
+    {
+        static MessengerState state;
+        return state;
+    }
+
+    // Enum values of source and type fit into 16 bits
+    static uint64_t MakeKey(GLenum source, GLenum type, GLuint id)
+    {
+        return (uint64_t{source & 0xFFFF} << 48) | (uint64_t{type & 0xFFFF} << 32) | uint64_t{id};
+    }
+
+    std::mutex mutex;
+    bool started = false;
+    GlDebugSeverity min_severity = GlDebugSeverity::Notification;
+    ankerl::unordered_dense::map<uint64_t, GlDebugMessenger::Message> messages;
+    size_t errors_count = 0;
+    std::optional<std::string> new_error;
+};
+}  // namespace
+
+static bool IsDebugOutputSupported()
+{
+#ifdef GL_KHR_debug
+    if (GLAD_GL_KHR_debug) return true;
+#endif
+
+    return GLAD_GL_VERSION_4_3;
+}
+
+bool GlDebugMessenger::Start(const GlDebugMessengerSettings& settings)
+{
+    if (!IsDebugOutputSupported()) return false;
+
+    auto& state = MessengerState::Get();
+    {
+        std::lock_guard lock(state.mutex);
+        state.started = true;
+        state.min_severity = settings.min_severity;
+    }
+
+    glEnable(GL_DEBUG_OUTPUT);
+    if (settings.synchronous)
+    {
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    }
+    else
+    {
+        glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    }
+
+    glDebugMessageCallback(GlDebugMessenger::DebugProc, nullptr);
+
+    // Let the driver drop filtered messages instead of formatting them
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+    for (auto severity = static_cast<uint8_t>(settings.min_severity);
+         severity <= static_cast<uint8_t>(GlDebugSeverity::High);
+         ++severity)
+    {
+        const GLenum gl_severity = FromDebugSeverity(static_cast<GlDebugSeverity>(severity));
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, gl_severity, 0, nullptr, GL_TRUE);
+    }
+
+    // Scope annotations produce a pair of these for every scope
+    glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_PUSH_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+    glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_POP_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+
+    return true;
+}
+
+void GlDebugMessenger::Stop()
+{
+    auto& state = MessengerState::Get();
+    {
+        std::lock_guard lock(state.mutex);
+        if (!state.started) return;
+        state.started = false;
+    }
+
+    glDebugMessageCallback(nullptr, nullptr);
+    glDisable(GL_DEBUG_OUTPUT);
+}
+
+bool GlDebugMessenger::IsStarted()
+{
+    auto& state = MessengerState::Get();
+    std::lock_guard lock(state.mutex);
+    return state.started;
+}
+
+void GlDebugMessenger::IgnoreMessage(GLenum source, GLenum type, GLuint id)
+{
+    glDebugMessageControl(source, type, GL_DONT_CARE, 1, &id, GL_FALSE);
+}
+
+void GlDebugMessenger::ForEachMessage(const std::function<void(const Message&)>& visitor)
+{
+    auto& state = MessengerState::Get();
+    std::lock_guard lock(state.mutex);
+    for (const auto& [key, message] : state.messages)
+    {
+        visitor(message);
+    }
+}
+
+size_t GlDebugMessenger::GetErrorsCount()
+{
+    auto& state = MessengerState::Get();
+    std::lock_guard lock(state.mutex);
+    return state.errors_count;
+}
+
+std::optional<std::string> GlDebugMessenger::TakeNewError()
+{
+    auto& state = MessengerState::Get();
+    std::lock_guard lock(state.mutex);
+    return std::exchange(state.new_error, std::nullopt);
+}
+
+void GlDebugMessenger::ResetCounters()
+{
+    auto& state = MessengerState::Get();
+    std::lock_guard lock(state.mutex);
+    state.messages.clear();
+    state.errors_count = 0;
+    state.new_error.reset();
+}
+
 void GlDebugMessenger::DebugProc(
     GLenum source,
     GLenum type,
     GLuint id,
-    GLenum /*severity*/,
-    [[maybe_unused]] GLsizei length,
+    GLenum gl_severity,
+    GLsizei length,
     const GLchar* message,
     [[maybe_unused]] const void* user_param)
 {
-    fmt::println("{} {} {}: {}", SourceToString(source), TypeToString(type), id, message);
+    auto& state = MessengerState::Get();
+    const GlDebugSeverity severity = ToDebugSeverity(gl_severity);
+
+    std::lock_guard lock(state.mutex);
+    if (severity < state.min_severity) return;
+
+    auto [it, inserted] = state.messages.try_emplace(MessengerState::MakeKey(source, type, id));
+    Message& record = it->second;
+    ++record.count;
+
+    if (inserted)
+    {
+        record.source = source;
+        record.type = type;
+        record.id = id;
+        record.severity = severity;
+        record.text = length < 0 ? std::string(message) : std::string(message, static_cast<size_t>(length));
+    }
+
+    if (type == GL_DEBUG_TYPE_ERROR)
+    {
+        ++state.errors_count;
+        state.new_error = record.text;
+    }
+
+    if (inserted)
+    {
+        fmt::println(
+            "{} {} {} {}: {}",
+            SourceToString(source),
+            TypeToString(type),
+            SeverityToString(severity),
+            id,
+            record.text);
+    }
+    else if (record.count == 10 || record.count == 100 || record.count == 1000 || record.count % 10000 == 0)
+    {
+        fmt::println("{} {} {}: repeated {} times", SourceToString(source), TypeToString(type), id, record.count);
+    }
 }
 
 }  // namespace klgl
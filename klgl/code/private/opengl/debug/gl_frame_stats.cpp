@@ -0,0 +1,121 @@
+#include "klgl/opengl/debug/gl_frame_stats.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace klgl
+{
+
+namespace
+{
+// Relaxed atomics: counters are independent, and a call that races with EndFrame may land in either frame
+struct AtomicFrameStats
+{
+    [[nodiscard]] GlFrameStats Load() const noexcept
+    {
+        return {
+            .draw_calls = draw_calls.load(std::memory_order_relaxed),
+            .instances = instances.load(std::memory_order_relaxed),
+            .vertices = vertices.load(std::memory_order_relaxed),
+            .buffer_upload_bytes = buffer_upload_bytes.load(std::memory_order_relaxed),
+            .texture_upload_bytes = texture_upload_bytes.load(std::memory_order_relaxed),
+            .program_switches = program_switches.load(std::memory_order_relaxed),
+            .state_changes = state_changes.load(std::memory_order_relaxed),
+        };
+    }
+
+    [[nodiscard]] GlFrameStats Exchange() noexcept
+    {
+        return {
+            .draw_calls = draw_calls.exchange(0, std::memory_order_relaxed),
+            .instances = instances.exchange(0, std::memory_order_relaxed),
+            .vertices = vertices.exchange(0, std::memory_order_relaxed),
+            .buffer_upload_bytes = buffer_upload_bytes.exchange(0, std::memory_order_relaxed),
+            .texture_upload_bytes = texture_upload_bytes.exchange(0, std::memory_order_relaxed),
+            .program_switches = program_switches.exchange(0, std::memory_order_relaxed),
+            .state_changes = state_changes.exchange(0, std::memory_order_relaxed),
+        };
+    }
+
+    std::atomic<size_t> draw_calls = 0;
+    std::atomic<size_t> instances = 0;
+    std::atomic<size_t> vertices = 0;
+    std::atomic<size_t> buffer_upload_bytes = 0;
+    std::atomic<size_t> texture_upload_bytes = 0;
+    std::atomic<size_t> program_switches = 0;
+    std::atomic<size_t> state_changes = 0;
+};
+
+struct FrameStatsState
+{
+    static FrameStatsState& Get()
+    {
+        static FrameStatsState state;
+        return state;
+    }
+
+    AtomicFrameStats current;
+
+    // Written once per frame, read by the overlay and tests
+    std::mutex last_frame_mutex;
+    GlFrameStats last_frame;
+};
+}  // namespace
+
+void GlFrameStatsRegistry::OnDraw(size_t vertices, size_t instances) noexcept
+{
+    auto& current = FrameStatsState::Get().current;
+    current.draw_calls.fetch_add(1, std::memory_order_relaxed);
+    current.instances.fetch_add(instances, std::memory_order_relaxed);
+    current.vertices.fetch_add(vertices * instances, std::memory_order_relaxed);
+}
+
+void GlFrameStatsRegistry::OnBufferUpload(size_t bytes) noexcept
+{
+    FrameStatsState::Get().current.buffer_upload_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void GlFrameStatsRegistry::OnTextureUpload(size_t bytes) noexcept
+{
+    FrameStatsState::Get().current.texture_upload_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void GlFrameStatsRegistry::OnProgramSwitch() noexcept
+{
+    FrameStatsState::Get().current.program_switches.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GlFrameStatsRegistry::OnStateChange() noexcept
+{
+    FrameStatsState::Get().current.state_changes.fetch_add(1, std::memory_order_relaxed);
+}
+
+GlFrameStats GlFrameStatsRegistry::GetCurrent() noexcept
+{
+    return FrameStatsState::Get().current.Load();
+}
+
+GlFrameStats GlFrameStatsRegistry::GetLastFrame() noexcept
+{
+    auto& state = FrameStatsState::Get();
+    std::lock_guard lock(state.last_frame_mutex);
+    return state.last_frame;
+}
+
+void GlFrameStatsRegistry::EndFrame() noexcept
+{
+    auto& state = FrameStatsState::Get();
+    const GlFrameStats finished = state.current.Exchange();
+    std::lock_guard lock(state.last_frame_mutex);
+    state.last_frame = finished;
+}
+
+void GlFrameStatsRegistry::Reset() noexcept
+{
+    auto& state = FrameStatsState::Get();
+    [[maybe_unused]] const GlFrameStats discarded = state.current.Exchange();
+    std::lock_guard lock(state.last_frame_mutex);
+    state.last_frame = {};
+}
+
+}  // namespace klgl
@@ -0,0 +1,479 @@
+#include "klgl/opengl/debug/gl_memory_tracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include "ankerl/unordered_dense.h"
+#include "fmt/core.h"
+#include "klgl/opengl/detail/maps/texture_internal_format_to_texel_size.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/target_texture_type.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/texture_internal_format.hpp"
+#include "klgl/opengl/state_cache.hpp"
+
+namespace klgl
+{
+
+GlMemoryStats& GlMemoryStats::operator+=(const GlMemoryStats& other)
+{
+    objects += other.objects;
+    bytes += other.bytes;
+    created += other.created;
+    deleted += other.deleted;
+    allocated_bytes += other.allocated_bytes;
+    return *this;
+}
+
+GlMemoryStatsDiff GlMemoryStatsDiff::Compute(const GlMemoryStats& before, const GlMemoryStats& after)
+{
+    return {
+        .objects = static_cast<int64_t>(after.objects) - static_cast<int64_t>(before.objects),
+        .bytes = static_cast<int64_t>(after.bytes) - static_cast<int64_t>(before.bytes),
+        .created = after.created - before.created,
+        .deleted = after.deleted - before.deleted,
+        .allocated_bytes = after.allocated_bytes - before.allocated_bytes,
+    };
+}
+
+GlMemorySnapshotDiff operator-(const GlMemorySnapshot& after, const GlMemorySnapshot& before)
+{
+    GlMemorySnapshotDiff diff;
+    for (size_t i = 0; i != diff.per_kind.size(); ++i)
+    {
+        diff.per_kind[i] = GlMemoryStatsDiff::Compute(before.per_kind[i], after.per_kind[i]);
+    }
+
+    diff.total = GlMemoryStatsDiff::Compute(before.total, after.total);
+    return diff;
+}
+
+static GLenum GetBindingQuery(GlBufferType target)
+{
+    switch (target)
+    {
+    case GlBufferType::Array:
+        return GL_ARRAY_BUFFER_BINDING;
+    case GlBufferType::AtomicCounter:
+        return GL_ATOMIC_COUNTER_BUFFER_BINDING;
+    case GlBufferType::CopyRead:
+        return GL_COPY_READ_BUFFER_BINDING;
+    case GlBufferType::CopyWrite:
+        return GL_COPY_WRITE_BUFFER_BINDING;
+    case GlBufferType::DispatchIndirect:
+        return GL_DISPATCH_INDIRECT_BUFFER_BINDING;
+    case GlBufferType::DrawIndirect:
+        return GL_DRAW_INDIRECT_BUFFER_BINDING;
+    case GlBufferType::ElementArray:
+        return GL_ELEMENT_ARRAY_BUFFER_BINDING;
+    case GlBufferType::PixelPack:
+        return GL_PIXEL_PACK_BUFFER_BINDING;
+    case GlBufferType::PixelUnpack:
+        return GL_PIXEL_UNPACK_BUFFER_BINDING;
+    case GlBufferType::Query:
+        return GL_QUERY_BUFFER_BINDING;
+    case GlBufferType::ShaderStorage:
+        return GL_SHADER_STORAGE_BUFFER_BINDING;
+    case GlBufferType::Texture:
+        return GL_TEXTURE_BUFFER_BINDING;
+    case GlBufferType::TransformFeedback:
+        return GL_TRANSFORM_FEEDBACK_BUFFER_BINDING;
+    case GlBufferType::Uniform:
+        return GL_UNIFORM_BUFFER_BINDING;
+    }
+
+    return GL_NONE;
+}
+
+static GLenum GetBindingQuery(GlTargetTextureType target)
+{
+    switch (target)
+    {
+    case GlTargetTextureType::Texture1d:
+        return GL_TEXTURE_BINDING_1D;
+    case GlTargetTextureType::Texture1dArray:
+        return GL_TEXTURE_BINDING_1D_ARRAY;
+    case GlTargetTextureType::Texture2d:
+        return GL_TEXTURE_BINDING_2D;
+    case GlTargetTextureType::Texture2dArray:
+        return GL_TEXTURE_BINDING_2D_ARRAY;
+    case GlTargetTextureType::Texture2dMultisample:
+        return GL_TEXTURE_BINDING_2D_MULTISAMPLE;
+    case GlTargetTextureType::Texture2dMultisampleArray:
+        return GL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY;
+    case GlTargetTextureType::Texture3d:
+        return GL_TEXTURE_BINDING_3D;
+    case GlTargetTextureType::TextureCubeMap:
+        return GL_TEXTURE_BINDING_CUBE_MAP;
+    case GlTargetTextureType::TextureCubeMapArray:
+        return GL_TEXTURE_BINDING_CUBE_MAP_ARRAY;
+    case GlTargetTextureType::TextureRectangle:
+        return GL_TEXTURE_BINDING_RECTANGLE;
+    }
+
+    return GL_NONE;
+}
+
+// Bind-to-edit hooks take the bound object from the state cache because glGetIntegerv may make the driver wait for
+// queued commands. The query is issued only when the cache does not know the binding, after it was invalidated
+static GLuint GetBoundObject(std::optional<GLuint> cached, GLenum binding_query)
+{
+    if (cached) return *cached;
+    if (binding_query == GL_NONE) return 0;
+
+    GLint name = 0;
+    glGetIntegerv(binding_query, &name);
+    return static_cast<GLuint>(name);
+}
+
+static GLuint GetBoundObject(GlBufferType target)
+{
+    return GetBoundObject(GlStateCache::Get().GetBoundBuffer(target), GetBindingQuery(target));
+}
+
+static GLuint GetBoundObject(GlTargetTextureType target)
+{
+    return GetBoundObject(GlStateCache::Get().GetBoundTexture(target), GetBindingQuery(target));
+}
+
+static size_t GetLevelBytes(size_t width, size_t height, size_t level, size_t texel_size)
+{
+    return std::max<size_t>(width >> level, 1) * std::max<size_t>(height >> level, 1) * texel_size;
+}
+
+namespace
+{
+struct ObjectRecord
+{
+    size_t bytes = 0;
+
+    // Textures only: bytes of each level and the format of the base level, so glGenerateMipmap can be estimated
+    std::vector<size_t> levels;
+    size_t width = 0;
+    size_t height = 0;
+    size_t texel_size = 0;
+};
+
+struct TrackerState
+{
+    static TrackerState& Get()
+    {
+        static TrackerState state;
+        return state;
+    }
+
+    ObjectRecord* Find(GlObjectKind kind, GLuint name)
+    {
+        auto& objects = objects_per_kind[static_cast<size_t>(kind)];
+        auto it = objects.find(name);
+        return it == objects.end() ? nullptr : &it->second;
+    }
+
+    void SetBytes(GlObjectKind kind, ObjectRecord& record, size_t bytes)
+    {
+        GlMemoryStats& stats = snapshot.Get(kind);
+        stats.bytes = stats.bytes - record.bytes + bytes;
+        stats.allocated_bytes += bytes;
+        record.bytes = bytes;
+    }
+
+    void SetTextureLevel(GLuint texture, size_t level, size_t texel_size, size_t width, size_t height)
+    {
+        ObjectRecord* record = Find(GlObjectKind::Texture, texture);
+        if (!record) return;
+
+        if (level == 0)
+        {
+            record->width = width;
+            record->height = height;
+            record->texel_size = texel_size;
+        }
+
+        record->levels.resize(std::max(record->levels.size(), level + 1));
+        record->levels[level] = GetLevelBytes(width, height, 0, texel_size);
+        SetBytes(GlObjectKind::Texture, *record, std::reduce(record->levels.begin(), record->levels.end()));
+    }
+
+    std::mutex mutex;
+    std::array<ankerl::unordered_dense::map<GLuint, ObjectRecord>, GlMemorySnapshot::kKindsCount> objects_per_kind;
+
+    // Totals are not kept up to date, TakeSnapshot computes them
+    GlMemorySnapshot snapshot;
+};
+}  // namespace
+
+#ifdef NDEBUG
+static std::atomic_bool tracker_enabled = false;
+#else
+static std::atomic_bool tracker_enabled = true;
+#endif
+
+static size_t GetTexelSize(GlTextureInternalFormat format)
+{
+    return detail::kTextureInternalFormatToTexelSize.Get(format);
+}
+
+// Unknown formats are assumed to be four bytes per texel
+static size_t GetTexelSize(GLint internal_format)
+{
+    const auto& from_gl_enum = detail::kGlTextureInternalFormatToGlValue.from_gl_enum;
+    if (!from_gl_enum.Contains(internal_format)) return 4;
+    return GetTexelSize(from_gl_enum.Get(internal_format));
+}
+
+void GlMemoryTracker::SetEnabled(bool enabled)
+{
+    if (!enabled) Reset();
+    tracker_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool GlMemoryTracker::IsEnabled() noexcept
+{
+    return tracker_enabled.load(std::memory_order_relaxed);
+}
+
+void GlMemoryTracker::OnCreated(GlObjectKind kind, std::span<const GLuint> names)
+{
+    if (!IsEnabled()) return;
+
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+
+    auto& objects = state.objects_per_kind[static_cast<size_t>(kind)];
+    GlMemoryStats& stats = state.snapshot.Get(kind);
+    for (const GLuint name : names)
+    {
+        if (name == 0) continue;
+
+        // The name could have been deleted with a raw OpenGL call and reused
+        if (auto it = objects.find(name); it != objects.end())
+        {
+            stats.bytes -= it->second.bytes;
+            --stats.objects;
+            objects.erase(it);
+        }
+
+        objects.emplace(name, ObjectRecord{});
+        ++stats.objects;
+        ++stats.created;
+    }
+}
+
+void GlMemoryTracker::OnDeleted(GlObjectKind kind, GLuint name)
+{
+    if (!IsEnabled()) return;
+
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+
+    auto& objects = state.objects_per_kind[static_cast<size_t>(kind)];
+    auto it = objects.find(name);
+    if (it == objects.end()) return;
+
+    GlMemoryStats& stats = state.snapshot.Get(kind);
+    stats.bytes -= it->second.bytes;
+    --stats.objects;
+    ++stats.deleted;
+    objects.erase(it);
+}
+
+void GlMemoryTracker::OnBufferData(GlBufferType target, size_t size)
+{
+    if (!IsEnabled()) return;
+
+    OnNamedBufferData(GetBoundObject(target), size);
+}
+
+void GlMemoryTracker::OnNamedBufferData(GLuint buffer, size_t size)
+{
+    if (!IsEnabled()) return;
+
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+    if (ObjectRecord* record = state.Find(GlObjectKind::Buffer, buffer))
+    {
+        state.SetBytes(GlObjectKind::Buffer, *record, size);
+    }
+}
+
+void GlMemoryTracker::OnTexImage(
+    GlTargetTextureType target,
+    size_t level,
+    GLint internal_format,
+    size_t width,
+    size_t height)
+{
+    if (!IsEnabled()) return;
+
+    const GLuint texture = GetBoundObject(target);
+    const size_t texel_size = GetTexelSize(internal_format);
+
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+    state.SetTextureLevel(texture, level, texel_size, width, height);
+}
+
+void GlMemoryTracker::OnTextureStorage(
+    GLuint texture,
+    size_t levels,
+    GlTextureInternalFormat format,
+    size_t width,
+    size_t height)
+{
+    if (!IsEnabled()) return;
+
+    const size_t texel_size = GetTexelSize(format);
+
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+    for (size_t level = 0; level != levels; ++level)
+    {
+        state.SetTextureLevel(
+            texture,
+            level,
+            texel_size,
+            std::max<size_t>(width >> level, 1),
+            std::max<size_t>(height >> level, 1));
+    }
+}
+
+void GlMemoryTracker::OnGenerateMipmap(GLenum target)
+{
+    if (!IsEnabled()) return;
+
+    const auto& from_gl_enum = detail::kGlTargetTextureType.from_gl_enum;
+    if (!from_gl_enum.Contains(target)) return;
+
+    const GLuint texture = GetBoundObject(from_gl_enum.Get(target));
+
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+    ObjectRecord* record = state.Find(GlObjectKind::Texture, texture);
+    if (!record || record->texel_size == 0) return;
+
+    const size_t width = record->width;
+    const size_t height = record->height;
+    const size_t texel_size = record->texel_size;
+    const size_t levels = std::bit_width(std::max(width, height));
+    for (size_t level = 1; level < levels; ++level)
+    {
+        state.SetTextureLevel(
+            texture,
+            level,
+            texel_size,
+            std::max<size_t>(width >> level, 1),
+            std::max<size_t>(height >> level, 1));
+    }
+}
+
+void GlMemoryTracker::OnRenderbufferStorage(GlTextureInternalFormat format, size_t width, size_t height)
+{
+    if (!IsEnabled()) return;
+
+    const GLuint renderbuffer = GetBoundObject(GlStateCache::Get().GetBoundRenderbuffer(), GL_RENDERBUFFER_BINDING);
+    SetRenderbufferSize(renderbuffer, format, width, height);
+}
+
+void GlMemoryTracker::SetTextureLevel(
+    GLuint texture,
+    size_t level,
+    GlTextureInternalFormat format,
+    size_t width,
+    size_t height)
+{
+    if (!IsEnabled()) return;
+
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+    state.SetTextureLevel(texture, level, GetTexelSize(format), width, height);
+}
+
+void GlMemoryTracker::SetRenderbufferSize(
+    GLuint renderbuffer,
+    GlTextureInternalFormat format,
+    size_t width,
+    size_t height)
+{
+    if (!IsEnabled()) return;
+
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+    if (ObjectRecord* record = state.Find(GlObjectKind::Renderbuffer, renderbuffer))
+    {
+        state.SetBytes(GlObjectKind::Renderbuffer, *record, GetLevelBytes(width, height, 0, GetTexelSize(format)));
+    }
+}
+
+GlMemorySnapshot GlMemoryTracker::TakeSnapshot()
+{
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+
+    GlMemorySnapshot snapshot = state.snapshot;
+    snapshot.total = {};
+    for (const GlMemoryStats& stats : snapshot.per_kind)
+    {
+        snapshot.total += stats;
+    }
+
+    return snapshot;
+}
+
+size_t GlMemoryTracker::GetObjectBytes(GlObjectKind kind, GLuint name)
+{
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+    const ObjectRecord* record = state.Find(kind, name);
+    return record ? record->bytes : 0;
+}
+
+void GlMemoryTracker::ForEachObject(const std::function<void(GlObjectKind kind, GLuint name, size_t bytes)>& visitor)
+{
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+    for (size_t kind_index = 0; kind_index != state.objects_per_kind.size(); ++kind_index)
+    {
+        const auto kind = static_cast<GlObjectKind>(kind_index);
+        for (const auto& [name, record] : state.objects_per_kind[kind_index])
+        {
+            visitor(kind, name, record.bytes);
+        }
+    }
+}
+
+size_t GlMemoryTracker::ReportLeaks()
+{
+    size_t leaks_count = 0;
+    size_t leaked_bytes = 0;
+    ForEachObject(
+        [&](GlObjectKind kind, GLuint name, size_t bytes)
+        {
+            fmt::println("Leaked OpenGL object: {} {} ({} bytes)", kind, name, bytes);
+            ++leaks_count;
+            leaked_bytes += bytes;
+        });
+
+    if (leaks_count != 0)
+    {
+        fmt::println("{} OpenGL objects holding {} bytes were not deleted", leaks_count, leaked_bytes);
+    }
+
+    return leaks_count;
+}
+
+void GlMemoryTracker::Reset()
+{
+    auto& state = TrackerState::Get();
+    std::lock_guard lock(state.mutex);
+    for (auto& objects : state.objects_per_kind)
+    {
+        objects.clear();
+    }
+
+    state.snapshot = {};
+}
+
+}  // namespace klgl
@@ -0,0 +1,80 @@
+#include "klgl/opengl/debug/gl_trace.hpp"
+
+#include <fmt/std.h>
+
+#include <fstream>
+#include <string>
+
+#include "klgl/filesystem/filesystem.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+constexpr uint32_t kTraceFileMagic = 0x4C54474B;  // "KGTL"
+constexpr size_t kCallHeaderSize = 2 + sizeof(uint32_t);
+}  // namespace
+
+GlTrace::Call GlTrace::ReadCall(std::span<const uint8_t>& bytes)
+{
+    ErrorHandling::Ensure(bytes.size() >= kCallHeaderSize, "Truncated GL trace call header");
+
+    Call call{};
+    call.opcode = static_cast<GlTraceOpcode>(bytes[0]);
+    const size_t args_size = bytes[1];
+    uint32_t data_size = 0;
+    std::memcpy(&data_size, bytes.data() + 2, sizeof(data_size));
+    bytes = bytes.subspan(kCallHeaderSize);
+
+    ErrorHandling::Ensure(bytes.size() >= args_size + data_size, "Truncated GL trace call body");
+    call.args = bytes.subspan(0, args_size);
+    call.data = bytes.subspan(args_size, data_size);
+    bytes = bytes.subspan(args_size + data_size);
+    return call;
+}
+
+void GlTrace::SaveToFile(const std::filesystem::path& path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    ErrorHandling::Ensure(file.is_open(), "Failed to open file \"{}\" for write", path);
+    file.write(reinterpret_cast<const char*>(&kTraceFileMagic), sizeof(kTraceFileMagic));  // NOLINT
+    file.write(reinterpret_cast<const char*>(bytes_.data()), static_cast<std::streamsize>(bytes_.size()));  // NOLINT
+    ErrorHandling::Ensure(file.good(), "Failed to write GL trace to \"{}\"", path);
+}
+
+GlTrace GlTrace::LoadFromFile(const std::filesystem::path& path)
+{
+    std::string content;
+    Filesystem::ReadFile(path, content);
+
+    uint32_t magic = 0;
+    ErrorHandling::Ensure(content.size() >= sizeof(magic), "File \"{}\" is too small to be a GL trace", path);
+    std::memcpy(&magic, content.data(), sizeof(magic));
+    ErrorHandling::Ensure(magic == kTraceFileMagic, "File \"{}\" is not a GL trace", path);
+
+    std::vector<uint8_t> bytes(content.size() - sizeof(magic));
+    std::memcpy(bytes.data(), content.data() + sizeof(magic), bytes.size());
+    return GlTrace(std::move(bytes));
+}
+
+GlTraceRecorder::~GlTraceRecorder()
+{
+    if (IsRecording()) active_ = nullptr;
+}
+
+void GlTraceRecorder::Start()
+{
+    ErrorHandling::Ensure(!active_, "Another GL trace recorder is already active on this thread");
+    bytes_.clear();
+    active_ = this;
+}
+
+GlTrace GlTraceRecorder::Stop()
+{
+    ErrorHandling::Ensure(IsRecording(), "GL trace recorder was not started");
+    active_ = nullptr;
+    return GlTrace(std::move(bytes_));
+}
+
+}  // namespace klgl
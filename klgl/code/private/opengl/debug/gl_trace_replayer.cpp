@@ -0,0 +1,718 @@
+#include "klgl/opengl/debug/gl_trace_replayer.hpp"
+
+#include <concepts>
+#include <vector>
+
+#include "klgl/camera/viewport.hpp"
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/target_texture_type.hpp"
+#include "klgl/opengl/gl_api.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+
+using ArgsReader = GlTrace::ArgsReader;
+
+// Trace data is not aligned, so values are copied before they are passed to OpenGL
+template <typename T>
+std::vector<T> CopyData(std::span<const uint8_t> data)
+{
+    std::vector<T> values(data.size() / sizeof(T));
+    std::memcpy(values.data(), data.data(), values.size() * sizeof(T));
+    return values;
+}
+
+template <typename T>
+void ReplayUniform(ArgsReader& args, std::span<const uint8_t> data)
+{
+    const auto location = args.Read<uint32_t>();
+    const bool transpose = args.Read<bool>();
+    const std::vector<T> values = CopyData<T>(data);
+    if constexpr (std::same_as<T, Mat3f> || std::same_as<T, Mat4f>)
+    {
+        OpenGl::SetUniformArrayNE(location, std::span<const T>{values}, transpose);
+    }
+    else
+    {
+        OpenGl::SetUniformArrayNE(location, std::span<const T>{values});
+    }
+}
+
+[[nodiscard]] const void* ReadPointer(ArgsReader& args)
+{
+    return reinterpret_cast<const void*>(args.Read<uintptr_t>());  // NOLINT
+}
+
+[[nodiscard]] GLuint GenName(GlObjectKind kind)
+{
+    switch (kind)
+    {
+    case GlObjectKind::Buffer:
+        return OpenGl::GenBufferNE().GetValue();
+    case GlObjectKind::VertexArray:
+        return OpenGl::GenVertexArrayNE().GetValue();
+    case GlObjectKind::Texture:
+        return OpenGl::GenTextureNE().GetValue();
+    case GlObjectKind::Framebuffer:
+        return OpenGl::GenFramebufferNE().GetValue();
+    case GlObjectKind::Renderbuffer:
+        return OpenGl::GenRenderbufferNE().GetValue();
+    case GlObjectKind::ProgramPipeline:
+        return OpenGl::GenProgramPipelineNE().GetValue();
+    default:
+        ErrorHandling::ThrowWithMessage("Objects of kind {} can not be generated", magic_enum::enum_name(kind));
+    }
+
+    return 0;
+}
+
+void DeleteName(GlObjectKind kind, GLuint name)
+{
+    switch (kind)
+    {
+    case GlObjectKind::Buffer:
+        OpenGl::DeleteBufferNE(GlBufferId{name});
+        break;
+    case GlObjectKind::VertexArray:
+        OpenGl::DeleteVertexArrayNE(GlVertexArrayId{name});
+        break;
+    case GlObjectKind::Texture:
+        OpenGl::DeleteTextureNE(GlTextureId{name});
+        break;
+    case GlObjectKind::Framebuffer:
+        OpenGl::DeleteFramebufferNE(GlFramebufferId{name});
+        break;
+    case GlObjectKind::Renderbuffer:
+        OpenGl::DeleteRenderbufferNE(GlRenderbufferId{name});
+        break;
+    case GlObjectKind::ProgramPipeline:
+        OpenGl::DeleteProgramPipelineNE(GlProgramPipelineId{name});
+        break;
+    case GlObjectKind::Shader:
+        OpenGl::DeleteShaderNE(GlShaderId{name});
+        break;
+    case GlObjectKind::Program:
+        OpenGl::DeleteProgramNE(GlProgramId{name});
+        break;
+    }
+}
+
+}  // namespace
+
+GlTraceStats GlTraceReplayer::Count(const GlTrace& trace)
+{
+    GlTraceStats stats;
+    trace.ForEachCall(
+        [&](const GlTrace::Call& call)
+        {
+            ++stats.calls;
+            ++stats.calls_per_opcode[static_cast<size_t>(call.opcode)];
+            stats.data_bytes += call.data.size();
+
+            switch (call.opcode)
+            {
+            case GlTraceOpcode::FrameEnd:
+                ++stats.frames;
+                break;
+            case GlTraceOpcode::DrawElements:
+            case GlTraceOpcode::DrawElementsInstanced:
+            case GlTraceOpcode::DrawArrays:
+            case GlTraceOpcode::DrawArraysInstanced:
+                ++stats.draw_calls;
+                break;
+            default:
+                break;
+            }
+        });
+
+    return stats;
+}
+
+void GlTraceReplayer::Replay(const GlTrace& trace, const std::function<void()>& on_frame_end)
+{
+    // Nothing is known about the state of the context the trace is replayed against
+    OpenGl::InvalidateStateCache();
+
+    trace.ForEachCall(
+        [&](const GlTrace::Call& call)
+        {
+            if (call.opcode == GlTraceOpcode::FrameEnd)
+            {
+                if (on_frame_end) on_frame_end();
+                return;
+            }
+
+            ReplayCall(call);
+        });
+}
+
+GLuint GlTraceReplayer::MapName(GlObjectKind kind, GLuint name) const
+{
+    // Zero is the default object of every kind
+    if (name == 0) return 0;
+
+    const auto& names = names_[static_cast<size_t>(kind)];
+    const auto it = names.find(name);
+    ErrorHandling::Ensure(
+        it != names.end(),
+        "GL trace references unknown object {} of kind {}",
+        name,
+        magic_enum::enum_name(kind));
+    return it->second;
+}
+
+void GlTraceReplayer::AddName(GlObjectKind kind, GLuint recorded, GLuint created)
+{
+    names_[static_cast<size_t>(kind)][recorded] = created;
+}
+
+void GlTraceReplayer::ReplayCall(const GlTrace::Call& call)
+{
+    using Kind = GlObjectKind;
+    ArgsReader args(call.args);
+    const std::span<const uint8_t> data = call.data;
+
+    auto read_buffer = [&]
+    {
+        return GlBufferId{MapName(Kind::Buffer, args.Read<GLuint>())};
+    };
+    auto read_vertex_array = [&]
+    {
+        return GlVertexArrayId{MapName(Kind::VertexArray, args.Read<GLuint>())};
+    };
+    auto read_texture = [&]
+    {
+        return GlTextureId{MapName(Kind::Texture, args.Read<GLuint>())};
+    };
+    auto read_shader = [&]
+    {
+        return GlShaderId{MapName(Kind::Shader, args.Read<GLuint>())};
+    };
+    auto read_program = [&]
+    {
+        return GlProgramId{MapName(Kind::Program, args.Read<GLuint>())};
+    };
+    auto read_pipeline = [&]
+    {
+        return GlProgramPipelineId{MapName(Kind::ProgramPipeline, args.Read<GLuint>())};
+    };
+    auto read_vec2 = [&]
+    {
+        const auto x = args.Read<size_t>();
+        const auto y = args.Read<size_t>();
+        return edt::Vec2<size_t>{x, y};
+    };
+
+    switch (call.opcode)
+    {
+    case GlTraceOpcode::FrameEnd:
+        break;
+
+    // Objects
+    case GlTraceOpcode::GenObjects:
+    {
+        const auto kind = args.Read<Kind>();
+        for (const GLuint recorded : CopyData<GLuint>(data))
+        {
+            AddName(kind, recorded, GenName(kind));
+        }
+        break;
+    }
+    case GlTraceOpcode::DeleteObject:
+    {
+        const auto kind = args.Read<Kind>();
+        const auto recorded = args.Read<GLuint>();
+        DeleteName(kind, MapName(kind, recorded));
+        names_[static_cast<size_t>(kind)].erase(recorded);
+        break;
+    }
+    case GlTraceOpcode::CreateBuffer:
+        AddName(Kind::Buffer, args.Read<GLuint>(), OpenGl::CreateBufferNE().GetValue());
+        break;
+    case GlTraceOpcode::CreateVertexArray:
+        AddName(Kind::VertexArray, args.Read<GLuint>(), OpenGl::CreateVertexArrayNE().GetValue());
+        break;
+    case GlTraceOpcode::CreateTexture:
+    {
+        const auto target = args.Read<GlTargetTextureType>();
+        AddName(Kind::Texture, args.Read<GLuint>(), OpenGl::CreateTextureNE(target).GetValue());
+        break;
+    }
+
+    // Buffers
+    case GlTraceOpcode::BindBuffer:
+    {
+        const auto target = args.Read<GlBufferType>();
+        OpenGl::BindBufferNE(target, read_buffer());
+        break;
+    }
+    case GlTraceOpcode::BindBufferBase:
+    {
+        const auto target = args.Read<GlBufferType>();
+        const auto index = args.Read<uint32_t>();
+        OpenGl::BindBufferBaseNE(target, index, read_buffer());
+        break;
+    }
+    case GlTraceOpcode::BindBufferRange:
+    {
+        const auto target = args.Read<GlBufferType>();
+        const auto index = args.Read<uint32_t>();
+        const auto buffer = read_buffer();
+        const auto offset = args.Read<size_t>();
+        const auto size = args.Read<size_t>();
+        OpenGl::BindBufferRangeNE(target, index, buffer, offset, size);
+        break;
+    }
+    case GlTraceOpcode::BufferData:
+    {
+        const auto target = args.Read<GlBufferType>();
+        const auto size = args.Read<size_t>();
+        const auto usage = args.Read<GlUsage>();
+        if (data.empty())
+        {
+            OpenGl::BufferDataNE(target, size, usage);
+        }
+        else
+        {
+            OpenGl::BufferDataNE(target, data, usage);
+        }
+        break;
+    }
+    case GlTraceOpcode::BufferSubData:
+    {
+        const auto target = args.Read<GlBufferType>();
+        OpenGl::BufferSubDataNE(target, args.Read<size_t>(), data);
+        break;
+    }
+    case GlTraceOpcode::BufferStorage:
+    {
+        const auto target = args.Read<GlBufferType>();
+        const auto size = args.Read<size_t>();
+        const auto flags = args.Read<GLbitfield>();
+        OpenGl::BufferStorageNE(target, size, data.empty() ? nullptr : data.data(), flags);
+        break;
+    }
+    case GlTraceOpcode::ClearBufferSubData:
+    {
+        const auto target = args.Read<GlBufferType>();
+        const auto offset = args.Read<size_t>();
+        OpenGl::ClearBufferSubDataNE(target, offset, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::CopyBufferSubData:
+    {
+        const auto read_target = args.Read<GlBufferType>();
+        const auto write_target = args.Read<GlBufferType>();
+        const auto read_offset = args.Read<size_t>();
+        const auto write_offset = args.Read<size_t>();
+        OpenGl::CopyBufferSubDataNE(read_target, write_target, read_offset, write_offset, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::NamedBufferData:
+    {
+        const auto buffer = read_buffer();
+        const auto size = args.Read<size_t>();
+        const auto usage = args.Read<GlUsage>();
+        if (data.empty())
+        {
+            OpenGl::NamedBufferDataNE(buffer, size, usage);
+        }
+        else
+        {
+            OpenGl::NamedBufferDataNE(buffer, data, usage);
+        }
+        break;
+    }
+    case GlTraceOpcode::NamedBufferSubData:
+    {
+        const auto buffer = read_buffer();
+        OpenGl::NamedBufferSubDataNE(buffer, args.Read<size_t>(), data);
+        break;
+    }
+
+    // Vertex arrays
+    case GlTraceOpcode::BindVertexArray:
+        OpenGl::BindVertexArrayNE(read_vertex_array());
+        break;
+    case GlTraceOpcode::EnableVertexAttribArray:
+        OpenGl::EnableVertexAttribArrayNE(args.Read<size_t>());
+        break;
+    case GlTraceOpcode::VertexAttribPointer:
+    {
+        const auto index = args.Read<size_t>();
+        const auto size = args.Read<size_t>();
+        const auto type = args.Read<GlVertexAttribComponentType>();
+        const bool normalized = args.Read<bool>();
+        const auto stride = args.Read<size_t>();
+        OpenGl::VertexAttribPointerNE(index, size, type, normalized, stride, ReadPointer(args));
+        break;
+    }
+    case GlTraceOpcode::VertexAttribIPointer:
+    {
+        const auto index = args.Read<size_t>();
+        const auto size = args.Read<size_t>();
+        const auto type = args.Read<GlVertexAttribComponentType>();
+        const auto stride = args.Read<size_t>();
+        OpenGl::VertexAttribIPointerNE(index, size, type, stride, ReadPointer(args));
+        break;
+    }
+    case GlTraceOpcode::VertexAttribDivisor:
+    {
+        const auto index = args.Read<size_t>();
+        OpenGl::VertexAttribDivisorNE(index, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::VertexArrayElementBuffer:
+    {
+        const auto array = read_vertex_array();
+        OpenGl::VertexArrayElementBufferNE(array, read_buffer());
+        break;
+    }
+    case GlTraceOpcode::VertexArrayVertexBuffer:
+    {
+        const auto array = read_vertex_array();
+        const auto binding_index = args.Read<size_t>();
+        const auto buffer = read_buffer();
+        const auto offset = args.Read<size_t>();
+        OpenGl::VertexArrayVertexBufferNE(array, binding_index, buffer, offset, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::VertexArrayAttribFormat:
+    {
+        const auto array = read_vertex_array();
+        const auto attribute_index = args.Read<size_t>();
+        const auto size = args.Read<size_t>();
+        const auto type = args.Read<GlVertexAttribComponentType>();
+        const bool normalized = args.Read<bool>();
+        const auto relative_offset = args.Read<size_t>();
+        OpenGl::VertexArrayAttribFormatNE(array, attribute_index, size, type, normalized, relative_offset);
+        break;
+    }
+    case GlTraceOpcode::VertexArrayAttribIFormat:
+    {
+        const auto array = read_vertex_array();
+        const auto attribute_index = args.Read<size_t>();
+        const auto size = args.Read<size_t>();
+        const auto type = args.Read<GlVertexAttribComponentType>();
+        OpenGl::VertexArrayAttribIFormatNE(array, attribute_index, size, type, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::VertexArrayAttribBinding:
+    {
+        const auto array = read_vertex_array();
+        const auto attribute_index = args.Read<size_t>();
+        OpenGl::VertexArrayAttribBindingNE(array, attribute_index, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::VertexArrayBindingDivisor:
+    {
+        const auto array = read_vertex_array();
+        const auto binding_index = args.Read<size_t>();
+        OpenGl::VertexArrayBindingDivisorNE(array, binding_index, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::EnableVertexArrayAttrib:
+    {
+        const auto array = read_vertex_array();
+        OpenGl::EnableVertexArrayAttribNE(array, args.Read<size_t>());
+        break;
+    }
+
+    // Textures
+    case GlTraceOpcode::ActiveTexture:
+        OpenGl::ActiveTextureNE(args.Read<uint32_t>());
+        break;
+    case GlTraceOpcode::BindTexture:
+    {
+        const auto target = args.Read<GlTargetTextureType>();
+        OpenGl::BindTextureNE(target, read_texture());
+        break;
+    }
+    case GlTraceOpcode::TexParameter:
+    {
+        const auto target = args.Read<GlTargetTextureType>();
+        const auto parameter = args.Read<GLenum>();
+        glTexParameteri(ToGlValue(target), parameter, args.Read<GLint>());
+        break;
+    }
+    case GlTraceOpcode::TextureParameter:
+    {
+        const auto texture = read_texture();
+        const auto parameter = args.Read<GLenum>();
+        glTextureParameteri(texture.GetValue(), parameter, args.Read<GLint>());
+        break;
+    }
+    case GlTraceOpcode::TexImage2d:
+    {
+        const auto target = args.Read<GlTargetTextureType>();
+        const auto level_of_detail = args.Read<size_t>();
+        const auto internal_format = args.Read<GLint>();
+        const auto width = args.Read<size_t>();
+        const auto height = args.Read<size_t>();
+        const auto data_format = args.Read<GLint>();
+        const auto pixel_data_type = args.Read<GLenum>();
+        OpenGl::TexImage2dNE(
+            target,
+            level_of_detail,
+            internal_format,
+            width,
+            height,
+            data_format,
+            pixel_data_type,
+            nullptr);
+        break;
+    }
+    case GlTraceOpcode::TexSubImage2d:
+    {
+        const auto target = args.Read<GlTargetTextureType>();
+        const auto level_of_detail = args.Read<size_t>();
+        const auto offset = read_vec2();
+        const auto size = read_vec2();
+        const auto layout = args.Read<GlPixelBufferLayout>();
+        const auto type = args.Read<GlPixelBufferChannelType>();
+        OpenGl::TexSubImage2dNE(target, level_of_detail, offset, size, layout, type, data);
+        break;
+    }
+    case GlTraceOpcode::TextureStorage2d:
+    {
+        const auto texture = read_texture();
+        const auto levels = args.Read<size_t>();
+        const auto format = args.Read<GlTextureInternalFormat>();
+        OpenGl::TextureStorage2dNE(texture, levels, format, read_vec2());
+        break;
+    }
+    case GlTraceOpcode::TextureSubImage2d:
+    {
+        const auto texture = read_texture();
+        const auto level_of_detail = args.Read<size_t>();
+        const auto offset = read_vec2();
+        const auto size = read_vec2();
+        const auto layout = args.Read<GlPixelBufferLayout>();
+        const auto type = args.Read<GlPixelBufferChannelType>();
+        OpenGl::TextureSubImage2dNE(texture, level_of_detail, offset, size, layout, type, data);
+        break;
+    }
+    case GlTraceOpcode::GenerateMipmap:
+        OpenGl::GenerateMipmapNE(args.Read<GLenum>());
+        break;
+
+    // Framebuffers and renderbuffers
+    case GlTraceOpcode::BindFramebuffer:
+    {
+        const auto target = args.Read<GlFramebufferBindTarget>();
+        OpenGl::BindFramebufferNE(target, GlFramebufferId{MapName(Kind::Framebuffer, args.Read<GLuint>())});
+        break;
+    }
+    case GlTraceOpcode::FramebufferTexture2d:
+    {
+        const auto target = args.Read<GlFramebufferBindTarget>();
+        const auto attachment = args.Read<GlFramebufferAttachment>();
+        const auto textarget = args.Read<GlTargetTextureType>();
+        const auto texture = read_texture();
+        OpenGl::FramebufferTexture2DNE(target, attachment, textarget, texture, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::FramebufferRenderbuffer:
+    {
+        const auto target = args.Read<GlFramebufferBindTarget>();
+        const auto attachment = args.Read<GlFramebufferAttachment>();
+        const GlRenderbufferId renderbuffer{MapName(Kind::Renderbuffer, args.Read<GLuint>())};
+        OpenGl::FramebufferRenderbufferNE(target, attachment, renderbuffer);
+        break;
+    }
+    case GlTraceOpcode::BindRenderbuffer:
+        OpenGl::BindRenderbufferNE(GlRenderbufferId{MapName(Kind::Renderbuffer, args.Read<GLuint>())});
+        break;
+    case GlTraceOpcode::RenderbufferStorage:
+    {
+        const auto format = args.Read<GlTextureInternalFormat>();
+        OpenGl::RenderbufferStorageNE(format, read_vec2());
+        break;
+    }
+
+    // Shaders and programs
+    case GlTraceOpcode::CreateShader:
+    {
+        const auto type = args.Read<GlShaderType>();
+        AddName(Kind::Shader, args.Read<GLuint>(), OpenGl::CreateShaderNE(type).GetValue());
+        break;
+    }
+    case GlTraceOpcode::ShaderSource:
+    {
+        const auto shader = read_shader();
+        const std::string_view source{reinterpret_cast<const char*>(data.data()), data.size()};  // NOLINT
+        OpenGl::ShaderSourceNE(shader, std::span{&source, 1});
+        break;
+    }
+    case GlTraceOpcode::CompileShader:
+        OpenGl::CompileShaderNE(read_shader());
+        break;
+    case GlTraceOpcode::CreateProgram:
+        AddName(Kind::Program, args.Read<GLuint>(), OpenGl::CreateProgramNE().GetValue());
+        break;
+    case GlTraceOpcode::AttachShader:
+    {
+        const auto program = read_program();
+        OpenGl::AttachShaderNE(program, read_shader());
+        break;
+    }
+    case GlTraceOpcode::LinkProgram:
+        OpenGl::LinkProgramNE(read_program());
+        break;
+    case GlTraceOpcode::SetProgramSeparable:
+    {
+        const auto program = read_program();
+        OpenGl::SetProgramSeparableNE(program, args.Read<bool>());
+        break;
+    }
+    case GlTraceOpcode::UseProgram:
+        OpenGl::UseProgramNE(read_program());
+        break;
+    case GlTraceOpcode::UniformBlockBinding:
+    {
+        const auto program = read_program();
+        const auto block_index = args.Read<uint32_t>();
+        OpenGl::UniformBlockBindingNE(program, block_index, args.Read<uint32_t>());
+        break;
+    }
+    case GlTraceOpcode::BindProgramPipeline:
+        OpenGl::BindProgramPipelineNE(read_pipeline());
+        break;
+    case GlTraceOpcode::UseProgramStage:
+    {
+        const auto pipeline = read_pipeline();
+        const auto stage = args.Read<GlShaderType>();
+        OpenGl::UseProgramStageNE(pipeline, stage, read_program());
+        break;
+    }
+    case GlTraceOpcode::ActiveShaderProgram:
+    {
+        const auto pipeline = read_pipeline();
+        OpenGl::ActiveShaderProgramNE(pipeline, read_program());
+        break;
+    }
+
+    // Uniforms
+    case GlTraceOpcode::SetUniformInt:
+        ReplayUniform<int32_t>(args, data);
+        break;
+    case GlTraceOpcode::SetUniformUInt:
+        ReplayUniform<uint32_t>(args, data);
+        break;
+    case GlTraceOpcode::SetUniformFloat:
+        ReplayUniform<float>(args, data);
+        break;
+    case GlTraceOpcode::SetUniformVec2f:
+        ReplayUniform<Vec2f>(args, data);
+        break;
+    case GlTraceOpcode::SetUniformVec3f:
+        ReplayUniform<Vec3f>(args, data);
+        break;
+    case GlTraceOpcode::SetUniformVec4f:
+        ReplayUniform<Vec4f>(args, data);
+        break;
+    case GlTraceOpcode::SetUniformMat3f:
+        ReplayUniform<Mat3f>(args, data);
+        break;
+    case GlTraceOpcode::SetUniformMat4f:
+        ReplayUniform<Mat4f>(args, data);
+        break;
+
+    // Fixed function state
+    case GlTraceOpcode::SetClearColor:
+    {
+        const auto r = args.Read<GLfloat>();
+        const auto g = args.Read<GLfloat>();
+        const auto b = args.Read<GLfloat>();
+        OpenGl::SetClearColorNE(r, g, b, args.Read<GLfloat>());
+        break;
+    }
+    case GlTraceOpcode::Clear:
+        OpenGl::ClearNE(args.Read<GLbitfield>());
+        break;
+    case GlTraceOpcode::SetViewport:
+    {
+        const auto x = args.Read<GLint>();
+        const auto y = args.Read<GLint>();
+        const auto width = args.Read<GLsizei>();
+        const auto height = args.Read<GLsizei>();
+        Viewport viewport;
+        viewport.position = edt::Vec2<GLint>{x, y}.Cast<uint32_t>();
+        viewport.size = edt::Vec2<GLsizei>{width, height}.Cast<uint32_t>();
+        OpenGl::SetViewportNE(viewport);
+        break;
+    }
+    case GlTraceOpcode::SetDepthTestEnabled:
+        OpenGl::SetDepthTestEnabledNE(args.Read<bool>());
+        break;
+    case GlTraceOpcode::SetBlendingEnabled:
+        OpenGl::SetBlendingEnabledNE(args.Read<bool>());
+        break;
+    case GlTraceOpcode::SetBlendFunction:
+    {
+        const auto source_factor = args.Read<GLenum>();
+        OpenGl::SetBlendFunctionNE(source_factor, args.Read<GLenum>());
+        break;
+    }
+    case GlTraceOpcode::EnableFaceCulling:
+        OpenGl::EnableFaceCullingNE(args.Read<bool>());
+        break;
+    case GlTraceOpcode::CullFace:
+        OpenGl::CullFaceNE(args.Read<GlCullFaceMode>());
+        break;
+    case GlTraceOpcode::PolygonMode:
+        OpenGl::PolygonModeNE(args.Read<GlPolygonMode>());
+        break;
+    case GlTraceOpcode::PointSize:
+        OpenGl::PointSizeNE(args.Read<float>());
+        break;
+    case GlTraceOpcode::LineWidth:
+        OpenGl::LineWidthNE(args.Read<float>());
+        break;
+    case GlTraceOpcode::InsertMemoryBarrier:
+        OpenGl::InsertMemoryBarrierNE(args.Read<GLbitfield>());
+        break;
+
+    // Draw
+    case GlTraceOpcode::DrawElements:
+    {
+        const auto mode = args.Read<GlPrimitiveType>();
+        const auto num = args.Read<size_t>();
+        const auto indices_type = args.Read<GlIndexBufferElementType>();
+        OpenGl::DrawElementsNE(mode, num, indices_type, ReadPointer(args));
+        break;
+    }
+    case GlTraceOpcode::DrawElementsInstanced:
+    {
+        const auto mode = args.Read<GlPrimitiveType>();
+        const auto num = args.Read<size_t>();
+        const auto indices_type = args.Read<GlIndexBufferElementType>();
+        const void* indices = ReadPointer(args);
+        OpenGl::DrawElementsInstancedNE(mode, num, indices_type, indices, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::DrawArrays:
+    {
+        const auto mode = args.Read<GlPrimitiveType>();
+        const auto first_index = args.Read<size_t>();
+        OpenGl::DrawArraysNE(mode, first_index, args.Read<size_t>());
+        break;
+    }
+    case GlTraceOpcode::DrawArraysInstanced:
+    {
+        const auto mode = args.Read<GlPrimitiveType>();
+        const auto first_index = args.Read<size_t>();
+        const auto indices_count = args.Read<size_t>();
+        OpenGl::DrawArraysInstancedNE(mode, first_index, indices_count, args.Read<size_t>());
+        break;
+    }
+
+    default:
+        ErrorHandling::ThrowWithMessage("Unknown GL trace opcode {}", static_cast<uint32_t>(call.opcode));
+    }
+}
+
+}  // namespace klgl
@@ -0,0 +1,182 @@
+#include "klgl/opengl/deletion_queue.hpp"
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "klgl/opengl/fence.hpp"
+#include "klgl/opengl/gl_api.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+struct DeletionBatch
+{
+    [[nodiscard]] size_t GetSize() const noexcept
+    {
+        return buffers.size() + vertex_arrays.size() + textures.size() + shaders.size() + programs.size() +
+               pipelines.size();
+    }
+
+    void Delete() noexcept
+    {
+        if (!buffers.empty()) OpenGl::DeleteBuffersNE(buffers);
+        if (!vertex_arrays.empty()) OpenGl::DeleteVertexArraysNE(vertex_arrays);
+        if (!textures.empty()) OpenGl::DeleteTexturesNE(textures);
+
+        // No batch version of glDelete* for these
+        for (const GlShaderId shader : shaders) OpenGl::DeleteShaderNE(shader);
+        for (const GlProgramId program : programs) OpenGl::DeleteProgramNE(program);
+        for (const GlProgramPipelineId pipeline : pipelines) OpenGl::DeleteProgramPipelineNE(pipeline);
+
+        buffers.clear();
+        vertex_arrays.clear();
+        textures.clear();
+        shaders.clear();
+        programs.clear();
+        pipelines.clear();
+    }
+
+    std::vector<GlBufferId> buffers;
+    std::vector<GlVertexArrayId> vertex_arrays;
+    std::vector<GlTextureId> textures;
+    std::vector<GlShaderId> shaders;
+    std::vector<GlProgramId> programs;
+    std::vector<GlProgramPipelineId> pipelines;
+
+    // Signaled when commands of the frame that released the objects are complete
+    GlFence fence;
+};
+
+struct DeletionQueueState
+{
+    std::mutex mutex;
+    GlDeletionMode mode = GlDeletionMode::Immediate;
+
+    // Objects released during the current frame
+    DeletionBatch pending;
+
+    // Fence mode: batches of previous frames, oldest first
+    std::deque<DeletionBatch> sealed;
+};
+
+DeletionQueueState& GetState()
+{
+    static DeletionQueueState state;
+    return state;
+}
+
+template <typename Id>
+bool EnqueueImpl(std::vector<Id> DeletionBatch::*objects, Id id)
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+    if (state.mode == GlDeletionMode::Immediate) return false;
+
+    (state.pending.*objects).push_back(id);
+    return true;
+}
+
+void FlushImpl(DeletionQueueState& state)
+{
+    for (DeletionBatch& batch : state.sealed) batch.Delete();
+    state.sealed.clear();
+    state.pending.Delete();
+}
+}  // namespace
+
+void GlDeletionQueue::SetMode(GlDeletionMode mode)
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+    if (mode == GlDeletionMode::Immediate) FlushImpl(state);
+    state.mode = mode;
+}
+
+GlDeletionMode GlDeletionQueue::GetMode()
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+    return state.mode;
+}
+
+bool GlDeletionQueue::Enqueue(GlBufferId buffer)
+{
+    return EnqueueImpl(&DeletionBatch::buffers, buffer);
+}
+
+bool GlDeletionQueue::Enqueue(GlVertexArrayId array)
+{
+    return EnqueueImpl(&DeletionBatch::vertex_arrays, array);
+}
+
+bool GlDeletionQueue::Enqueue(GlTextureId texture)
+{
+    return EnqueueImpl(&DeletionBatch::textures, texture);
+}
+
+bool GlDeletionQueue::Enqueue(GlShaderId shader)
+{
+    return EnqueueImpl(&DeletionBatch::shaders, shader);
+}
+
+bool GlDeletionQueue::Enqueue(GlProgramId program)
+{
+    return EnqueueImpl(&DeletionBatch::programs, program);
+}
+
+bool GlDeletionQueue::Enqueue(GlProgramPipelineId pipeline)
+{
+    return EnqueueImpl(&DeletionBatch::pipelines, pipeline);
+}
+
+void GlDeletionQueue::OnFrameEnd()
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+
+    switch (state.mode)
+    {
+    case GlDeletionMode::Immediate:
+        break;
+    case GlDeletionMode::FrameEnd:
+        state.pending.Delete();
+        break;
+    case GlDeletionMode::Fence:
+        if (state.pending.GetSize() != 0)
+        {
+            state.pending.fence = GlFence::Insert();
+            state.sealed.push_back(std::move(state.pending));
+            state.pending = {};
+        }
+
+        // Fences complete in order, so the first one that is not signaled stops the loop
+        while (!state.sealed.empty() && state.sealed.front().fence.IsSignaled())
+        {
+            state.sealed.front().Delete();
+            state.sealed.pop_front();
+        }
+        break;
+    }
+}
+
+void GlDeletionQueue::Flush()
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+    FlushImpl(state);
+}
+
+size_t GlDeletionQueue::GetPendingCount()
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+
+    size_t count = state.pending.GetSize();
+    for (const DeletionBatch& batch : state.sealed) count += batch.GetSize();
+    return count;
+}
+
+}  // namespace klgl
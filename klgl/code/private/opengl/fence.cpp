@@ -0,0 +1,101 @@
+#include "klgl/opengl/fence.hpp"
+
+#include <utility>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/gl_api.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+// The wait is repeated until the fence is signaled. The timeout only limits the duration of one blocking call
+constexpr uint64_t kFenceWaitTimeoutNs = 1'000'000'000;
+}  // namespace
+
+GlFence GlFence::Insert()
+{
+    GlFence fence;
+    fence.sync_ = OpenGl::FenceSync();
+    return fence;
+}
+
+bool GlFence::IsSignaled()
+{
+    if (!sync_) return true;
+
+    const GLenum result = OpenGl::ClientWaitSyncNE(sync_, TakeWaitFlags(), 0);
+    ErrorHandling::Ensure(result != GL_WAIT_FAILED, "Failed to query the fence");
+    if (result == GL_TIMEOUT_EXPIRED) return false;
+
+    Reset();
+    return true;
+}
+
+void GlFence::Wait()
+{
+    if (!sync_) return;
+
+    GLenum result = GL_TIMEOUT_EXPIRED;
+    while (result == GL_TIMEOUT_EXPIRED)
+    {
+        result = OpenGl::ClientWaitSyncNE(sync_, TakeWaitFlags(), kFenceWaitTimeoutNs);
+    }
+
+    Reset();
+    ErrorHandling::Ensure(result != GL_WAIT_FAILED, "Failed to wait for the fence");
+}
+
+void GlFence::Reset() noexcept
+{
+    if (sync_)
+    {
+        OpenGl::DeleteSyncNE(std::exchange(sync_, nullptr));
+    }
+
+    flushed_ = false;
+}
+
+void GlFence::MoveFrom(GlFence& other) noexcept
+{
+    Reset();
+    sync_ = std::exchange(other.sync_, nullptr);
+    flushed_ = std::exchange(other.flushed_, false);
+}
+
+GLbitfield GlFence::TakeWaitFlags() noexcept
+{
+    return std::exchange(flushed_, true) ? GLbitfield{0} : GLbitfield{GL_SYNC_FLUSH_COMMANDS_BIT};
+}
+
+GlFenceRing::GlFenceRing(size_t frames_in_flight)
+{
+    ErrorHandling::Ensure(frames_in_flight != 0, "Fence ring needs at least one slot");
+    fences_.resize(frames_in_flight);
+}
+
+void GlFenceRing::Resize(size_t frames_in_flight)
+{
+    ErrorHandling::Ensure(frames_in_flight != 0, "Fence ring needs at least one slot");
+    WaitAll();
+    fences_.resize(frames_in_flight);
+    current_ = 0;
+}
+
+void GlFenceRing::NextFrame()
+{
+    fences_[current_] = GlFence::Insert();
+    current_ = (current_ + 1) % fences_.size();
+    fences_[current_].Wait();
+}
+
+void GlFenceRing::WaitAll()
+{
+    for (GlFence& fence : fences_)
+    {
+        fence.Wait();
+    }
+}
+
+}  // namespace klgl
@@ -7,4 +7,96 @@
 #include "klgl/opengl/detail/gl_api_impl.hpp"
 // clang-format on
 
+#else
+#include "klgl/opengl/gl_api.hpp"
+#endif
+
+#include "fmt/format.h"
+#include "fmt/ranges.h"  // IWYU pragma: keep
+#include "klgl/opengl/debug/gl_debug_messenger.hpp"
+#include "klgl/opengl/open_gl_error.hpp"
+#include "magic_enum/magic_enum.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+bool direct_state_access_allowed = true;
+}  // namespace
+
+bool OpenGl::HasDirectStateAccess() noexcept
+{
+    if (!direct_state_access_allowed) return false;
+
+#ifdef GL_ARB_direct_state_access
+    if (GLAD_GL_ARB_direct_state_access) return true;
 #endif
+
+    return GLAD_GL_VERSION_4_5;
+}
+
+void OpenGl::SetDirectStateAccessAllowed(bool allowed) noexcept
+{
+    direct_state_access_allowed = allowed;
+}
+
+GlErrorCheckMode OpenGl::SetErrorCheckMode(GlErrorCheckMode mode)
+{
+    if (mode == GlErrorCheckMode::DebugCallback)
+    {
+        if (!GlDebugMessenger::IsStarted() && !GlDebugMessenger::Start())
+        {
+            mode = GlErrorCheckMode::PerFrame;
+        }
+    }
+    else
+    {
+        GlDebugMessenger::Stop();
+    }
+
+    error_check_mode_.store(mode, std::memory_order_relaxed);
+    return mode;
+}
+
+void OpenGl::CheckFrameErrors()
+{
+    // Off mode does not poll at all. The state cache trusts the caller there: after failed calls it may skip calls
+    // that are needed, until InvalidateStateCache
+    const GlErrorCheckMode mode = GetErrorCheckMode();
+    if (mode == GlErrorCheckMode::Off) return;
+
+    // In PerCall mode errors of unchecked calls are drained too, so they are not reported by the next checked call.
+    // Each error flag is reported once, so the loop ends even if the driver keeps several of them
+    std::vector<GlError> errors;
+    for (GlError error = GetError(); error != GlError::NoError; error = GetError())
+    {
+        errors.push_back(error);
+        if (errors.size() == magic_enum::enum_count<GlError>()) break;
+    }
+
+    std::optional<std::string> debug_message;
+    if (mode == GlErrorCheckMode::DebugCallback)
+    {
+        debug_message = GlDebugMessenger::TakeNewError();
+    }
+
+    [[likely]] if (errors.empty() && !debug_message.has_value())
+    {
+        return;
+    }
+
+    // The cache assumed that failed calls changed the state
+    InvalidateStateCache();
+    if (mode != GlErrorCheckMode::PerFrame && mode != GlErrorCheckMode::DebugCallback) return;
+
+    std::string message = fmt::format("OpenGL errors during the frame: {}", errors);
+    if (debug_message.has_value())
+    {
+        fmt::format_to(std::back_inserter(message), ". Last debug message: {}", *debug_message);
+    }
+
+    throw OpenGlError(errors.empty() ? GlError::Unknown : errors.front(), std::move(message));
+}
+
+}  // namespace klgl
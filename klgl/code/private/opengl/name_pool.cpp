@@ -0,0 +1,114 @@
+#include "klgl/opengl/name_pool.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/gl_api.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+struct NamePoolState
+{
+    std::mutex mutex;
+    size_t batch_size = GlNamePool::kDefaultBatchSize;
+    std::vector<GlBufferId> gen_buffers;
+    std::vector<GlVertexArrayId> gen_vertex_arrays;
+    std::vector<GlTextureId> gen_textures;
+    std::vector<GlBufferId> created_buffers;
+    std::vector<GlVertexArrayId> created_vertex_arrays;
+};
+
+NamePoolState& GetState()
+{
+    static NamePoolState state;
+    return state;
+}
+
+template <typename Id, auto refill>
+Id TakeName(std::vector<Id> NamePoolState::*names_member)
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+
+    auto& names = state.*names_member;
+    if (names.empty())
+    {
+        // Refill throws before the pool is touched, so it never keeps names that were not generated
+        std::vector<Id> fresh(state.batch_size);
+        refill(std::span{fresh});
+
+        // Given out in the order they were generated
+        names.assign(fresh.rbegin(), fresh.rend());
+    }
+
+    const Id name = names.back();
+    names.pop_back();
+    return name;
+}
+}  // namespace
+
+GlBufferId GlNamePool::GenBuffer()
+{
+    return TakeName<GlBufferId, &OpenGl::GenBuffers>(&NamePoolState::gen_buffers);
+}
+
+GlVertexArrayId GlNamePool::GenVertexArray()
+{
+    return TakeName<GlVertexArrayId, &OpenGl::GenVertexArrays>(&NamePoolState::gen_vertex_arrays);
+}
+
+GlTextureId GlNamePool::GenTexture()
+{
+    return TakeName<GlTextureId, &OpenGl::GenTextures>(&NamePoolState::gen_textures);
+}
+
+GlBufferId GlNamePool::CreateBuffer()
+{
+    return TakeName<GlBufferId, &OpenGl::CreateBuffers>(&NamePoolState::created_buffers);
+}
+
+GlVertexArrayId GlNamePool::CreateVertexArray()
+{
+    return TakeName<GlVertexArrayId, &OpenGl::CreateVertexArrays>(&NamePoolState::created_vertex_arrays);
+}
+
+void GlNamePool::SetBatchSize(size_t batch_size)
+{
+    ErrorHandling::Ensure(batch_size != 0, "Name pool batch size must be positive");
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+    state.batch_size = batch_size;
+}
+
+size_t GlNamePool::GetBatchSize()
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+    return state.batch_size;
+}
+
+void GlNamePool::Clear()
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+
+    if (!state.gen_buffers.empty()) OpenGl::DeleteBuffersNE(state.gen_buffers);
+    if (!state.created_buffers.empty()) OpenGl::DeleteBuffersNE(state.created_buffers);
+    if (!state.gen_vertex_arrays.empty()) OpenGl::DeleteVertexArraysNE(state.gen_vertex_arrays);
+    if (!state.created_vertex_arrays.empty()) OpenGl::DeleteVertexArraysNE(state.created_vertex_arrays);
+    if (!state.gen_textures.empty()) OpenGl::DeleteTexturesNE(state.gen_textures);
+
+    state.gen_buffers.clear();
+    state.created_buffers.clear();
+    state.gen_vertex_arrays.clear();
+    state.created_vertex_arrays.clear();
+    state.gen_textures.clear();
+}
+
+}  // namespace klgl
@@ -0,0 +1,241 @@
+#include "opengl/null_gl/glsl_declarations.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+
+namespace klgl::null_gl
+{
+
+namespace
+{
+constexpr auto kGlslTypes = std::to_array<GlslType>({
+    {"float", GL_FLOAT, GlslBaseType::Float, 1, false},
+    {"vec2", GL_FLOAT_VEC2, GlslBaseType::Float, 2, false},
+    {"vec3", GL_FLOAT_VEC3, GlslBaseType::Float, 3, false},
+    {"vec4", GL_FLOAT_VEC4, GlslBaseType::Float, 4, false},
+    {"double", GL_DOUBLE, GlslBaseType::Double, 1, false},
+    {"dvec2", GL_DOUBLE_VEC2, GlslBaseType::Double, 2, false},
+    {"dvec3", GL_DOUBLE_VEC3, GlslBaseType::Double, 3, false},
+    {"dvec4", GL_DOUBLE_VEC4, GlslBaseType::Double, 4, false},
+    {"int", GL_INT, GlslBaseType::Int, 1, false},
+    {"ivec2", GL_INT_VEC2, GlslBaseType::Int, 2, false},
+    {"ivec3", GL_INT_VEC3, GlslBaseType::Int, 3, false},
+    {"ivec4", GL_INT_VEC4, GlslBaseType::Int, 4, false},
+    {"uint", GL_UNSIGNED_INT, GlslBaseType::UnsignedInt, 1, false},
+    {"uvec2", GL_UNSIGNED_INT_VEC2, GlslBaseType::UnsignedInt, 2, false},
+    {"uvec3", GL_UNSIGNED_INT_VEC3, GlslBaseType::UnsignedInt, 3, false},
+    {"uvec4", GL_UNSIGNED_INT_VEC4, GlslBaseType::UnsignedInt, 4, false},
+    {"bool", GL_BOOL, GlslBaseType::Bool, 1, false},
+    {"bvec2", GL_BOOL_VEC2, GlslBaseType::Bool, 2, false},
+    {"bvec3", GL_BOOL_VEC3, GlslBaseType::Bool, 3, false},
+    {"bvec4", GL_BOOL_VEC4, GlslBaseType::Bool, 4, false},
+    {"mat2", GL_FLOAT_MAT2, GlslBaseType::Float, 4, true},
+    {"mat3", GL_FLOAT_MAT3, GlslBaseType::Float, 9, true},
+    {"mat4", GL_FLOAT_MAT4, GlslBaseType::Float, 16, true},
+    {"mat2x3", GL_FLOAT_MAT2x3, GlslBaseType::Float, 6, true},
+    {"mat2x4", GL_FLOAT_MAT2x4, GlslBaseType::Float, 8, true},
+    {"mat3x2", GL_FLOAT_MAT3x2, GlslBaseType::Float, 6, true},
+    {"mat3x4", GL_FLOAT_MAT3x4, GlslBaseType::Float, 12, true},
+    {"mat4x2", GL_FLOAT_MAT4x2, GlslBaseType::Float, 8, true},
+    {"mat4x3", GL_FLOAT_MAT4x3, GlslBaseType::Float, 12, true},
+    {"sampler1D", GL_SAMPLER_1D, GlslBaseType::Sampler, 1, false},
+    {"sampler2D", GL_SAMPLER_2D, GlslBaseType::Sampler, 1, false},
+    {"sampler3D", GL_SAMPLER_3D, GlslBaseType::Sampler, 1, false},
+    {"samplerCube", GL_SAMPLER_CUBE, GlslBaseType::Sampler, 1, false},
+    {"sampler2DShadow", GL_SAMPLER_2D_SHADOW, GlslBaseType::Sampler, 1, false},
+    {"sampler2DArray", GL_SAMPLER_2D_ARRAY, GlslBaseType::Sampler, 1, false},
+    {"sampler2DRect", GL_SAMPLER_2D_RECT, GlslBaseType::Sampler, 1, false},
+    {"samplerBuffer", GL_SAMPLER_BUFFER, GlslBaseType::Sampler, 1, false},
+    {"isampler2D", GL_INT_SAMPLER_2D, GlslBaseType::Sampler, 1, false},
+    {"usampler2D", GL_UNSIGNED_INT_SAMPLER_2D, GlslBaseType::Sampler, 1, false},
+    {"image2D", GL_IMAGE_2D, GlslBaseType::Sampler, 1, false},
+    {"iimage2D", GL_INT_IMAGE_2D, GlslBaseType::Sampler, 1, false},
+    {"uimage2D", GL_UNSIGNED_INT_IMAGE_2D, GlslBaseType::Sampler, 1, false},
+});
+
+bool IsIdentifierChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Removes comments and preprocessor directives. Line continuations are not supported
+std::string StripSource(std::string_view source)
+{
+    std::string result;
+    result.reserve(source.size());
+
+    bool line_start = true;
+    size_t i = 0;
+    while (i < source.size())
+    {
+        const char c = source[i];
+        if (source.substr(i).starts_with("//") || (line_start && c == '#'))
+        {
+            i = std::min(source.find('\n', i), source.size());
+            continue;
+        }
+
+        if (source.substr(i).starts_with("/*"))
+        {
+            const size_t end = source.find("*/", i + 2);
+            i = end == std::string_view::npos ? source.size() : end + 2;
+            result.push_back(' ');
+            continue;
+        }
+
+        if (c == '\n') line_start = true;
+        else if (!std::isspace(static_cast<unsigned char>(c))) line_start = false;
+
+        result.push_back(c);
+        ++i;
+    }
+
+    return result;
+}
+
+std::vector<std::string_view> Tokenize(std::string_view statement)
+{
+    std::vector<std::string_view> tokens;
+    size_t i = 0;
+    while (i < statement.size())
+    {
+        if (std::isspace(static_cast<unsigned char>(statement[i])))
+        {
+            ++i;
+            continue;
+        }
+
+        size_t length = 1;
+        if (IsIdentifierChar(statement[i]))
+        {
+            while (i + length < statement.size() && IsIdentifierChar(statement[i + length])) ++length;
+        }
+
+        tokens.push_back(statement.substr(i, length));
+        i += length;
+    }
+
+    return tokens;
+}
+
+std::optional<int32_t> ParseInt(std::string_view token)
+{
+    int32_t value = 0;
+    auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (ec != std::errc{} || ptr != token.data() + token.size()) return std::nullopt;
+    return value;
+}
+
+bool IsIgnoredQualifier(std::string_view token)
+{
+    constexpr std::array<std::string_view, 9> kQualifiers{
+        "lowp",
+        "mediump",
+        "highp",
+        "flat",
+        "smooth",
+        "noperspective",
+        "invariant",
+        "centroid",
+        "readonly",
+    };
+
+    return std::ranges::find(kQualifiers, token) != kQualifiers.end();
+}
+
+void ParseStatement(std::string_view statement, bool vertex_shader, GlslDeclarations& result)
+{
+    const std::vector<std::string_view> tokens = Tokenize(statement);
+    size_t i = 0;
+
+    std::optional<int32_t> location;
+    if (i < tokens.size() && tokens[i] == "layout")
+    {
+        ++i;
+        for (; i < tokens.size() && tokens[i] != ")"; ++i)
+        {
+            if (tokens[i] == "location" && i + 2 < tokens.size() && tokens[i + 1] == "=")
+            {
+                location = ParseInt(tokens[i + 2]);
+            }
+        }
+        ++i;
+    }
+
+    while (i < tokens.size() && IsIgnoredQualifier(tokens[i])) ++i;
+    if (i >= tokens.size()) return;
+
+    std::vector<GlslDeclaration>* declarations = nullptr;
+    if (tokens[i] == "uniform") declarations = &result.uniforms;
+    else if (tokens[i] == "in" && vertex_shader) declarations = &result.inputs;
+    else return;
+    ++i;
+
+    while (i < tokens.size() && IsIgnoredQualifier(tokens[i])) ++i;
+    if (i >= tokens.size()) return;
+
+    const GlslType* type = FindGlslType(tokens[i]);
+    if (!type) return;
+    ++i;
+
+    while (i < tokens.size())
+    {
+        GlslDeclaration& declaration = declarations->emplace_back();
+        declaration.type = type;
+        declaration.name = tokens[i];
+        declaration.location = location;
+        location.reset();
+        ++i;
+
+        if (i + 2 < tokens.size() && tokens[i] == "[" && tokens[i + 2] == "]")
+        {
+            declaration.array_size = static_cast<size_t>(std::max(ParseInt(tokens[i + 1]).value_or(1), 1));
+            i += 3;
+        }
+
+        // Skip initializer up to the next declarator
+        while (i < tokens.size() && tokens[i] != ",") ++i;
+        ++i;
+    }
+}
+}  // namespace
+
+const GlslType* FindGlslType(std::string_view name)
+{
+    auto it = std::ranges::find(kGlslTypes, name, &GlslType::name);
+    return it == kGlslTypes.end() ? nullptr : &*it;
+}
+
+GlslDeclarations ScanGlslDeclarations(std::string_view source, bool vertex_shader)
+{
+    GlslDeclarations result;
+
+    const std::string stripped = StripSource(source);
+    size_t depth = 0;
+    size_t statement_begin = 0;
+    for (size_t i = 0; i != stripped.size(); ++i)
+    {
+        const char c = stripped[i];
+        if (c == '{')
+        {
+            // Function bodies and interface blocks
+            ++depth;
+        }
+        else if (c == '}')
+        {
+            if (depth != 0 && --depth == 0) statement_begin = i + 1;
+        }
+        else if (c == ';' && depth == 0)
+        {
+            const std::string_view statement{stripped.data() + statement_begin, i - statement_begin};
+            ParseStatement(statement, vertex_shader, result);
+            statement_begin = i + 1;
+        }
+    }
+
+    return result;
+}
+
+}  // namespace klgl::null_gl
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace klgl::null_gl
+{
+
+enum class GlslBaseType : uint8_t
+{
+    Float,
+    Double,
+    Int,
+    UnsignedInt,
+    Bool,
+    Sampler,
+};
+
+struct GlslType
+{
+    std::string_view name;
+    GLenum gl_type = GL_NONE;
+    GlslBaseType base_type = GlslBaseType::Float;
+
+    // Number of scalars: 3 for vec3, 16 for mat4
+    uint8_t components = 1;
+    bool matrix = false;
+};
+
+struct GlslDeclaration
+{
+    const GlslType* type = nullptr;
+    std::string name;
+
+    // One for variables that are not arrays
+    size_t array_size = 1;
+
+    // From layout(location = N)
+    std::optional<int32_t> location;
+};
+
+struct GlslDeclarations
+{
+    std::vector<GlslDeclaration> uniforms;
+
+    // Only filled for vertex shaders
+    std::vector<GlslDeclaration> inputs;
+};
+
+[[nodiscard]] const GlslType* FindGlslType(std::string_view name);
+
+// Finds uniforms of the default block and vertex inputs declared in the global scope. This is not a GLSL parser:
+// preprocessor directives are skipped as if every conditional branch was taken, uniform blocks and variables of
+// types missing in the type table are ignored, and array sizes must be integer literals
+[[nodiscard]] GlslDeclarations ScanGlslDeclarations(std::string_view source, bool vertex_shader);
+
+}  // namespace klgl::null_gl
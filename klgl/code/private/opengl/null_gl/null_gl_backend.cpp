@@ -0,0 +1,2892 @@
+#include "klgl/opengl/null_gl_backend.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ankerl/unordered_dense.h"
+#include "fmt/format.h"
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/debug/gl_frame_stats.hpp"
+#include "klgl/opengl/debug/gl_memory_tracker.hpp"
+#include "klgl/opengl/deletion_queue.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/name_pool.hpp"
+#include "opengl/null_gl/glsl_declarations.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+
+constexpr size_t kTextureUnits = 32;
+constexpr GLuint kVertexAttributes = 16;
+constexpr GLuint kIndexedBufferBindings = 16;
+constexpr GLint kMaxTextureSize = 16384;
+constexpr GLint kUniformBufferOffsetAlignment = 256;
+constexpr GLint kStorageBufferOffsetAlignment = 16;
+constexpr size_t kMaxDebugGroupDepth = 64;
+constexpr std::string_view kExtensions[] = {"GL_KHR_debug"};
+
+struct NullBuffer
+{
+    std::vector<uint8_t> data;
+    bool immutable = false;
+    GLbitfield storage_flags = 0;
+    bool mapped = false;
+    GLbitfield map_access = 0;
+};
+
+struct NullTexture
+{
+    struct Level
+    {
+        GLsizei width = 0;
+        GLsizei height = 0;
+    };
+
+    // Assigned by the first bind or by glCreateTextures
+    GLenum target = GL_NONE;
+    GLenum internal_format = GL_NONE;
+    std::vector<Level> levels;
+    bool immutable = false;
+};
+
+struct NullVertexArray
+{
+    GLuint element_buffer = 0;
+    uint32_t enabled_attributes = 0;
+};
+
+struct NullRenderbuffer
+{
+    GLenum internal_format = GL_NONE;
+    GLsizei width = 0;
+    GLsizei height = 0;
+};
+
+struct NullFramebuffer
+{
+    ankerl::unordered_dense::map<GLenum, GLuint> attachments;
+};
+
+struct NullShader
+{
+    GLenum type = GL_NONE;
+    std::string source;
+    bool compiled = false;
+    std::string log;
+};
+
+struct NullVariable
+{
+    const null_gl::GlslType* type = nullptr;
+    std::string name;
+    GLint size = 1;
+    GLint location = -1;
+};
+
+struct NullProgram
+{
+    [[nodiscard]] const NullVariable* FindUniformAtLocation(GLint location) const
+    {
+        auto it = std::ranges::find_if(
+            uniforms,
+            [&](const NullVariable& uniform)
+            { return location >= uniform.location && location < uniform.location + uniform.size; });
+        return it == uniforms.end() ? nullptr : &*it;
+    }
+
+    std::vector<GLuint> shaders;
+    bool linked = false;
+    bool separable = false;
+    std::string log;
+    std::vector<NullVariable> uniforms;
+    std::vector<NullVariable> attributes;
+    ankerl::unordered_dense::map<GLint, std::vector<uint8_t>> uniform_values;
+};
+
+struct NullProgramPipeline
+{
+    ankerl::unordered_dense::map<GLbitfield, GLuint> stages;
+    GLuint active_program = 0;
+};
+
+template <typename T>
+struct NullObjects
+{
+    [[nodiscard]] T* Find(GLuint name)
+    {
+        auto it = objects.find(name);
+        return it == objects.end() ? nullptr : &it->second;
+    }
+
+    [[nodiscard]] bool IsNameOrZero(GLuint name) const { return name == 0 || objects.contains(name); }
+
+    GLuint Add(T object = {})
+    {
+        const GLuint name = next_name++;
+        objects.emplace(name, std::move(object));
+        return name;
+    }
+
+    ankerl::unordered_dense::map<GLuint, T> objects;
+    GLuint next_name = 1;
+};
+
+struct NullGlState
+{
+    static NullGlState& Get()
+    {
+        static NullGlState state;
+        return state;
+    }
+
+    static NullGlState& OnCall(std::string_view function)
+    {
+        auto& state = Get();
+        ++state.stats.calls;
+        ++state.calls[function];
+        state.function = function;
+        return state;
+    }
+
+    // Returns the condition. Keeps the first error until glGetError like drivers do
+    template <typename... Args>
+    bool Check(bool condition, GLenum error, fmt::format_string<Args...> format, Args&&... args)
+    {
+        if (condition) return true;
+
+        ++stats.errors;
+        if (this->error == GL_NO_ERROR) this->error = error;
+        last_error_message = fmt::format("gl{}: {}", function, fmt::format(format, std::forward<Args>(args)...));
+
+        if (debug_output && debug_callback)
+        {
+            debug_callback(
+                GL_DEBUG_SOURCE_API,
+                GL_DEBUG_TYPE_ERROR,
+                error,
+                GL_DEBUG_SEVERITY_HIGH,
+                static_cast<GLsizei>(last_error_message.size()),
+                last_error_message.c_str(),
+                debug_user_param);
+        }
+
+        return false;
+    }
+
+    bool CheckEnum(bool condition, GLenum value)
+    {
+        return Check(condition, GL_INVALID_ENUM, "invalid enum {:#x}", value);
+    }
+
+    // Element array binding is a part of the vertex array state
+    [[nodiscard]] GLuint& GetBufferBinding(GLenum target)
+    {
+        if (target == GL_ELEMENT_ARRAY_BUFFER) return GetVertexArrayState().element_buffer;
+        return buffer_bindings[target];
+    }
+
+    [[nodiscard]] NullVertexArray& GetVertexArrayState()
+    {
+        if (NullVertexArray* bound = vertex_arrays.Find(vertex_array)) return *bound;
+        return default_vertex_array;
+    }
+
+    [[nodiscard]] GLuint& GetTextureBinding(GLenum target) { return texture_units[active_texture_unit][target]; }
+
+    // Program that receives glUniform calls
+    [[nodiscard]] NullProgram* GetUniformProgram()
+    {
+        if (program != 0) return programs.Find(program);
+        if (NullProgramPipeline* bound = pipelines.Find(pipeline)) return programs.Find(bound->active_program);
+        return nullptr;
+    }
+
+    // Bound buffer which is validated for data store updates
+    NullBuffer* GetBoundBuffer(GLenum target);
+
+    NullGlSettings settings;
+    bool loaded = false;
+    std::string version_string;
+    std::string_view function;
+    NullGlStats stats;
+    ankerl::unordered_dense::map<std::string_view, size_t> calls;
+
+    GLenum error = GL_NO_ERROR;
+    std::string last_error_message;
+    GLDEBUGPROC debug_callback = nullptr;
+    const void* debug_user_param = nullptr;
+    bool debug_output = false;
+    size_t debug_group_depth = 0;
+
+    NullObjects<NullBuffer> buffers;
+    NullObjects<NullTexture> textures;
+    NullObjects<NullVertexArray> vertex_arrays;
+    NullObjects<NullRenderbuffer> renderbuffers;
+    NullObjects<NullFramebuffer> framebuffers;
+    NullObjects<NullProgramPipeline> pipelines;
+
+    // Shaders and programs share the namespace
+    NullObjects<NullShader> shaders;
+    NullObjects<NullProgram> programs;
+    GLuint next_shader_or_program = 1;
+
+    ankerl::unordered_dense::set<uintptr_t> syncs;
+    uintptr_t next_sync = 1;
+
+    ankerl::unordered_dense::map<GLenum, GLuint> buffer_bindings;
+    NullVertexArray default_vertex_array;
+    std::array<ankerl::unordered_dense::map<GLenum, GLuint>, kTextureUnits> texture_units;
+    size_t active_texture_unit = 0;
+    GLuint vertex_array = 0;
+    GLuint program = 0;
+    GLuint pipeline = 0;
+    GLuint renderbuffer = 0;
+    GLuint draw_framebuffer = 0;
+    GLuint read_framebuffer = 0;
+    std::array<GLint, 4> viewport{};
+    ankerl::unordered_dense::set<GLenum> capabilities;
+};
+
+bool IsBufferTarget(GLenum target)
+{
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:
+    case GL_ATOMIC_COUNTER_BUFFER:
+    case GL_COPY_READ_BUFFER:
+    case GL_COPY_WRITE_BUFFER:
+    case GL_DISPATCH_INDIRECT_BUFFER:
+    case GL_DRAW_INDIRECT_BUFFER:
+    case GL_ELEMENT_ARRAY_BUFFER:
+    case GL_PIXEL_PACK_BUFFER:
+    case GL_PIXEL_UNPACK_BUFFER:
+    case GL_QUERY_BUFFER:
+    case GL_SHADER_STORAGE_BUFFER:
+    case GL_TEXTURE_BUFFER:
+    case GL_TRANSFORM_FEEDBACK_BUFFER:
+    case GL_UNIFORM_BUFFER:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool IsIndexedBufferTarget(GLenum target)
+{
+    return target == GL_ATOMIC_COUNTER_BUFFER || target == GL_SHADER_STORAGE_BUFFER ||
+           target == GL_TRANSFORM_FEEDBACK_BUFFER || target == GL_UNIFORM_BUFFER;
+}
+
+bool IsTextureTarget(GLenum target)
+{
+    switch (target)
+    {
+    case GL_TEXTURE_1D:
+    case GL_TEXTURE_1D_ARRAY:
+    case GL_TEXTURE_2D:
+    case GL_TEXTURE_2D_ARRAY:
+    case GL_TEXTURE_2D_MULTISAMPLE:
+    case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+    case GL_TEXTURE_3D:
+    case GL_TEXTURE_CUBE_MAP:
+    case GL_TEXTURE_CUBE_MAP_ARRAY:
+    case GL_TEXTURE_RECTANGLE:
+    case GL_TEXTURE_BUFFER:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Maps targets accepted by glTexImage2D to the binding they edit
+GLenum GetTexImage2dBindingTarget(GLenum target)
+{
+    switch (target)
+    {
+    case GL_TEXTURE_2D:
+    case GL_TEXTURE_1D_ARRAY:
+    case GL_TEXTURE_RECTANGLE:
+        return target;
+    case GL_TEXTURE_CUBE_MAP_POSITIVE_X:
+    case GL_TEXTURE_CUBE_MAP_NEGATIVE_X:
+    case GL_TEXTURE_CUBE_MAP_POSITIVE_Y:
+    case GL_TEXTURE_CUBE_MAP_NEGATIVE_Y:
+    case GL_TEXTURE_CUBE_MAP_POSITIVE_Z:
+    case GL_TEXTURE_CUBE_MAP_NEGATIVE_Z:
+        return GL_TEXTURE_CUBE_MAP;
+    default:
+        return GL_NONE;
+    }
+}
+
+bool IsPrimitiveMode(GLenum mode)
+{
+    switch (mode)
+    {
+    case GL_POINTS:
+    case GL_LINE_STRIP:
+    case GL_LINE_LOOP:
+    case GL_LINES:
+    case GL_LINE_STRIP_ADJACENCY:
+    case GL_LINES_ADJACENCY:
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN:
+    case GL_TRIANGLES:
+    case GL_TRIANGLE_STRIP_ADJACENCY:
+    case GL_TRIANGLES_ADJACENCY:
+    case GL_PATCHES:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool IsUsage(GLenum usage)
+{
+    switch (usage)
+    {
+    case GL_STREAM_DRAW:
+    case GL_STREAM_READ:
+    case GL_STREAM_COPY:
+    case GL_STATIC_DRAW:
+    case GL_STATIC_READ:
+    case GL_STATIC_COPY:
+    case GL_DYNAMIC_DRAW:
+    case GL_DYNAMIC_READ:
+    case GL_DYNAMIC_COPY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+size_t GetIndexSize(GLenum type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_BYTE:
+        return 1;
+    case GL_UNSIGNED_SHORT:
+        return 2;
+    case GL_UNSIGNED_INT:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+// Zero for unknown combinations. Rows are assumed to be tightly packed
+size_t GetPixelSize(GLenum format, GLenum type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+        return 2;
+    case GL_UNSIGNED_INT_8_8_8_8:
+    case GL_UNSIGNED_INT_8_8_8_8_REV:
+    case GL_UNSIGNED_INT_10_10_10_2:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_24_8:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV:
+    case GL_UNSIGNED_INT_5_9_9_9_REV:
+        return 4;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+        return 8;
+    default:
+        break;
+    }
+
+    size_t component_size = 0;
+    switch (type)
+    {
+    case GL_UNSIGNED_BYTE:
+    case GL_BYTE:
+        component_size = 1;
+        break;
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+        component_size = 2;
+        break;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+        component_size = 4;
+        break;
+    default:
+        return 0;
+    }
+
+    switch (format)
+    {
+    case GL_RED:
+    case GL_RED_INTEGER:
+    case GL_DEPTH_COMPONENT:
+    case GL_STENCIL_INDEX:
+        return component_size;
+    case GL_RG:
+    case GL_RG_INTEGER:
+    case GL_DEPTH_STENCIL:
+        return component_size * 2;
+    case GL_RGB:
+    case GL_BGR:
+    case GL_RGB_INTEGER:
+        return component_size * 3;
+    case GL_RGBA:
+    case GL_BGRA:
+    case GL_RGBA_INTEGER:
+        return component_size * 4;
+    default:
+        return 0;
+    }
+}
+
+// Texel size of internal formats accepted by glClearBufferSubData
+size_t GetBufferClearFormatSize(GLenum internal_format)
+{
+    switch (internal_format)
+    {
+    case GL_R8:
+    case GL_R8I:
+    case GL_R8UI:
+        return 1;
+    case GL_R16:
+    case GL_R16F:
+    case GL_R16I:
+    case GL_R16UI:
+    case GL_RG8:
+    case GL_RG8I:
+    case GL_RG8UI:
+        return 2;
+    case GL_R32F:
+    case GL_R32I:
+    case GL_R32UI:
+    case GL_RG16:
+    case GL_RG16F:
+    case GL_RG16I:
+    case GL_RG16UI:
+    case GL_RGBA8:
+    case GL_RGBA8I:
+    case GL_RGBA8UI:
+        return 4;
+    case GL_RG32F:
+    case GL_RG32I:
+    case GL_RG32UI:
+    case GL_RGBA16:
+    case GL_RGBA16F:
+    case GL_RGBA16I:
+    case GL_RGBA16UI:
+        return 8;
+    case GL_RGB32F:
+    case GL_RGB32I:
+    case GL_RGB32UI:
+        return 12;
+    case GL_RGBA32F:
+    case GL_RGBA32I:
+    case GL_RGBA32UI:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+GLsync ToSync(uintptr_t id)
+{
+    return reinterpret_cast<GLsync>(id * 16);  // NOLINT
+}
+
+uintptr_t FromSync(GLsync sync)
+{
+    return reinterpret_cast<uintptr_t>(sync) / 16;  // NOLINT
+}
+
+bool IsRangeInside(GLintptr offset, GLsizeiptr size, size_t total)
+{
+    return offset >= 0 && size >= 0 && static_cast<size_t>(offset) + static_cast<size_t>(size) <= total;
+}
+
+NullBuffer* NullGlState::GetBoundBuffer(GLenum target)
+{
+    if (!CheckEnum(IsBufferTarget(target), target)) return nullptr;
+
+    NullBuffer* buffer = buffers.Find(GetBufferBinding(target));
+    Check(buffer != nullptr, GL_INVALID_OPERATION, "no buffer is bound to {:#x}", target);
+    return buffer;
+}
+
+void CopyToClient(void* destination, size_t size)
+{
+    if (destination) std::memset(destination, 0, size);
+}
+
+void WriteString(std::string_view string, GLsizei buffer_size, GLsizei* length, GLchar* destination)
+{
+    const size_t written = buffer_size > 0 ? std::min(string.size(), static_cast<size_t>(buffer_size) - 1) : 0;
+    if (destination && buffer_size > 0)
+    {
+        std::memcpy(destination, string.data(), written);
+        destination[written] = '\0';  // NOLINT
+    }
+
+    if (length) *length = static_cast<GLsizei>(written);
+}
+
+struct NullGl
+{
+    /******************************************** Context and state **********************************************/
+
+    static const GLubyte* APIENTRY GetString(GLenum name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        std::string_view result;
+        switch (name)
+        {
+        case GL_VENDOR:
+            result = "klgl";
+            break;
+        case GL_RENDERER:
+            result = "Null OpenGL backend";
+            break;
+        case GL_VERSION:
+            result = state.version_string;
+            break;
+        case GL_SHADING_LANGUAGE_VERSION:
+            result = "4.60";
+            break;
+        case GL_EXTENSIONS:
+            result = kExtensions[0];
+            break;
+        default:
+            state.CheckEnum(false, name);
+            return nullptr;
+        }
+
+        return reinterpret_cast<const GLubyte*>(result.data());  // NOLINT
+    }
+
+    static const GLubyte* APIENTRY GetStringi(GLenum name, GLuint index)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(name == GL_EXTENSIONS, name)) return nullptr;
+        if (!state.Check(index < std::size(kExtensions), GL_INVALID_VALUE, "extension index {} is too big", index))
+        {
+            return nullptr;
+        }
+
+        return reinterpret_cast<const GLubyte*>(kExtensions[index].data());  // NOLINT
+    }
+
+    static void APIENTRY GetIntegerv(GLenum name, GLint* data)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        auto name_value = [&](GLuint value)
+        {
+            *data = static_cast<GLint>(value);
+        };
+
+        switch (name)
+        {
+        case GL_MAJOR_VERSION:
+            *data = state.settings.major_version;
+            break;
+        case GL_MINOR_VERSION:
+            *data = state.settings.minor_version;
+            break;
+        case GL_NUM_EXTENSIONS:
+            *data = static_cast<GLint>(std::size(kExtensions));
+            break;
+        case GL_MAX_TEXTURE_SIZE:
+            *data = kMaxTextureSize;
+            break;
+        case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+            *data = static_cast<GLint>(kTextureUnits);
+            break;
+        case GL_MAX_VERTEX_ATTRIBS:
+            *data = static_cast<GLint>(kVertexAttributes);
+            break;
+        case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+        case GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS:
+            *data = static_cast<GLint>(kIndexedBufferBindings);
+            break;
+        case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+            *data = kUniformBufferOffsetAlignment;
+            break;
+        case GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT:
+            *data = kStorageBufferOffsetAlignment;
+            break;
+        case GL_VIEWPORT:
+            std::ranges::copy(state.viewport, data);
+            break;
+        case GL_ARRAY_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_ARRAY_BUFFER));
+            break;
+        case GL_ATOMIC_COUNTER_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_ATOMIC_COUNTER_BUFFER));
+            break;
+        case GL_COPY_READ_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_COPY_READ_BUFFER));
+            break;
+        case GL_COPY_WRITE_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_COPY_WRITE_BUFFER));
+            break;
+        case GL_DISPATCH_INDIRECT_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_DISPATCH_INDIRECT_BUFFER));
+            break;
+        case GL_DRAW_INDIRECT_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_DRAW_INDIRECT_BUFFER));
+            break;
+        case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_ELEMENT_ARRAY_BUFFER));
+            break;
+        case GL_PIXEL_PACK_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_PIXEL_PACK_BUFFER));
+            break;
+        case GL_PIXEL_UNPACK_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_PIXEL_UNPACK_BUFFER));
+            break;
+        case GL_QUERY_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_QUERY_BUFFER));
+            break;
+        case GL_SHADER_STORAGE_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_SHADER_STORAGE_BUFFER));
+            break;
+        case GL_TEXTURE_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_TEXTURE_BUFFER));
+            break;
+        case GL_TRANSFORM_FEEDBACK_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_TRANSFORM_FEEDBACK_BUFFER));
+            break;
+        case GL_UNIFORM_BUFFER_BINDING:
+            name_value(state.GetBufferBinding(GL_UNIFORM_BUFFER));
+            break;
+        case GL_TEXTURE_BINDING_1D:
+            name_value(state.GetTextureBinding(GL_TEXTURE_1D));
+            break;
+        case GL_TEXTURE_BINDING_1D_ARRAY:
+            name_value(state.GetTextureBinding(GL_TEXTURE_1D_ARRAY));
+            break;
+        case GL_TEXTURE_BINDING_2D:
+            name_value(state.GetTextureBinding(GL_TEXTURE_2D));
+            break;
+        case GL_TEXTURE_BINDING_2D_ARRAY:
+            name_value(state.GetTextureBinding(GL_TEXTURE_2D_ARRAY));
+            break;
+        case GL_TEXTURE_BINDING_2D_MULTISAMPLE:
+            name_value(state.GetTextureBinding(GL_TEXTURE_2D_MULTISAMPLE));
+            break;
+        case GL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY:
+            name_value(state.GetTextureBinding(GL_TEXTURE_2D_MULTISAMPLE_ARRAY));
+            break;
+        case GL_TEXTURE_BINDING_3D:
+            name_value(state.GetTextureBinding(GL_TEXTURE_3D));
+            break;
+        case GL_TEXTURE_BINDING_CUBE_MAP:
+            name_value(state.GetTextureBinding(GL_TEXTURE_CUBE_MAP));
+            break;
+        case GL_TEXTURE_BINDING_CUBE_MAP_ARRAY:
+            name_value(state.GetTextureBinding(GL_TEXTURE_CUBE_MAP_ARRAY));
+            break;
+        case GL_TEXTURE_BINDING_RECTANGLE:
+            name_value(state.GetTextureBinding(GL_TEXTURE_RECTANGLE));
+            break;
+        case GL_ACTIVE_TEXTURE:
+            name_value(GL_TEXTURE0 + static_cast<GLuint>(state.active_texture_unit));
+            break;
+        case GL_VERTEX_ARRAY_BINDING:
+            name_value(state.vertex_array);
+            break;
+        case GL_CURRENT_PROGRAM:
+            name_value(state.program);
+            break;
+        case GL_PROGRAM_PIPELINE_BINDING:
+            name_value(state.pipeline);
+            break;
+        case GL_RENDERBUFFER_BINDING:
+            name_value(state.renderbuffer);
+            break;
+        case GL_DRAW_FRAMEBUFFER_BINDING:
+            name_value(state.draw_framebuffer);
+            break;
+        case GL_READ_FRAMEBUFFER_BINDING:
+            name_value(state.read_framebuffer);
+            break;
+        default:
+            state.CheckEnum(false, name);
+            break;
+        }
+    }
+
+    static GLenum APIENTRY GetError()
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        return std::exchange(state.error, GLenum{GL_NO_ERROR});
+    }
+
+    static void APIENTRY Enable(GLenum capability)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        state.capabilities.insert(capability);
+        if (capability == GL_DEBUG_OUTPUT) state.debug_output = true;
+    }
+
+    static void APIENTRY Disable(GLenum capability)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        state.capabilities.erase(capability);
+        if (capability == GL_DEBUG_OUTPUT) state.debug_output = false;
+    }
+
+    static void APIENTRY Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(width >= 0 && height >= 0, GL_INVALID_VALUE, "negative size {}x{}", width, height)) return;
+        state.viewport = {x, y, width, height};
+    }
+
+    static void APIENTRY Clear(GLbitfield mask)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        constexpr GLbitfield kValidBits = GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
+        state.Check((mask & ~kValidBits) == 0, GL_INVALID_VALUE, "invalid mask {:#x}", mask);
+    }
+
+    static void APIENTRY ClearColor(GLfloat, GLfloat, GLfloat, GLfloat) { NullGlState::OnCall(__func__); }
+    static void APIENTRY BlendFunc(GLenum, GLenum) { NullGlState::OnCall(__func__); }
+    static void APIENTRY CullFace(GLenum) { NullGlState::OnCall(__func__); }
+    static void APIENTRY PolygonMode(GLenum, GLenum) { NullGlState::OnCall(__func__); }
+    static void APIENTRY PatchParameteri(GLenum, GLint) { NullGlState::OnCall(__func__); }
+    static void APIENTRY MemoryBarrier(GLbitfield) { NullGlState::OnCall(__func__); }
+
+    static void APIENTRY LineWidth(GLfloat width)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        state.Check(width > 0, GL_INVALID_VALUE, "width {} is not positive", width);
+    }
+
+    static void APIENTRY PointSize(GLfloat size)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        state.Check(size > 0, GL_INVALID_VALUE, "size {} is not positive", size);
+    }
+
+    static void APIENTRY ReadPixels(GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, void* data)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(width >= 0 && height >= 0, GL_INVALID_VALUE, "negative size {}x{}", width, height)) return;
+
+        const size_t pixel_size = GetPixelSize(format, type);
+        if (!state.Check(pixel_size != 0, GL_INVALID_ENUM, "invalid format {:#x} and type {:#x}", format, type)) return;
+
+        const size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * pixel_size;
+        CopyToClient(data, size);
+        state.stats.downloaded_bytes += size;
+    }
+
+    /************************************************* Debug *****************************************************/
+
+    static void APIENTRY DebugMessageCallback(GLDEBUGPROC callback, const void* user_param)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        state.debug_callback = callback;
+        state.debug_user_param = user_param;
+    }
+
+    static void APIENTRY DebugMessageControl(GLenum, GLenum, GLenum, GLsizei, const GLuint*, GLboolean)
+    {
+        NullGlState::OnCall(__func__);
+    }
+
+    static void APIENTRY PushDebugGroup(GLenum, GLuint, GLsizei, const GLchar*)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(state.debug_group_depth < kMaxDebugGroupDepth, GL_STACK_OVERFLOW, "too many debug groups"))
+        {
+            return;
+        }
+
+        ++state.debug_group_depth;
+    }
+
+    static void APIENTRY PopDebugGroup()
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(state.debug_group_depth != 0, GL_STACK_UNDERFLOW, "no debug group to pop")) return;
+        --state.debug_group_depth;
+    }
+
+    /************************************************ Buffers ****************************************************/
+
+    static void APIENTRY GenBuffers(GLsizei n, GLuint* buffers)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+        std::generate_n(buffers, n, [&] { return state.buffers.Add(); });
+    }
+
+    static void APIENTRY CreateBuffers(GLsizei n, GLuint* buffers)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+        std::generate_n(buffers, n, [&] { return state.buffers.Add(); });
+    }
+
+    static void APIENTRY DeleteBuffers(GLsizei n, const GLuint* buffers)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+
+        for (const GLuint buffer : std::span{buffers, static_cast<size_t>(n)})
+        {
+            if (buffer == 0 || !state.buffers.objects.erase(buffer)) continue;
+
+            // Deleted buffers are unbound from the context and from the current vertex array
+            for (auto& [target, bound] : state.buffer_bindings)
+            {
+                if (bound == buffer) bound = 0;
+            }
+
+            GLuint& element_buffer = state.GetVertexArrayState().element_buffer;
+            if (element_buffer == buffer) element_buffer = 0;
+        }
+    }
+
+    static void APIENTRY BindBuffer(GLenum target, GLuint buffer)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(IsBufferTarget(target), target)) return;
+        if (!state.Check(state.buffers.IsNameOrZero(buffer), GL_INVALID_OPERATION, "unknown buffer {}", buffer))
+        {
+            return;
+        }
+
+        state.GetBufferBinding(target) = buffer;
+    }
+
+    static void APIENTRY BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(IsIndexedBufferTarget(target), target)) return;
+        if (!state.Check(index < kIndexedBufferBindings, GL_INVALID_VALUE, "binding index {} is too big", index))
+        {
+            return;
+        }
+
+        if (!state.Check(state.buffers.IsNameOrZero(buffer), GL_INVALID_OPERATION, "unknown buffer {}", buffer))
+        {
+            return;
+        }
+
+        if (buffer != 0)
+        {
+            GLintptr alignment = 4;
+            if (target == GL_UNIFORM_BUFFER) alignment = kUniformBufferOffsetAlignment;
+            if (target == GL_SHADER_STORAGE_BUFFER) alignment = kStorageBufferOffsetAlignment;
+
+            if (!state.Check(size > 0, GL_INVALID_VALUE, "size {} is not positive", size)) return;
+            if (!state.Check(
+                    offset >= 0 && offset % alignment == 0,
+                    GL_INVALID_VALUE,
+                    "offset {} is not a multiple of {}",
+                    offset,
+                    alignment))
+            {
+                return;
+            }
+        }
+
+        state.GetBufferBinding(target) = buffer;
+    }
+
+    static void APIENTRY BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(IsIndexedBufferTarget(target), target)) return;
+        if (!state.Check(index < kIndexedBufferBindings, GL_INVALID_VALUE, "binding index {} is too big", index))
+        {
+            return;
+        }
+
+        if (!state.Check(state.buffers.IsNameOrZero(buffer), GL_INVALID_OPERATION, "unknown buffer {}", buffer))
+        {
+            return;
+        }
+
+        state.GetBufferBinding(target) = buffer;
+    }
+
+    static void SetBufferData(NullGlState& state, NullBuffer& buffer, GLsizeiptr size, const void* data, GLenum usage)
+    {
+        if (!state.Check(size >= 0, GL_INVALID_VALUE, "negative size {}", size)) return;
+        if (!state.CheckEnum(IsUsage(usage), usage)) return;
+        if (!state.Check(!buffer.immutable, GL_INVALID_OPERATION, "buffer storage is immutable")) return;
+
+        // New data store is not mapped
+        buffer.mapped = false;
+        buffer.data.assign(static_cast<size_t>(size), 0);
+        if (data)
+        {
+            std::memcpy(buffer.data.data(), data, buffer.data.size());
+            state.stats.uploaded_bytes += buffer.data.size();
+        }
+    }
+
+    static void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (NullBuffer* buffer = state.GetBoundBuffer(target))
+        {
+            SetBufferData(state, *buffer, size, data, usage);
+        }
+    }
+
+    static void APIENTRY NamedBufferData(GLuint name, GLsizeiptr size, const void* data, GLenum usage)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullBuffer* buffer = state.buffers.Find(name);
+        if (!state.Check(buffer != nullptr, GL_INVALID_OPERATION, "unknown buffer {}", name)) return;
+        SetBufferData(state, *buffer, size, data, usage);
+    }
+
+    static void
+    SetBufferSubData(NullGlState& state, NullBuffer& buffer, GLintptr offset, GLsizeiptr size, const void* data)
+    {
+        if (!state.Check(
+                IsRangeInside(offset, size, buffer.data.size()),
+                GL_INVALID_VALUE,
+                "range [{}, {}) is outside of the buffer of {} bytes",
+                offset,
+                offset + size,
+                buffer.data.size()))
+        {
+            return;
+        }
+
+        if (!state.Check(
+                !buffer.mapped || (buffer.map_access & GL_MAP_PERSISTENT_BIT),
+                GL_INVALID_OPERATION,
+                "buffer is mapped"))
+        {
+            return;
+        }
+
+        if (!state.Check(
+                !buffer.immutable || (buffer.storage_flags & GL_DYNAMIC_STORAGE_BIT),
+                GL_INVALID_OPERATION,
+                "immutable buffer was created without GL_DYNAMIC_STORAGE_BIT"))
+        {
+            return;
+        }
+
+        if (size != 0) std::memcpy(buffer.data.data() + offset, data, static_cast<size_t>(size));
+        state.stats.uploaded_bytes += static_cast<size_t>(size);
+    }
+
+    static void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (NullBuffer* buffer = state.GetBoundBuffer(target))
+        {
+            SetBufferSubData(state, *buffer, offset, size, data);
+        }
+    }
+
+    static void APIENTRY NamedBufferSubData(GLuint name, GLintptr offset, GLsizeiptr size, const void* data)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullBuffer* buffer = state.buffers.Find(name);
+        if (!state.Check(buffer != nullptr, GL_INVALID_OPERATION, "unknown buffer {}", name)) return;
+        SetBufferSubData(state, *buffer, offset, size, data);
+    }
+
+    static void APIENTRY BufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullBuffer* buffer = state.GetBoundBuffer(target);
+        if (!buffer) return;
+
+        if (!state.Check(size > 0, GL_INVALID_VALUE, "size {} is not positive", size)) return;
+        if (!state.Check(!buffer->immutable, GL_INVALID_OPERATION, "buffer storage is immutable")) return;
+
+        const bool persistent = flags & GL_MAP_PERSISTENT_BIT;
+        const bool coherent = flags & GL_MAP_COHERENT_BIT;
+        const bool mappable = flags & (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
+        if (!state.Check(!persistent || mappable, GL_INVALID_VALUE, "persistent mapping without read or write")) return;
+        if (!state.Check(!coherent || persistent, GL_INVALID_VALUE, "coherent mapping must be persistent")) return;
+
+        buffer->data.assign(static_cast<size_t>(size), 0);
+        if (data)
+        {
+            std::memcpy(buffer->data.data(), data, buffer->data.size());
+            state.stats.uploaded_bytes += buffer->data.size();
+        }
+
+        buffer->immutable = true;
+        buffer->storage_flags = flags;
+        buffer->mapped = false;
+    }
+
+    static void* APIENTRY MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullBuffer* buffer = state.GetBoundBuffer(target);
+        if (!buffer) return nullptr;
+
+        if (!state.Check(
+                length > 0 && IsRangeInside(offset, length, buffer->data.size()),
+                GL_INVALID_VALUE,
+                "range [{}, {}) is outside of the buffer of {} bytes",
+                offset,
+                offset + length,
+                buffer->data.size()))
+        {
+            return nullptr;
+        }
+
+        if (!state.Check(!buffer->mapped, GL_INVALID_OPERATION, "buffer is already mapped")) return nullptr;
+        if (!state.Check(
+                access & (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT),
+                GL_INVALID_OPERATION,
+                "access has neither read nor write bit"))
+        {
+            return nullptr;
+        }
+
+        constexpr GLbitfield kStorageBits =
+            GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        if (!state.Check(
+                !buffer->immutable || (access & kStorageBits & ~buffer->storage_flags) == 0,
+                GL_INVALID_OPERATION,
+                "access {:#x} is not allowed by storage flags {:#x}",
+                access,
+                buffer->storage_flags))
+        {
+            return nullptr;
+        }
+
+        buffer->mapped = true;
+        buffer->map_access = access;
+        return buffer->data.data() + offset;
+    }
+
+    static GLboolean APIENTRY UnmapBuffer(GLenum target)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullBuffer* buffer = state.GetBoundBuffer(target);
+        if (!buffer) return GL_FALSE;
+        if (!state.Check(buffer->mapped, GL_INVALID_OPERATION, "buffer is not mapped")) return GL_FALSE;
+
+        buffer->mapped = false;
+        return GL_TRUE;
+    }
+
+    static void APIENTRY CopyBufferSubData(
+        GLenum read_target,
+        GLenum write_target,
+        GLintptr read_offset,
+        GLintptr write_offset,
+        GLsizeiptr size)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullBuffer* source = state.GetBoundBuffer(read_target);
+        NullBuffer* destination = state.GetBoundBuffer(write_target);
+        if (!source || !destination) return;
+
+        if (!state.Check(
+                IsRangeInside(read_offset, size, source->data.size()) &&
+                    IsRangeInside(write_offset, size, destination->data.size()),
+                GL_INVALID_VALUE,
+                "copy of {} bytes from {} to {} does not fit",
+                size,
+                read_offset,
+                write_offset))
+        {
+            return;
+        }
+
+        if (!state.Check(
+                source != destination || read_offset + size <= write_offset || write_offset + size <= read_offset,
+                GL_INVALID_VALUE,
+                "source and destination ranges overlap"))
+        {
+            return;
+        }
+
+        std::memmove(
+            destination->data.data() + write_offset,
+            source->data.data() + read_offset,
+            static_cast<size_t>(size));
+    }
+
+    static void APIENTRY ClearBufferSubData(
+        GLenum target,
+        GLenum internal_format,
+        GLintptr offset,
+        GLsizeiptr size,
+        GLenum,
+        GLenum,
+        const void* data)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullBuffer* buffer = state.GetBoundBuffer(target);
+        if (!buffer) return;
+
+        const size_t texel_size = GetBufferClearFormatSize(internal_format);
+        if (!state.CheckEnum(texel_size != 0, internal_format)) return;
+        if (!state.Check(
+                IsRangeInside(offset, size, buffer->data.size()) && offset % static_cast<GLintptr>(texel_size) == 0 &&
+                    size % static_cast<GLsizeiptr>(texel_size) == 0,
+                GL_INVALID_VALUE,
+                "range [{}, {}) does not match the buffer or the texel size {}",
+                offset,
+                offset + size,
+                texel_size))
+        {
+            return;
+        }
+
+        // The data is given in client format, which is assumed to match the internal format
+        uint8_t* begin = buffer->data.data() + offset;
+        for (GLsizeiptr i = 0; i < size; i += static_cast<GLsizeiptr>(texel_size))
+        {
+            if (data) std::memcpy(begin + i, data, texel_size);
+            else std::memset(begin + i, 0, texel_size);
+        }
+    }
+
+    /********************************************* Vertex arrays *************************************************/
+
+    static void APIENTRY GenVertexArrays(GLsizei n, GLuint* arrays)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+        std::generate_n(arrays, n, [&] { return state.vertex_arrays.Add(); });
+    }
+
+    static void APIENTRY CreateVertexArrays(GLsizei n, GLuint* arrays)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+        std::generate_n(arrays, n, [&] { return state.vertex_arrays.Add(); });
+    }
+
+    static void APIENTRY DeleteVertexArrays(GLsizei n, const GLuint* arrays)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+
+        for (const GLuint array : std::span{arrays, static_cast<size_t>(n)})
+        {
+            if (array != 0 && state.vertex_arrays.objects.erase(array) && state.vertex_array == array)
+            {
+                state.vertex_array = 0;
+            }
+        }
+    }
+
+    static void APIENTRY BindVertexArray(GLuint array)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(
+                state.vertex_arrays.IsNameOrZero(array),
+                GL_INVALID_OPERATION,
+                "unknown vertex array {}",
+                array))
+        {
+            return;
+        }
+
+        state.vertex_array = array;
+    }
+
+    static NullVertexArray* GetBoundVertexArray(NullGlState& state, GLuint attribute)
+    {
+        NullVertexArray* array = state.vertex_arrays.Find(state.vertex_array);
+        if (!state.Check(array != nullptr, GL_INVALID_OPERATION, "no vertex array is bound")) return nullptr;
+        if (!state.Check(
+                attribute < kVertexAttributes,
+                GL_INVALID_VALUE,
+                "attribute index {} is too big",
+                attribute))
+        {
+            return nullptr;
+        }
+
+        return array;
+    }
+
+    static NullVertexArray* FindVertexArray(NullGlState& state, GLuint name, GLuint attribute)
+    {
+        NullVertexArray* array = state.vertex_arrays.Find(name);
+        if (!state.Check(array != nullptr, GL_INVALID_OPERATION, "unknown vertex array {}", name)) return nullptr;
+        if (!state.Check(
+                attribute < kVertexAttributes,
+                GL_INVALID_VALUE,
+                "attribute index {} is too big",
+                attribute))
+        {
+            return nullptr;
+        }
+
+        return array;
+    }
+
+    static void APIENTRY EnableVertexAttribArray(GLuint index)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (NullVertexArray* array = GetBoundVertexArray(state, index))
+        {
+            array->enabled_attributes |= 1u << index;
+        }
+    }
+
+    static void
+    ValidateAttributePointer(NullGlState& state, GLuint index, GLint size, GLsizei stride, const void* pointer)
+    {
+        if (!GetBoundVertexArray(state, index)) return;
+        if (!state.Check((size >= 1 && size <= 4) || size == GL_BGRA, GL_INVALID_VALUE, "invalid size {}", size))
+        {
+            return;
+        }
+
+        if (!state.Check(stride >= 0, GL_INVALID_VALUE, "negative stride {}", stride)) return;
+        state.Check(
+            state.GetBufferBinding(GL_ARRAY_BUFFER) != 0 || pointer == nullptr,
+            GL_INVALID_OPERATION,
+            "no buffer is bound to GL_ARRAY_BUFFER");
+    }
+
+    static void APIENTRY
+    VertexAttribPointer(GLuint index, GLint size, GLenum, GLboolean, GLsizei stride, const void* pointer)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        ValidateAttributePointer(state, index, size, stride, pointer);
+    }
+
+    static void APIENTRY VertexAttribIPointer(GLuint index, GLint size, GLenum, GLsizei stride, const void* pointer)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        ValidateAttributePointer(state, index, size, stride, pointer);
+    }
+
+    static void APIENTRY VertexAttribLPointer(GLuint index, GLint size, GLenum, GLsizei stride, const void* pointer)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        ValidateAttributePointer(state, index, size, stride, pointer);
+    }
+
+    static void APIENTRY VertexAttribDivisor(GLuint index, GLuint)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        GetBoundVertexArray(state, index);
+    }
+
+    static void APIENTRY EnableVertexArrayAttrib(GLuint array, GLuint index)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (NullVertexArray* found = FindVertexArray(state, array, index))
+        {
+            found->enabled_attributes |= 1u << index;
+        }
+    }
+
+    static void APIENTRY
+    VertexArrayVertexBuffer(GLuint array, GLuint binding, GLuint buffer, GLintptr offset, GLsizei stride)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindVertexArray(state, array, binding)) return;
+        if (!state.Check(state.buffers.IsNameOrZero(buffer), GL_INVALID_OPERATION, "unknown buffer {}", buffer)) return;
+        state.Check(offset >= 0 && stride >= 0, GL_INVALID_VALUE, "negative offset {} or stride {}", offset, stride);
+    }
+
+    static void APIENTRY VertexArrayElementBuffer(GLuint array, GLuint buffer)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullVertexArray* found = state.vertex_arrays.Find(array);
+        if (!state.Check(found != nullptr, GL_INVALID_OPERATION, "unknown vertex array {}", array)) return;
+        if (!state.Check(state.buffers.IsNameOrZero(buffer), GL_INVALID_OPERATION, "unknown buffer {}", buffer)) return;
+        found->element_buffer = buffer;
+    }
+
+    static void APIENTRY VertexArrayAttribFormat(GLuint array, GLuint index, GLint size, GLenum, GLboolean, GLuint)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindVertexArray(state, array, index)) return;
+        state.Check((size >= 1 && size <= 4) || size == GL_BGRA, GL_INVALID_VALUE, "invalid size {}", size);
+    }
+
+    static void APIENTRY VertexArrayAttribIFormat(GLuint array, GLuint index, GLint size, GLenum, GLuint)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindVertexArray(state, array, index)) return;
+        state.Check(size >= 1 && size <= 4, GL_INVALID_VALUE, "invalid size {}", size);
+    }
+
+    static void APIENTRY VertexArrayAttribBinding(GLuint array, GLuint index, GLuint binding)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindVertexArray(state, array, index)) return;
+        state.Check(binding < kVertexAttributes, GL_INVALID_VALUE, "binding index {} is too big", binding);
+    }
+
+    static void APIENTRY VertexArrayBindingDivisor(GLuint array, GLuint binding, GLuint)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        FindVertexArray(state, array, binding);
+    }
+
+    /************************************************* Draw ******************************************************/
+
+    static bool ValidateDraw(NullGlState& state, GLenum mode, GLsizei count, GLsizei instances)
+    {
+        if (!state.CheckEnum(IsPrimitiveMode(mode), mode)) return false;
+        if (!state.Check(count >= 0 && instances >= 0, GL_INVALID_VALUE, "negative count {}", count)) return false;
+        return state.Check(state.vertex_array != 0, GL_INVALID_OPERATION, "no vertex array is bound");
+    }
+
+    static bool ValidateIndices(NullGlState& state, GLsizei count, GLenum type, const void* indices)
+    {
+        const size_t index_size = GetIndexSize(type);
+        if (!state.CheckEnum(index_size != 0, type)) return false;
+
+        const NullBuffer* buffer = state.buffers.Find(state.GetVertexArrayState().element_buffer);
+        if (!state.Check(buffer != nullptr, GL_INVALID_OPERATION, "no element buffer is bound")) return false;
+
+        // Drivers do not have to report this, but reading outside of the buffer is never intended
+        const auto offset = reinterpret_cast<uintptr_t>(indices);  // NOLINT
+        return state.Check(
+            offset + static_cast<size_t>(count) * index_size <= buffer->data.size(),
+            GL_INVALID_OPERATION,
+            "{} indices at offset {} do not fit into the element buffer of {} bytes",
+            count,
+            offset,
+            buffer->data.size());
+    }
+
+    static void CountDraw(NullGlState& state, GLsizei count, GLsizei instances)
+    {
+        ++state.stats.draw_calls;
+        state.stats.vertices += static_cast<size_t>(count) * static_cast<size_t>(instances);
+    }
+
+    static void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(first >= 0, GL_INVALID_VALUE, "negative first vertex {}", first)) return;
+        if (ValidateDraw(state, mode, count, 1)) CountDraw(state, count, 1);
+    }
+
+    static void APIENTRY DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(first >= 0, GL_INVALID_VALUE, "negative first vertex {}", first)) return;
+        if (ValidateDraw(state, mode, count, instances)) CountDraw(state, count, instances);
+    }
+
+    static void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (ValidateDraw(state, mode, count, 1) && ValidateIndices(state, count, type, indices))
+        {
+            CountDraw(state, count, 1);
+        }
+    }
+
+    static void APIENTRY
+    DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (ValidateDraw(state, mode, count, instances) && ValidateIndices(state, count, type, indices))
+        {
+            CountDraw(state, count, instances);
+        }
+    }
+
+    /*********************************************** Textures ****************************************************/
+
+    static void APIENTRY GenTextures(GLsizei n, GLuint* textures)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+        std::generate_n(textures, n, [&] { return state.textures.Add(); });
+    }
+
+    static void APIENTRY CreateTextures(GLenum target, GLsizei n, GLuint* textures)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(IsTextureTarget(target), target)) return;
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+        std::generate_n(textures, n, [&] { return state.textures.Add({.target = target}); });
+    }
+
+    static void APIENTRY DeleteTextures(GLsizei n, const GLuint* textures)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+
+        for (const GLuint texture : std::span{textures, static_cast<size_t>(n)})
+        {
+            if (texture == 0 || !state.textures.objects.erase(texture)) continue;
+
+            for (auto& unit : state.texture_units)
+            {
+                for (auto& [target, bound] : unit)
+                {
+                    if (bound == texture) bound = 0;
+                }
+            }
+        }
+    }
+
+    static void APIENTRY ActiveTexture(GLenum unit)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(unit >= GL_TEXTURE0 && unit < GL_TEXTURE0 + kTextureUnits, unit)) return;
+        state.active_texture_unit = unit - GL_TEXTURE0;
+    }
+
+    static void APIENTRY BindTexture(GLenum target, GLuint texture)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(IsTextureTarget(target), target)) return;
+
+        if (NullTexture* found = state.textures.Find(texture))
+        {
+            if (!state.Check(
+                    found->target == GL_NONE || found->target == target,
+                    GL_INVALID_OPERATION,
+                    "texture {} was created with target {:#x}",
+                    texture,
+                    found->target))
+            {
+                return;
+            }
+
+            found->target = target;
+        }
+        else if (!state.Check(texture == 0, GL_INVALID_OPERATION, "unknown texture {}", texture))
+        {
+            return;
+        }
+
+        state.GetTextureBinding(target) = texture;
+    }
+
+    static NullTexture* GetBoundTexture(NullGlState& state, GLenum target)
+    {
+        if (!state.CheckEnum(IsTextureTarget(target), target)) return nullptr;
+
+        // Default texture objects are not modelled
+        NullTexture* texture = state.textures.Find(state.GetTextureBinding(target));
+        state.Check(texture != nullptr, GL_INVALID_OPERATION, "no texture is bound to {:#x}", target);
+        return texture;
+    }
+
+    static bool ValidateLevelSize(NullGlState& state, GLint level, GLsizei width, GLsizei height)
+    {
+        return state.Check(
+            level >= 0 && width >= 0 && height >= 0 && width <= kMaxTextureSize && height <= kMaxTextureSize,
+            GL_INVALID_VALUE,
+            "invalid level {} or size {}x{}",
+            level,
+            width,
+            height);
+    }
+
+    static void
+    UploadPixels(NullGlState& state, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+    {
+        const size_t pixel_size = GetPixelSize(format, type);
+        if (!state.Check(pixel_size != 0, GL_INVALID_ENUM, "invalid format {:#x} and type {:#x}", format, type)) return;
+
+        // With a pixel unpack buffer the pointer is an offset into it and nothing comes from the client memory
+        if (pixels && state.GetBufferBinding(GL_PIXEL_UNPACK_BUFFER) == 0)
+        {
+            state.stats.uploaded_bytes += static_cast<size_t>(width) * static_cast<size_t>(height) * pixel_size;
+        }
+    }
+
+    static void APIENTRY TexImage2D(
+        GLenum target,
+        GLint level,
+        GLint internal_format,
+        GLsizei width,
+        GLsizei height,
+        GLint border,
+        GLenum format,
+        GLenum type,
+        const void* pixels)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        const GLenum binding_target = GetTexImage2dBindingTarget(target);
+        if (!state.CheckEnum(binding_target != GL_NONE, target)) return;
+
+        NullTexture* texture = GetBoundTexture(state, binding_target);
+        if (!texture) return;
+        if (!state.Check(!texture->immutable, GL_INVALID_OPERATION, "texture storage is immutable")) return;
+        if (!ValidateLevelSize(state, level, width, height)) return;
+        if (!state.Check(border == 0, GL_INVALID_VALUE, "border must be zero")) return;
+
+        texture->internal_format = static_cast<GLenum>(internal_format);
+        texture->levels.resize(std::max(texture->levels.size(), static_cast<size_t>(level) + 1));
+        texture->levels[static_cast<size_t>(level)] = {width, height};
+        UploadPixels(state, width, height, format, type, pixels);
+    }
+
+    static void SetSubImage(
+        NullGlState& state,
+        NullTexture& texture,
+        GLint level,
+        GLint x,
+        GLint y,
+        GLsizei width,
+        GLsizei height,
+        GLenum format,
+        GLenum type,
+        const void* pixels)
+    {
+        if (!state.Check(
+                level >= 0 && static_cast<size_t>(level) < texture.levels.size(),
+                GL_INVALID_OPERATION,
+                "level {} is not allocated",
+                level))
+        {
+            return;
+        }
+
+        const NullTexture::Level& allocated = texture.levels[static_cast<size_t>(level)];
+        if (!state.Check(
+                x >= 0 && y >= 0 && width >= 0 && height >= 0 && x + width <= allocated.width &&
+                    y + height <= allocated.height,
+                GL_INVALID_VALUE,
+                "region {}x{} at ({}, {}) is outside of the level of size {}x{}",
+                width,
+                height,
+                x,
+                y,
+                allocated.width,
+                allocated.height))
+        {
+            return;
+        }
+
+        UploadPixels(state, width, height, format, type, pixels);
+    }
+
+    static void APIENTRY TexSubImage2D(
+        GLenum target,
+        GLint level,
+        GLint x,
+        GLint y,
+        GLsizei width,
+        GLsizei height,
+        GLenum format,
+        GLenum type,
+        const void* pixels)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        const GLenum binding_target = GetTexImage2dBindingTarget(target);
+        if (!state.CheckEnum(binding_target != GL_NONE, target)) return;
+
+        if (NullTexture* texture = GetBoundTexture(state, binding_target))
+        {
+            SetSubImage(state, *texture, level, x, y, width, height, format, type, pixels);
+        }
+    }
+
+    static void APIENTRY
+    TextureStorage2D(GLuint name, GLsizei levels, GLenum internal_format, GLsizei width, GLsizei height)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullTexture* texture = state.textures.Find(name);
+        if (!state.Check(texture != nullptr, GL_INVALID_OPERATION, "unknown texture {}", name)) return;
+        if (!state.Check(!texture->immutable, GL_INVALID_OPERATION, "texture storage is immutable")) return;
+        if (!state.Check(width > 0 && height > 0, GL_INVALID_VALUE, "size {}x{} is not positive", width, height))
+        {
+            return;
+        }
+
+        if (!ValidateLevelSize(state, 0, width, height)) return;
+
+        const auto max_levels = static_cast<GLsizei>(std::bit_width(static_cast<uint32_t>(std::max(width, height))));
+        if (!state.Check(
+                levels >= 1 && levels <= max_levels,
+                GL_INVALID_OPERATION,
+                "{} levels for size {}x{}",
+                levels,
+                width,
+                height))
+        {
+            return;
+        }
+
+        texture->immutable = true;
+        texture->internal_format = internal_format;
+        texture->levels.clear();
+        for (GLsizei level = 0; level != levels; ++level)
+        {
+            texture->levels.push_back({std::max(width >> level, 1), std::max(height >> level, 1)});
+        }
+    }
+
+    static void APIENTRY TextureSubImage2D(
+        GLuint name,
+        GLint level,
+        GLint x,
+        GLint y,
+        GLsizei width,
+        GLsizei height,
+        GLenum format,
+        GLenum type,
+        const void* pixels)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullTexture* texture = state.textures.Find(name);
+        if (!state.Check(texture != nullptr, GL_INVALID_OPERATION, "unknown texture {}", name)) return;
+        SetSubImage(state, *texture, level, x, y, width, height, format, type, pixels);
+    }
+
+    static void APIENTRY GenerateMipmap(GLenum target)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullTexture* texture = GetBoundTexture(state, target);
+        if (!texture) return;
+        if (!state.Check(!texture->levels.empty(), GL_INVALID_OPERATION, "base level is not allocated")) return;
+
+        const NullTexture::Level base = texture->levels.front();
+        const size_t levels = std::bit_width(static_cast<uint32_t>(std::max({base.width, base.height, 1})));
+        texture->levels.resize(levels);
+        for (size_t level = 1; level != levels; ++level)
+        {
+            texture->levels[level] = {std::max(base.width >> level, 1), std::max(base.height >> level, 1)};
+        }
+    }
+
+    static void APIENTRY GetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void* pixels)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        const NullTexture* texture = GetBoundTexture(state, target);
+        if (!texture) return;
+        if (!state.Check(
+                level >= 0 && static_cast<size_t>(level) < texture->levels.size(),
+                GL_INVALID_VALUE,
+                "level {} is not allocated",
+                level))
+        {
+            return;
+        }
+
+        const size_t pixel_size = GetPixelSize(format, type);
+        if (!state.Check(pixel_size != 0, GL_INVALID_ENUM, "invalid format {:#x} and type {:#x}", format, type)) return;
+
+        const NullTexture::Level& allocated = texture->levels[static_cast<size_t>(level)];
+        const size_t size = static_cast<size_t>(allocated.width) * static_cast<size_t>(allocated.height) * pixel_size;
+        CopyToClient(pixels, size);
+        state.stats.downloaded_bytes += size;
+    }
+
+    static void ValidateTexParameter(GLenum target)
+    {
+        auto& state = NullGlState::Get();
+        GetBoundTexture(state, target);
+    }
+
+    static void APIENTRY TexParameteri(GLenum target, GLenum, GLint)
+    {
+        NullGlState::OnCall(__func__);
+        ValidateTexParameter(target);
+    }
+
+    static void APIENTRY TexParameterf(GLenum target, GLenum, GLfloat)
+    {
+        NullGlState::OnCall(__func__);
+        ValidateTexParameter(target);
+    }
+
+    static void APIENTRY TexParameteriv(GLenum target, GLenum, const GLint*)
+    {
+        NullGlState::OnCall(__func__);
+        ValidateTexParameter(target);
+    }
+
+    static void APIENTRY TexParameterfv(GLenum target, GLenum, const GLfloat*)
+    {
+        NullGlState::OnCall(__func__);
+        ValidateTexParameter(target);
+    }
+
+    static void APIENTRY TexParameterIiv(GLenum target, GLenum, const GLint*)
+    {
+        NullGlState::OnCall(__func__);
+        ValidateTexParameter(target);
+    }
+
+    static void APIENTRY TexParameterIuiv(GLenum target, GLenum, const GLuint*)
+    {
+        NullGlState::OnCall(__func__);
+        ValidateTexParameter(target);
+    }
+
+    static void APIENTRY TextureParameteri(GLuint texture, GLenum, GLint)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        state.Check(state.textures.Find(texture) != nullptr, GL_INVALID_OPERATION, "unknown texture {}", texture);
+    }
+
+    /************************************** Framebuffers and renderbuffers ***************************************/
+
+    static void APIENTRY GenFramebuffers(GLsizei n, GLuint* framebuffers)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+        std::generate_n(framebuffers, n, [&] { return state.framebuffers.Add(); });
+    }
+
+    static void APIENTRY DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+
+        for (const GLuint framebuffer : std::span{framebuffers, static_cast<size_t>(n)})
+        {
+            if (framebuffer == 0 || !state.framebuffers.objects.erase(framebuffer)) continue;
+            if (state.draw_framebuffer == framebuffer) state.draw_framebuffer = 0;
+            if (state.read_framebuffer == framebuffer) state.read_framebuffer = 0;
+        }
+    }
+
+    static void APIENTRY BindFramebuffer(GLenum target, GLuint framebuffer)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(
+                target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER,
+                target))
+        {
+            return;
+        }
+
+        if (!state.Check(
+                state.framebuffers.IsNameOrZero(framebuffer),
+                GL_INVALID_OPERATION,
+                "unknown framebuffer {}",
+                framebuffer))
+        {
+            return;
+        }
+
+        if (target != GL_READ_FRAMEBUFFER) state.draw_framebuffer = framebuffer;
+        if (target != GL_DRAW_FRAMEBUFFER) state.read_framebuffer = framebuffer;
+    }
+
+    static NullFramebuffer* GetBoundFramebuffer(NullGlState& state, GLenum target)
+    {
+        const GLuint bound = target == GL_READ_FRAMEBUFFER ? state.read_framebuffer : state.draw_framebuffer;
+        NullFramebuffer* framebuffer = state.framebuffers.Find(bound);
+        state.Check(framebuffer != nullptr, GL_INVALID_OPERATION, "default framebuffer can not be modified");
+        return framebuffer;
+    }
+
+    static void APIENTRY FramebufferTexture2D(GLenum target, GLenum attachment, GLenum, GLuint texture, GLint level)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullFramebuffer* framebuffer = GetBoundFramebuffer(state, target);
+        if (!framebuffer) return;
+        if (!state.Check(state.textures.IsNameOrZero(texture), GL_INVALID_OPERATION, "unknown texture {}", texture))
+        {
+            return;
+        }
+
+        if (!state.Check(level >= 0, GL_INVALID_VALUE, "negative level {}", level)) return;
+        framebuffer->attachments[attachment] = texture;
+    }
+
+    static void APIENTRY FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum, GLuint renderbuffer)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullFramebuffer* framebuffer = GetBoundFramebuffer(state, target);
+        if (!framebuffer) return;
+        if (!state.Check(
+                state.renderbuffers.IsNameOrZero(renderbuffer),
+                GL_INVALID_OPERATION,
+                "unknown renderbuffer {}",
+                renderbuffer))
+        {
+            return;
+        }
+
+        framebuffer->attachments[attachment] = renderbuffer;
+    }
+
+    static void APIENTRY GenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+        std::generate_n(renderbuffers, n, [&] { return state.renderbuffers.Add(); });
+    }
+
+    static void APIENTRY DeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+
+        for (const GLuint renderbuffer : std::span{renderbuffers, static_cast<size_t>(n)})
+        {
+            if (renderbuffer != 0 && state.renderbuffers.objects.erase(renderbuffer) &&
+                state.renderbuffer == renderbuffer)
+            {
+                state.renderbuffer = 0;
+            }
+        }
+    }
+
+    static void APIENTRY BindRenderbuffer(GLenum target, GLuint renderbuffer)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(target == GL_RENDERBUFFER, target)) return;
+        if (!state.Check(
+                state.renderbuffers.IsNameOrZero(renderbuffer),
+                GL_INVALID_OPERATION,
+                "unknown renderbuffer {}",
+                renderbuffer))
+        {
+            return;
+        }
+
+        state.renderbuffer = renderbuffer;
+    }
+
+    static void APIENTRY RenderbufferStorage(GLenum target, GLenum internal_format, GLsizei width, GLsizei height)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(target == GL_RENDERBUFFER, target)) return;
+
+        NullRenderbuffer* renderbuffer = state.renderbuffers.Find(state.renderbuffer);
+        if (!state.Check(renderbuffer != nullptr, GL_INVALID_OPERATION, "no renderbuffer is bound")) return;
+        if (!ValidateLevelSize(state, 0, width, height)) return;
+
+        *renderbuffer = {.internal_format = internal_format, .width = width, .height = height};
+    }
+
+    /************************************************ Shaders ****************************************************/
+
+    static GLuint APIENTRY CreateShader(GLenum type)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        switch (type)
+        {
+        case GL_VERTEX_SHADER:
+        case GL_FRAGMENT_SHADER:
+        case GL_GEOMETRY_SHADER:
+        case GL_TESS_CONTROL_SHADER:
+        case GL_TESS_EVALUATION_SHADER:
+        case GL_COMPUTE_SHADER:
+            break;
+        default:
+            state.CheckEnum(false, type);
+            return 0;
+        }
+
+        const GLuint name = state.next_shader_or_program++;
+        state.shaders.objects.emplace(name, NullShader{.type = type});
+        return name;
+    }
+
+    static NullShader* FindShader(NullGlState& state, GLuint name)
+    {
+        NullShader* shader = state.shaders.Find(name);
+        state.Check(shader != nullptr, GL_INVALID_VALUE, "unknown shader {}", name);
+        return shader;
+    }
+
+    static void APIENTRY ShaderSource(GLuint name, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullShader* shader = FindShader(state, name);
+        if (!shader) return;
+        if (!state.Check(count >= 0, GL_INVALID_VALUE, "negative count {}", count)) return;
+
+        shader->source.clear();
+        for (size_t i = 0; i != static_cast<size_t>(count); ++i)
+        {
+            const GLint length = lengths ? lengths[i] : -1;  // NOLINT
+            if (length < 0) shader->source.append(strings[i]);  // NOLINT
+            else shader->source.append(strings[i], static_cast<size_t>(length));  // NOLINT
+        }
+    }
+
+    static void APIENTRY CompileShader(GLuint name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullShader* shader = FindShader(state, name);
+        if (!shader) return;
+
+        shader->compiled = shader->source.find_first_not_of(" \t\r\n") != std::string::npos;
+        shader->log = shader->compiled ? "" : "Shader source is empty";
+    }
+
+    static void APIENTRY GetShaderiv(GLuint name, GLenum parameter, GLint* value)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        const NullShader* shader = FindShader(state, name);
+        if (!shader) return;
+
+        switch (parameter)
+        {
+        case GL_SHADER_TYPE:
+            *value = static_cast<GLint>(shader->type);
+            break;
+        case GL_COMPILE_STATUS:
+            *value = shader->compiled ? GL_TRUE : GL_FALSE;
+            break;
+        case GL_DELETE_STATUS:
+            *value = GL_FALSE;
+            break;
+        case GL_INFO_LOG_LENGTH:
+            *value = shader->log.empty() ? 0 : static_cast<GLint>(shader->log.size() + 1);
+            break;
+        case GL_SHADER_SOURCE_LENGTH:
+            *value = shader->source.empty() ? 0 : static_cast<GLint>(shader->source.size() + 1);
+            break;
+        default:
+            state.CheckEnum(false, parameter);
+            break;
+        }
+    }
+
+    static void APIENTRY GetShaderInfoLog(GLuint name, GLsizei buffer_size, GLsizei* length, GLchar* log)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (const NullShader* shader = FindShader(state, name))
+        {
+            WriteString(shader->log, buffer_size, length, log);
+        }
+    }
+
+    static void APIENTRY DeleteShader(GLuint name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (name == 0) return;
+
+        // Programs keep what they took from the shader at link time, so it can go away right now
+        state.Check(state.shaders.objects.erase(name) != 0, GL_INVALID_VALUE, "unknown shader {}", name);
+    }
+
+    /*********************************************** Programs ****************************************************/
+
+    static GLuint APIENTRY CreateProgram()
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        const GLuint name = state.next_shader_or_program++;
+        state.programs.objects.emplace(name, NullProgram{});
+        return name;
+    }
+
+    static NullProgram* FindProgram(NullGlState& state, GLuint name)
+    {
+        NullProgram* program = state.programs.Find(name);
+        state.Check(program != nullptr, GL_INVALID_VALUE, "unknown program {}", name);
+        return program;
+    }
+
+    static void APIENTRY AttachShader(GLuint program_name, GLuint shader_name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullProgram* program = FindProgram(state, program_name);
+        if (!program || !FindShader(state, shader_name)) return;
+        if (!state.Check(
+                std::ranges::find(program->shaders, shader_name) == program->shaders.end(),
+                GL_INVALID_OPERATION,
+                "shader {} is already attached",
+                shader_name))
+        {
+            return;
+        }
+
+        program->shaders.push_back(shader_name);
+    }
+
+    static void APIENTRY ProgramParameteri(GLuint name, GLenum parameter, GLint value)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullProgram* program = FindProgram(state, name);
+        if (!program) return;
+        if (!state.CheckEnum(
+                parameter == GL_PROGRAM_SEPARABLE || parameter == GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                parameter))
+        {
+            return;
+        }
+
+        if (parameter == GL_PROGRAM_SEPARABLE) program->separable = value != GL_FALSE;
+    }
+
+    static void AddVariable(std::vector<NullVariable>& variables, const null_gl::GlslDeclaration& declaration)
+    {
+        if (std::ranges::find(variables, declaration.name, &NullVariable::name) != variables.end()) return;
+
+        variables.push_back({
+            .type = declaration.type,
+            .name = declaration.name,
+            .size = static_cast<GLint>(declaration.array_size),
+            .location = declaration.location.value_or(-1),
+        });
+    }
+
+    // Uniforms take a location per array element. Matrix vertex inputs also take a location per column: the name of
+    // a matrix type starts with the number of columns (mat3, mat2x4)
+    static GLint GetLocationsCount(const NullVariable& variable, bool vertex_inputs)
+    {
+        if (!vertex_inputs || !variable.type->matrix) return variable.size;
+        return variable.size * (variable.type->name[3] - '0');
+    }
+
+    // Variables without explicit locations take the first free ones
+    static void AssignLocations(std::vector<NullVariable>& variables, bool vertex_inputs)
+    {
+        ankerl::unordered_dense::set<GLint> used;
+        for (const NullVariable& variable : variables)
+        {
+            if (variable.location < 0) continue;
+            const GLint count = GetLocationsCount(variable, vertex_inputs);
+            for (GLint i = 0; i != count; ++i) used.insert(variable.location + i);
+        }
+
+        GLint next = 0;
+        for (NullVariable& variable : variables)
+        {
+            if (variable.location >= 0) continue;
+
+            const GLint count = GetLocationsCount(variable, vertex_inputs);
+            auto is_free = [&](GLint location)
+            {
+                for (GLint i = 0; i != count; ++i)
+                {
+                    if (used.contains(location + i)) return false;
+                }
+                return true;
+            };
+
+            while (!is_free(next)) ++next;
+            variable.location = next;
+            for (GLint i = 0; i != count; ++i) used.insert(next + i);
+            next += count;
+        }
+    }
+
+    static void APIENTRY LinkProgram(GLuint name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullProgram* program = FindProgram(state, name);
+        if (!program) return;
+
+        program->linked = false;
+        program->uniforms.clear();
+        program->attributes.clear();
+        program->uniform_values.clear();
+
+        if (program->shaders.empty())
+        {
+            program->log = "No shaders attached";
+            return;
+        }
+
+        for (const GLuint shader_name : program->shaders)
+        {
+            const NullShader* shader = state.shaders.Find(shader_name);
+            if (!shader || !shader->compiled)
+            {
+                program->log = fmt::format("Shader {} is not compiled", shader_name);
+                return;
+            }
+
+            const auto declarations = null_gl::ScanGlslDeclarations(shader->source, shader->type == GL_VERTEX_SHADER);
+            for (const auto& uniform : declarations.uniforms) AddVariable(program->uniforms, uniform);
+            for (const auto& input : declarations.inputs) AddVariable(program->attributes, input);
+        }
+
+        AssignLocations(program->uniforms, false);
+        AssignLocations(program->attributes, true);
+        program->linked = true;
+        program->log.clear();
+    }
+
+    static void APIENTRY GetProgramiv(GLuint name, GLenum parameter, GLint* value)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        const NullProgram* program = FindProgram(state, name);
+        if (!program) return;
+
+        auto max_name_length = [](const std::vector<NullVariable>& variables)
+        {
+            size_t length = 0;
+            for (const NullVariable& variable : variables)
+            {
+                // Arrays are reported with "[0]" suffix
+                length = std::max(length, variable.name.size() + (variable.size > 1 ? 3 : 0) + 1);
+            }
+            return static_cast<GLint>(length);
+        };
+
+        switch (parameter)
+        {
+        case GL_DELETE_STATUS:
+        case GL_VALIDATE_STATUS:
+            *value = parameter == GL_VALIDATE_STATUS && program->linked ? GL_TRUE : GL_FALSE;
+            break;
+        case GL_LINK_STATUS:
+            *value = program->linked ? GL_TRUE : GL_FALSE;
+            break;
+        case GL_PROGRAM_SEPARABLE:
+            *value = program->separable ? GL_TRUE : GL_FALSE;
+            break;
+        case GL_INFO_LOG_LENGTH:
+            *value = program->log.empty() ? 0 : static_cast<GLint>(program->log.size() + 1);
+            break;
+        case GL_ATTACHED_SHADERS:
+            *value = static_cast<GLint>(program->shaders.size());
+            break;
+        case GL_ACTIVE_ATTRIBUTES:
+            *value = static_cast<GLint>(program->attributes.size());
+            break;
+        case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:
+            *value = max_name_length(program->attributes);
+            break;
+        case GL_ACTIVE_UNIFORMS:
+            *value = static_cast<GLint>(program->uniforms.size());
+            break;
+        case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+            *value = max_name_length(program->uniforms);
+            break;
+        case GL_ACTIVE_UNIFORM_BLOCKS:
+        case GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH:
+        case GL_ACTIVE_ATOMIC_COUNTER_BUFFERS:
+        case GL_PROGRAM_BINARY_LENGTH:
+        case GL_TRANSFORM_FEEDBACK_VARYINGS:
+        case GL_TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH:
+            *value = 0;
+            break;
+        default:
+            state.CheckEnum(false, parameter);
+            break;
+        }
+    }
+
+    static void APIENTRY GetProgramInfoLog(GLuint name, GLsizei buffer_size, GLsizei* length, GLchar* log)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (const NullProgram* program = FindProgram(state, name))
+        {
+            WriteString(program->log, buffer_size, length, log);
+        }
+    }
+
+    static void APIENTRY DeleteProgram(GLuint name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (name == 0) return;
+
+        // The program in use is deleted right away instead of when it stops being current
+        if (!state.Check(state.programs.objects.erase(name) != 0, GL_INVALID_VALUE, "unknown program {}", name)) return;
+        if (state.program == name) state.program = 0;
+    }
+
+    static void APIENTRY UseProgram(GLuint name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (name != 0)
+        {
+            const NullProgram* program = FindProgram(state, name);
+            if (!program) return;
+            if (!state.Check(program->linked, GL_INVALID_OPERATION, "program {} is not linked", name)) return;
+        }
+
+        state.program = name;
+    }
+
+    static void GetActiveVariable(
+        NullGlState& state,
+        const std::vector<NullVariable>& variables,
+        GLuint index,
+        GLsizei buffer_size,
+        GLsizei* length,
+        GLint* size,
+        GLenum* type,
+        GLchar* name)
+    {
+        if (!state.Check(index < variables.size(), GL_INVALID_VALUE, "index {} is too big", index)) return;
+
+        const NullVariable& variable = variables[index];
+        const std::string reported_name = variable.size > 1 ? variable.name + "[0]" : variable.name;
+        WriteString(reported_name, buffer_size, length, name);
+        *size = variable.size;
+        *type = variable.type->gl_type;
+    }
+
+    static void APIENTRY GetActiveAttrib(
+        GLuint program_name,
+        GLuint index,
+        GLsizei buffer_size,
+        GLsizei* length,
+        GLint* size,
+        GLenum* type,
+        GLchar* name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (const NullProgram* program = FindProgram(state, program_name))
+        {
+            GetActiveVariable(state, program->attributes, index, buffer_size, length, size, type, name);
+        }
+    }
+
+    static void APIENTRY GetActiveUniform(
+        GLuint program_name,
+        GLuint index,
+        GLsizei buffer_size,
+        GLsizei* length,
+        GLint* size,
+        GLenum* type,
+        GLchar* name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (const NullProgram* program = FindProgram(state, program_name))
+        {
+            GetActiveVariable(state, program->uniforms, index, buffer_size, length, size, type, name);
+        }
+    }
+
+    // Accepts "name", "name[0]" and "name[i]"
+    static GLint FindLocation(const std::vector<NullVariable>& variables, std::string_view name)
+    {
+        GLint element = 0;
+        if (name.ends_with(']'))
+        {
+            const size_t bracket = name.rfind('[');
+            if (bracket == std::string_view::npos) return -1;
+
+            const std::string_view index = name.substr(bracket + 1, name.size() - bracket - 2);
+            auto [ptr, ec] = std::from_chars(index.data(), index.data() + index.size(), element);
+            if (ec != std::errc{} || ptr != index.data() + index.size()) return -1;
+            name = name.substr(0, bracket);
+        }
+
+        auto it = std::ranges::find(variables, name, &NullVariable::name);
+        if (it == variables.end() || element < 0 || element >= it->size) return -1;
+        return it->location + element;
+    }
+
+    static GLint APIENTRY GetAttribLocation(GLuint program_name, const GLchar* name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        const NullProgram* program = FindProgram(state, program_name);
+        if (!program) return -1;
+        if (!state.Check(program->linked, GL_INVALID_OPERATION, "program {} is not linked", program_name)) return -1;
+        return FindLocation(program->attributes, name);
+    }
+
+    static GLint APIENTRY GetUniformLocation(GLuint program_name, const GLchar* name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        const NullProgram* program = FindProgram(state, program_name);
+        if (!program) return -1;
+        if (!state.Check(program->linked, GL_INVALID_OPERATION, "program {} is not linked", program_name)) return -1;
+        return FindLocation(program->uniforms, name);
+    }
+
+    static void APIENTRY
+    GetActiveUniformsiv(GLuint program_name, GLsizei count, const GLuint* indices, GLenum parameter, GLint* values)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        const NullProgram* program = FindProgram(state, program_name);
+        if (!program) return;
+        if (!state.Check(count >= 0, GL_INVALID_VALUE, "negative count {}", count)) return;
+
+        for (size_t i = 0; i != static_cast<size_t>(count); ++i)
+        {
+            const GLuint index = indices[i];  // NOLINT
+            if (!state.Check(index < program->uniforms.size(), GL_INVALID_VALUE, "index {} is too big", index)) return;
+
+            // Default block uniforms do not have layout properties
+            const NullVariable& uniform = program->uniforms[index];
+            GLint& value = values[i];  // NOLINT
+            switch (parameter)
+            {
+            case GL_UNIFORM_TYPE:
+                value = static_cast<GLint>(uniform.type->gl_type);
+                break;
+            case GL_UNIFORM_SIZE:
+                value = uniform.size;
+                break;
+            case GL_UNIFORM_NAME_LENGTH:
+                value = static_cast<GLint>(uniform.name.size() + (uniform.size > 1 ? 3 : 0) + 1);
+                break;
+            case GL_UNIFORM_BLOCK_INDEX:
+            case GL_UNIFORM_OFFSET:
+            case GL_UNIFORM_ARRAY_STRIDE:
+            case GL_UNIFORM_MATRIX_STRIDE:
+                value = -1;
+                break;
+            case GL_UNIFORM_IS_ROW_MAJOR:
+                value = 0;
+                break;
+            default:
+                state.CheckEnum(false, parameter);
+                return;
+            }
+        }
+    }
+
+    static void APIENTRY GetActiveUniformBlockiv(GLuint program_name, GLuint index, GLenum, GLint*)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindProgram(state, program_name)) return;
+        state.Check(false, GL_INVALID_VALUE, "uniform block {} does not exist", index);
+    }
+
+    static void APIENTRY GetActiveUniformBlockName(GLuint program_name, GLuint index, GLsizei, GLsizei*, GLchar*)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindProgram(state, program_name)) return;
+        state.Check(false, GL_INVALID_VALUE, "uniform block {} does not exist", index);
+    }
+
+    static void APIENTRY UniformBlockBinding(GLuint program_name, GLuint index, GLuint)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindProgram(state, program_name)) return;
+        state.Check(false, GL_INVALID_VALUE, "uniform block {} does not exist", index);
+    }
+
+    // Program resources are only queried for storage blocks, which are never reported
+    static void APIENTRY GetProgramInterfaceiv(GLuint program_name, GLenum, GLenum parameter, GLint* value)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindProgram(state, program_name)) return;
+        if (!state.CheckEnum(parameter == GL_ACTIVE_RESOURCES || parameter == GL_MAX_NAME_LENGTH, parameter)) return;
+        *value = 0;
+    }
+
+    static void APIENTRY
+    GetProgramResourceiv(GLuint program_name, GLenum, GLuint index, GLsizei, const GLenum*, GLsizei, GLsizei*, GLint*)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindProgram(state, program_name)) return;
+        state.Check(false, GL_INVALID_VALUE, "resource {} does not exist", index);
+    }
+
+    static void APIENTRY GetProgramResourceName(GLuint program_name, GLenum, GLuint index, GLsizei, GLsizei*, GLchar*)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!FindProgram(state, program_name)) return;
+        state.Check(false, GL_INVALID_VALUE, "resource {} does not exist", index);
+    }
+
+    /*********************************************** Uniforms ****************************************************/
+
+    static bool IsUniformTypeCompatible(
+        const null_gl::GlslType& type,
+        null_gl::GlslBaseType base_type,
+        uint8_t components,
+        bool matrix)
+    {
+        using null_gl::GlslBaseType;
+        if (type.components != components || type.matrix != matrix) return false;
+
+        switch (type.base_type)
+        {
+        case GlslBaseType::Bool:
+            return base_type == GlslBaseType::Float || base_type == GlslBaseType::Int ||
+                   base_type == GlslBaseType::UnsignedInt;
+        case GlslBaseType::Sampler:
+            return base_type == GlslBaseType::Int;
+        default:
+            return type.base_type == base_type;
+        }
+    }
+
+    static void SetUniform(
+        GLint location,
+        null_gl::GlslBaseType base_type,
+        uint8_t components,
+        bool matrix,
+        GLsizei count,
+        const void* values)
+    {
+        auto& state = NullGlState::Get();
+        NullProgram* program = state.GetUniformProgram();
+        if (!state.Check(program != nullptr, GL_INVALID_OPERATION, "no program is in use")) return;
+
+        // Location -1 is silently ignored to let shaders optimize uniforms out
+        if (location == -1) return;
+
+        if (!state.Check(count >= 0, GL_INVALID_VALUE, "negative count {}", count)) return;
+
+        const NullVariable* uniform = program->FindUniformAtLocation(location);
+        if (!state.Check(uniform != nullptr, GL_INVALID_OPERATION, "invalid location {}", location)) return;
+        if (!state.Check(
+                IsUniformTypeCompatible(*uniform->type, base_type, components, matrix),
+                GL_INVALID_OPERATION,
+                "uniform {} of type {} can not be set with this function",
+                uniform->name,
+                uniform->type->name))
+        {
+            return;
+        }
+
+        if (!state.Check(
+                count <= 1 || uniform->size > 1,
+                GL_INVALID_OPERATION,
+                "uniform {} is not an array",
+                uniform->name))
+        {
+            return;
+        }
+
+        const size_t element_size = components * sizeof(uint32_t);
+        const auto available = static_cast<size_t>(uniform->location + uniform->size - location);
+        const auto* bytes = static_cast<const uint8_t*>(values);
+        for (size_t i = 0; i != std::min(static_cast<size_t>(count), available); ++i)
+        {
+            auto& value = program->uniform_values[location + static_cast<GLint>(i)];
+            value.assign(bytes + i * element_size, bytes + (i + 1) * element_size);  // NOLINT
+        }
+    }
+
+    template <null_gl::GlslBaseType base_type, typename T, typename... Ts>
+    static void SetUniformValues(GLint location, T first, Ts... rest)
+    {
+        const std::array<T, 1 + sizeof...(Ts)> values{first, rest...};
+        SetUniform(location, base_type, static_cast<uint8_t>(values.size()), false, 1, values.data());
+    }
+
+    static void APIENTRY Uniform1f(GLint location, GLfloat x)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniformValues<null_gl::GlslBaseType::Float>(location, x);
+    }
+
+    static void APIENTRY Uniform2f(GLint location, GLfloat x, GLfloat y)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniformValues<null_gl::GlslBaseType::Float>(location, x, y);
+    }
+
+    static void APIENTRY Uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniformValues<null_gl::GlslBaseType::Float>(location, x, y, z);
+    }
+
+    static void APIENTRY Uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniformValues<null_gl::GlslBaseType::Float>(location, x, y, z, w);
+    }
+
+    static void APIENTRY Uniform1i(GLint location, GLint x)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniformValues<null_gl::GlslBaseType::Int>(location, x);
+    }
+
+    static void APIENTRY Uniform1ui(GLint location, GLuint x)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniformValues<null_gl::GlslBaseType::UnsignedInt>(location, x);
+    }
+
+    static void APIENTRY Uniform1fv(GLint location, GLsizei count, const GLfloat* values)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniform(location, null_gl::GlslBaseType::Float, 1, false, count, values);
+    }
+
+    static void APIENTRY Uniform2fv(GLint location, GLsizei count, const GLfloat* values)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniform(location, null_gl::GlslBaseType::Float, 2, false, count, values);
+    }
+
+    static void APIENTRY Uniform3fv(GLint location, GLsizei count, const GLfloat* values)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniform(location, null_gl::GlslBaseType::Float, 3, false, count, values);
+    }
+
+    static void APIENTRY Uniform4fv(GLint location, GLsizei count, const GLfloat* values)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniform(location, null_gl::GlslBaseType::Float, 4, false, count, values);
+    }
+
+    static void APIENTRY Uniform1iv(GLint location, GLsizei count, const GLint* values)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniform(location, null_gl::GlslBaseType::Int, 1, false, count, values);
+    }
+
+    static void APIENTRY Uniform1uiv(GLint location, GLsizei count, const GLuint* values)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniform(location, null_gl::GlslBaseType::UnsignedInt, 1, false, count, values);
+    }
+
+    // Values are stored as passed, transposition is not applied
+    static void APIENTRY UniformMatrix3fv(GLint location, GLsizei count, GLboolean, const GLfloat* values)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniform(location, null_gl::GlslBaseType::Float, 9, true, count, values);
+    }
+
+    static void APIENTRY UniformMatrix4fv(GLint location, GLsizei count, GLboolean, const GLfloat* values)
+    {
+        NullGlState::OnCall(__func__);
+        SetUniform(location, null_gl::GlslBaseType::Float, 16, true, count, values);
+    }
+
+    /******************************************* Program pipelines ***********************************************/
+
+    static void APIENTRY GenProgramPipelines(GLsizei n, GLuint* pipelines)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+        std::generate_n(pipelines, n, [&] { return state.pipelines.Add(); });
+    }
+
+    static void APIENTRY DeleteProgramPipelines(GLsizei n, const GLuint* pipelines)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(n >= 0, GL_INVALID_VALUE, "negative count {}", n)) return;
+
+        for (const GLuint pipeline : std::span{pipelines, static_cast<size_t>(n)})
+        {
+            if (pipeline != 0 && state.pipelines.objects.erase(pipeline) && state.pipeline == pipeline)
+            {
+                state.pipeline = 0;
+            }
+        }
+    }
+
+    static void APIENTRY BindProgramPipeline(GLuint pipeline)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(
+                state.pipelines.IsNameOrZero(pipeline),
+                GL_INVALID_OPERATION,
+                "unknown program pipeline {}",
+                pipeline))
+        {
+            return;
+        }
+
+        state.pipeline = pipeline;
+    }
+
+    static void APIENTRY UseProgramStages(GLuint pipeline_name, GLbitfield stages, GLuint program_name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullProgramPipeline* pipeline = state.pipelines.Find(pipeline_name);
+        if (!state.Check(pipeline != nullptr, GL_INVALID_OPERATION, "unknown program pipeline {}", pipeline_name))
+        {
+            return;
+        }
+
+        if (program_name != 0)
+        {
+            const NullProgram* program = FindProgram(state, program_name);
+            if (!program) return;
+            if (!state.Check(
+                    program->linked && program->separable,
+                    GL_INVALID_OPERATION,
+                    "program {} is not linked or not separable",
+                    program_name))
+            {
+                return;
+            }
+        }
+
+        for (GLbitfield bit = 1; bit != 0 && bit <= stages; bit <<= 1)
+        {
+            if (stages & bit) pipeline->stages[bit] = program_name;
+        }
+    }
+
+    static void APIENTRY ActiveShaderProgram(GLuint pipeline_name, GLuint program_name)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        NullProgramPipeline* pipeline = state.pipelines.Find(pipeline_name);
+        if (!state.Check(pipeline != nullptr, GL_INVALID_OPERATION, "unknown program pipeline {}", pipeline_name))
+        {
+            return;
+        }
+
+        if (program_name != 0 && !FindProgram(state, program_name)) return;
+        pipeline->active_program = program_name;
+    }
+
+    /************************************************* Sync ******************************************************/
+
+    static GLsync APIENTRY FenceSync(GLenum condition, GLbitfield flags)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.CheckEnum(condition == GL_SYNC_GPU_COMMANDS_COMPLETE, condition)) return nullptr;
+        if (!state.Check(flags == 0, GL_INVALID_VALUE, "flags must be zero")) return nullptr;
+
+        const uintptr_t id = state.next_sync++;
+        state.syncs.insert(id);
+        return ToSync(id);
+    }
+
+    // Nothing is executed asynchronously, so every fence is already signaled
+    static GLenum APIENTRY ClientWaitSync(GLsync sync, GLbitfield, GLuint64)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!state.Check(state.syncs.contains(FromSync(sync)), GL_INVALID_VALUE, "unknown sync object"))
+        {
+            return GL_WAIT_FAILED;
+        }
+
+        return GL_ALREADY_SIGNALED;
+    }
+
+    static void APIENTRY DeleteSync(GLsync sync)
+    {
+        auto& state = NullGlState::OnCall(__func__);
+        if (!sync) return;
+        state.Check(state.syncs.erase(FromSync(sync)) != 0, GL_INVALID_VALUE, "unknown sync object");
+    }
+};
+
+#define KLGL_NULL_GL_ENTRY(function) {"gl" #function, reinterpret_cast<void*>(&NullGl::function)}  // NOLINT
+#define KLGL_NULL_GL_KHR_ENTRY(function) {"gl" #function "KHR", reinterpret_cast<void*>(&NullGl::function)}  // NOLINT
+
+void* GetProcAddress(const char* name)
+{
+    static const ankerl::unordered_dense::map<std::string_view, void*> entry_points{
+        KLGL_NULL_GL_ENTRY(GetString),
+        KLGL_NULL_GL_ENTRY(GetStringi),
+        KLGL_NULL_GL_ENTRY(GetIntegerv),
+        KLGL_NULL_GL_ENTRY(GetError),
+        KLGL_NULL_GL_ENTRY(Enable),
+        KLGL_NULL_GL_ENTRY(Disable),
+        KLGL_NULL_GL_ENTRY(Viewport),
+        KLGL_NULL_GL_ENTRY(Clear),
+        KLGL_NULL_GL_ENTRY(ClearColor),
+        KLGL_NULL_GL_ENTRY(BlendFunc),
+        KLGL_NULL_GL_ENTRY(CullFace),
+        KLGL_NULL_GL_ENTRY(PolygonMode),
+        KLGL_NULL_GL_ENTRY(PatchParameteri),
+        KLGL_NULL_GL_ENTRY(MemoryBarrier),
+        KLGL_NULL_GL_ENTRY(LineWidth),
+        KLGL_NULL_GL_ENTRY(PointSize),
+        KLGL_NULL_GL_ENTRY(ReadPixels),
+        KLGL_NULL_GL_ENTRY(DebugMessageCallback),
+        KLGL_NULL_GL_ENTRY(DebugMessageControl),
+        KLGL_NULL_GL_ENTRY(PushDebugGroup),
+        KLGL_NULL_GL_ENTRY(PopDebugGroup),
+        KLGL_NULL_GL_KHR_ENTRY(DebugMessageCallback),
+        KLGL_NULL_GL_KHR_ENTRY(DebugMessageControl),
+        KLGL_NULL_GL_KHR_ENTRY(PushDebugGroup),
+        KLGL_NULL_GL_KHR_ENTRY(PopDebugGroup),
+        KLGL_NULL_GL_ENTRY(GenBuffers),
+        KLGL_NULL_GL_ENTRY(CreateBuffers),
+        KLGL_NULL_GL_ENTRY(DeleteBuffers),
+        KLGL_NULL_GL_ENTRY(BindBuffer),
+        KLGL_NULL_GL_ENTRY(BindBufferRange),
+        KLGL_NULL_GL_ENTRY(BindBufferBase),
+        KLGL_NULL_GL_ENTRY(BufferData),
+        KLGL_NULL_GL_ENTRY(NamedBufferData),
+        KLGL_NULL_GL_ENTRY(BufferSubData),
+        KLGL_NULL_GL_ENTRY(NamedBufferSubData),
+        KLGL_NULL_GL_ENTRY(BufferStorage),
+        KLGL_NULL_GL_ENTRY(MapBufferRange),
+        KLGL_NULL_GL_ENTRY(UnmapBuffer),
+        KLGL_NULL_GL_ENTRY(CopyBufferSubData),
+        KLGL_NULL_GL_ENTRY(ClearBufferSubData),
+        KLGL_NULL_GL_ENTRY(GenVertexArrays),
+        KLGL_NULL_GL_ENTRY(CreateVertexArrays),
+        KLGL_NULL_GL_ENTRY(DeleteVertexArrays),
+        KLGL_NULL_GL_ENTRY(BindVertexArray),
+        KLGL_NULL_GL_ENTRY(EnableVertexAttribArray),
+        KLGL_NULL_GL_ENTRY(VertexAttribPointer),
+        KLGL_NULL_GL_ENTRY(VertexAttribIPointer),
+        KLGL_NULL_GL_ENTRY(VertexAttribLPointer),
+        KLGL_NULL_GL_ENTRY(VertexAttribDivisor),
+        KLGL_NULL_GL_ENTRY(EnableVertexArrayAttrib),
+        KLGL_NULL_GL_ENTRY(VertexArrayVertexBuffer),
+        KLGL_NULL_GL_ENTRY(VertexArrayElementBuffer),
+        KLGL_NULL_GL_ENTRY(VertexArrayAttribFormat),
+        KLGL_NULL_GL_ENTRY(VertexArrayAttribIFormat),
+        KLGL_NULL_GL_ENTRY(VertexArrayAttribBinding),
+        KLGL_NULL_GL_ENTRY(VertexArrayBindingDivisor),
+        KLGL_NULL_GL_ENTRY(DrawArrays),
+        KLGL_NULL_GL_ENTRY(DrawArraysInstanced),
+        KLGL_NULL_GL_ENTRY(DrawElements),
+        KLGL_NULL_GL_ENTRY(DrawElementsInstanced),
+        KLGL_NULL_GL_ENTRY(GenTextures),
+        KLGL_NULL_GL_ENTRY(CreateTextures),
+        KLGL_NULL_GL_ENTRY(DeleteTextures),
+        KLGL_NULL_GL_ENTRY(ActiveTexture),
+        KLGL_NULL_GL_ENTRY(BindTexture),
+        KLGL_NULL_GL_ENTRY(TexImage2D),
+        KLGL_NULL_GL_ENTRY(TexSubImage2D),
+        KLGL_NULL_GL_ENTRY(TextureStorage2D),
+        KLGL_NULL_GL_ENTRY(TextureSubImage2D),
+        KLGL_NULL_GL_ENTRY(GenerateMipmap),
+        KLGL_NULL_GL_ENTRY(GetTexImage),
+        KLGL_NULL_GL_ENTRY(TexParameteri),
+        KLGL_NULL_GL_ENTRY(TexParameterf),
+        KLGL_NULL_GL_ENTRY(TexParameteriv),
+        KLGL_NULL_GL_ENTRY(TexParameterfv),
+        KLGL_NULL_GL_ENTRY(TexParameterIiv),
+        KLGL_NULL_GL_ENTRY(TexParameterIuiv),
+        KLGL_NULL_GL_ENTRY(TextureParameteri),
+        KLGL_NULL_GL_ENTRY(GenFramebuffers),
+        KLGL_NULL_GL_ENTRY(DeleteFramebuffers),
+        KLGL_NULL_GL_ENTRY(BindFramebuffer),
+        KLGL_NULL_GL_ENTRY(FramebufferTexture2D),
+        KLGL_NULL_GL_ENTRY(FramebufferRenderbuffer),
+        KLGL_NULL_GL_ENTRY(GenRenderbuffers),
+        KLGL_NULL_GL_ENTRY(DeleteRenderbuffers),
+        KLGL_NULL_GL_ENTRY(BindRenderbuffer),
+        KLGL_NULL_GL_ENTRY(RenderbufferStorage),
+        KLGL_NULL_GL_ENTRY(CreateShader),
+        KLGL_NULL_GL_ENTRY(ShaderSource),
+        KLGL_NULL_GL_ENTRY(CompileShader),
+        KLGL_NULL_GL_ENTRY(GetShaderiv),
+        KLGL_NULL_GL_ENTRY(GetShaderInfoLog),
+        KLGL_NULL_GL_ENTRY(DeleteShader),
+        KLGL_NULL_GL_ENTRY(CreateProgram),
+        KLGL_NULL_GL_ENTRY(AttachShader),
+        KLGL_NULL_GL_ENTRY(ProgramParameteri),
+        KLGL_NULL_GL_ENTRY(LinkProgram),
+        KLGL_NULL_GL_ENTRY(GetProgramiv),
+        KLGL_NULL_GL_ENTRY(GetProgramInfoLog),
+        KLGL_NULL_GL_ENTRY(DeleteProgram),
+        KLGL_NULL_GL_ENTRY(UseProgram),
+        KLGL_NULL_GL_ENTRY(GetActiveAttrib),
+        KLGL_NULL_GL_ENTRY(GetActiveUniform),
+        KLGL_NULL_GL_ENTRY(GetAttribLocation),
+        KLGL_NULL_GL_ENTRY(GetUniformLocation),
+        KLGL_NULL_GL_ENTRY(GetActiveUniformsiv),
+        KLGL_NULL_GL_ENTRY(GetActiveUniformBlockiv),
+        KLGL_NULL_GL_ENTRY(GetActiveUniformBlockName),
+        KLGL_NULL_GL_ENTRY(UniformBlockBinding),
+        KLGL_NULL_GL_ENTRY(GetProgramInterfaceiv),
+        KLGL_NULL_GL_ENTRY(GetProgramResourceiv),
+        KLGL_NULL_GL_ENTRY(GetProgramResourceName),
+        KLGL_NULL_GL_ENTRY(Uniform1f),
+        KLGL_NULL_GL_ENTRY(Uniform2f),
+        KLGL_NULL_GL_ENTRY(Uniform3f),
+        KLGL_NULL_GL_ENTRY(Uniform4f),
+        KLGL_NULL_GL_ENTRY(Uniform1i),
+        KLGL_NULL_GL_ENTRY(Uniform1ui),
+        KLGL_NULL_GL_ENTRY(Uniform1fv),
+        KLGL_NULL_GL_ENTRY(Uniform2fv),
+        KLGL_NULL_GL_ENTRY(Uniform3fv),
+        KLGL_NULL_GL_ENTRY(Uniform4fv),
+        KLGL_NULL_GL_ENTRY(Uniform1iv),
+        KLGL_NULL_GL_ENTRY(Uniform1uiv),
+        KLGL_NULL_GL_ENTRY(UniformMatrix3fv),
+        KLGL_NULL_GL_ENTRY(UniformMatrix4fv),
+        KLGL_NULL_GL_ENTRY(GenProgramPipelines),
+        KLGL_NULL_GL_ENTRY(DeleteProgramPipelines),
+        KLGL_NULL_GL_ENTRY(BindProgramPipeline),
+        KLGL_NULL_GL_ENTRY(UseProgramStages),
+        KLGL_NULL_GL_ENTRY(ActiveShaderProgram),
+        KLGL_NULL_GL_ENTRY(FenceSync),
+        KLGL_NULL_GL_ENTRY(ClientWaitSync),
+        KLGL_NULL_GL_ENTRY(DeleteSync),
+    };
+
+    auto it = entry_points.find(name);
+    return it == entry_points.end() ? nullptr : it->second;
+}
+
+#undef KLGL_NULL_GL_ENTRY
+#undef KLGL_NULL_GL_KHR_ENTRY
+
+}  // namespace
+
+void NullGlBackend::Load(const NullGlSettings& settings)
+{
+    // Queued and pooled names belong to the previous state
+    if (IsLoaded())
+    {
+        GlDeletionQueue::Flush();
+        GlNamePool::Clear();
+    }
+
+    auto& state = NullGlState::Get();
+    state = NullGlState{};
+    state.settings = settings;
+    state.version_string = fmt::format("{}.{}.0 klgl null", settings.major_version, settings.minor_version);
+    state.loaded = gladLoadGLLoader(&GetProcAddress) != 0;
+    ErrorHandling::Ensure(state.loaded, "Failed to load the null OpenGL backend");
+
+    // Names start from one again, so anything remembered about previous objects is wrong now
+    OpenGl::InvalidateStateCache();
+    GlMemoryTracker::Reset();
+    GlFrameStatsRegistry::Reset();
+    ResetStats();
+}
+
+bool NullGlBackend::IsLoaded()
+{
+    return NullGlState::Get().loaded;
+}
+
+const NullGlStats& NullGlBackend::GetStats()
+{
+    return NullGlState::Get().stats;
+}
+
+size_t NullGlBackend::GetCallsCount(std::string_view function)
+{
+    if (!function.starts_with("gl")) return 0;
+    function.remove_prefix(2);
+
+    const auto& calls = NullGlState::Get().calls;
+    auto it = calls.find(function);
+    return it == calls.end() ? 0 : it->second;
+}
+
+void NullGlBackend::ResetStats()
+{
+    auto& state = NullGlState::Get();
+    state.stats = {};
+    state.calls.clear();
+}
+
+std::span<const uint8_t> NullGlBackend::GetBufferData(GLuint buffer)
+{
+    const NullBuffer* found = NullGlState::Get().buffers.Find(buffer);
+    return found ? std::span<const uint8_t>{found->data} : std::span<const uint8_t>{};
+}
+
+std::span<const uint8_t> NullGlBackend::GetUniformValue(GLuint program, GLint location)
+{
+    const NullProgram* found = NullGlState::Get().programs.Find(program);
+    if (!found) return {};
+
+    auto it = found->uniform_values.find(location);
+    return it == found->uniform_values.end() ? std::span<const uint8_t>{} : std::span<const uint8_t>{it->second};
+}
+
+std::string_view NullGlBackend::GetLastErrorMessage()
+{
+    return NullGlState::Get().last_error_message;
+}
+
+}  // namespace klgl
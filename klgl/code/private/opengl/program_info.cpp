@@ -1,9 +1,12 @@
 #include "klgl/opengl/program_info.hpp"
 
 #include <algorithm>
+#include <array>
 #include <ranges>
+#include <string_view>
 
 #include "klgl/error_handling.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/uniform_type.hpp"
 #include "klgl/opengl/gl_api.hpp"
 
 namespace klgl
@@ -40,14 +43,24 @@ void GlProgramInfo::FetchVertexAttributes(GlProgramId program)
 void GlProgramInfo::FetchUniforms(GlProgramId program)
 {
     const size_t num_uniforms = OpenGl::GetProgramActiveUniformsCount(program);
-    uniforms.resize(num_uniforms);
+
+    // Members of uniform blocks do not have a location
+    std::vector<uint32_t> indices(num_uniforms);
+    std::ranges::copy(std::views::iota(uint32_t{0}, static_cast<uint32_t>(num_uniforms)), indices.begin());
+    std::vector<int32_t> block_indices(num_uniforms);
+    OpenGl::GetActiveUniformsIntParameter(program, indices, GlActiveUniformIntParameter::BlockIndex, block_indices);
+
+    uniforms.clear();
+    uniforms.reserve(num_uniforms);
 
     std::string name_buffer;
     name_buffer.resize(OpenGl::GetProgramActiveUniformMaxNameLength(program));
 
     for (const size_t index : std::views::iota(size_t{0}, num_uniforms))
     {
-        auto& uniform = uniforms[index];
+        if (block_indices[index] != -1) continue;
+
+        auto& uniform = uniforms.emplace_back();
 
         size_t name_length = 0;
         OpenGl::GetActiveUniform(
@@ -67,6 +80,199 @@ void GlProgramInfo::FetchUniforms(GlProgramId program)
     }
 }
 
+void GlProgramInfo::FetchUniformBlocks(GlProgramId program)
+{
+    const size_t num_blocks = OpenGl::GetProgramActiveUniformBlocksCount(program);
+    uniform_blocks.resize(num_blocks);
+
+    std::string name_buffer;
+    name_buffer.resize(OpenGl::GetProgramActiveUniformMaxNameLength(program));
+
+    std::vector<int32_t> values;
+    for (const uint32_t block_index : std::views::iota(uint32_t{0}, static_cast<uint32_t>(num_blocks)))
+    {
+        auto& block = uniform_blocks[block_index];
+        block.index = block_index;
+        block.name = OpenGl::GetActiveUniformBlockName(program, block_index);
+        block.binding = static_cast<size_t>(
+            OpenGl::GetActiveUniformBlockIntParameter(program, block_index, GlUniformBlockIntParameter::Binding));
+        block.data_size = static_cast<size_t>(
+            OpenGl::GetActiveUniformBlockIntParameter(program, block_index, GlUniformBlockIntParameter::DataSize));
+
+        const std::vector<uint32_t> indices = OpenGl::GetActiveUniformBlockUniformIndices(program, block_index);
+        block.members.resize(indices.size());
+        values.resize(indices.size());
+
+        for (size_t i = 0; i != indices.size(); ++i)
+        {
+            auto& member = block.members[i];
+            member.index = indices[i];
+
+            size_t name_length = 0;
+            size_t array_size = 0;
+            OpenGl::GetActiveUniform(
+                program,
+                member.index,
+                name_buffer.size(),
+                name_length,
+                array_size,
+                member.type,
+                name_buffer.data());
+
+            std::string_view name = std::string_view{name_buffer}.substr(0, name_length);
+            constexpr std::string_view kArraySuffix = "[0]";
+            if (name.ends_with(kArraySuffix))
+            {
+                name.remove_suffix(kArraySuffix.size());
+                member.array_size = array_size;
+            }
+            member.name = name;
+        }
+
+        auto fetch = [&](GlActiveUniformIntParameter parameter, auto member_field)
+        {
+            OpenGl::GetActiveUniformsIntParameter(program, indices, parameter, values);
+            for (size_t i = 0; i != indices.size(); ++i)
+            {
+                block.members[i].*member_field = static_cast<size_t>(std::max(values[i], 0));
+            }
+        };
+
+        fetch(GlActiveUniformIntParameter::Offset, &GlUniformBlockMemberInfo::offset);
+        fetch(GlActiveUniformIntParameter::ArrayStride, &GlUniformBlockMemberInfo::array_stride);
+        fetch(GlActiveUniformIntParameter::MatrixStride, &GlUniformBlockMemberInfo::matrix_stride);
+
+        OpenGl::GetActiveUniformsIntParameter(program, indices, GlActiveUniformIntParameter::IsRowMajor, values);
+        for (size_t i = 0; i != indices.size(); ++i)
+        {
+            block.members[i].row_major = values[i] != 0;
+        }
+
+        std::ranges::sort(block.members, std::less{}, &GlUniformBlockMemberInfo::offset);
+    }
+}
+
+const GlUniformBlockInfo* GlProgramInfo::FindUniformBlock(std::string_view name) const
+{
+    auto it = std::ranges::find(uniform_blocks, name, &GlUniformBlockInfo::name);
+    return it != uniform_blocks.end() ? &*it : nullptr;
+}
+
+const GlStorageBlockInfo* GlProgramInfo::FindStorageBlock(std::string_view name) const
+{
+    auto it = std::ranges::find(storage_blocks, name, &GlStorageBlockInfo::name);
+    return it != storage_blocks.end() ? &*it : nullptr;
+}
+
+void GlProgramInfo::FetchStorageBlocks(GlProgramId program)
+{
+    storage_blocks.clear();
+    if (!GLAD_GL_VERSION_4_3) return;
+
+    auto get_resource_name = [&](GLenum interface, GLuint index, GLint name_length)
+    {
+        std::string name;
+        name.resize(static_cast<size_t>(std::max(name_length, 1)));
+        GLsizei written = 0;
+        glGetProgramResourceName(program.GetValue(), interface, index, name_length, &written, name.data());
+        name.resize(static_cast<size_t>(written));
+        return name;
+    };
+
+    GLint num_blocks = 0;
+    glGetProgramInterfaceiv(program.GetValue(), GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES, &num_blocks);
+    OpenGl::ThrowIfError();
+
+    storage_blocks.resize(static_cast<size_t>(num_blocks));
+    for (const GLuint block_index : std::views::iota(GLuint{0}, static_cast<GLuint>(num_blocks)))
+    {
+        constexpr std::array<GLenum, 4> kBlockProps{
+            GL_NAME_LENGTH,
+            GL_BUFFER_BINDING,
+            GL_BUFFER_DATA_SIZE,
+            GL_NUM_ACTIVE_VARIABLES};
+        std::array<GLint, kBlockProps.size()> block_values{};
+        glGetProgramResourceiv(
+            program.GetValue(),
+            GL_SHADER_STORAGE_BLOCK,
+            block_index,
+            static_cast<GLsizei>(kBlockProps.size()),
+            kBlockProps.data(),
+            static_cast<GLsizei>(block_values.size()),
+            nullptr,
+            block_values.data());
+
+        auto& block = storage_blocks[block_index];
+        block.index = block_index;
+        block.name = get_resource_name(GL_SHADER_STORAGE_BLOCK, block_index, block_values[0]);
+        block.binding = static_cast<size_t>(block_values[1]);
+        block.data_size = static_cast<size_t>(block_values[2]);
+
+        std::vector<GLint> variables(static_cast<size_t>(block_values[3]));
+        constexpr GLenum kActiveVariables = GL_ACTIVE_VARIABLES;
+        glGetProgramResourceiv(
+            program.GetValue(),
+            GL_SHADER_STORAGE_BLOCK,
+            block_index,
+            1,
+            &kActiveVariables,
+            static_cast<GLsizei>(variables.size()),
+            nullptr,
+            variables.data());
+
+        block.members.resize(variables.size());
+        for (size_t i = 0; i != variables.size(); ++i)
+        {
+            constexpr std::array<GLenum, 9> kMemberProps{
+                GL_NAME_LENGTH,
+                GL_TYPE,
+                GL_ARRAY_SIZE,
+                GL_OFFSET,
+                GL_ARRAY_STRIDE,
+                GL_MATRIX_STRIDE,
+                GL_IS_ROW_MAJOR,
+                GL_TOP_LEVEL_ARRAY_SIZE,
+                GL_TOP_LEVEL_ARRAY_STRIDE};
+            std::array<GLint, kMemberProps.size()> member_values{};
+            const auto variable_index = static_cast<GLuint>(variables[i]);
+            glGetProgramResourceiv(
+                program.GetValue(),
+                GL_BUFFER_VARIABLE,
+                variable_index,
+                static_cast<GLsizei>(kMemberProps.size()),
+                kMemberProps.data(),
+                static_cast<GLsizei>(member_values.size()),
+                nullptr,
+                member_values.data());
+
+            auto to_size = [](GLint value)
+            {
+                return static_cast<size_t>(std::max(value, 0));
+            };
+
+            auto& member = block.members[i];
+            member.index = variable_index;
+            member.name = get_resource_name(GL_BUFFER_VARIABLE, variable_index, member_values[0]);
+            constexpr std::string_view kArraySuffix = "[0]";
+            if (std::string_view{member.name}.ends_with(kArraySuffix))
+            {
+                member.name.resize(member.name.size() - kArraySuffix.size());
+                member.array_size = to_size(member_values[2]);
+            }
+            member.type = detail::kGlUniformTypeToGlValue.from_gl_enum.Get(static_cast<GLenum>(member_values[1]));
+            member.offset = to_size(member_values[3]);
+            member.array_stride = to_size(member_values[4]);
+            member.matrix_stride = to_size(member_values[5]);
+            member.row_major = member_values[6] != 0;
+            member.top_level_array_size = to_size(member_values[7]);
+            member.top_level_array_stride = to_size(member_values[8]);
+        }
+
+        OpenGl::ThrowIfError();
+        std::ranges::sort(block.members, std::less{}, &GlStorageBlockMemberInfo::offset);
+    }
+}
+
 void GlProgramInfo::PrintStorageBlocks(GlProgramId program)
 {
     GLint count = 0;
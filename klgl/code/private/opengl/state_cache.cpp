@@ -0,0 +1,94 @@
+#include "klgl/opengl/state_cache.hpp"
+
+namespace klgl
+{
+
+GlStateCache& GlStateCache::Get() noexcept
+{
+    thread_local GlStateCache instance;
+    return instance;
+}
+
+bool GlStateCache::BindVertexArray(GlVertexArrayId array) noexcept
+{
+    if (!Change(vertex_array_, array.GetValue())) return false;
+
+    // Element array buffer binding is a part of the vertex array state
+    buffers_[static_cast<size_t>(GlBufferType::ElementArray)].reset();
+    return true;
+}
+
+bool GlStateCache::ActiveTexture(uint32_t unit) noexcept
+{
+    if (unit >= kMaxTextureUnits)
+    {
+        active_texture_unit_.reset();
+        ++counters_.issued;
+        return true;
+    }
+
+    return Change(active_texture_unit_, unit);
+}
+
+bool GlStateCache::BindTexture(GlTargetTextureType target, GlTextureId texture) noexcept
+{
+    if (!active_texture_unit_)
+    {
+        ++counters_.issued;
+        return true;
+    }
+
+    return Change(textures_[*active_texture_unit_][static_cast<size_t>(target)], texture.GetValue());
+}
+
+std::optional<GLuint> GlStateCache::GetBoundTexture(GlTargetTextureType target) const noexcept
+{
+    if (!active_texture_unit_) return std::nullopt;
+    return textures_[*active_texture_unit_][static_cast<size_t>(target)];
+}
+
+void GlStateCache::OnVertexArrayDeleted(GlVertexArrayId array) noexcept
+{
+    if (vertex_array_ == array.GetValue())
+    {
+        // Deleting the bound vertex array binds the default one
+        vertex_array_ = 0;
+        buffers_[static_cast<size_t>(GlBufferType::ElementArray)].reset();
+    }
+}
+
+void GlStateCache::OnBufferDeleted(GlBufferId buffer) noexcept
+{
+    for (auto& bound_buffer : buffers_)
+    {
+        Forget(bound_buffer, buffer.GetValue());
+    }
+}
+
+void GlStateCache::OnTextureDeleted(GlTextureId texture) noexcept
+{
+    for (TextureUnitState& unit : textures_)
+    {
+        for (auto& bound_texture : unit)
+        {
+            Forget(bound_texture, texture.GetValue());
+        }
+    }
+}
+
+void GlStateCache::Invalidate() noexcept
+{
+    program_.reset();
+    program_pipeline_.reset();
+    vertex_array_.reset();
+    buffers_ = {};
+    active_texture_unit_.reset();
+    textures_ = {};
+    renderbuffer_.reset();
+    depth_test_.reset();
+    blending_.reset();
+    blend_function_.reset();
+    viewport_.reset();
+}
+
+}  // namespace klgl
@@ -0,0 +1,217 @@
+#include "klgl/opengl/storage_buffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/fence.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/name_pool.hpp"
+#include "klgl/opengl/program_info.hpp"
+#include "klgl/opengl/std140.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+
+constexpr GLbitfield kPersistentMappingFlags =
+    GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+// Blocks until all previously issued commands complete
+void WaitForGpu()
+{
+    GlFence::Insert().Wait();
+}
+
+// Arrays of three component vectors have the stride of four component vectors in std430 layout
+std::optional<GlUniformType> GetPaddedVectorType(GlUniformType type)
+{
+    switch (type)
+    {
+    case GlUniformType::FloatVec3:
+        return GlUniformType::FloatVec4;
+    case GlUniformType::IntVec3:
+        return GlUniformType::IntVec4;
+    case GlUniformType::UnsignedIntVec3:
+        return GlUniformType::UnsignedIntVec4;
+    case GlUniformType::BoolVec3:
+        return GlUniformType::BoolVec4;
+    case GlUniformType::DoubleVec3:
+        return GlUniformType::DoubleVec4;
+    default:
+        return std::nullopt;
+    }
+}
+
+}  // namespace
+
+StorageBufferBase::StorageBufferBase(std::span<const uint8_t> initial_data)
+    : size_(initial_data.size())
+{
+    ErrorHandling::Ensure(GLAD_GL_VERSION_4_3, "Shader storage buffers require OpenGL 4.3");
+    ErrorHandling::Ensure(size_ != 0, "Trying to create an empty storage buffer");
+
+    buffer_ = GlObject<GlBufferId>::CreateFrom(GlNamePool::GenBuffer());
+    OpenGl::BindBuffer(GlBufferType::ShaderStorage, buffer_);
+
+    if (GLAD_GL_VERSION_4_4)
+    {
+        OpenGl::BufferStorage(GlBufferType::ShaderStorage, size_, initial_data.data(), kPersistentMappingFlags);
+        mapped_ = static_cast<uint8_t*>(
+            OpenGl::MapBufferRange(GlBufferType::ShaderStorage, 0, size_, kPersistentMappingFlags));
+    }
+    else
+    {
+        OpenGl::BufferData(GlBufferType::ShaderStorage, initial_data, GlUsage::DynamicCopy);
+    }
+}
+
+StorageBufferBase::StorageBufferBase(StorageBufferBase&& other) noexcept
+    : buffer_(std::move(other.buffer_)),
+      mapped_(std::exchange(other.mapped_, nullptr)),
+      size_(std::exchange(other.size_, 0))
+{
+}
+
+StorageBufferBase& StorageBufferBase::operator=(StorageBufferBase&& other) noexcept
+{
+    // Deleting the buffer also unmaps it
+    buffer_ = std::move(other.buffer_);
+    mapped_ = std::exchange(other.mapped_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+}
+
+void StorageBufferBase::Bind(uint32_t binding) const
+{
+    OpenGl::BindBufferBase(GlBufferType::ShaderStorage, binding, buffer_);
+}
+
+void StorageBufferBase::WriteBytes(size_t offset, std::span<const uint8_t> data)
+{
+    EnsureRange(offset, data.size());
+
+    if (IsPersistentlyMapped())
+    {
+        std::memcpy(mapped_ + offset, data.data(), data.size());
+        return;
+    }
+
+    OpenGl::BindBuffer(GlBufferType::ShaderStorage, buffer_);
+    if (data.size() == size_)
+    {
+        // Orphan the previous data store so the driver does not have to wait until GPU finishes using it
+        OpenGl::BufferData(GlBufferType::ShaderStorage, data, GlUsage::DynamicCopy);
+    }
+    else
+    {
+        OpenGl::BufferSubData(GlBufferType::ShaderStorage, offset, data);
+    }
+}
+
+void StorageBufferBase::ReadBytes(size_t offset, std::span<uint8_t> out) const
+{
+    EnsureRange(offset, out.size());
+
+    if (IsPersistentlyMapped())
+    {
+        OpenGl::InsertMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+        WaitForGpu();
+        std::memcpy(out.data(), mapped_ + offset, out.size());
+        return;
+    }
+
+    OpenGl::InsertMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    WaitForGpu();
+    OpenGl::BindBuffer(GlBufferType::ShaderStorage, buffer_);
+    const void* mapped_range = OpenGl::MapBufferRange(GlBufferType::ShaderStorage, offset, out.size(), GL_MAP_READ_BIT);
+    std::memcpy(out.data(), mapped_range, out.size());
+    const bool intact = OpenGl::UnmapBuffer(GlBufferType::ShaderStorage);
+    ErrorHandling::Ensure(intact, "Storage buffer content was corrupted while it was mapped");
+}
+
+void StorageBufferBase::ClearBytes(size_t offset, size_t size)
+{
+    EnsureRange(offset, size);
+    OpenGl::BindBuffer(GlBufferType::ShaderStorage, buffer_);
+    OpenGl::ClearBufferSubData(GlBufferType::ShaderStorage, offset, size);
+}
+
+void StorageBufferBase::CopyBytes(const StorageBufferBase& source, size_t source_offset, size_t offset, size_t size)
+{
+    source.EnsureRange(source_offset, size);
+    EnsureRange(offset, size);
+    OpenGl::BindBuffer(GlBufferType::CopyRead, source.buffer_);
+    OpenGl::BindBuffer(GlBufferType::CopyWrite, buffer_);
+    OpenGl::CopyBufferSubData(GlBufferType::CopyRead, GlBufferType::CopyWrite, source_offset, offset, size);
+}
+
+void StorageBufferBase::EnsureElementLayout(
+    const GlStorageBlockInfo& block,
+    size_t element_size,
+    std::optional<GlUniformType> element_type) const
+{
+    ErrorHandling::Ensure(!block.members.empty(), "Storage block \"{}\" does not have active members", block.name);
+
+    for (const GlStorageBlockMemberInfo& member : block.members)
+    {
+        ErrorHandling::Ensure(
+            member.top_level_array_size == 0,
+            "Member \"{}\" of storage block \"{}\" is not a part of a runtime sized array. Storage buffer expects "
+            "a block with one runtime sized array",
+            member.name,
+            block.name);
+
+        ErrorHandling::Ensure(
+            member.top_level_array_stride == element_size,
+            "Storage block \"{}\" has array stride {} but the buffer element has {} bytes",
+            block.name,
+            member.top_level_array_stride,
+            element_size);
+
+        const GlUniformTypeShape shape = GetUniformTypeShape(member.type).value();
+        const size_t num_vectors = member.row_major ? shape.rows : shape.columns;
+        const size_t vector_size = shape.component_size * (member.row_major ? shape.columns : shape.rows);
+        const size_t num_elements = std::max<size_t>(member.array_size, 1);
+        const size_t last_element_offset = member.offset + (num_elements - 1) * member.array_stride;
+        const size_t end = last_element_offset + (num_vectors - 1) * member.matrix_stride + vector_size;
+        ErrorHandling::Ensure(
+            end <= element_size,
+            "Member \"{}\" of storage block \"{}\" ends at byte {} which is outside of {} bytes buffer element",
+            member.name,
+            block.name,
+            end,
+            element_size);
+    }
+
+    if (element_type)
+    {
+        const GlStorageBlockMemberInfo& member = block.members.front();
+        const GlUniformTypeShape shape = GetUniformTypeShape(*element_type).value();
+        const bool same_type = member.type == *element_type || GetPaddedVectorType(member.type) == element_type;
+        const bool same_layout = block.members.size() == 1 && same_type && member.offset == 0 &&
+                                 member.array_size == 0 && !member.row_major &&
+                                 (shape.columns == 1 || member.matrix_stride == shape.GetColumnSize());
+        ErrorHandling::Ensure(
+            same_layout,
+            "Storage block \"{}\" has elements of type {} but the buffer has elements of type {}",
+            block.name,
+            member.type,
+            *element_type);
+    }
+}
+
+void StorageBufferBase::EnsureRange(size_t offset, size_t size) const
+{
+    ErrorHandling::Ensure(
+        offset <= size_ && size <= size_ - offset,
+        "Range [{}, {}) is outside of storage buffer with {} bytes",
+        offset,
+        offset + size,
+        size_);
+}
+
+}  // namespace klgl
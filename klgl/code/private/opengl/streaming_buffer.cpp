@@ -0,0 +1,136 @@
+#include "klgl/opengl/streaming_buffer.hpp"
+
+#include <bit>
+#include <utility>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/name_pool.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+
+constexpr GLbitfield kPersistentMappingFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+// Buffer is bound to this target only to create and update it, so vertex array state is not affected
+constexpr GlBufferType kEditTarget = GlBufferType::CopyWrite;
+
+constexpr size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}  // namespace
+
+StreamingBuffer::StreamingBuffer(size_t region_size, size_t regions)
+    : fences_(regions),
+      region_size_(AlignUp(region_size, kMaxAlignment)),
+      regions_(regions)
+{
+    ErrorHandling::Ensure(region_size_ != 0, "Trying to create an empty streaming buffer");
+
+    buffer_ = GlObject<GlBufferId>::CreateFrom(GlNamePool::GenBuffer());
+    OpenGl::BindBuffer(kEditTarget, buffer_);
+
+    if (GLAD_GL_VERSION_4_4)
+    {
+        const size_t size = region_size_ * regions_;
+        OpenGl::BufferStorage(kEditTarget, size, nullptr, kPersistentMappingFlags);
+        mapped_ = static_cast<uint8_t*>(OpenGl::MapBufferRange(kEditTarget, 0, size, kPersistentMappingFlags));
+    }
+    else
+    {
+        // Orphaning gives a fresh data store each frame, so one region is enough
+        OpenGl::BufferData(kEditTarget, region_size_, GlUsage::StreamDraw);
+        staging_.resize(region_size_);
+    }
+}
+
+StreamingBuffer::StreamingBuffer(StreamingBuffer&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+StreamingBuffer& StreamingBuffer::operator=(StreamingBuffer&& other) noexcept
+{
+    // Deleting the buffer also unmaps it
+    buffer_ = std::move(other.buffer_);
+    fences_ = std::move(other.fences_);
+    mapped_ = std::exchange(other.mapped_, nullptr);
+    staging_ = std::move(other.staging_);
+    region_size_ = std::exchange(other.region_size_, 0);
+    regions_ = std::exchange(other.regions_, 0);
+    head_ = std::exchange(other.head_, 0);
+    flushed_ = std::exchange(other.flushed_, 0);
+    return *this;
+}
+
+void StreamingBuffer::Reserve(size_t region_size)
+{
+    if (region_size <= region_size_) return;
+
+    // OpenGL keeps the old data store alive until commands that read it complete
+    *this = StreamingBuffer(std::max(region_size, region_size_ * 2), std::max<size_t>(regions_, 2));
+}
+
+StreamingBufferAllocation<uint8_t> StreamingBuffer::AllocateBytes(size_t size, size_t alignment)
+{
+    ErrorHandling::Ensure(
+        std::has_single_bit(alignment) && alignment <= kMaxAlignment,
+        "Invalid streaming buffer allocation alignment {}",
+        alignment);
+
+    const size_t begin = AlignUp(head_, std::max(alignment, kMinAlignment));
+    ErrorHandling::Ensure(
+        begin <= region_size_ && size <= region_size_ - begin,
+        "Streaming buffer region of {} bytes can not fit {} more bytes ({} are used). Reserve more space",
+        region_size_,
+        size,
+        head_);
+
+    head_ = begin + size;
+
+    if (IsPersistentlyMapped())
+    {
+        const size_t offset = GetRegionBegin() + begin;
+        return {std::span{mapped_ + offset, size}, offset};
+    }
+
+    return {std::span{staging_}.subspan(begin, size), begin};
+}
+
+void StreamingBuffer::Flush()
+{
+    if (IsPersistentlyMapped() || flushed_ == head_) return;
+
+    OpenGl::BindBuffer(kEditTarget, buffer_);
+    if (flushed_ == 0)
+    {
+        // Commands of previous frames may still read the old data store, so ask for a new one instead of waiting
+        OpenGl::BufferData(kEditTarget, region_size_, GlUsage::StreamDraw);
+    }
+
+    OpenGl::BufferSubData(kEditTarget, flushed_, std::span{staging_}.subspan(flushed_, head_ - flushed_));
+    flushed_ = head_;
+}
+
+void StreamingBuffer::NextFrame()
+{
+    head_ = 0;
+    flushed_ = 0;
+
+    if (IsPersistentlyMapped())
+    {
+        fences_.NextFrame();
+    }
+}
+
+size_t StreamingBuffer::GetRegionBegin() const
+{
+    return fences_.GetCurrentIndex() * region_size_;
+}
+
+}  // namespace klgl
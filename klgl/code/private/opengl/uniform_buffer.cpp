@@ -0,0 +1,199 @@
+#include "klgl/opengl/uniform_buffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/name_pool.hpp"
+#include "klgl/opengl/program_info.hpp"
+#include "klgl/opengl/std140.hpp"
+
+namespace klgl
+{
+
+UniformBuffer::UniformBuffer(std::vector<Member> members, size_t size)
+    : members_(std::move(members)),
+      data_(size, 0)
+{
+    buffer_ = GlObject<GlBufferId>::CreateFrom(GlNamePool::GenBuffer());
+    OpenGl::BindBuffer(GlBufferType::Uniform, buffer_);
+    OpenGl::BufferData(GlBufferType::Uniform, std::span<const uint8_t>{data_}, GlUsage::DynamicDraw);
+}
+
+UniformBuffer UniformBuffer::CreateStd140(std::span<const MemberDescription> members)
+{
+    Std140LayoutBuilder layout;
+    std::vector<Member> result;
+    result.reserve(members.size());
+    for (const MemberDescription& description : members)
+    {
+        const Std140Member location = layout.Add(description.type, description.array_size);
+        result.push_back({
+            .name = description.name,
+            .type = description.type,
+            .array_size = description.array_size,
+            .offset = location.offset,
+            .array_stride = location.array_stride,
+            .matrix_stride = location.matrix_stride,
+        });
+    }
+
+    return UniformBuffer(std::move(result), layout.GetSize());
+}
+
+UniformBuffer UniformBuffer::CreateFromBlock(const GlUniformBlockInfo& block)
+{
+    std::vector<Member> result;
+    result.reserve(block.members.size());
+    for (const GlUniformBlockMemberInfo& member : block.members)
+    {
+        ErrorHandling::Ensure(
+            !member.row_major,
+            "Member \"{}\" of uniform block \"{}\" is row major. Only column major matrices are supported",
+            member.name,
+            block.name);
+
+        result.push_back({
+            .name = member.name,
+            .type = member.type,
+            .array_size = member.array_size,
+            .offset = member.offset,
+            .array_stride = member.array_stride,
+            .matrix_stride = member.matrix_stride,
+        });
+    }
+
+    return UniformBuffer(std::move(result), block.data_size);
+}
+
+std::optional<size_t> UniformBuffer::FindMember(std::string_view name) const
+{
+    auto it = std::ranges::find(members_, name, &Member::name);
+    if (it == members_.end()) return std::nullopt;
+    return static_cast<size_t>(std::distance(members_.begin(), it));
+}
+
+size_t UniformBuffer::GetMember(std::string_view name) const
+{
+    [[likely]] if (auto maybe_index = FindMember(name))
+    {
+        return *maybe_index;
+    }
+
+    throw ErrorHandling::RuntimeErrorWithMessage("Uniform buffer does not have member \"{}\"", name);
+}
+
+void UniformBuffer::WriteElements(
+    size_t member_index,
+    GlUniformType type,
+    std::span<const uint8_t> values,
+    size_t count,
+    size_t first_element)
+{
+    const Member& member = members_[member_index];
+    ErrorHandling::Ensure(
+        member.type == type,
+        "Uniform buffer member \"{}\" has type {} but the value has type {}",
+        member.name,
+        member.type,
+        type);
+
+    const size_t num_elements = std::max<size_t>(member.array_size, 1);
+    ErrorHandling::Ensure(
+        first_element + count <= num_elements,
+        "Writing elements [{}, {}) to uniform buffer member \"{}\" which has {} elements",
+        first_element,
+        first_element + count,
+        member.name,
+        num_elements);
+
+    if (count == 0) return;
+
+    const GlUniformTypeShape shape = GetUniformTypeShape(type).value();
+    const size_t element_size = values.size() / count;
+    ErrorHandling::Ensure(
+        element_size == shape.GetTightSize(),
+        "Type {} is expected to have {} bytes, got {}",
+        type,
+        shape.GetTightSize(),
+        element_size);
+
+    const size_t column_size = shape.GetColumnSize();
+    const size_t begin = member.offset + first_element * member.array_stride;
+    size_t end = begin;
+    for (size_t i = 0; i != count; ++i)
+    {
+        const size_t element_offset = begin + i * member.array_stride;
+        const uint8_t* source = values.data() + i * element_size;
+        if (shape.columns == 1)
+        {
+            std::memcpy(data_.data() + element_offset, source, element_size);
+            end = element_offset + element_size;
+        }
+        else
+        {
+            for (size_t column = 0; column != shape.columns; ++column)
+            {
+                const size_t column_offset = element_offset + column * member.matrix_stride;
+                std::memcpy(data_.data() + column_offset, source + column * column_size, column_size);
+                end = column_offset + column_size;
+            }
+        }
+    }
+
+    if (IsDirty())
+    {
+        dirty_begin_ = std::min(dirty_begin_, begin);
+        dirty_end_ = std::max(dirty_end_, end);
+    }
+    else
+    {
+        dirty_begin_ = begin;
+        dirty_end_ = end;
+    }
+}
+
+void UniformBuffer::Upload()
+{
+    if (!IsDirty()) return;
+
+    OpenGl::BindBuffer(GlBufferType::Uniform, buffer_);
+    OpenGl::BufferSubData(
+        GlBufferType::Uniform,
+        dirty_begin_,
+        std::span<const uint8_t>{data_}.subspan(dirty_begin_, dirty_end_ - dirty_begin_));
+    dirty_begin_ = 0;
+    dirty_end_ = 0;
+}
+
+void UniformBuffer::Bind(uint32_t binding) const
+{
+    OpenGl::BindBufferRange(GlBufferType::Uniform, binding, buffer_, 0, data_.size());
+}
+
+void UniformBuffer::EnsureCompatible(const GlUniformBlockInfo& block) const
+{
+    ErrorHandling::Ensure(
+        block.data_size <= data_.size(),
+        "Uniform block \"{}\" requires {} bytes but the buffer has only {}",
+        block.name,
+        block.data_size,
+        data_.size());
+
+    for (const GlUniformBlockMemberInfo& block_member : block.members)
+    {
+        const Member& member = members_[GetMember(block_member.name)];
+        const bool same_layout = member.type == block_member.type && member.array_size == block_member.array_size &&
+                                 member.offset == block_member.offset &&
+                                 member.array_stride == block_member.array_stride &&
+                                 member.matrix_stride == block_member.matrix_stride && !block_member.row_major;
+        ErrorHandling::Ensure(
+            same_layout,
+            "Member \"{}\" of uniform block \"{}\" has different layout than in the uniform buffer",
+            block_member.name,
+            block.name);
+    }
+}
+
+}  // namespace klgl
@@ -1,64 +1,227 @@
 #include "klgl/rendering/painter2d.hpp"
 
-#include "EverydayTools/Math/IntRange.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <vector>
+
 #include "EverydayTools/Math/Math.hpp"
 #include "klgl/application.hpp"
 #include "klgl/error_handling.hpp"
+#include "klgl/opengl/name_pool.hpp"
 #include "klgl/opengl/program_info.hpp"
+#include "klgl/opengl/streaming_buffer.hpp"
 #include "klgl/opengl/vertex_attribute_helper.hpp"
 #include "klgl/reflection/matrix_reflect.hpp"  // IWYU pragma: keep
+#include "klgl/rendering/painter2d_layer.hpp"
 #include "klgl/shader/shader.hpp"
+#include "klgl/template/member_offset.hpp"
+#include "klgl/texture/texture_atlas.hpp"
 
 namespace klgl
 {
 
-class Painter2d::Impl
+namespace
 {
-public:
-    static constexpr size_t kBatchSize = 128;
+// Values of a_type. Painter2d.geom expands outlines by line widths
+constexpr uint8_t kRectType = 0;
+constexpr uint8_t kCircleType = 1;
+constexpr uint8_t kTriangleType = 2;
+constexpr uint8_t kRectLinesType = 3;
+constexpr uint8_t kTriangleLinesType = 4;
+constexpr uint8_t kSpriteType = 5;
+
+Painter2d::Instance MakePrimitive(uint8_t type, const Vec4u8& color, const Mat3f& transform, const Vec2f& params)
+{
+    return {
+        .transform = transform.Transposed(),
+        .params = params,
+        .color = color,
+        .type = type,
+    };
+}
+
+// Same as TranslationMatrix(center) * RotationMatrix2d(rotation) * ScaleMatrix(size / 2) written in the transposed
+// layout without matrix products. Trigonometry is skipped for primitives that are not rotated
+Painter2d::Instance MakeBoxPrimitive(
+    uint8_t type,
+    const Vec4u8& color,
+    const Vec2f& center,
+    const Vec2f& size,
+    float rotation_degrees,
+    const Vec2f& params)
+{
+    float r00 = 1.f, r01 = 0.f, r10 = 0.f, r11 = 1.f;  // NOLINT
+    if (rotation_degrees != 0.f)
+    {
+        const Mat3f rotation = edt::Math::RotationMatrix2d(edt::Math::DegToRad(rotation_degrees));
+        r00 = rotation(0, 0);
+        r01 = rotation(0, 1);
+        r10 = rotation(1, 0);
+        r11 = rotation(1, 1);
+    }
+
+    const Vec2f half_size = size / 2.f;
+    Painter2d::Instance instance{.params = params, .color = color, .type = type};
+    Mat3f& t = instance.transform;
+    t(0, 0) = r00 * half_size.x();
+    t(1, 0) = r01 * half_size.y();
+    t(2, 0) = center.x();
+    t(0, 1) = r10 * half_size.x();
+    t(1, 1) = r11 * half_size.y();
+    t(2, 1) = center.y();
+    t(0, 2) = 0.f;
+    t(1, 2) = 0.f;
+    t(2, 2) = 1.f;
+    return instance;
+}
 
-    template <typename ValueType, bool to_float = true, bool normalize = false>
-    struct Batch
+// Copies primitives that are not entirely outside of the clip space to out, keeping the order. Returns the number of
+// copied primitives. See CommandList::Cull
+size_t CullInstances(std::span<const Painter2d::Instance> instances, const Mat3f& view, Painter2d::Instance* out)
+{
+    // Both matrices are transposed, so view(c, r) and transform(c, r) are elements of the row r and the column c
+    const float v00 = view(0, 0);
+    const float v01 = view(1, 0);
+    const float v02 = view(2, 0);
+    const float v10 = view(0, 1);
+    const float v11 = view(1, 1);
+    const float v12 = view(2, 1);
+
+    // The first two rows of transforms of a chunk are copied to separate arrays, so the compiler vectorizes the
+    // bounds test. Transforms are affine: the last row is (0, 0, 1)
+    constexpr size_t kChunkSize = 64;
+    std::array<std::array<float, kChunkSize>, 6> t{};
+    std::array<uint8_t, kChunkSize> visible{};
+
+    const size_t count = instances.size();
+    size_t kept = 0;
+    for (size_t begin = 0; begin < count; begin += kChunkSize)
     {
-        using AttribHelper = VertexBufferHelperStatic<ValueType, normalize, to_float>;
+        const size_t chunk_size = std::min(kChunkSize, count - begin);
+        for (size_t i = 0; i != chunk_size; ++i)
+        {
+            const Mat3f& m = instances[begin + i].transform;
+            t[0][i] = m(0, 0);
+            t[1][i] = m(1, 0);
+            t[2][i] = m(2, 0);
+            t[3][i] = m(0, 1);
+            t[4][i] = m(1, 1);
+            t[5][i] = m(2, 1);
+        }
 
-        Batch() : vbo(GlObject<GlBufferId>::CreateFrom(OpenGl::GenBuffer()))
+        // Clip space bounding box of the quad the geometry shader emits for corners (+-1, +-1)
+        for (size_t i = 0; i != kChunkSize; ++i)
         {
-            OpenGl::BindBuffer(GlBufferType::Array, vbo);
-            OpenGl::BufferData(GlBufferType::Array, std::span{values}.size_bytes(), GlUsage::DynamicDraw);
+            const float center_x = v00 * t[2][i] + v01 * t[5][i] + v02;
+            const float center_y = v10 * t[2][i] + v11 * t[5][i] + v12;
+            const float extent_x = std::abs(v00 * t[0][i] + v01 * t[3][i]) + std::abs(v00 * t[1][i] + v01 * t[4][i]);
+            const float extent_y = std::abs(v10 * t[0][i] + v11 * t[3][i]) + std::abs(v10 * t[1][i] + v11 * t[4][i]);
+            visible[i] = (std::abs(center_x) - extent_x <= 1.f) & (std::abs(center_y) - extent_y <= 1.f);
         }
 
-        void Send(size_t location, edt::IntRange<size_t> elements_to_update)
+        // The destination never passes the element being read, so the output may be the input itself
+        for (size_t i = 0; i != chunk_size; ++i)
         {
-            OpenGl::BindBuffer(GlBufferType::Array, vbo);
-            OpenGl::BufferSubData(
-                GlBufferType::Array,
-                elements_to_update.begin,
-                std::span{values}.subspan(elements_to_update.begin));
-            AttribHelper::EnableVertexAttribArray(location);
-            AttribHelper::AttributePointer(location);
-            AttribHelper::AttributeDivisor(location, 1);
+            const Painter2d::Instance& instance = instances[begin + i];
+            if (visible[i] || instance.type == kRectLinesType || instance.type == kTriangleLinesType)
+            {
+                out[kept++] = instance;
+            }
         }
+    }
+
+    return kept;
+}
+}  // namespace
+
+class Painter2d::Impl
+{
+public:
+    // Attributes are interleaved so one upload covers a whole draw
+    using Instance = Painter2d::Instance;
 
-        GlObject<GlBufferId> vbo{};
-        std::array<ValueType, kBatchSize> values{};
+    // Instance buffer grows to fit all primitives of a frame, so this only sets the size of the first frame
+    static constexpr size_t kInitialCapacity = 1024;
+
+    // All attributes read the instance buffer from the same binding
+    static constexpr size_t kInstanceBinding = 0;
+
+    // Submitted lists are not copied: primitives of the session are uploaded from segments in the order they were
+    // added. A segment is either a submitted list or a range of commands_
+    struct Segment
+    {
+        std::span<const Instance> submitted;
+        size_t begin = 0;
+        size_t end = 0;
     };
 
+    using TransformAttrib = VertexBufferHelperStatic<Mat3f>;
+    using ParamsAttrib = VertexBufferHelperStatic<Vec2f>;
+    using ColorAttrib = VertexBufferHelperStatic<Vec4u8, true>;
+    using TypeAttrib = VertexBufferHelperStatic<uint8_t, false, false>;
+    using UvAttrib = VertexBufferHelperStatic<edt::Matrix<uint16_t, 4, 1>, true>;
+
     Impl()
     {
         shader_ = std::make_unique<Shader>("klgl/painter2d");
 
-        vao_ = GlObject<GlVertexArrayId>::CreateFrom(OpenGl::GenVertexArray());
-        OpenGl::BindVertexArray(vao_);
-
-        vbo_ = GlObject<GlBufferId>::CreateFrom(OpenGl::GenBuffer());
-        OpenGl::BindBuffer(GlBufferType::Array, vbo_);
-
         const auto& program_info = shader_->GetInfo();
         a_type_ = program_info.VerifyAndGetVertexAttributeLocation<uint8_t>("a_type");
         a_color_ = program_info.VerifyAndGetVertexAttributeLocation<Vec4f>("a_color");
         a_transform_ = program_info.VerifyAndGetVertexAttributeLocation<Mat3f>("a_transform");
         a_params_ = program_info.VerifyAndGetVertexAttributeLocation<Vec2f>("a_params");
+        a_uv_ = program_info.VerifyAndGetVertexAttributeLocation<Vec4f>("a_uv");
+
+        instance_buffer_ = StreamingBuffer(kInitialCapacity * sizeof(Instance));
+
+        if (direct_state_access_)
+        {
+            vao_ = GlObject<GlVertexArrayId>::CreateFrom(GlNamePool::CreateVertexArray());
+            SetupAttributeFormat<TransformAttrib, &Instance::transform>(a_transform_);
+            SetupAttributeFormat<ParamsAttrib, &Instance::params>(a_params_);
+            SetupAttributeFormat<ColorAttrib, &Instance::color>(a_color_);
+            SetupAttributeFormat<TypeAttrib, &Instance::type>(a_type_);
+            SetupAttributeFormat<UvAttrib, &Instance::uv>(a_uv_);
+            OpenGl::VertexArrayBindingDivisor(vao_, kInstanceBinding, 1);
+        }
+        else
+        {
+            vao_ = GlObject<GlVertexArrayId>::CreateFrom(GlNamePool::GenVertexArray());
+            OpenGl::BindVertexArray(vao_);
+            SetupAttributeArray<TransformAttrib>(a_transform_);
+            SetupAttributeArray<ParamsAttrib>(a_params_);
+            SetupAttributeArray<ColorAttrib>(a_color_);
+            SetupAttributeArray<TypeAttrib>(a_type_);
+            SetupAttributeArray<UvAttrib>(a_uv_);
+        }
+    }
+
+    template <typename AttribHelper, auto member>
+    void SetupAttributeFormat(size_t location)
+    {
+        AttribHelper::EnableVertexArrayAttrib(vao_, location);
+        AttribHelper::AttributeFormat(vao_, location, MemberOffset<member>(), kInstanceBinding);
+    }
+
+    template <typename AttribHelper>
+    static void SetupAttributeArray(size_t location)
+    {
+        AttribHelper::EnableVertexAttribArray(location);
+        AttribHelper::AttributeDivisor(location, 1);
+    }
+
+    // Pointers of the bind-to-edit path include the buffer and the offset, so they are specified again for each draw
+    void SetAttributePointers(GlBufferId buffer, size_t offset) const
+    {
+        constexpr size_t stride = sizeof(Instance);
+        OpenGl::BindBuffer(GlBufferType::Array, buffer);
+        TransformAttrib::AttributePointer(a_transform_, stride, offset + MemberOffset<&Instance::transform>());
+        ParamsAttrib::AttributePointer(a_params_, stride, offset + MemberOffset<&Instance::params>());
+        ColorAttrib::AttributePointer(a_color_, stride, offset + MemberOffset<&Instance::color>());
+        TypeAttrib::AttributePointer(a_type_, stride, offset + MemberOffset<&Instance::type>());
+        UvAttrib::AttributePointer(a_uv_, stride, offset + MemberOffset<&Instance::uv>());
     }
 
     void BeginDraw()
@@ -67,92 +230,155 @@ public:
             !drawing,
             "Trying to start drawing but previous drawing session was not paired with EndDraw call");
         drawing = true;
-        num_primitives = 0;
+
+        // Keeps the capacity, so after the first few frames primitives are added without allocations
+        commands_.Clear();
+        segments_.clear();
+        segmented_commands_ = 0;
+    }
+
+    void NextFrame()
+    {
+        ErrorHandling::Ensure(!drawing, "Attempt to start a new frame inside of a drawing session");
+
+        // Waits for GPU to finish the frame that used the next region
+        instance_buffer_.NextFrame();
     }
 
     void EndDraw()
     {
         ErrorHandling::Ensure(drawing, "Attempt to stop drawing twice or without previous BeginDraw call");
         drawing = false;
+        CloseCommandsSegment();
+
+        size_t total = 0;
+        for (const Segment& segment : segments_) total += GetInstances(segment).size();
+
+        culled_count_ = 0;
+        if (total == 0) return;
+
+        // Sessions of one frame are placed one after another in the same region. Only instances are written to the
+        // buffer, so the used size stays aligned for them
+        instance_buffer_.Reserve(instance_buffer_.GetUsedBytes() + total * sizeof(Instance));
+
+        // Segments are copied straight to the upload, culled on the way. All primitives share the shader and the view
+        // matrix, so the whole session is one upload and one draw
+        const auto allocation = instance_buffer_.Allocate<Instance>(total);
+        size_t count = 0;
+        for (const Segment& segment : segments_)
+        {
+            const std::span<const Instance> instances = GetInstances(segment);
+            if (culling_enabled_)
+            {
+                count += CullInstances(instances, view_matrix_, allocation.data.data() + count);
+            }
+            else
+            {
+                std::ranges::copy(instances, allocation.data.begin() + static_cast<std::ptrdiff_t>(count));
+                count += instances.size();
+            }
+        }
+
+        instance_buffer_.Flush();
+        culled_count_ = total - count;
+        if (count == 0) return;
+
+        DrawInstances(instance_buffer_.GetBuffer(), allocation.offset, count);
+    }
+
+    void DrawLayer(Painter2dLayer& layer)
+    {
+        layer.Upload();
+        if (layer.GetSlotsCount() == 0) return;
 
+        DrawInstances(layer.GetBuffer(), 0, layer.GetSlotsCount());
+    }
+
+    void DrawInstances(GlBufferId buffer, size_t offset, size_t count)
+    {
         shader_->Use();
 
         shader_->SetUniform(u_view_, view_matrix_);
+        if (atlas_) shader_->SetUniform(u_atlas_, atlas_->GetTexture());
 
         OpenGl::EnableBlending();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        OpenGl::SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         shader_->SendUniforms();
 
         OpenGl::BindVertexArray(vao_);
 
-        for (size_t batch_index = 0; batch_index != type_batches_.size(); ++batch_index)
+        if (direct_state_access_)
         {
-            if (num_primitives <= batch_index * kBatchSize) break;
-
-            // number of circles initialized for the current batch
-            const size_t num_locally_used = std::min(num_primitives - batch_index * kBatchSize, kBatchSize);
-            const edt::IntRange<size_t> update_range{.begin = 0, .end = num_locally_used};
-
-            type_batches_[batch_index].Send(a_type_, update_range);
-            color_batches_[batch_index].Send(a_color_, update_range);
-            transform_batches_[batch_index].Send(a_transform_, update_range);
-            param_batches_[batch_index].Send(a_params_, update_range);
-
-            OpenGl::DrawArraysInstanced(GlPrimitiveType::Points, 0, 1, num_locally_used);
+            OpenGl::VertexArrayVertexBuffer(vao_, kInstanceBinding, buffer, offset, sizeof(Instance));
+        }
+        else
+        {
+            SetAttributePointers(buffer, offset);
         }
+
+        OpenGl::DrawArraysInstanced(GlPrimitiveType::Points, 0, 1, count);
     }
 
-    void EnsureBeganDrawing() { ErrorHandling::Ensure(drawing, "Did not start drawing session!"); }
+    // Primitives added directly to the painter
+    CommandList& GetCommands()
+    {
+        ErrorHandling::Ensure(drawing, "Did not start drawing session!");
+        return commands_;
+    }
 
-    void AddPrimitive(uint8_t shape, const Vec4u8& color, const Mat3f& transform, const Vec2f& params)
+    void Submit(std::span<const CommandList> lists)
     {
-        EnsureBeganDrawing();
+        ErrorHandling::Ensure(drawing, "Did not start drawing session!");
 
-        if (num_primitives == type_batches_.size() * kBatchSize)
+        // Primitives added directly before the lists are drawn before them
+        CloseCommandsSegment();
+        for (const CommandList& list : lists)
         {
-            type_batches_.emplace_back();
-            color_batches_.emplace_back();
-            transform_batches_.emplace_back();
-            param_batches_.emplace_back();
+            if (!list.IsEmpty()) segments_.push_back({.submitted = list.GetInstances()});
         }
+    }
 
-        const size_t index_in_batch = num_primitives % kBatchSize;
-        const size_t batch_index = num_primitives / kBatchSize;
-
-        num_primitives += 1;
-
-        auto& type_batch = type_batches_[batch_index];
-        type_batch.values[index_in_batch] = shape;
-
-        auto& color_batch = color_batches_[batch_index];
-        color_batch.values[index_in_batch] = color;
+    // Adds primitives added directly since the previous segment as a segment
+    void CloseCommandsSegment()
+    {
+        const size_t end = commands_.GetSize();
+        if (end == segmented_commands_) return;
 
-        auto& transform_batch = transform_batches_[batch_index];
-        transform_batch.values[index_in_batch] = transform.Transposed();
+        segments_.push_back({.begin = segmented_commands_, .end = end});
+        segmented_commands_ = end;
+    }
 
-        auto& param_batch = param_batches_[batch_index];
-        param_batch.values[index_in_batch] = params;
+    [[nodiscard]] std::span<const Instance> GetInstances(const Segment& segment) const
+    {
+        if (!segment.submitted.empty()) return segment.submitted;
+        return commands_.GetInstances().subspan(segment.begin, segment.end - segment.begin);
     }
 
-    std::vector<Batch<uint8_t, false>> type_batches_;
-    std::vector<Batch<Vec4u8, true, true>> color_batches_;
-    std::vector<Batch<Mat3f>> transform_batches_;
-    std::vector<Batch<Vec2f>> param_batches_;
+    CommandList commands_;
+    std::vector<Segment> segments_;
 
+    // End of the part of commands_ covered by segments
+    size_t segmented_commands_ = 0;
+    StreamingBuffer instance_buffer_;
     GlObject<GlVertexArrayId> vao_;
-    GlObject<GlBufferId> vbo_;
 
     Application* app_ = nullptr;
     std::unique_ptr<Shader> shader_;
 
+    // Selected once because the vertex array is set up differently for each path
+    bool direct_state_access_ = OpenGl::HasDirectStateAccess();
     bool drawing = false;
-    size_t num_primitives = 0;
+    bool culling_enabled_ = false;
+    size_t culled_count_ = 0;
     size_t a_transform_ = 0;
     size_t a_color_ = 1;
     size_t a_type_ = 2;
     size_t a_params_ = 3;
+    size_t a_uv_ = 4;
     UniformHandle u_view_ = UniformHandle("u_view");
+    UniformHandle u_atlas_ = UniformHandle("u_atlas");
+    const TextureAtlas* atlas_ = nullptr;
     Mat3f view_matrix_ = Mat3f::Identity();
 };
 
@@ -160,6 +386,11 @@ Painter2d::Painter2d() : self(std::make_unique<Impl>()) {}
 
 Painter2d::~Painter2d() = default;
 
+void Painter2d::NextFrame()
+{
+    self->NextFrame();
+}
+
 void Painter2d::BeginDraw()
 {
     self->BeginDraw();
@@ -170,20 +401,83 @@ void Painter2d::EndDraw()
     self->EndDraw();
 }
 
-void Painter2d::RectLines(const Rect2d& rect, LineWidth line_width)
+void Painter2d::DrawLayer(Painter2dLayer& layer)
 {
-    auto m = edt::Math::ScaleMatrix(rect.size / 2);
-    if (rect.rotation_degrees != 0.f)
-    {
-        const float radians = edt::Math::DegToRad(rect.rotation_degrees);
-        m = edt::Math::RotationMatrix2d(radians).MatMul(m);
-    }
+    self->DrawLayer(layer);
+}
+
+void Painter2d::Submit(const CommandList& list)
+{
+    self->Submit(std::span{&list, 1});
+}
 
-    m = edt::Math::TranslationMatrix(rect.center).MatMul(m);
-    self->AddPrimitive(3, rect.color, m, {line_width.inner, line_width.outer});
+void Painter2d::Submit(std::span<const CommandList> lists)
+{
+    self->Submit(lists);
+}
+
+void Painter2d::RectLines(const Rect2d& rect, LineWidth line_width)
+{
+    self->GetCommands().RectLines(rect, line_width);
 }
 
 void Painter2d::TriangleLines(const Triangle2d& triangle, LineWidth line_width)
+{
+    self->GetCommands().TriangleLines(triangle, line_width);
+}
+
+void Painter2d::FillRect(const Rect2d& rect)
+{
+    self->GetCommands().FillRect(rect);
+}
+
+void Painter2d::FillCircle(const Circle2d& circle)
+{
+    self->GetCommands().FillCircle(circle);
+}
+
+void Painter2d::FillTriangle(const Triangle2d& triangle)
+{
+    self->GetCommands().FillTriangle(triangle);
+}
+
+void Painter2d::DrawLine(const Line2d& line)
+{
+    self->GetCommands().DrawLine(line);
+}
+
+void Painter2d::DrawSprite(const Rect2d& rect, const TextureAtlasRegion& region)
+{
+    self->GetCommands().DrawSprite(rect, region);
+}
+
+void Painter2d::FillRects(std::span<const Rect2d> rects)
+{
+    self->GetCommands().FillRects(rects);
+}
+
+void Painter2d::FillCircles(std::span<const Circle2d> circles)
+{
+    self->GetCommands().FillCircles(circles);
+}
+
+void Painter2d::DrawLines(std::span<const Line2d> lines)
+{
+    self->GetCommands().DrawLines(lines);
+}
+
+Painter2d::Instance Painter2d::MakeInstance(const Rect2d& rect, LineWidth line_width)
+{
+    return MakeBoxPrimitive(
+        kRectLinesType,
+        rect.color,
+        rect.center,
+        rect.size,
+        rect.rotation_degrees,
+        {line_width.inner, line_width.outer});
+}
+
+Painter2d::Instance Painter2d::MakeInstance(const Triangle2d& triangle, LineWidth line_width)
 {
     const Vec2f i = (triangle.b - triangle.a) / 2;
     const Vec2f j = (triangle.c - triangle.a) / 2;
@@ -194,37 +488,20 @@ void Painter2d::TriangleLines(const Triangle2d& triangle, LineWidth line_width)
     m.SetColumn(1, Vec3f{j, 0});
     m.SetColumn(2, Vec3f(t, 1));
 
-    self->AddPrimitive(4, triangle.color, m, {line_width.inner, line_width.outer});
+    return MakePrimitive(kTriangleLinesType, triangle.color, m, {line_width.inner, line_width.outer});
 }
 
-void Painter2d::FillRect(const Rect2d& rect)
+Painter2d::Instance Painter2d::MakeInstance(const Rect2d& rect)
 {
-    auto m = edt::Math::ScaleMatrix(rect.size / 2);
-    if (rect.rotation_degrees != 0.f)
-    {
-        const float radians = edt::Math::DegToRad(rect.rotation_degrees);
-        m = edt::Math::RotationMatrix2d(radians).MatMul(m);
-    }
-
-    m = edt::Math::TranslationMatrix(rect.center).MatMul(m);
-    self->AddPrimitive(0, rect.color, m, {});
+    return MakeBoxPrimitive(kRectType, rect.color, rect.center, rect.size, rect.rotation_degrees, {});
 }
 
-void Painter2d::FillCircle(const Circle2d& circle)
+Painter2d::Instance Painter2d::MakeInstance(const Circle2d& circle)
 {
-    auto m = edt::Math::ScaleMatrix(circle.size / 2.f);
-    if (circle.rotation_degrees != 0.f)
-    {
-        const float radians = edt::Math::DegToRad(circle.rotation_degrees);
-        m = edt::Math::RotationMatrix2d(radians).MatMul(m);
-    }
-
-    m = edt::Math::TranslationMatrix(circle.center).MatMul(m);
-
-    self->AddPrimitive(1, circle.color, m, {});
+    return MakeBoxPrimitive(kCircleType, circle.color, circle.center, circle.size, circle.rotation_degrees, {});
 }
 
-void Painter2d::FillTriangle(const Triangle2d& triangle)
+Painter2d::Instance Painter2d::MakeInstance(const Triangle2d& triangle)
 {
     // The transformation below is an inlined version of the following algorithm:
     // 1. Translate by 1 so that bottom left corner in screen space (point A) becomes 0, 0
@@ -245,10 +522,10 @@ void Painter2d::FillTriangle(const Triangle2d& triangle)
     m.SetColumn(1, Vec3f{j, 0});
     m.SetColumn(2, Vec3f(t, 1));
 
-    self->AddPrimitive(2, triangle.color, m, {});
+    return MakePrimitive(kTriangleType, triangle.color, m, {});
 }
 
-void Painter2d::DrawLine(const Line2d& line)
+Painter2d::Instance Painter2d::MakeInstance(const Line2d& line)
 {
     const Vec2f ab = line.b - line.a;
     const Vec2f d = ab.Normalized();
@@ -259,7 +536,65 @@ void Painter2d::DrawLine(const Line2d& line)
     m.SetColumn(0, Vec3f{x, 0.f});  // axis x (along the line)
     m.SetColumn(1, Vec3f{y, 0.f});  // axis y
     m.SetColumn(2, Vec3f{t, 1.f});  // translation
-    self->AddPrimitive(0, line.color, m, {});
+    return MakePrimitive(kRectType, line.color, m, {});
+}
+
+Painter2d::Instance Painter2d::MakeInstance(const Rect2d& rect, const TextureAtlasRegion& region)
+{
+    const auto to_unorm16 = [](float value)
+    {
+        return static_cast<uint16_t>(std::lround(std::clamp(value, 0.f, 1.f) * 65535.f));
+    };
+
+    Instance instance = MakeBoxPrimitive(kSpriteType, rect.color, rect.center, rect.size, rect.rotation_degrees, {});
+    instance.uv = {
+        to_unorm16(region.uv_min.x()),
+        to_unorm16(region.uv_min.y()),
+        to_unorm16(region.uv_max.x()),
+        to_unorm16(region.uv_max.y()),
+    };
+    return instance;
+}
+
+void Painter2d::CommandList::Append(const CommandList& other)
+{
+    // Indices instead of iterators keep appending the list to itself valid after resize
+    const size_t size = instances_.size();
+    const size_t count = other.instances_.size();
+    instances_.resize(size + count);
+    std::copy_n(other.instances_.begin(), count, instances_.begin() + static_cast<std::ptrdiff_t>(size));
+}
+
+std::span<Painter2d::Instance> Painter2d::CommandList::Grow(size_t count)
+{
+    const size_t size = instances_.size();
+    instances_.resize(size + count);
+    return std::span{instances_}.subspan(size);
+}
+
+void Painter2d::CommandList::FillRects(std::span<const Rect2d> rects)
+{
+    std::ranges::transform(rects, Grow(rects.size()).begin(), [](const Rect2d& rect) { return MakeInstance(rect); });
+}
+
+void Painter2d::CommandList::FillCircles(std::span<const Circle2d> circles)
+{
+    std::ranges::transform(
+        circles,
+        Grow(circles.size()).begin(),
+        [](const Circle2d& circle) { return MakeInstance(circle); });
+}
+
+void Painter2d::CommandList::DrawLines(std::span<const Line2d> lines)
+{
+    std::ranges::transform(lines, Grow(lines.size()).begin(), [](const Line2d& line) { return MakeInstance(line); });
+}
+
+size_t Painter2d::CommandList::Cull(const Mat3f& view)
+{
+    const size_t count = instances_.size();
+    instances_.resize(CullInstances(instances_, view, instances_.data()));
+    return count - instances_.size();
 }
 
 void Painter2d::SetViewMatrix(const Mat3f& view_matrix)
@@ -267,4 +602,19 @@ void Painter2d::SetViewMatrix(const Mat3f& view_matrix)
     self->view_matrix_ = view_matrix;
 }
 
+void Painter2d::SetTextureAtlas(const TextureAtlas* atlas)
+{
+    self->atlas_ = atlas;
+}
+
+void Painter2d::SetCullingEnabled(bool enabled)
+{
+    self->culling_enabled_ = enabled;
+}
+
+size_t Painter2d::GetCulledCount() const
+{
+    return self->culled_count_;
+}
+
 }  // namespace klgl
@@ -0,0 +1,128 @@
+#include "klgl/rendering/painter2d_layer.hpp"
+
+#include <algorithm>
+#include <span>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/name_pool.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+constexpr size_t kMinCapacity = 64;
+
+// Buffer is bound to this target only to update it, so vertex array state is not affected
+constexpr GlBufferType kEditTarget = GlBufferType::CopyWrite;
+}  // namespace
+
+Painter2dLayer::Handle Painter2dLayer::Add(const Instance& instance)
+{
+    uint32_t slot = 0;
+    if (free_slots_.empty())
+    {
+        ErrorHandling::Ensure(instances_.size() < Handle::kInvalidSlot, "Too many primitives in the layer");
+        slot = static_cast<uint32_t>(instances_.size());
+        instances_.push_back(instance);
+        generations_.push_back(0);
+    }
+    else
+    {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+        instances_[slot] = instance;
+    }
+
+    MarkDirty(slot);
+    return {.slot = slot, .generation = generations_[slot]};
+}
+
+void Painter2dLayer::Update(Handle handle, const Instance& instance)
+{
+    EnsureContains(handle);
+    instances_[handle.slot] = instance;
+    MarkDirty(handle.slot);
+}
+
+void Painter2dLayer::Remove(Handle handle)
+{
+    EnsureContains(handle);
+
+    // Zero transform collapses the primitive to a point, so it produces no fragments until the slot is reused
+    instances_[handle.slot] = Instance{};
+    generations_[handle.slot] += 1;
+    free_slots_.push_back(handle.slot);
+    MarkDirty(handle.slot);
+}
+
+bool Painter2dLayer::Contains(Handle handle) const
+{
+    // Removing a primitive increments the generation of its slot, so handles to removed primitives do not match
+    return handle.slot < generations_.size() && generations_[handle.slot] == handle.generation;
+}
+
+void Painter2dLayer::EnsureContains(Handle handle) const
+{
+    ErrorHandling::Ensure(
+        Contains(handle),
+        "Handle {}:{} does not refer to a primitive of the layer",
+        handle.slot,
+        handle.generation);
+}
+
+void Painter2dLayer::MarkDirty(size_t slot)
+{
+    if (!HasChanges())
+    {
+        dirty_begin_ = slot;
+        dirty_end_ = slot + 1;
+        return;
+    }
+
+    dirty_begin_ = std::min(dirty_begin_, slot);
+    dirty_end_ = std::max(dirty_end_, slot + 1);
+}
+
+void Painter2dLayer::Upload()
+{
+    if (instances_.size() > buffer_capacity_)
+    {
+        // The old buffer is deleted after commands that read it complete, so the new one gets all slots
+        buffer_capacity_ = std::max({instances_.size(), buffer_capacity_ * 2, kMinCapacity});
+        const size_t capacity_bytes = buffer_capacity_ * sizeof(Instance);
+        if (OpenGl::HasDirectStateAccess())
+        {
+            buffer_ = GlObject<GlBufferId>::CreateFrom(GlNamePool::CreateBuffer());
+            OpenGl::NamedBufferData(buffer_, capacity_bytes, GlUsage::DynamicDraw);
+        }
+        else
+        {
+            buffer_ = GlObject<GlBufferId>::CreateFrom(GlNamePool::GenBuffer());
+            OpenGl::BindBuffer(kEditTarget, buffer_);
+            OpenGl::BufferData(kEditTarget, capacity_bytes, GlUsage::DynamicDraw);
+        }
+
+        dirty_begin_ = 0;
+        dirty_end_ = instances_.size();
+    }
+
+    if (!HasChanges()) return;
+
+    const auto changed = std::span<const Instance>{instances_}.subspan(dirty_begin_, dirty_end_ - dirty_begin_);
+    if (OpenGl::HasDirectStateAccess())
+    {
+        OpenGl::NamedBufferSubData(buffer_, dirty_begin_, changed);
+    }
+    else
+    {
+        OpenGl::BindBuffer(kEditTarget, buffer_);
+        OpenGl::BufferSubData(kEditTarget, dirty_begin_, changed);
+    }
+
+    dirty_begin_ = 0;
+    dirty_end_ = 0;
+}
+
+}  // namespace klgl
@@ -0,0 +1,173 @@
+#include "klgl/rendering/resource_uploader.hpp"
+
+#include <fmt/format.h>
+
+#include "GLFW/glfw3.h"
+#include "klgl/mesh/mesh_data.hpp"
+#include "klgl/opengl/debug/annotations.hpp"
+#include "klgl/opengl/fence.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/name_pool.hpp"
+#include "klgl/opengl/open_gl_error.hpp"
+#include "klgl/texture/texture.hpp"
+#include "klgl/window.hpp"
+
+namespace klgl
+{
+
+ResourceUploader::ResourceUploader(Window& window) : ResourceUploader(window.CreateSharedContext()) {}
+
+ResourceUploader::ResourceUploader(GLFWwindow* context) : context_(context)
+{
+    thread_ = std::thread([this] { ThreadMain(); });
+}
+
+ResourceUploader::~ResourceUploader()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+
+    has_jobs_.notify_one();
+    thread_.join();
+    Window::DestroySharedContext(context_);
+}
+
+template <typename T>
+UploadHandle<T> ResourceUploader::Enqueue(std::function<T()> upload, std::function<void(T&)> finalize)
+{
+    auto state = std::make_shared<detail::UploadState<T>>();
+    state->finalize = std::move(finalize);
+
+    auto job = [state, upload = std::move(upload)]
+    {
+        ResetContextState();
+
+        try
+        {
+            state->value.emplace(upload());
+            FinishUpload();
+        }
+        catch (...)
+        {
+            state->error = std::current_exception();
+        }
+
+        // Before the result is published, so the main thread may delete the objects right away
+        ResetContextState();
+        state->ready.store(true, std::memory_order_release);
+        state->ready.notify_all();
+    };
+
+    {
+        std::lock_guard lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+
+    has_jobs_.notify_one();
+    return UploadHandle<T>(std::move(state));
+}
+
+UploadHandle<std::unique_ptr<Texture>> ResourceUploader::UploadTexture(TextureUpload upload)
+{
+    if (!upload.pixels.empty())
+    {
+        upload.pixel_format.ValidateBufferSize(upload.resolution, upload.pixels.size());
+        upload.pixel_format.EnsureCompatibleWithInternalTextureFormat(upload.format);
+    }
+
+    return Enqueue<std::unique_ptr<Texture>>(
+        [upload = std::move(upload)]
+        {
+            ScopeAnnotation annotation("Upload texture");
+            auto texture = Texture::CreateEmpty(upload.resolution, upload.format);
+            if (!upload.pixels.empty()) texture->SetPixels(upload.pixel_format, upload.pixels);
+            return texture;
+        });
+}
+
+UploadHandle<std::unique_ptr<MeshOpenGL>> ResourceUploader::UploadMesh(MeshUpload upload)
+{
+    MeshOpenGL::ValidateIndicesCountForTopology(upload.topology, upload.indices.size());
+
+    return Enqueue<std::unique_ptr<MeshOpenGL>>(
+        [upload = std::move(upload)]
+        {
+            ScopeAnnotation annotation("Upload mesh");
+            auto mesh = std::make_unique<MeshOpenGL>();
+            mesh->topology = upload.topology;
+            mesh->elements_count = upload.indices.size();
+
+            if (OpenGl::HasDirectStateAccess())
+            {
+                mesh->vbo = GlObject<GlBufferId>::CreateFrom(GlNamePool::CreateBuffer());
+                mesh->ebo = GlObject<GlBufferId>::CreateFrom(GlNamePool::CreateBuffer());
+                OpenGl::NamedBufferData(mesh->vbo, std::span{upload.vertices}, GlUsage::StaticDraw);
+                OpenGl::NamedBufferData(mesh->ebo, std::span{upload.indices}, GlUsage::StaticDraw);
+            }
+            else
+            {
+                // Element array binding is vertex array state, so both buffers go through a target without one
+                mesh->vbo = GlObject<GlBufferId>::CreateFrom(GlNamePool::GenBuffer());
+                mesh->ebo = GlObject<GlBufferId>::CreateFrom(GlNamePool::GenBuffer());
+                OpenGl::BindBuffer(GlBufferType::CopyWrite, mesh->vbo);
+                OpenGl::BufferData(GlBufferType::CopyWrite, std::span{upload.vertices}, GlUsage::StaticDraw);
+                OpenGl::BindBuffer(GlBufferType::CopyWrite, mesh->ebo);
+                OpenGl::BufferData(GlBufferType::CopyWrite, std::span{upload.indices}, GlUsage::StaticDraw);
+            }
+
+            return mesh;
+        },
+        [](std::unique_ptr<MeshOpenGL>& mesh) { mesh->CreateVertexArray(); });
+}
+
+size_t ResourceUploader::GetQueueSize() const
+{
+    std::lock_guard lock(mutex_);
+    return jobs_.size();
+}
+
+void ResourceUploader::ThreadMain()
+{
+    if (context_) glfwMakeContextCurrent(context_);
+
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(mutex_);
+            has_jobs_.wait(lock, [&] { return stop_ || !jobs_.empty(); });
+            if (jobs_.empty()) break;
+
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        job();
+    }
+
+    if (context_) glfwMakeContextCurrent(nullptr);
+}
+
+void ResourceUploader::FinishUpload()
+{
+    GlFence::Insert().Wait();
+
+    // Debug callback and per frame checks are set up for the main context only
+    if (const GlError error = OpenGl::GetError(); error != GlError::NoError)
+    {
+        throw OpenGlError(error, fmt::format("OpenGL error during resource upload: {}", error));
+    }
+}
+
+void ResourceUploader::ResetContextState() noexcept
+{
+    OpenGl::InvalidateStateCache();
+
+    // Deleted objects stay alive while they are bound in some context. Uploads bind only these targets
+    OpenGl::BindBufferNE(GlBufferType::CopyWrite, {});
+    OpenGl::BindTextureNE(GlTargetTextureType::Texture2d, {});
+}
+
+}  // namespace klgl
@@ -0,0 +1,727 @@
+#include "klgl/rendering/software_rasterizer_2d.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/texture/image.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+// Values of Painter2d::Instance::type, see painter2d.frag
+constexpr uint8_t kRectType = 0;
+constexpr uint8_t kCircleType = 1;
+constexpr uint8_t kTriangleType = 2;
+constexpr uint8_t kRectLinesType = 3;
+constexpr uint8_t kTriangleLinesType = 4;
+constexpr uint8_t kSpriteType = 5;
+
+// Vertices are snapped to 1/256 of a pixel. Edge functions are exact on this grid, so a pixel center on an edge shared
+// by two polygons is covered by one of them and translucent outlines are not blended twice where their quads meet
+constexpr int64_t kSubpixelBits = 8;
+constexpr int64_t kSubpixelOne = int64_t{1} << kSubpixelBits;
+constexpr int64_t kSubpixelHalf = kSubpixelOne / 2;
+
+// Vertices are clamped to this distance from the image in pixels, so products in edge functions fit in 64 bits
+constexpr float kGuardBand = 1 << 20;
+
+struct Point
+{
+    float x = 0;
+    float y = 0;
+};
+
+Point operator+(Point a, Point b)
+{
+    return {a.x + b.x, a.y + b.y};
+}
+
+Point operator-(Point a, Point b)
+{
+    return {a.x - b.x, a.y - b.y};
+}
+
+Point operator*(float k, Point a)
+{
+    return {k * a.x, k * a.y};
+}
+
+Point operator/(Point a, float k)
+{
+    return {a.x / k, a.y / k};
+}
+
+float Dot(Point a, Point b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+float Length(Point a)
+{
+    return std::sqrt(Dot(a, a));
+}
+
+float Sqr(float a)
+{
+    return a * a;
+}
+
+// First two rows of a 3x3 matrix whose last row is (0, 0, 1)
+struct Affine
+{
+    // Painter2d stores matrices transposed, so m(c, r) is the element of the row r and the column c
+    [[nodiscard]] static Affine FromTransposed(const Mat3f& m)
+    {
+        return {m(0, 0), m(1, 0), m(2, 0), m(0, 1), m(1, 1), m(2, 1)};
+    }
+
+    [[nodiscard]] Point operator()(Point p) const { return {m00 * p.x + m01 * p.y + m02, m10 * p.x + m11 * p.y + m12}; }
+
+    [[nodiscard]] Affine operator*(const Affine& o) const
+    {
+        return {
+            m00 * o.m00 + m01 * o.m10,
+            m00 * o.m01 + m01 * o.m11,
+            m00 * o.m02 + m01 * o.m12 + m02,
+            m10 * o.m00 + m11 * o.m10,
+            m10 * o.m01 + m11 * o.m11,
+            m10 * o.m02 + m11 * o.m12 + m12,
+        };
+    }
+
+    // Singular transforms collapse primitives to lines or points that cover no pixels, so their inverse is not used
+    [[nodiscard]] Affine Inverse() const
+    {
+        const float det = m00 * m11 - m01 * m10;
+        if (det == 0.f) return {};
+
+        const float k = 1.f / det;
+        return {
+            m11 * k,
+            -m01 * k,
+            (m01 * m12 - m11 * m02) * k,
+            -m10 * k,
+            m00 * k,
+            (m10 * m02 - m00 * m12) * k,
+        };
+    }
+
+    float m00 = 0;
+    float m01 = 0;
+    float m02 = 0;
+    float m10 = 0;
+    float m11 = 0;
+    float m12 = 0;
+};
+
+// Quads of painter2d.geom for rect outlines in world coordinates, in the order of triangle strip vertices
+std::array<std::array<Point, 4>, 4> MakeRectLinesStrips(const Affine& local_to_world, float inner, float outer)
+{
+    const std::array corners{
+        local_to_world({-1, -1}),
+        local_to_world({-1, 1}),
+        local_to_world({1, 1}),
+        local_to_world({1, -1}),
+    };
+
+    std::array<Point, 4> sides{};
+    for (size_t i = 0; i != 4; ++i)
+    {
+        const Point side = corners[(i + 1) % 4] - corners[i];
+        sides[i] = side / Length(side);
+    }
+
+    // Directions from corners to inner corners, scaled so that lines have the requested width
+    std::array<Point, 4> directions{};
+    for (size_t i = 0; i != 4; ++i)
+    {
+        const Point& prev = sides[(i + 3) % 4];
+        directions[i] = (sides[i] - prev) / std::sqrt(1 - Sqr(Dot(sides[i], prev)));
+    }
+
+    std::array<std::array<Point, 4>, 4> strips{};
+    for (size_t i = 0; i != 4; ++i)
+    {
+        const size_t j = (i + 1) % 4;
+        strips[i] = {
+            corners[i] - outer * directions[i],
+            corners[i] + inner * directions[i],
+            corners[j] - outer * directions[j],
+            corners[j] + inner * directions[j],
+        };
+    }
+
+    return strips;
+}
+
+// Quads of painter2d.geom for triangle outlines in world coordinates, in the order of triangle strip vertices
+std::array<std::array<Point, 4>, 3> MakeTriangleLinesStrips(const Affine& local_to_world, float inner, float outer)
+{
+    const Point va = local_to_world({-1, -1});
+    const Point vb = local_to_world({1, -1});
+    const Point vc = local_to_world({-1, 1});
+
+    const Point sa = vb - va;
+    const Point sb = vc - vb;
+    const Point sc = va - vc;
+
+    const float la = Length(sa);
+    const float lb = Length(sb);
+    const float lc = Length(sc);
+
+    const Point a = sa / la;
+    const Point b = sb / lb;
+    const Point c = sc / lc;
+
+    const float j = lb / std::sqrt(1 - Sqr(Dot(a, c)));
+
+    const Point a_dir = j * (a - c) / lb;
+    const Point b_dir = j * (b - a) / lc;
+    const Point c_dir = j * (c - b) / la;
+
+    const Point a_inner = va + inner * a_dir;
+    const Point b_inner = vb + inner * b_dir;
+    const Point c_inner = vc + inner * c_dir;
+    const Point a_outer = va - outer * a_dir;
+    const Point b_outer = vb - outer * b_dir;
+    const Point c_outer = vc - outer * c_dir;
+
+    return {{
+        {a_outer, b_outer, a_inner, b_inner},
+        {b_outer, c_outer, b_inner, c_inner},
+        {c_outer, a_outer, c_inner, a_inner},
+    }};
+}
+
+// Data of a primitive read by the pixel loop
+struct Primitive
+{
+    std::array<float, 4> normalized_color{};
+    Affine pixel_to_local;  // To the quad with corners (+-1, +-1) for types that read local coordinates
+    Point uv_min;
+    Point uv_max;
+    Vec4u8 color;
+    uint8_t type = 0;
+};
+
+// Triangle or convex quad. Vertices are in fixed point pixel coordinates, counter-clockwise
+struct Polygon
+{
+    std::array<int64_t, 4> x{};
+    std::array<int64_t, 4> y{};
+    size_t vertex_count = 0;
+
+    // Pixels whose centers may be covered, inclusive
+    int64_t min_x = 0;
+    int64_t min_y = 0;
+    int64_t max_x = 0;
+    int64_t max_y = 0;
+
+    uint32_t primitive = 0;
+};
+
+// Exclusive upper bounds
+struct PixelBounds
+{
+    int64_t min_x = 0;
+    int64_t min_y = 0;
+    int64_t max_x = 0;
+    int64_t max_y = 0;
+};
+
+std::array<float, 4> Normalize(const Vec4u8& color)
+{
+    constexpr float k = 1.f / 255.f;
+    return {
+        static_cast<float>(color.x()) * k,
+        static_cast<float>(color.y()) * k,
+        static_cast<float>(color.z()) * k,
+        static_cast<float>(color.w()) * k,
+    };
+}
+
+// Source color of glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA), applied to all channels including alpha
+struct BlendColor
+{
+    explicit BlendColor(const std::array<float, 4>& color)
+    {
+        // Half is added here so that conversion of the result rounds it: both terms are not negative
+        const float a = color[3];
+        for (size_t i = 0; i != 4; ++i) premultiplied[i] = color[i] * a * 255.f + 0.5f;
+        inverse_alpha = 1.f - a;
+    }
+
+    void Blend(Vec4u8& pixel) const
+    {
+        const auto channel = [&](uint8_t dst, size_t i)
+        {
+            return static_cast<uint8_t>(premultiplied[i] + static_cast<float>(dst) * inverse_alpha);
+        };
+
+        pixel = {channel(pixel.x(), 0), channel(pixel.y(), 1), channel(pixel.z(), 2), channel(pixel.w(), 3)};
+    }
+
+    // Same as Blend for each pixel. Channels are processed as plain bytes, so the compiler vectorizes the loop
+    void BlendSpan(Vec4u8* pixels, size_t count) const
+    {
+        static_assert(sizeof(Vec4u8) == 4);
+        auto* bytes = reinterpret_cast<uint8_t*>(pixels);  // NOLINT
+        for (size_t i = 0; i != count * 4; i += 4)
+        {
+            for (size_t c = 0; c != 4; ++c)
+            {
+                const float dst = static_cast<float>(bytes[i + c]);
+                bytes[i + c] = static_cast<uint8_t>(premultiplied[c] + dst * inverse_alpha);
+            }
+        }
+    }
+
+    std::array<float, 4> premultiplied{};
+    float inverse_alpha = 0;
+};
+
+Vec4u8 SampleNearest(const Image& image, Point uv)
+{
+    const auto texel = [](float coord, size_t size)
+    {
+        return std::min(static_cast<size_t>(std::max(coord * static_cast<float>(size), 0.f)), size - 1);
+    };
+
+    return image.At(texel(uv.x, image.GetWidth()), texel(uv.y, image.GetHeight()));
+}
+
+// Bounds of pixels [0, n) of a row covered by an edge whose function is e + k * step at the pixel k. Estimates in
+// floating point are corrected by exact tests, so pixels on shared edges are still covered once
+
+// First pixel where an increasing edge function is not negative
+int64_t RowBegin(int64_t e, int64_t step, double inverse_step, int64_t n)
+{
+    const double estimate = static_cast<double>(-e) * inverse_step;
+    auto k = static_cast<int64_t>(std::clamp(estimate, 0.0, static_cast<double>(n)));
+    while (k > 0 && e + (k - 1) * step >= 0) --k;
+    while (k < n && e + k * step < 0) ++k;
+    return k;
+}
+
+// Pixel after the last one where a decreasing edge function is not negative
+int64_t RowEnd(int64_t e, int64_t step, double inverse_step, int64_t n)
+{
+    const double estimate = static_cast<double>(e) * -inverse_step + 1;
+    auto k = static_cast<int64_t>(std::clamp(estimate, 0.0, static_cast<double>(n)));
+    while (k > 0 && e + (k - 1) * step < 0) --k;
+    while (k < n && e + k * step >= 0) ++k;
+    return k;
+}
+
+// Calls shade(row_pixels, x_begin, x_end, y) for each row of the tile with pixels covered by the polygon. Covered
+// pixels of a row are contiguous, so shading loops run over plain ranges without coverage tests
+template <typename ShadeFn>
+void ForEachCoveredSpan(Image& image, const Polygon& polygon, const PixelBounds& tile, ShadeFn&& shade)
+{
+    const int64_t x0 = std::max(polygon.min_x, tile.min_x);
+    const int64_t y0 = std::max(polygon.min_y, tile.min_y);
+    const int64_t x1 = std::min(polygon.max_x + 1, tile.max_x);
+    const int64_t y1 = std::min(polygon.max_y + 1, tile.max_y);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    // Edge functions at the center of the first pixel of a row and their increments per pixel. A pixel is covered
+    // when all of them are not negative
+    const int64_t px = x0 * kSubpixelOne + kSubpixelHalf;
+    const int64_t py = y0 * kSubpixelOne + kSubpixelHalf;
+    const size_t edges_count = polygon.vertex_count;
+    std::array<int64_t, 4> row{};
+    std::array<int64_t, 4> step_x{};
+    std::array<int64_t, 4> step_y{};
+    std::array<double, 4> inverse_step_x{};
+    for (size_t i = 0; i != edges_count; ++i)
+    {
+        const size_t j = (i + 1) % edges_count;
+        const int64_t dx = polygon.x[j] - polygon.x[i];
+        const int64_t dy = polygon.y[j] - polygon.y[i];
+
+        // Top-left rule: an edge shared by two polygons goes in opposite directions in them, so it is inclusive for
+        // one polygon only
+        const bool inclusive = dy < 0 || (dy == 0 && dx < 0);
+        row[i] = dx * (py - polygon.y[i]) - dy * (px - polygon.x[i]) - (inclusive ? 0 : 1);
+        step_x[i] = -dy * kSubpixelOne;
+        step_y[i] = dx * kSubpixelOne;
+        inverse_step_x[i] = step_x[i] != 0 ? 1.0 / static_cast<double>(step_x[i]) : 0.0;
+    }
+
+    for (int64_t y = y0; y != y1; ++y)
+    {
+        // Each edge function is linear along the row, so it bounds covered pixels from one side
+        const int64_t n = x1 - x0;
+        int64_t begin = 0;
+        int64_t end = n;
+        for (size_t i = 0; i != edges_count; ++i)
+        {
+            if (step_x[i] > 0)
+            {
+                begin = std::max(begin, RowBegin(row[i], step_x[i], inverse_step_x[i], n));
+            }
+            else if (step_x[i] < 0)
+            {
+                end = std::min(end, RowEnd(row[i], step_x[i], inverse_step_x[i], n));
+            }
+            else if (row[i] < 0)
+            {
+                end = 0;
+            }
+
+            row[i] += step_y[i];
+        }
+
+        if (begin < end) shade(&image.At(0, static_cast<size_t>(y)), x0 + begin, x0 + end, y);
+    }
+}
+
+// Adapts shade(pixel, pixel_center) to ForEachCoveredSpan
+template <typename ShadeFn>
+auto PerPixel(ShadeFn shade)
+{
+    return [shade](Vec4u8* pixels, int64_t begin, int64_t end, int64_t y)
+    {
+        const float center_y = static_cast<float>(y) + 0.5f;
+        for (int64_t x = begin; x != end; ++x) shade(pixels[x], Point{static_cast<float>(x) + 0.5f, center_y});
+    };
+}
+}  // namespace
+
+class SoftwareRasterizer2d::Impl
+{
+public:
+    explicit Impl(const Settings& settings) : settings_(settings)
+    {
+        ErrorHandling::Ensure(settings_.tile_size != 0, "Tile size of the rasterizer must not be zero");
+        if (settings_.threads_count == 0)
+        {
+            settings_.threads_count = std::max(size_t{1}, size_t{std::thread::hardware_concurrency()});
+        }
+    }
+
+    void Draw(Image& image, std::span<const Painter2d::Instance> instances)
+    {
+        width_ = static_cast<int64_t>(image.GetWidth());
+        height_ = static_cast<int64_t>(image.GetHeight());
+        if (width_ == 0 || height_ == 0) return;
+
+        const size_t tile_size = settings_.tile_size;
+        tiles_x_ = (image.GetWidth() + tile_size - 1) / tile_size;
+        const size_t tiles_y = (image.GetHeight() + tile_size - 1) / tile_size;
+        bins_.resize(tiles_x_ * tiles_y);
+        for (auto& bin : bins_) bin.clear();
+        primitives_.clear();
+        polygons_.clear();
+
+        // Binning is sequential: it is cheap compared to rasterization and keeps primitives ordered in every bin
+        const float half_width = static_cast<float>(width_) / 2;
+        const float half_height = static_cast<float>(height_) / 2;
+        const Affine clip_to_pixel{half_width, 0, half_width, 0, half_height, half_height};
+        const Affine world_to_pixel = clip_to_pixel * Affine::FromTransposed(view_matrix_);
+        for (const auto& instance : instances) AddPrimitive(instance, world_to_pixel);
+        if (polygons_.empty()) return;
+
+        // Tiles are taken one by one, so threads that got cheap tiles take more of them
+        std::atomic<size_t> next_tile = 0;
+        const auto rasterize_tiles = [&]
+        {
+            for (size_t tile = next_tile++; tile < bins_.size(); tile = next_tile++)
+            {
+                RasterizeTile(image, tile);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        const size_t threads_count = std::min(settings_.threads_count, bins_.size());
+        threads.reserve(threads_count - 1);
+        for (size_t i = 1; i < threads_count; ++i) threads.emplace_back(rasterize_tiles);
+        rasterize_tiles();
+        for (auto& thread : threads) thread.join();
+    }
+
+private:
+    void AddPrimitive(const Painter2d::Instance& instance, const Affine& world_to_pixel)
+    {
+        // Fully transparent primitives do not change the image. Removed slots of layers are transparent too
+        if (instance.color.w() == 0) return;
+        if (instance.type == kSpriteType && (!atlas_ || atlas_->GetPixels().empty())) return;
+
+        const Affine local_to_world = Affine::FromTransposed(instance.transform);
+        const Affine local_to_pixel = world_to_pixel * local_to_world;
+
+        constexpr float kUvScale = 1.f / 65535.f;
+        primitives_.push_back({
+            .normalized_color = Normalize(instance.color),
+            .pixel_to_local = local_to_pixel.Inverse(),
+            .uv_min = {static_cast<float>(instance.uv.x()) * kUvScale, static_cast<float>(instance.uv.y()) * kUvScale},
+            .uv_max = {static_cast<float>(instance.uv.z()) * kUvScale, static_cast<float>(instance.uv.w()) * kUvScale},
+            .color = instance.color,
+            .type = instance.type,
+        });
+
+        const auto add_world_strips = [&](const auto& strips)
+        {
+            for (const auto& strip : strips) AddStrip(world_to_pixel, strip);
+        };
+
+        const float inner = instance.params.x();
+        const float outer = instance.params.y();
+        switch (instance.type)
+        {
+        case kTriangleType:
+            AddPolygon(std::array{local_to_pixel({-1, -1}), local_to_pixel({1, -1}), local_to_pixel({-1, 1})});
+            break;
+
+        case kRectLinesType:
+            add_world_strips(MakeRectLinesStrips(local_to_world, inner, outer));
+            break;
+
+        case kTriangleLinesType:
+            add_world_strips(MakeTriangleLinesStrips(local_to_world, inner, outer));
+            break;
+
+        default:
+            AddQuad(std::array{
+                local_to_pixel({-1, -1}),
+                local_to_pixel({1, -1}),
+                local_to_pixel({1, 1}),
+                local_to_pixel({-1, 1}),
+            });
+            break;
+        }
+    }
+
+    // Triangles of a triangle strip with four vertices. Outline strips are not always convex, so they are not merged
+    void AddStrip(const Affine& to_pixel, const std::array<Point, 4>& strip)
+    {
+        const std::array<Point, 4> v{to_pixel(strip[0]), to_pixel(strip[1]), to_pixel(strip[2]), to_pixel(strip[3])};
+        AddPolygon(std::array{v[0], v[1], v[2]});
+        AddPolygon(std::array{v[2], v[1], v[3]});
+    }
+
+    // Parallelogram. Covers the same pixels as its two triangles, but rows are walked once
+    void AddQuad(const std::array<Point, 4>& corners)
+    {
+        if (!AddPolygon(corners))
+        {
+            // Snapping to the subpixel grid made a thin quad concave
+            AddPolygon(std::array{corners[0], corners[1], corners[3]});
+            AddPolygon(std::array{corners[3], corners[1], corners[2]});
+        }
+    }
+
+    // Adds a convex polygon to bins of tiles it overlaps. Belongs to the last added primitive. Returns false only if
+    // the polygon is concave after snapping
+    bool AddPolygon(std::span<const Point> points)
+    {
+        const auto to_fixed = [](float v)
+        {
+            return std::llround(std::clamp(v, -kGuardBand, kGuardBand) * static_cast<float>(kSubpixelOne));
+        };
+
+        Polygon polygon{.vertex_count = points.size(), .primitive = static_cast<uint32_t>(primitives_.size() - 1)};
+        auto& x = polygon.x;
+        auto& y = polygon.y;
+        const size_t n = points.size();
+        for (size_t i = 0; i != n; ++i)
+        {
+            // Outlines of degenerate shapes get NaN from normalization like in the geometry shader
+            if (!std::isfinite(points[i].x) || !std::isfinite(points[i].y)) return true;
+
+            x[i] = to_fixed(points[i].x);
+            y[i] = to_fixed(points[i].y);
+        }
+
+        // Cross products of adjacent edges have the sign of the area for convex polygons
+        int64_t area = 0;
+        bool has_positive = false;
+        bool has_negative = false;
+        for (size_t i = 0; i != n; ++i)
+        {
+            const size_t j = (i + 1) % n;
+            const size_t k = (i + 2) % n;
+            area += x[i] * y[j] - x[j] * y[i];
+            const int64_t cross = (x[j] - x[i]) * (y[k] - y[j]) - (y[j] - y[i]) * (x[k] - x[j]);
+            has_positive |= cross > 0;
+            has_negative |= cross < 0;
+        }
+
+        if (has_positive && has_negative) return false;
+        if (area == 0) return true;
+        if (area < 0)
+        {
+            std::reverse(x.begin(), x.begin() + static_cast<std::ptrdiff_t>(n));
+            std::reverse(y.begin(), y.begin() + static_cast<std::ptrdiff_t>(n));
+        }
+
+        // First and last pixels whose centers are inside of the bounding box
+        const auto [min_x, max_x] = std::minmax_element(x.begin(), x.begin() + static_cast<std::ptrdiff_t>(n));
+        const auto [min_y, max_y] = std::minmax_element(y.begin(), y.begin() + static_cast<std::ptrdiff_t>(n));
+        polygon.min_x = std::max<int64_t>((*min_x - kSubpixelHalf + kSubpixelOne - 1) >> kSubpixelBits, 0);
+        polygon.min_y = std::max<int64_t>((*min_y - kSubpixelHalf + kSubpixelOne - 1) >> kSubpixelBits, 0);
+        polygon.max_x = std::min<int64_t>((*max_x - kSubpixelHalf) >> kSubpixelBits, width_ - 1);
+        polygon.max_y = std::min<int64_t>((*max_y - kSubpixelHalf) >> kSubpixelBits, height_ - 1);
+        if (polygon.min_x > polygon.max_x || polygon.min_y > polygon.max_y) return true;
+
+        const auto index = static_cast<uint32_t>(polygons_.size());
+        polygons_.push_back(polygon);
+
+        const auto tile_size = static_cast<int64_t>(settings_.tile_size);
+        for (int64_t tile_y = polygon.min_y / tile_size; tile_y <= polygon.max_y / tile_size; ++tile_y)
+        {
+            for (int64_t tile_x = polygon.min_x / tile_size; tile_x <= polygon.max_x / tile_size; ++tile_x)
+            {
+                bins_[static_cast<size_t>(tile_y) * tiles_x_ + static_cast<size_t>(tile_x)].push_back(index);
+            }
+        }
+
+        return true;
+    }
+
+    void RasterizeTile(Image& image, size_t tile) const
+    {
+        const auto tile_size = static_cast<int64_t>(settings_.tile_size);
+        const auto tile_x = static_cast<int64_t>(tile % tiles_x_);
+        const auto tile_y = static_cast<int64_t>(tile / tiles_x_);
+        const PixelBounds bounds{
+            .min_x = tile_x * tile_size,
+            .min_y = tile_y * tile_size,
+            .max_x = std::min((tile_x + 1) * tile_size, width_),
+            .max_y = std::min((tile_y + 1) * tile_size, height_),
+        };
+
+        for (const uint32_t index : bins_[tile])
+        {
+            RasterizePolygon(image, polygons_[index], bounds);
+        }
+    }
+
+    // Fragment shader
+    void RasterizePolygon(Image& image, const Polygon& polygon, const PixelBounds& tile) const
+    {
+        const Primitive& primitive = primitives_[polygon.primitive];
+        const auto& color = primitive.normalized_color;
+        const BlendColor blend(color);
+        const Affine& to_local = primitive.pixel_to_local;
+
+        switch (primitive.type)
+        {
+        case kRectType:
+        case kTriangleType:
+        case kRectLinesType:
+        case kTriangleLinesType:
+            if (primitive.color.w() == 255)
+            {
+                ForEachCoveredSpan(
+                    image,
+                    polygon,
+                    tile,
+                    [&](Vec4u8* pixels, int64_t begin, int64_t end, int64_t)
+                    { std::fill(pixels + begin, pixels + end, primitive.color); });
+            }
+            else
+            {
+                ForEachCoveredSpan(
+                    image,
+                    polygon,
+                    tile,
+                    [&](Vec4u8* pixels, int64_t begin, int64_t end, int64_t)
+                    { blend.BlendSpan(pixels + begin, static_cast<size_t>(end - begin)); });
+            }
+            break;
+
+        case kCircleType:
+            ForEachCoveredSpan(
+                image,
+                polygon,
+                tile,
+                PerPixel(
+                    [&](Vec4u8& pixel, Point center)
+                    {
+                        const Point cc = to_local(center);
+                        if (Dot(cc, cc) <= 1.f) blend.Blend(pixel);
+                    }));
+            break;
+
+        case kSpriteType:
+            ForEachCoveredSpan(
+                image,
+                polygon,
+                tile,
+                PerPixel(
+                    [&](Vec4u8& pixel, Point center)
+                    {
+                        const Point tex_coord = (to_local(center) + Point{1, 1}) / 2;
+                        const Point uv{
+                            std::lerp(primitive.uv_min.x, primitive.uv_max.x, tex_coord.x),
+                            std::lerp(primitive.uv_min.y, primitive.uv_max.y, tex_coord.y),
+                        };
+
+                        const auto t = Normalize(SampleNearest(*atlas_, uv));
+                        BlendColor(std::array{t[0] * color[0], t[1] * color[1], t[2] * color[2], t[3] * color[3]})
+                            .Blend(pixel);
+                    }));
+            break;
+
+        // Yellow grid pattern the shader draws for unknown types
+        default:
+            ForEachCoveredSpan(
+                image,
+                polygon,
+                tile,
+                PerPixel(
+                    [&](Vec4u8& pixel, Point center)
+                    {
+                        const Point tex_coord = (to_local(center) + Point{1, 1}) / 2;
+                        const int k = static_cast<int>(tex_coord.x * 10) + static_cast<int>(tex_coord.y * 10);
+                        if (k % 2 == 0) pixel = {255, 255, 0, 255};
+                    }));
+            break;
+        }
+    }
+
+public:
+    Mat3f view_matrix_ = Mat3f::Identity();
+    const Image* atlas_ = nullptr;
+
+private:
+    Settings settings_;
+    int64_t width_ = 0;
+    int64_t height_ = 0;
+    size_t tiles_x_ = 0;
+    std::vector<Primitive> primitives_;
+    std::vector<Polygon> polygons_;
+    std::vector<std::vector<uint32_t>> bins_;
+};
+
+SoftwareRasterizer2d::SoftwareRasterizer2d() : SoftwareRasterizer2d(Settings{}) {}
+
+SoftwareRasterizer2d::SoftwareRasterizer2d(const Settings& settings) : self(std::make_unique<Impl>(settings)) {}
+
+SoftwareRasterizer2d::~SoftwareRasterizer2d() = default;
+
+void SoftwareRasterizer2d::SetViewMatrix(const Mat3f& view_matrix)
+{
+    self->view_matrix_ = view_matrix;
+}
+
+void SoftwareRasterizer2d::SetAtlasImage(const Image* atlas)
+{
+    self->atlas_ = atlas;
+}
+
+void SoftwareRasterizer2d::Draw(Image& image, std::span<const Painter2d::Instance> instances)
+{
+    self->Draw(image, instances);
+}
+
+}  // namespace klgl
@@ -0,0 +1,42 @@
+#include "shader/separable_stage_cache.hpp"
+
+#include <fmt/format.h>
+
+#include "klgl/opengl/detail/maps/to_gl_value/shader_type.hpp"
+
+namespace klgl
+{
+
+SeparableStageCache& SeparableStageCache::Get()
+{
+    static SeparableStageCache instance;
+    return instance;
+}
+
+std::shared_ptr<SeparableStage> SeparableStageCache::Find(GlShaderType type, std::string_view source)
+{
+    auto it = stages_.find(MakeKey(type, source));
+    if (it == stages_.end()) return nullptr;
+
+    auto stage = it->second.lock();
+    if (!stage)
+    {
+        stages_.erase(it);
+    }
+
+    return stage;
+}
+
+void SeparableStageCache::Add(std::string_view source, const std::shared_ptr<SeparableStage>& stage)
+{
+    // Forget programs that are not used by any shader anymore
+    std::erase_if(stages_, [](const auto& key_and_stage) { return key_and_stage.second.expired(); });
+    stages_[MakeKey(stage->type, source)] = stage;
+}
+
+std::string SeparableStageCache::MakeKey(GlShaderType type, std::string_view source)
+{
+    return fmt::format("{}\n{}", ToGlValue(type), source);
+}
+
+}  // namespace klgl
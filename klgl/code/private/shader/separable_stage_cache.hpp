@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "ankerl/unordered_dense.h"
+#include "klgl/opengl/enums.hpp"
+#include "klgl/opengl/object.hpp"
+#include "klgl/opengl/program_info.hpp"
+
+namespace klgl
+{
+
+// Single shader stage linked as a separable program
+struct SeparableStage
+{
+    GlShaderType type{};
+    GlObject<GlProgramId> program;
+    GlProgramInfo info;
+
+    // Stage programs are shared between shaders, so uniform values stored in the program may belong to another
+    // shader. This is the id of the shader that sent its values to the program last.
+    uint64_t uniforms_owner = 0;
+};
+
+// Keeps separable stage programs that are alive by the full source code that was used to compile them.
+// Shaders that produce exactly the same code for some stage share the program for that stage.
+class SeparableStageCache
+{
+public:
+    static SeparableStageCache& Get();
+
+    [[nodiscard]] std::shared_ptr<SeparableStage> Find(GlShaderType type, std::string_view source);
+    void Add(std::string_view source, const std::shared_ptr<SeparableStage>& stage);
+
+private:
+    [[nodiscard]] static std::string MakeKey(GlShaderType type, std::string_view source);
+
+private:
+    ankerl::unordered_dense::map<std::string, std::weak_ptr<SeparableStage>> stages_;
+};
+
+}  // namespace klgl
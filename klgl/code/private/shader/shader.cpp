@@ -4,9 +4,13 @@
 #include <fmt/std.h>
 #include <imgui.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
 #include <filesystem>
+#include <memory>
 #include <string_view>
 #include <tl/expected.hpp>
 #include <vector>
@@ -15,7 +19,6 @@
 #include "fmt/core.h"
 #include "fmt/std.h"  // IWYU pragma: keep
 #include "klgl/error_handling.hpp"
-#include "klgl/filesystem/filesystem.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/uniform_type.hpp"
 #include "klgl/opengl/gl_api.hpp"
 #include "klgl/opengl/program_info.hpp"
@@ -23,12 +26,14 @@
 #include "klgl/shader/sampler_uniform.hpp"
 #include "klgl/shader/shader.hpp"
 #include "klgl/shader/shader_define.hpp"
+#include "klgl/shader/shader_source_cache.hpp"
 #include "klgl/shader/shader_uniform.hpp"
 #include "klgl/template/constexpr_string_hash.hpp"
 #include "klgl/texture/texture.hpp"
 #include "klgl/ui/imgui_helpers.hpp"
 #include "klgl/ui/type_id_widget_minimal.hpp"
 #include "nlohmann/json.hpp"
+#include "shader/separable_stage_cache.hpp"
 
 namespace klgl
 {
@@ -95,9 +100,91 @@ struct Shader::Internal
 
         return false;
     }
+
+    // Compiles the code in the buffer and throws with source file numbers legend in case of error
+    [[nodiscard]] static GlObject<GlShaderId> CompileShader(
+        GlShaderType type,
+        std::string_view code,
+        const std::filesystem::path& path,
+        std::span<const std::filesystem::path> source_files)
+    {
+        auto shader = GlObject<GlShaderId>::CreateFrom(OpenGl::CreateShader(type));
+        std::string compile_log;
+        [[unlikely]] if (!TryCompileShader(shader, std::span{&code, 1}, &compile_log))
+        {
+            std::string source_files_legend;
+            for (size_t index = 0; index != source_files.size(); ++index)
+            {
+                fmt::format_to(std::back_inserter(source_files_legend), "\n    {}: {}", index, source_files[index]);
+            }
+
+            throw klgl::ErrorHandling::RuntimeErrorWithMessage(
+                "failed to compile shader {} log:\n{}\nSource string numbers:{}",
+                path,
+                compile_log,
+                source_files_legend);
+        }
+
+        return shader;
+    }
+
+    [[nodiscard]] static std::shared_ptr<SeparableStage> CreateSeparableStage(
+        GlShaderType type,
+        std::string_view code,
+        const std::filesystem::path& path,
+        std::span<const std::filesystem::path> source_files)
+    {
+        auto shader = CompileShader(type, code, path, source_files);
+
+        auto stage = std::make_shared<SeparableStage>();
+        stage->type = type;
+        stage->program = GlObject<GlProgramId>::CreateFrom(OpenGl::CreateProgram());
+        OpenGl::SetProgramSeparable(stage->program, true);
+
+        std::string link_log;
+        [[unlikely]] if (!TryLinkShaderProgram(stage->program, std::span{&shader, 1}, &link_log))
+        {
+            throw klgl::ErrorHandling::RuntimeErrorWithMessage("Failed to link separable stage {}. {}", path, link_log);
+        }
+
+        stage->info.FetchUniforms(stage->program);
+        stage->info.FetchUniformBlocks(stage->program);
+        stage->info.FetchStorageBlocks(stage->program);
+        stage->info.FetchVertexAttributes(stage->program);
+        return stage;
+    }
+
+    [[nodiscard]] static bool IsSeparableSupported()
+    {
+        static const bool supported = []
+        {
+            if (GLAD_GL_VERSION_4_1) return true;
+            fmt::print("OpenGL 4.1 is required for separable shader stages. Monolithic programs are used instead\n");
+            return false;
+        }();
+        return supported;
+    }
+
+    // Calls the function for every program that has uniforms of this shader: the monolithic program or every
+    // program of the separable pipeline
+    template <typename Self, typename F>
+    static void ForEachProgram(Self& self, F&& f)
+    {
+        if (self.stages_.empty())
+        {
+            f(size_t{0}, self.program_.GetId(), self.info_);
+            return;
+        }
+
+        for (size_t stage_index = 0; stage_index != self.stages_.size(); ++stage_index)
+        {
+            const SeparableStage& stage = *self.stages_[stage_index];
+            f(stage_index, stage.program.GetId(), stage.info);
+        }
+    }
 };
 
-Shader::Shader(std::filesystem::path path) : path_(std::move(path))
+Shader::Shader(std::filesystem::path path) : path_(std::move(path)), instance_id_(GenerateInstanceId())
 {
     std::string compile_buffer;
     Compile(compile_buffer);
@@ -105,9 +192,23 @@ Shader::Shader(std::filesystem::path path) : path_(std::move(path))
 
 Shader::~Shader() = default;
 
+uint64_t Shader::GenerateInstanceId()
+{
+    static std::atomic<uint64_t> next_id = 1;
+    return next_id++;
+}
+
 void Shader::Use()
 {
-    OpenGl::UseProgram(program_);
+    if (pipeline_.IsValid())
+    {
+        OpenGl::UseProgram({});
+        OpenGl::BindProgramPipeline(pipeline_);
+    }
+    else
+    {
+        OpenGl::UseProgram(program_);
+    }
 }
 
 std::optional<uint32_t> Shader::FindUniformLocation(const char* name) const noexcept
@@ -151,16 +252,18 @@ void Shader::Compile(std::string& buffer)
     if (!need_recompile_) return;
 
     program_ = {};
+    pipeline_ = {};
+    stages_.clear();
+
+    auto& source_cache = ShaderSourceCache::Get();
+    source_cache.SetRootDirectory(shaders_dir_);
 
     auto shader_dir = shaders_dir_ / path_;
 
     std::optional<std::filesystem::path> json_file_path;
     ass::EnumMap<GlShaderType, std::filesystem::path> type_to_path;
-    for (const auto& entry : std::filesystem::directory_iterator(shader_dir))
+    for (const auto& path : source_cache.GetDirectoryFiles(shader_dir))
     {
-        if (entry.is_directory()) continue;
-
-        const auto& path = entry.path();
         const std::string ext = path.extension().string();
 
         if (ext == ".json")
@@ -194,17 +297,18 @@ void Shader::Compile(std::string& buffer)
         type_to_path.Emplace(type, path);
     }
 
-    // Reuse the buffer to read JSON file
     std::optional<nlohmann::json> maybe_config;
     if (json_file_path)
     {
-        Filesystem::ReadFile(json_file_path.value(), buffer);
-        maybe_config = nlohmann::json::parse(buffer);
-        buffer.clear();
+        maybe_config = nlohmann::json::parse(source_cache.GetFileContent(json_file_path.value()));
     }
 
+    const bool separable =
+        maybe_config && maybe_config->value("separable", false) && Internal::IsSeparableSupported();
+
     size_t num_compiled = 0;
     std::array<GlObject<GlShaderId>, magic_enum::enum_count<GlShaderType>()> shaders{};
+    std::vector<std::shared_ptr<SeparableStage>> stages;
 
     {
         std::string_view version = "330 core";
@@ -214,6 +318,7 @@ void Shader::Compile(std::string& buffer)
             const auto& version_str = value.get_ref<const nlohmann::json::string_t&>();
             version = version_str;
         }
+        buffer.clear();
         fmt::format_to(std::back_inserter(buffer), "#version {}\n\n", version);
     }
 
@@ -228,6 +333,12 @@ void Shader::Compile(std::string& buffer)
             }
         }
 
+        define_indices_.reserve(defines_.size());
+        for (size_t index = 0; index != defines_.size(); ++index)
+        {
+            define_indices_.emplace(defines_[index].name.GetId(), static_cast<uint32_t>(index));
+        }
+
         definitions_initialized_ = true;
     }
 
@@ -236,48 +347,70 @@ void Shader::Compile(std::string& buffer)
         def.GenDefine(buffer);
     }
 
-    // Resets the line number to display correct line number in logs if there is an error
-    fmt::format_to(std::back_inserter(buffer), "#line 1\n");
-
     const size_t common_code_length = buffer.size();
+    std::vector<std::filesystem::path> source_files;
+
+    auto& stage_cache = SeparableStageCache::Get();
 
     for (GlShaderType type : ass::EnumSet<GlShaderType>::Full())
     {
         if (!type_to_path.Contains(type)) continue;
 
-        shaders[num_compiled] = GlObject<GlShaderId>::CreateFrom(OpenGl::CreateShader(type));
-        const auto& shader = shaders[num_compiled];
-        num_compiled++;
-
+        // Expands includes and emits #line directives to display correct file and line in logs
         const auto& path = type_to_path.Get(type);
-        Filesystem::AppendFileContentToBuffer(path, buffer);
+        source_files.clear();
+        source_cache.AppendPreprocessed(path, buffer, source_files);
 
-        const std::string_view code_view = buffer;
-        std::string compile_log;
-        [[unlikely]] if (!Internal::TryCompileShader(shader, std::span{&code_view, 1}, &compile_log))
+        if (separable)
         {
-            throw klgl::ErrorHandling::RuntimeErrorWithMessage(
-                "failed to compile shader {} log:\n{}",
-                path,
-                compile_log);
+            // Stages with exactly the same code are compiled and linked only once
+            auto stage = stage_cache.Find(type, buffer);
+            if (!stage)
+            {
+                stage = Internal::CreateSeparableStage(type, buffer, path, source_files);
+                stage_cache.Add(buffer, stage);
+            }
+
+            stages.push_back(std::move(stage));
+        }
+        else
+        {
+            shaders[num_compiled++] = Internal::CompileShader(type, buffer, path, source_files);
         }
 
         // remove file content to reuse the code shared across all types of shaders
         buffer.resize(common_code_length);
     }
 
-    auto program = GlObject<GlProgramId>::CreateFrom(OpenGl::CreateProgram());
+    if (separable)
+    {
+        auto pipeline = GlObject<GlProgramPipelineId>::CreateFrom(OpenGl::GenProgramPipeline());
+        for (const auto& stage : stages)
+        {
+            OpenGl::UseProgramStage(pipeline, stage->type, stage->program);
+        }
 
-    std::string link_log;
-    [[unlikely]] if (!Internal::TryLinkShaderProgram(program, std::span(shaders).subspan(0, num_compiled), &link_log))
+        pipeline_ = std::move(pipeline);
+        stages_ = std::move(stages);
+    }
+    else
     {
-        throw klgl::ErrorHandling::RuntimeErrorWithMessage("Failed to link shader {}. {}", path_, link_log);
+        auto program = GlObject<GlProgramId>::CreateFrom(OpenGl::CreateProgram());
+
+        const auto compiled_shaders = std::span(shaders).subspan(0, num_compiled);
+        std::string link_log;
+        [[unlikely]] if (!Internal::TryLinkShaderProgram(program, compiled_shaders, &link_log))
+        {
+            throw klgl::ErrorHandling::RuntimeErrorWithMessage("Failed to link shader {}. {}", path_, link_log);
+        }
+
+        program_ = std::move(program);
     }
 
-    program_ = std::move(program);
     need_recompile_ = false;
     UpdateInfo();
     UpdateUniforms();
+    ApplyUniformBlockBindings();
 }
 
 void Shader::DrawDetails()
@@ -320,6 +453,52 @@ void Shader::DrawDetails()
             ImGui::TreePop();
         }
 
+        if (!info_.uniform_blocks.empty() && ImGui::TreeNode("Uniform blocks"))
+        {
+            for (const auto& block : info_.uniform_blocks)
+            {
+                if (ImGui::TreeNode(block.name.data()))
+                {
+                    ImGuiHelper::FormattedText(buffer, "Index: {}", block.index);
+                    ImGuiHelper::FormattedText(buffer, "Binding: {}", block.binding);
+                    ImGuiHelper::FormattedText(buffer, "Size: {}", block.data_size);
+                    for (const auto& member : block.members)
+                    {
+                        ImGuiHelper::FormattedText(buffer, "{} {}: offset {}", member.type, member.name, member.offset);
+                    }
+                    ImGui::TreePop();
+                }
+            }
+
+            ImGui::TreePop();
+        }
+
+        if (!info_.storage_blocks.empty() && ImGui::TreeNode("Storage blocks"))
+        {
+            for (const auto& block : info_.storage_blocks)
+            {
+                if (ImGui::TreeNode(block.name.data()))
+                {
+                    ImGuiHelper::FormattedText(buffer, "Index: {}", block.index);
+                    ImGuiHelper::FormattedText(buffer, "Binding: {}", block.binding);
+                    ImGuiHelper::FormattedText(buffer, "Size: {}", block.data_size);
+                    for (const auto& member : block.members)
+                    {
+                        ImGuiHelper::FormattedText(
+                            buffer,
+                            "{} {}: offset {}, stride {}",
+                            member.type,
+                            member.name,
+                            member.offset,
+                            member.top_level_array_stride);
+                    }
+                    ImGui::TreePop();
+                }
+            }
+
+            ImGui::TreePop();
+        }
+
         ImGui::TreePop();
     }
 
@@ -338,37 +517,57 @@ void Shader::DrawDetails()
         ImGui::TreePop();
     }
 
+    if (!stages_.empty())
+    {
+        ImGuiHelper::FormattedText(buffer, "Separable stages: {}", stages_.size());
+    }
+
+    if (ImGui::Button("Reload sources"))
+    {
+        ShaderSourceCache::Get().Revalidate();
+        need_recompile_ = true;
+    }
+
     constexpr size_t stack_val_bytes = 64;
     std::array<uint64_t, stack_val_bytes / 8> stack_val_arr{};
 
     if (ImGui::TreeNode("Dynamic Variables"))
     {
-        for (ShaderUniform& uniform : uniforms_)
+        std::string element_name;
+        for (size_t index = 0; index != uniforms_.size(); ++index)
         {
-            auto type_info = cppreflection::GetTypeRegistry()->FindType(uniform.GetTypeGUID());
+            const ShaderUniform& uniform = uniforms_[index];
             if (uniform.GetTypeGUID() == cppreflection::GetStaticTypeGUID<SamplerUniform>())
             {
                 continue;
             }
 
-            type_info->GetSpecialMembers().copyConstructor(
-                stack_val_arr.data(),  // NOLINT
-                uniform.GetValue().data());
-            assert(stack_val_bytes >= type_info->GetInstanceSize());
-
-            std::span<uint8_t> val_view(
-                reinterpret_cast<uint8_t*>(stack_val_arr.data()),  // NOLINT
-                type_info->GetInstanceSize());
+            // Uniforms with the same name in other separable stages share the value
+            if (FindUniformIndex(uniform.GetName()) != index)
+            {
+                continue;
+            }
 
-            const bool value_changed =
-                SimpleTypeWidget(uniform.GetTypeGUID(), uniform.GetName().GetView(), val_view.data());
+            const size_t element_size = uniform.GetElementSize();
+            assert(stack_val_bytes >= element_size);
+            const std::span<const uint8_t> value = GetUniformValueView(index);
+            std::span<uint8_t> val_view(reinterpret_cast<uint8_t*>(stack_val_arr.data()), element_size);  // NOLINT
 
-            if (value_changed)
+            for (size_t element_index = 0; element_index != uniform.GetCount(); ++element_index)
             {
-                uniform.SetValue(val_view);
-            }
+                std::ranges::copy(value.subspan(element_index * element_size, element_size), val_view.begin());
 
-            type_info->GetSpecialMembers().destructor(val_view.data());
+                element_name = uniform.GetNameView();
+                if (uniform.GetCount() != 1)
+                {
+                    fmt::format_to(std::back_inserter(element_name), "[{}]", element_index);
+                }
+
+                if (SimpleTypeWidget(uniform.GetTypeGUID(), element_name, val_view.data()))
+                {
+                    SetUniformValue(index, val_view, element_index);
+                }
+            }
         }
         ImGui::TreePop();
     }
@@ -414,17 +613,12 @@ void Shader::SetDefineValue(DefineHandle& handle, edt::GUID type_guid, std::span
 std::optional<DefineHandle> Shader::FindDefine(Name name) const noexcept
 {
     std::optional<DefineHandle> result;
-    for (size_t index = 0; index < defines_.size(); ++index)
+    if (auto it = define_indices_.find(name.GetId()); it != define_indices_.end())
     {
-        const ShaderDefine& define = defines_[index];
-        if (define.name == name)
-        {
-            DefineHandle h;
-            h.name = name;
-            h.index = static_cast<uint32_t>(index);
-            result = h;
-            break;
-        }
+        DefineHandle h;
+        h.name = name;
+        h.index = it->second;
+        result = h;
     }
 
     return result;
@@ -443,22 +637,29 @@ DefineHandle Shader::GetDefine(Name name) const
 std::optional<UniformHandle> Shader::FindUniform(Name name) const noexcept
 {
     std::optional<UniformHandle> result;
-    for (size_t index = 0; index < uniforms_.size(); ++index)
+    if (auto it = uniform_slots_.find(name.GetId()); it != uniform_slots_.end())
     {
-        const ShaderUniform& uniform = uniforms_[index];
-        if (uniform.GetName() == name)
+        const uint32_t slot = it->second;
+        if (uniform_slot_to_index_[slot] != kInactiveUniformSlot)
         {
-            UniformHandle h;
-            h.name = name;
-            h.index = static_cast<uint32_t>(index);
-            result = h;
-            break;
+            result = UniformHandle(slot, name);
         }
     }
 
     return result;
 }
 
+std::optional<size_t> Shader::FindUniformIndex(Name name) const noexcept
+{
+    std::optional<size_t> result;
+    if (auto maybe_handle = FindUniform(name))
+    {
+        result = uniform_slot_to_index_[maybe_handle->index];
+    }
+
+    return result;
+}
+
 UniformHandle Shader::GetUniform(Name name) const
 {
     [[likely]] if (auto maybe_handle = FindUniform(name); maybe_handle)
@@ -471,29 +672,59 @@ UniformHandle Shader::GetUniform(Name name) const
 
 ShaderUniform& Shader::GetUniform(UniformHandle& handle)
 {
-    UpdateUniformHandle(handle);
-    return uniforms_[handle.index];
+    return uniforms_[ResolveUniformIndex(handle)];
 }
 
 const ShaderUniform& Shader::GetUniform(UniformHandle& handle) const
 {
-    UpdateUniformHandle(handle);
-    return uniforms_[handle.index];
+    return uniforms_[ResolveUniformIndex(handle)];
 }
 
 std::span<const uint8_t> Shader::GetUniformValueViewRaw(UniformHandle& handle, edt::GUID type_guid) const
 {
-    auto& uniform = GetUniform(handle);
-    uniform.EnsureTypeMatch(type_guid);
-    return uniform.GetValue();
+    const size_t index = ResolveUniformIndex(handle);
+    uniforms_[index].EnsureTypeMatch(type_guid);
+    return GetUniformValueView(index);
+}
+
+std::span<const uint8_t> Shader::GetUniformValueView(size_t index) const
+{
+    const ShaderUniform& uniform = uniforms_[index];
+    return std::span(uniform_values_).subspan(uniform.GetValueOffset(), uniform.GetValueSize());
 }
 
-void Shader::UpdateUniformHandle(UniformHandle& handle) const
+void Shader::SetUniformValue(size_t index, std::span<const uint8_t> value, size_t first_element)
 {
-    if (handle.index >= uniforms_.size() || uniforms_[handle.index].GetName() != handle.name)
+    ShaderUniform& uniform = uniforms_[index];
+    const size_t element_size = uniform.GetElementSize();
+    assert(value.size() % element_size == 0);
+    assert((first_element * element_size + value.size()) <= uniform.GetValueSize());
+    std::ranges::copy(value, uniform_values_.data() + uniform.GetValueOffset() + first_element * element_size);
+
+    // Aliases in other separable stages share the value but have to be sent separately
+    const auto first = static_cast<uint32_t>(first_element);
+    const auto count = static_cast<uint32_t>(value.size() / element_size);
+    for (size_t i = index; i != ShaderUniform::kNoAlias; i = uniforms_[i].GetNextAlias())
     {
-        handle = GetUniform(handle.name);
+        uniforms_[i].MarkDirty(first, count);
+        MarkUniformDirty(i);
+    }
+}
+
+size_t Shader::ResolveUniformIndex(UniformHandle& handle) const
+{
+    // Slots do not change when the shader is recompiled, so a handle obtained once keeps working
+    [[likely]] if (handle.index < uniform_slot_to_index_.size())
+    {
+        const uint32_t index = uniform_slot_to_index_[handle.index];
+        [[likely]] if (index < uniforms_.size() && uniforms_[index].GetName() == handle.name)
+        {
+            return index;
+        }
     }
+
+    handle = GetUniform(handle.name);
+    return uniform_slot_to_index_[handle.index];
 }
 
 void Shader::UpdateDefineHandle(DefineHandle& handle) const
@@ -506,31 +737,164 @@ void Shader::UpdateDefineHandle(DefineHandle& handle) const
 
 void Shader::SetUniform(UniformHandle& handle, edt::GUID type_guid, std::span<const uint8_t> value)
 {
-    auto& uniform = GetUniform(handle);
+    const size_t index = ResolveUniformIndex(handle);
+    const ShaderUniform& uniform = uniforms_[index];
     uniform.EnsureTypeMatch(type_guid);
-    uniform.SetValue(value);
+    ErrorHandling::Ensure(
+        value.size() == uniform.GetElementSize(),
+        "Uniform {} expects value of size {} but got {} bytes",
+        uniform.GetNameView(),
+        uniform.GetElementSize(),
+        value.size());
+    SetUniformValue(index, value);
+}
+
+void Shader::SetUniformArray(
+    UniformHandle& handle,
+    edt::GUID type_guid,
+    std::span<const uint8_t> values,
+    size_t first_element)
+{
+    const size_t index = ResolveUniformIndex(handle);
+    const ShaderUniform& uniform = uniforms_[index];
+    uniform.EnsureTypeMatch(type_guid);
+    const size_t element_size = uniform.GetElementSize();
+    ErrorHandling::Ensure(
+        values.size() % element_size == 0,
+        "Uniform {} expects values of size {} but got {} bytes",
+        uniform.GetNameView(),
+        element_size,
+        values.size());
+
+    const size_t elements_count = values.size() / element_size;
+    ErrorHandling::Ensure(
+        first_element + elements_count <= uniform.GetCount(),
+        "Range [{}, {}) is out of bounds of uniform {}[{}]",
+        first_element,
+        first_element + elements_count,
+        uniform.GetNameView(),
+        uniform.GetCount());
+
+    if (elements_count != 0)
+    {
+        SetUniformValue(index, values, first_element);
+    }
+}
+
+size_t Shader::GetUniformArraySize(UniformHandle& handle) const
+{
+    return GetUniform(handle).GetCount();
 }
 
 void Shader::SetUniform(UniformHandle& handle, const Texture& texture)
 {
     auto sampler_uniform = GetUniformValue<SamplerUniform>(handle);
-    ShaderUniform& u = uniforms_[handle.index];
     sampler_uniform.texture = texture.GetTexture();
-    u.SetValue(std::span(reinterpret_cast<const uint8_t*>(&sampler_uniform), sizeof(sampler_uniform)));  // NOLINT
+    SetUniformValue(
+        ResolveUniformIndex(handle),
+        std::span(reinterpret_cast<const uint8_t*>(&sampler_uniform), sizeof(sampler_uniform)));  // NOLINT
 }
 
 void Shader::SendUniforms()
 {
-    for (const ShaderUniform& uniform : uniforms_)
+    ClaimSeparableStages();
+
+    size_t active_stage = stages_.size();
+    for (size_t word_index = 0; word_index != dirty_uniforms_.size(); ++word_index)
     {
-        uniform.SendValue();
+        uint64_t word = std::exchange(dirty_uniforms_[word_index], 0);
+        while (word != 0)
+        {
+            const size_t bit_index = static_cast<size_t>(std::countr_zero(word));
+            word &= word - 1;
+            SendUniformValue(word_index * 64 + bit_index, active_stage);
+        }
     }
 }
 
 void Shader::SendUniform(UniformHandle& handle)
 {
-    ShaderUniform& uniform = GetUniform(handle);
-    uniform.SendValue();
+    ClaimSeparableStages();
+
+    size_t active_stage = stages_.size();
+    for (size_t i = ResolveUniformIndex(handle); i != ShaderUniform::kNoAlias; i = uniforms_[i].GetNextAlias())
+    {
+        if (IsUniformDirty(i))
+        {
+            MarkUniformClean(i);
+            SendUniformValue(i, active_stage);
+        }
+    }
+}
+
+void Shader::SendUniformValue(size_t index, size_t& active_stage)
+{
+    ShaderUniform& uniform = uniforms_[index];
+
+    // glUniform* modifies the active program of the bound pipeline
+    if (!stages_.empty() && uniform.GetStage() != active_stage)
+    {
+        active_stage = uniform.GetStage();
+        OpenGl::ActiveShaderProgram(pipeline_, stages_[active_stage]->program);
+    }
+
+    uniform.SendDirtyRange(uniform_values_.data());
+}
+
+void Shader::ClaimSeparableStages()
+{
+    for (size_t stage_index = 0; stage_index != stages_.size(); ++stage_index)
+    {
+        SeparableStage& stage = *stages_[stage_index];
+        if (stage.uniforms_owner == instance_id_) continue;
+
+        // Another shader could have overwritten values in the shared program
+        stage.uniforms_owner = instance_id_;
+        for (size_t index = 0; index != uniforms_.size(); ++index)
+        {
+            if (uniforms_[index].GetStage() == stage_index)
+            {
+                uniforms_[index].MarkDirty();
+                MarkUniformDirty(index);
+            }
+        }
+    }
+}
+
+void Shader::SetUniformBlockBinding(std::string_view block_name, uint32_t binding)
+{
+    auto it = std::ranges::find(uniform_block_bindings_, block_name, &std::pair<std::string, uint32_t>::first);
+    if (it == uniform_block_bindings_.end())
+    {
+        uniform_block_bindings_.emplace_back(block_name, binding);
+    }
+    else
+    {
+        it->second = binding;
+    }
+
+    ApplyUniformBlockBinding(block_name, binding);
+}
+
+void Shader::ApplyUniformBlockBinding(std::string_view block_name, uint32_t binding)
+{
+    Internal::ForEachProgram(
+        *this,
+        [&](size_t, GlProgramId program, const GlProgramInfo& info)
+        {
+            if (const GlUniformBlockInfo* block = info.FindUniformBlock(block_name))
+            {
+                OpenGl::UniformBlockBinding(program, static_cast<uint32_t>(block->index), binding);
+            }
+        });
+}
+
+void Shader::ApplyUniformBlockBindings()
+{
+    for (const auto& [block_name, binding] : uniform_block_bindings_)
+    {
+        ApplyUniformBlockBinding(block_name, binding);
+    }
 }
 
 static std::optional<edt::GUID> ConvertGlType(GLenum gl_type)
@@ -579,81 +943,153 @@ static std::optional<edt::GUID> ConvertGlType(GLenum gl_type)
 
 void Shader::UpdateInfo()
 {
-    info_.FetchUniforms(program_);
-    info_.FetchVertexAttributes(program_);
+    if (stages_.empty())
+    {
+        info_.FetchUniforms(program_);
+        info_.FetchUniformBlocks(program_);
+        info_.FetchStorageBlocks(program_);
+        info_.FetchVertexAttributes(program_);
+        return;
+    }
+
+    // Reflection of stages is fetched once when the stage is linked. Here it is just combined.
+    info_ = {};
+    for (const auto& stage : stages_)
+    {
+        if (stage->type == GlShaderType::Vertex)
+        {
+            info_.vertex_attributes = stage->info.vertex_attributes;
+        }
+
+        info_.uniforms.insert(info_.uniforms.end(), stage->info.uniforms.begin(), stage->info.uniforms.end());
+        info_.uniform_blocks.insert(
+            info_.uniform_blocks.end(),
+            stage->info.uniform_blocks.begin(),
+            stage->info.uniform_blocks.end());
+        info_.storage_blocks.insert(
+            info_.storage_blocks.end(),
+            stage->info.storage_blocks.begin(),
+            stage->info.storage_blocks.end());
+    }
 }
 
 void Shader::UpdateUniforms()
 {
     std::vector<ShaderUniform> uniforms;
+    std::vector<uint8_t> values;
     uniforms.reserve(info_.uniforms.size());
-    for (size_t i = 0; i != info_.uniforms.size(); ++i)
-    {
-        const auto& uniform_info = info_.uniforms[i];
+    uint8_t samplers_count = 0;
 
-        const std::optional<edt::GUID> cpp_type = ConvertGlType(ToGlValue(uniform_info.type));
-        if (!cpp_type)
-        {
-            fmt::print("Skip variable {} in \"{}\" - unsupported type", uniform_info.name, path_.string());
-            continue;
-        }
+    // The last uniform with the name. Used to link uniforms with the same name in different separable stages.
+    ankerl::unordered_dense::map<Name::NameId, uint32_t> last_uniform_with_name;
 
-        auto get_or_add = [&uniforms, &cpp_type, this](std::string_view name)
+    auto add_program_uniforms = [&](size_t stage_index, GlProgramId program, const GlProgramInfo& program_info)
+    {
+        for (const auto& uniform_info : program_info.uniforms)
         {
-            // find existing variable
-            if (auto existing_uniform = std::ranges::find(uniforms_, name, &ShaderUniform::GetNameView);
-                existing_uniform != uniforms_.end())
+            const std::optional<edt::GUID> cpp_type = ConvertGlType(ToGlValue(uniform_info.type));
+            if (!cpp_type)
             {
-                uniforms.push_back(std::move(*existing_uniform));
-                // the previous value can be saved only if variable has the same type
-                if (*cpp_type != existing_uniform->GetTypeGUID())
-                {
-                    uniforms.back().SetType(*cpp_type);
-                }
+                fmt::print("Skip variable {} in \"{}\" - unsupported type", uniform_info.name, path_.string());
+                continue;
             }
-            else
+
+            // Arrays are reported as "name[0]" but they are stored as a single uniform with "name"
+            std::string_view name = uniform_info.name;
+            if (name.ends_with("[0]"))
             {
-                uniforms.emplace_back();
-                auto& uniform = uniforms.back();
-                uniform.SetName(Name(name));
-                uniform.SetType(*cpp_type);
+                name.remove_suffix(3);
             }
 
-            const GLint location = glGetUniformLocation(program_.GetId().GetValue(), name.data());
-            uniforms.back().SetLocation(static_cast<uint32_t>(location));
-        };
+            const auto new_index = static_cast<uint32_t>(uniforms.size());
+            auto& uniform = uniforms.emplace_back();
+            uniform.SetName(Name(name));
+            uniform.SetType(*cpp_type, static_cast<uint32_t>(uniform_info.size));
+            uniform.SetStage(static_cast<uint8_t>(stage_index));
 
-        if (uniform_info.size == 1)
-        {
-            get_or_add(uniform_info.name);
-        }
-        else
-        {
-            std::string name_with_index(uniform_info.name);
-            const size_t name_no_index_size = name_with_index.find('[');
-            for (size_t element_index = 0; element_index != uniform_info.size; ++element_index)
+            const GLint location = OpenGl::GetUniformLocation(program, uniform_info.name.c_str());
+            uniform.SetLocation(static_cast<uint32_t>(location));
+
+            // The program object is new, so every value has to be sent again
+            uniform.MarkDirty();
+
+            auto [last_it, first_with_name] = last_uniform_with_name.try_emplace(uniform.GetName().GetId(), new_index);
+            if (!first_with_name)
+            {
+                // Another stage already has uniform with this name. Both stages use the same value.
+                ShaderUniform& previous = uniforms[last_it->second];
+                ErrorHandling::Ensure(
+                    previous.GetTypeGUID() == uniform.GetTypeGUID() && previous.GetCount() == uniform.GetCount(),
+                    "Uniform {} has different types in different stages of {}",
+                    name,
+                    path_);
+                uniform.SetValueOffset(previous.GetValueOffset());
+                previous.SetNextAlias(new_index);
+                last_it->second = new_index;
+                continue;
+            }
+
+            // Place the value to the arena respecting alignment of the type
+            const size_t alignment = uniform.GetValueAlignment();
+            const size_t offset = (values.size() + alignment - 1) / alignment * alignment;
+            uniform.SetValueOffset(static_cast<uint32_t>(offset));
+            values.resize(offset + uniform.GetValueSize());
+            const std::span<uint8_t> value = std::span(values).subspan(offset, uniform.GetValueSize());
+
+            const cppreflection::Type* type_info = cppreflection::GetTypeRegistry()->FindType(*cpp_type);
+            for (size_t element_offset = 0; element_offset != value.size(); element_offset += uniform.GetElementSize())
+            {
+                type_info->GetSpecialMembers().defaultConstructor(value.data() + element_offset);
+            }
+
+            // The previous value can be saved only if variable has the same type. Array elements that
+            // exist in both versions are preserved.
+            const std::optional<size_t> existing_index = FindUniformIndex(uniform.GetName());
+            if (existing_index && uniforms_[*existing_index].GetTypeGUID() == *cpp_type)
             {
-                name_with_index.resize(name_no_index_size);
-                fmt::format_to(std::back_inserter(name_with_index), "[{}]", element_index);
-                get_or_add(name_with_index);
+                const auto previous_value = GetUniformValueView(*existing_index);
+                std::ranges::copy(previous_value.first(std::min(previous_value.size(), value.size())), value.begin());
+            }
+
+            if (*cpp_type == cppreflection::GetStaticTypeInfo<SamplerUniform>().guid)
+            {
+                auto* samplers = reinterpret_cast<SamplerUniform*>(value.data());  // NOLINT
+                for (auto& sampler : std::span(samplers, uniform.GetCount()))
+                {
+                    sampler.sampler_index = samplers_count++;
+                }
             }
         }
-    }
+    };
 
-    std::swap(uniforms, uniforms_);
+    Internal::ForEachProgram(*this, add_program_uniforms);
 
-    // Update index for sampler uniforms
-    for (size_t i = 0; i < uniforms_.size(); ++i)
+    uniforms_ = std::move(uniforms);
+    uniform_values_ = std::move(values);
+
+    // Assign slots to new names and point all slots to the new indices. Slot points to the first uniform
+    // with the name, other stages are reachable through aliases.
+    std::ranges::fill(uniform_slot_to_index_, kInactiveUniformSlot);
+    for (size_t index = 0; index != uniforms_.size(); ++index)
     {
-        ShaderUniform& uniform = uniforms_[i];
-        if (uniform.GetTypeGUID() == cppreflection::GetStaticTypeInfo<SamplerUniform>().guid)
+        const auto new_slot = static_cast<uint32_t>(uniform_slot_to_index_.size());
+        auto [it, inserted] = uniform_slots_.try_emplace(uniforms_[index].GetName().GetId(), new_slot);
+        if (inserted)
+        {
+            uniform_slot_to_index_.push_back(kInactiveUniformSlot);
+        }
+
+        if (uniform_slot_to_index_[it->second] == kInactiveUniformSlot)
         {
-            UniformHandle handle(static_cast<uint32_t>(i), uniform.GetName());
-            auto sampler = GetUniformValue<SamplerUniform>(handle);
-            sampler.sampler_index = static_cast<uint8_t>(i);
-            uniform.SetValue(std::span(reinterpret_cast<const uint8_t*>(&sampler), sizeof(sampler)));  // NOLINT
+            uniform_slot_to_index_[it->second] = static_cast<uint32_t>(index);
         }
     }
+
+    dirty_uniforms_.assign((uniforms_.size() + 63) / 64, ~uint64_t{0});
+    if (const size_t tail = uniforms_.size() % 64; tail != 0)
+    {
+        dirty_uniforms_.back() = (uint64_t{1} << tail) - 1;
+    }
 }
 
 }  // namespace klgl
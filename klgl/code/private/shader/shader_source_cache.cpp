@@ -0,0 +1,255 @@
+#include "klgl/shader/shader_source_cache.hpp"
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <algorithm>
+#include <optional>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/filesystem/filesystem.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+
+[[nodiscard]] std::string MakeKey(const std::filesystem::path& path)
+{
+    return path.lexically_normal().generic_string();
+}
+
+[[nodiscard]] constexpr std::string_view TrimLeft(std::string_view s)
+{
+    const size_t first = s.find_first_not_of(" \t");
+    return first == std::string_view::npos ? std::string_view{} : s.substr(first);
+}
+
+// Returns the path in quotes if the line is an include directive: #include "path"
+[[nodiscard]] std::optional<std::string_view> ParseIncludeDirective(std::string_view line)
+{
+    line = TrimLeft(line);
+    if (!line.starts_with('#')) return std::nullopt;
+
+    line = TrimLeft(line.substr(1));
+    constexpr std::string_view kInclude = "include";
+    if (!line.starts_with(kInclude)) return std::nullopt;
+
+    line = TrimLeft(line.substr(kInclude.size()));
+    const size_t closing_quote = line.size() > 1 ? line.find('"', 1) : std::string_view::npos;
+
+    [[unlikely]] if (!line.starts_with('"') || closing_quote == std::string_view::npos)
+    {
+        ErrorHandling::ThrowWithMessage("Malformed include directive: \"{}\". Expected #include \"path\"", line);
+    }
+
+    return line.substr(1, closing_quote - 1);
+}
+
+}  // namespace
+
+ShaderSourceCache& ShaderSourceCache::Get()
+{
+    static ShaderSourceCache instance;
+    return instance;
+}
+
+void ShaderSourceCache::SetRootDirectory(const std::filesystem::path& root)
+{
+    std::lock_guard lock(mutex_);
+    auto normalized = root.lexically_normal();
+    if (normalized == root_) return;
+
+    root_ = std::move(normalized);
+    directories_.clear();
+    files_.clear();
+    indexed_ = false;
+}
+
+std::filesystem::path ShaderSourceCache::GetRootDirectory() const
+{
+    std::lock_guard lock(mutex_);
+    return root_;
+}
+
+std::vector<std::filesystem::path> ShaderSourceCache::GetDirectoryFiles(const std::filesystem::path& directory)
+{
+    std::lock_guard lock(mutex_);
+    EnsureIndexed();
+
+    auto it = directories_.find(MakeKey(directory));
+    [[unlikely]] if (it == directories_.end())
+    {
+        ErrorHandling::ThrowWithMessage("Directory {} is not found in shader root {}", directory, root_);
+    }
+
+    return it->second;
+}
+
+std::string ShaderSourceCache::GetFileContent(const std::filesystem::path& path)
+{
+    std::lock_guard lock(mutex_);
+    return GetFileContentNoLock(path);
+}
+
+void ShaderSourceCache::AppendPreprocessed(
+    const std::filesystem::path& path,
+    std::string& buffer,
+    std::vector<std::filesystem::path>& source_files)
+{
+    std::lock_guard lock(mutex_);
+    EnsureIndexed();
+    AppendPreprocessedNoLock(path.lexically_normal(), buffer, source_files);
+}
+
+void ShaderSourceCache::Revalidate()
+{
+    std::lock_guard lock(mutex_);
+    if (indexed_)
+    {
+        Index();
+    }
+
+    for (auto it = files_.begin(); it != files_.end();)
+    {
+        auto& [key, file] = *it;
+        std::error_code error;
+        const auto write_time = std::filesystem::last_write_time(key, error);
+        if (error)
+        {
+            it = files_.erase(it);
+            continue;
+        }
+
+        if (write_time != file.write_time)
+        {
+            Filesystem::ReadFile(key, file.content);
+            file.write_time = write_time;
+        }
+
+        ++it;
+    }
+}
+
+void ShaderSourceCache::EnsureIndexed()
+{
+    if (!indexed_)
+    {
+        Index();
+    }
+}
+
+void ShaderSourceCache::Index()
+{
+    directories_.clear();
+    directories_[MakeKey(root_)];
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root_))
+    {
+        const auto& path = entry.path();
+        if (entry.is_directory())
+        {
+            directories_[MakeKey(path)];
+        }
+        else
+        {
+            directories_[MakeKey(path.parent_path())].push_back(path.lexically_normal());
+        }
+    }
+
+    for (auto& [key, files] : directories_)
+    {
+        std::ranges::sort(files);
+    }
+
+    indexed_ = true;
+}
+
+bool ShaderSourceCache::IsIndexedFile(const std::filesystem::path& path) const
+{
+    auto it = directories_.find(MakeKey(path.parent_path()));
+    return it != directories_.end() && std::ranges::binary_search(it->second, path);
+}
+
+const std::string& ShaderSourceCache::GetFileContentNoLock(const std::filesystem::path& path)
+{
+    auto [it, inserted] = files_.try_emplace(MakeKey(path));
+    CachedFile& file = it->second;
+    if (inserted)
+    {
+        try
+        {
+            file.write_time = std::filesystem::last_write_time(path);
+            Filesystem::ReadFile(path, file.content);
+        }
+        catch (...)
+        {
+            files_.erase(it);
+            throw;
+        }
+    }
+
+    return file.content;
+}
+
+std::filesystem::path ShaderSourceCache::ResolveInclude(
+    const std::filesystem::path& including_file,
+    std::string_view include_path) const
+{
+    for (const auto& base : {including_file.parent_path(), root_})
+    {
+        auto candidate = (base / include_path).lexically_normal();
+        if (IsIndexedFile(candidate))
+        {
+            return candidate;
+        }
+    }
+
+    throw ErrorHandling::RuntimeErrorWithMessage(
+        "Could not resolve #include \"{}\" in {}. Paths are relative to the including file or to {}",
+        include_path,
+        including_file,
+        root_);
+}
+
+void ShaderSourceCache::AppendPreprocessedNoLock(
+    const std::filesystem::path& path,
+    std::string& buffer,
+    std::vector<std::filesystem::path>& source_files)
+{
+    const size_t source_index = source_files.size();
+    source_files.push_back(path);
+
+    // The content of the cached file is not modified during preprocessing so it is safe to keep the view
+    const std::string_view content = GetFileContentNoLock(path);
+    fmt::format_to(std::back_inserter(buffer), "#line 1 {}\n", source_index);
+
+    size_t line_number = 0;
+    size_t line_start = 0;
+    while (line_start < content.size())
+    {
+        const size_t line_end = std::min(content.find('\n', line_start), content.size());
+        const std::string_view line = content.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+        ++line_number;
+
+        if (auto maybe_include = ParseIncludeDirective(line))
+        {
+            auto include_path = ResolveInclude(path, *maybe_include);
+            if (std::ranges::find(source_files, include_path) == source_files.end())
+            {
+                AppendPreprocessedNoLock(include_path, buffer, source_files);
+            }
+
+            // Restore position in the current file
+            fmt::format_to(std::back_inserter(buffer), "#line {} {}\n", line_number + 1, source_index);
+            continue;
+        }
+
+        buffer.append(line);
+        buffer.push_back('\n');
+    }
+}
+
+}  // namespace klgl
@@ -1,6 +1,10 @@
 #include "klgl/shader/shader_uniform.hpp"
 
+#include <algorithm>
+#include <array>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 
 #include "CppReflection/TypeRegistry.hpp"
 #include "EverydayTools/GUID_fmtlib.hpp"  // IWYU pragma: keep
@@ -12,111 +16,91 @@
 namespace klgl
 {
 
+namespace
+{
+
 template <typename T>
-struct ValueTypeHelper
+void SendUniformValues(uint32_t location, uint32_t count, const uint8_t* values)
 {
-    static bool Exec(edt::GUID type_guid, uint32_t location, std::span<const uint8_t> value)
+    if (count == 1)
     {
-        if (cppreflection::GetStaticTypeInfo<T>().guid == type_guid)
-        {
-            OpenGl::SetUniform(location, *reinterpret_cast<const T*>(value.data()));  // NOLINT
-            return true;
-        }
-
-        return false;
+        OpenGl::SetUniform(location, *reinterpret_cast<const T*>(values));  // NOLINT
     }
-};
-
-template <>
-struct ValueTypeHelper<SamplerUniform>
-{
-    static bool
-    Exec(edt::GUID type_guid, [[maybe_unused]] uint32_t location, [[maybe_unused]] std::span<const uint8_t> value)
+    else
     {
-        if (cppreflection::GetStaticTypeInfo<SamplerUniform>().guid == type_guid)
-        {
-            auto& v = *reinterpret_cast<const SamplerUniform*>(value.data());  // NOLINT
-            static_assert(GL_TEXTURE31 - GL_TEXTURE0 == 31);
-            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + v.sampler_index));
-            OpenGl::BindTexture(GlTargetTextureType::Texture2d, v.texture);
-            glUniform1i(static_cast<GLint>(location), static_cast<GLint>(v.sampler_index));
-
-            return true;
-        }
-
-        return false;
+        OpenGl::SetUniformArray(location, std::span(reinterpret_cast<const T*>(values), count));  // NOLINT
     }
-};
-
-template <typename T>
-bool SendActualValue(edt::GUID type_guid, uint32_t location, std::span<const uint8_t> value)
-{
-    return ValueTypeHelper<T>::Exec(type_guid, location, value);
 }
 
-ShaderUniform::ShaderUniform() = default;
-
-ShaderUniform::~ShaderUniform()
+template <>
+void SendUniformValues<SamplerUniform>(uint32_t location, uint32_t count, const uint8_t* values)
 {
-    Clear();
+    static_assert(GL_TEXTURE31 - GL_TEXTURE0 == 31);
+    for (uint32_t index = 0; index != count; ++index)
+    {
+        auto& v = reinterpret_cast<const SamplerUniform*>(values)[index];  // NOLINT
+        OpenGl::ActiveTexture(v.sampler_index);
+        OpenGl::BindTexture(GlTargetTextureType::Texture2d, v.texture);
+        OpenGl::SetUniform(location + index, static_cast<int32_t>(v.sampler_index));
+    }
 }
 
-ShaderUniform::ShaderUniform(ShaderUniform&& another) noexcept
+struct UniformTypeTraits
 {
-    MoveFrom(another);
-}
+    edt::GUID type_guid;
+    uint32_t size;
+    uint32_t alignment;
+    ShaderUniform::SendFunction send_function;
+};
 
-void ShaderUniform::MoveFrom(ShaderUniform& another)
+template <typename T>
+[[nodiscard]] constexpr UniformTypeTraits MakeUniformTypeTraits()
 {
-    Clear();
-    name_ = another.name_;
-    value_ = std::move(another.value_);
-    location_ = another.location_;
-    type_guid_ = another.type_guid_;
-    sent_ = another.sent_;
+    // Values are copied to the arena and never destroyed
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+    return UniformTypeTraits{
+        .type_guid = cppreflection::GetStaticTypeInfo<T>().guid,
+        .size = sizeof(T),
+        .alignment = alignof(T),
+        .send_function = &SendUniformValues<T>,
+    };
 }
 
-void ShaderUniform::SendValue() const
-{
-    CheckNotEmpty();
-
-    if (sent_)
-    {
-        return;
-    }
-
-    sent_ = true;
+constexpr std::array kUniformTypes{
+    MakeUniformTypeTraits<int32_t>(),
+    MakeUniformTypeTraits<uint32_t>(),
+    MakeUniformTypeTraits<float>(),
+    MakeUniformTypeTraits<Vec2f>(),
+    MakeUniformTypeTraits<Vec3f>(),
+    MakeUniformTypeTraits<Vec4f>(),
+    MakeUniformTypeTraits<Mat3f>(),
+    MakeUniformTypeTraits<Mat4f>(),
+    MakeUniformTypeTraits<SamplerUniform>(),
+};
 
-    const bool type_found = SendActualValue<int32_t>(type_guid_, location_, value_) ||
-                            SendActualValue<uint32_t>(type_guid_, location_, value_) ||
-                            SendActualValue<float>(type_guid_, location_, value_) ||
-                            SendActualValue<Vec2f>(type_guid_, location_, value_) ||
-                            SendActualValue<Vec3f>(type_guid_, location_, value_) ||
-                            SendActualValue<Vec4f>(type_guid_, location_, value_) ||
-                            SendActualValue<Mat3f>(type_guid_, location_, value_) ||
-                            SendActualValue<Mat4f>(type_guid_, location_, value_) ||
-                            SendActualValue<SamplerUniform>(type_guid_, location_, value_);
+// Array elements are passed to glUniform*v as they are stored in the arena
+static_assert(sizeof(Vec3f) == 3 * sizeof(float) && sizeof(Mat3f) == 9 * sizeof(float));
 
-    [[unlikely]] if (!type_found)
-    {
-        const cppreflection::Type* type_info = cppreflection::GetTypeRegistry()->FindType(type_guid_);
-        throw std::runtime_error(fmt::format("Invalid type {}", type_info->GetName()));
-    }
-}
+}  // namespace
 
-void ShaderUniform::SetType(edt::GUID type_guid)
+void ShaderUniform::SetType(edt::GUID type_guid, uint32_t count)
 {
-    Clear();
-    auto type_info = cppreflection::GetTypeRegistry()->FindType(type_guid);
-    [[unlikely]] if (!type_info)
+    auto it = std::ranges::find(kUniformTypes, type_guid, &UniformTypeTraits::type_guid);
+    [[unlikely]] if (it == kUniformTypes.end())
     {
-        auto error = fmt::format("Unknown type id {}\n", type_guid);
-        throw std::runtime_error(error);
+        const cppreflection::Type* type_info = cppreflection::GetTypeRegistry()->FindType(type_guid);
+        throw std::runtime_error(fmt::format(
+            "Unsupported uniform type {}",
+            type_info ? std::string_view(type_info->GetName()) : std::string_view("unknown")));
     }
 
     type_guid_ = type_guid;
-    value_.resize(type_info->GetInstanceSize());
-    type_info->GetSpecialMembers().defaultConstructor(value_.data());
+    count_ = count;
+    element_size_ = it->size;
+    value_alignment_ = it->alignment;
+    send_function_ = it->send_function;
+    dirty_begin_ = count_;
+    dirty_end_ = 0;
 }
 
 void ShaderUniform::EnsureTypeMatch(edt::GUID type_guid) const
@@ -127,43 +111,4 @@ void ShaderUniform::EnsureTypeMatch(edt::GUID type_guid) const
     }
 }
 
-bool ShaderUniform::IsEmpty() const noexcept
-{
-    return value_.empty();
-}
-
-void ShaderUniform::SetValue(std::span<const uint8_t> value)
-{
-    CheckNotEmpty();
-    sent_ = false;
-    const cppreflection::Type* type_info = cppreflection::GetTypeRegistry()->FindType(type_guid_);
-    assert(type_info->GetInstanceSize() == value.size());
-    type_info->GetSpecialMembers().copyAssign(value_.data(), value.data());
-}
-
-ShaderUniform& ShaderUniform::operator=(ShaderUniform&& another) noexcept
-{
-    MoveFrom(another);
-    return *this;
-}
-
-void ShaderUniform::Clear()
-{
-    if (!IsEmpty())
-    {
-        const cppreflection::Type* type_info = cppreflection::GetTypeRegistry()->FindType(type_guid_);
-        type_info->GetSpecialMembers().destructor(value_.data());
-        value_.clear();
-        sent_ = false;
-    }
-}
-
-void ShaderUniform::CheckNotEmpty() const
-{
-    [[unlikely]] if (IsEmpty())
-    {
-        throw std::logic_error("Trying to use empty uniform");
-    }
-}
-
 }  // namespace klgl
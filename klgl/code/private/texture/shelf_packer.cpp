@@ -0,0 +1,38 @@
+#include "klgl/texture/shelf_packer.hpp"
+
+namespace klgl
+{
+
+ShelfPacker::ShelfPacker(const Vec2<size_t>& size) : size_(size) {}
+
+std::optional<Vec2<size_t>> ShelfPacker::Insert(const Vec2<size_t>& size)
+{
+    if (size.x() > size_.x()) return std::nullopt;
+
+    Shelf* best = nullptr;
+    for (Shelf& shelf : shelves_)
+    {
+        if (shelf.height < size.y() || size_.x() - shelf.used_width < size.x()) continue;
+        if (!best || shelf.height < best->height) best = &shelf;
+    }
+
+    if (!best)
+    {
+        if (size_.y() - used_height_ < size.y()) return std::nullopt;
+
+        best = &shelves_.emplace_back(Shelf{.y = used_height_, .height = size.y()});
+        used_height_ += size.y();
+    }
+
+    const Vec2<size_t> position{best->used_width, best->y};
+    best->used_width += size.x();
+    return position;
+}
+
+void ShelfPacker::Clear()
+{
+    shelves_.clear();
+    used_height_ = 0;
+}
+
+}  // namespace klgl
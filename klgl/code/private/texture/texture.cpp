@@ -8,6 +8,7 @@
 #include "klgl/opengl/detail/maps/to_gl_value/target_texture_type.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/texture_internal_format.hpp"
 #include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/name_pool.hpp"
 
 namespace klgl
 {
@@ -51,54 +52,54 @@ std::unique_ptr<Texture> Texture::CreateEmpty(const Vec2<size_t>& resolution, co
     const TextureFormatInfo texture_format_info = TextureFormatHelper::GetTextureInternalFormatInfo(format);
     klgl::ErrorHandling::Ensure(!texture_format_info.base, "Do not use base internal formats.");
 
-    auto tex = std::make_unique<Texture>();
-    tex->texture_ = GlObject<GlTextureId>::CreateFrom(OpenGl::GenTexture());
-    tex->type_ = GlTargetTextureType::Texture2d;
-    tex->resolution_ = resolution;
-    tex->format_ = format;
-    tex->Bind();
-
-    assert(tex->type_ == GlTargetTextureType::Texture2d);
-    OpenGl::TexImage2d(
-        tex->type_,
-        0,
-        ToGlValue(format),
-        resolution.x(),
-        resolution.y(),
-        GL_RGBA,
-        GL_UNSIGNED_BYTE,
-        nullptr);
-
-    OpenGl::SetTextureWrap(tex->type_, GlTextureWrapAxis::R, GlTextureWrapMode::Repeat);
-    OpenGl::SetTextureWrap(tex->type_, GlTextureWrapAxis::S, GlTextureWrapMode::Repeat);
-    OpenGl::SetTextureWrap(tex->type_, GlTextureWrapAxis::T, GlTextureWrapMode::Repeat);
-    OpenGl::SetTextureMagFilter(tex->type_, GlTextureFilter::Nearest);
-    OpenGl::SetTextureMinFilter(tex->type_, GlTextureFilter::Nearest);
-
-    return tex;
+    return Create(resolution, format, GL_RGBA, GL_UNSIGNED_BYTE);
 }
 
 std::unique_ptr<Texture> Texture::CreateDepthStencil(const Vec2<size_t>& resolution)
 {
     ErrorHandling::Ensure(resolution != Vec2<size_t>{}, "Empty texture size!");
 
+    return Create(resolution, GlTextureInternalFormat::DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8);
+}
+
+std::unique_ptr<Texture> Texture::Create(
+    const Vec2<size_t>& resolution,
+    const GlTextureInternalFormat format,
+    const GLint pixel_data_format,
+    const GLenum pixel_data_type)
+{
     auto tex = std::make_unique<Texture>();
-    tex->texture_ = GlObject<GlTextureId>::CreateFrom(OpenGl::GenTexture());
     tex->type_ = GlTargetTextureType::Texture2d;
     tex->resolution_ = resolution;
-    tex->format_ = GlTextureInternalFormat::DEPTH24_STENCIL8;
+    tex->format_ = format;
+
+    if (OpenGl::HasDirectStateAccess())
+    {
+        // Immutable storage: the size and the format of the texture never change
+        tex->texture_ = GlObject<GlTextureId>::CreateFrom(OpenGl::CreateTexture(tex->type_));
+        OpenGl::TextureStorage2d(tex->texture_, 1, format, resolution);
+
+        OpenGl::SetTextureWrap(tex->texture_, GlTextureWrapAxis::R, GlTextureWrapMode::Repeat);
+        OpenGl::SetTextureWrap(tex->texture_, GlTextureWrapAxis::S, GlTextureWrapMode::Repeat);
+        OpenGl::SetTextureWrap(tex->texture_, GlTextureWrapAxis::T, GlTextureWrapMode::Repeat);
+        OpenGl::SetTextureMagFilter(tex->texture_, GlTextureFilter::Nearest);
+        OpenGl::SetTextureMinFilter(tex->texture_, GlTextureFilter::Nearest);
+
+        return tex;
+    }
+
+    tex->texture_ = GlObject<GlTextureId>::CreateFrom(GlNamePool::GenTexture());
     tex->Bind();
 
     assert(tex->type_ == GlTargetTextureType::Texture2d);
-
     OpenGl::TexImage2d(
         tex->type_,
         0,
-        ToGlValue(tex->format_),
+        ToGlValue(format),
         resolution.x(),
         resolution.y(),
-        GL_DEPTH_STENCIL,
-        GL_UNSIGNED_INT_24_8,
+        pixel_data_format,
+        pixel_data_type,
         nullptr);
 
     OpenGl::SetTextureWrap(tex->type_, GlTextureWrapAxis::R, GlTextureWrapMode::Repeat);
@@ -117,23 +118,36 @@ void Texture::Bind() const
 
 void Texture::SetPixels(const PixelBufferFormat& format, std::span<const uint8_t> data)
 {
-    format.ValidateBufferSize(resolution_, data.size_bytes());
+    SetPixels(format, {}, resolution_, data);
+}
+
+void Texture::SetPixels(
+    const PixelBufferFormat& format,
+    const Vec2<size_t>& offset,
+    const Vec2<size_t>& size,
+    std::span<const uint8_t> data)
+{
+    ErrorHandling::Ensure(
+        offset.x() + size.x() <= resolution_.x() && offset.y() + size.y() <= resolution_.y(),
+        "Region {}x{} at ({}, {}) is outside of {}x{} texture",
+        size.x(),
+        size.y(),
+        offset.x(),
+        offset.y(),
+        resolution_.x(),
+        resolution_.y());
+    format.ValidateBufferSize(size, data.size_bytes());
     format.EnsureCompatibleWithInternalTextureFormat(format_);
 
     assert(type_ == GlTargetTextureType::Texture2d);
+    if (OpenGl::HasDirectStateAccess())
+    {
+        OpenGl::TextureSubImage2d(texture_, 0, offset, size, format.layout, format.type, data);
+        return;
+    }
+
     Bind();
-    constexpr GLint x_offset = 0, y_offset = 0;
-    glTexSubImage2D(
-        ToGlValue(type_),
-        0,
-        x_offset,
-        y_offset,
-        static_cast<GLsizei>(resolution_.x()),
-        static_cast<GLsizei>(resolution_.y()),
-        ToGlValue(format.layout),
-        ToGlValue(format.type),
-        data.data());
-    assert(glGetError() == GL_NO_ERROR);
+    OpenGl::TexSubImage2d(type_, 0, offset, size, format.layout, format.type, data);
 
     // std::vector<Vec3<uint8_t>> got_pixels;
     // got_pixels.resize(p.pixel_data.size());
@@ -0,0 +1,48 @@
+#include "klgl/texture/texture_atlas.hpp"
+
+#include "klgl/error_handling.hpp"
+#include "klgl/texture/texture.hpp"
+
+namespace klgl
+{
+
+TextureAtlas::TextureAtlas(const Vec2<size_t>& size)
+    : texture_(Texture::CreateEmpty(size, GlTextureInternalFormat::RGBA8)),
+      packer_(size)
+{
+}
+
+TextureAtlas::~TextureAtlas() = default;
+
+std::optional<TextureAtlasRegion> TextureAtlas::Add(const Vec2<size_t>& size, std::span<const Vec4u8> pixels)
+{
+    ErrorHandling::Ensure(
+        pixels.size() == size.x() * size.y(),
+        "Expected {} pixels for {}x{} image but got {}",
+        size.x() * size.y(),
+        size.x(),
+        size.y(),
+        pixels.size());
+
+    const auto position = packer_.Insert(size + kPadding);
+    if (!position) return std::nullopt;
+
+    texture_->SetPixels(
+        {.layout = GlPixelBufferLayout::RGBA, .type = GlPixelBufferChannelType::UByte},
+        *position,
+        size,
+        std::span{reinterpret_cast<const uint8_t*>(pixels.data()), pixels.size_bytes()});  // NOLINT
+
+    const Vec2f texture_size = texture_->GetSize().Cast<float>();
+    const auto to_uv = [&](const Vec2<size_t>& pixel)
+    {
+        return Vec2f{
+            static_cast<float>(pixel.x()) / texture_size.x(),
+            static_cast<float>(pixel.y()) / texture_size.y(),
+        };
+    };
+
+    return TextureAtlasRegion{.uv_min = to_uv(*position), .uv_max = to_uv(*position + size)};
+}
+
+}  // namespace klgl
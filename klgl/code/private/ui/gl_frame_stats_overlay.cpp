@@ -0,0 +1,36 @@
+#include "klgl/ui/gl_frame_stats_overlay.hpp"
+
+#include "imgui.h"
+#include "klgl/opengl/debug/gl_frame_stats.hpp"
+
+namespace klgl
+{
+
+void GlFrameStatsOverlay::Draw()
+{
+    const GlFrameStats stats = GlFrameStatsRegistry::GetLastFrame();
+
+    constexpr float kPadding = 10.f;
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    const ImVec2 position{viewport->WorkPos.x + viewport->WorkSize.x - kPadding, viewport->WorkPos.y + kPadding};
+    ImGui::SetNextWindowPos(position, ImGuiCond_Always, ImVec2{1.f, 0.f});
+    ImGui::SetNextWindowBgAlpha(0.35f);
+
+    constexpr ImGuiWindowFlags kFlags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                                        ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+                                        ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+    if (ImGui::Begin("Frame stats", nullptr, kFlags))
+    {
+        constexpr double kKiB = 1024.0;
+        ImGui::Text("Draw calls: %zu", stats.draw_calls);
+        ImGui::Text("Instances: %zu", stats.instances);
+        ImGui::Text("Vertices: %zu", stats.vertices);
+        ImGui::Text("Programs: %zu", stats.program_switches);
+        ImGui::Text("State changes: %zu", stats.state_changes);
+        ImGui::Text("Buffer uploads: %.1f KiB", static_cast<double>(stats.buffer_upload_bytes) / kKiB);
+        ImGui::Text("Texture uploads: %.1f KiB", static_cast<double>(stats.texture_upload_bytes) / kKiB);
+    }
+    ImGui::End();
+}
+
+}  // namespace klgl
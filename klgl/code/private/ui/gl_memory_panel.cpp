@@ -0,0 +1,104 @@
+#include "klgl/ui/gl_memory_panel.hpp"
+
+#include <array>
+#include <cmath>
+#include <string>
+
+#include "fmt/format.h"
+#include "imgui.h"
+#include "magic_enum/magic_enum.hpp"
+
+namespace klgl
+{
+
+static std::string FormatBytes(double bytes)
+{
+    constexpr std::array kUnits{"B", "KiB", "MiB", "GiB"};
+    size_t unit = 0;
+    while (std::abs(bytes) >= 1024.0 && unit + 1 != kUnits.size())
+    {
+        bytes /= 1024.0;
+        ++unit;
+    }
+
+    return unit == 0 ? fmt::format("{} {}", bytes, kUnits[unit]) : fmt::format("{:.2f} {}", bytes, kUnits[unit]);
+}
+
+static void DrawRow(std::string_view name, const GlMemoryStats& stats, const std::optional<GlMemoryStatsDiff>& diff)
+{
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(name.data(), name.data() + name.size());
+    ImGui::TableNextColumn();
+    ImGui::Text("%zu", stats.objects);
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(FormatBytes(static_cast<double>(stats.bytes)).c_str());
+    ImGui::TableNextColumn();
+    ImGui::Text("%zu / %zu", stats.created, stats.deleted);
+
+    if (diff)
+    {
+        ImGui::TableNextColumn();
+        ImGui::Text("%+lld", static_cast<long long>(diff->objects));  // NOLINT
+        ImGui::TableNextColumn();
+        const std::string bytes = FormatBytes(static_cast<double>(diff->bytes));
+        ImGui::Text("%s%s", diff->bytes > 0 ? "+" : "", bytes.c_str());
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(FormatBytes(static_cast<double>(diff->allocated_bytes)).c_str());
+    }
+}
+
+void GlMemoryPanel::Draw()
+{
+    // Objects created before tracking was enabled are not counted
+    bool enabled = GlMemoryTracker::IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled))
+    {
+        GlMemoryTracker::SetEnabled(enabled);
+        ClearBaseline();
+    }
+
+    const GlMemorySnapshot current = GlMemoryTracker::TakeSnapshot();
+
+    ImGui::SameLine();
+    if (ImGui::Button("Capture baseline")) CaptureBaseline();
+    if (baseline_)
+    {
+        ImGui::SameLine();
+        if (ImGui::Button("Clear baseline")) ClearBaseline();
+    }
+
+    std::optional<GlMemorySnapshotDiff> diff;
+    if (baseline_) diff = current - *baseline_;
+
+    const int columns = diff ? 7 : 4;
+    constexpr auto kTableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+    if (!ImGui::BeginTable("GlMemory", columns, kTableFlags)) return;
+
+    ImGui::TableSetupColumn("Kind");
+    ImGui::TableSetupColumn("Objects");
+    ImGui::TableSetupColumn("Memory");
+    ImGui::TableSetupColumn("Created / Deleted");
+    if (diff)
+    {
+        ImGui::TableSetupColumn("Objects delta");
+        ImGui::TableSetupColumn("Memory delta");
+        ImGui::TableSetupColumn("Allocated since");
+    }
+    ImGui::TableHeadersRow();
+
+    for (const GlObjectKind kind : magic_enum::enum_values<GlObjectKind>())
+    {
+        std::optional<GlMemoryStatsDiff> kind_diff;
+        if (diff) kind_diff = diff->Get(kind);
+        DrawRow(magic_enum::enum_name(kind), current.Get(kind), kind_diff);
+    }
+
+    std::optional<GlMemoryStatsDiff> total_diff;
+    if (diff) total_diff = diff->total;
+    DrawRow("Total", current.total, total_diff);
+
+    ImGui::EndTable();
+}
+
+}  // namespace klgl
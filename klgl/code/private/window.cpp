@@ -42,6 +42,23 @@ void Window::SwapBuffers() noexcept
     glfwSwapBuffers(window_);
 }
 
+GLFWwindow* Window::CreateSharedContext() const
+{
+    // Context hints set for the main window are still active, so the version and the profile match
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* context = glfwCreateWindow(1, 1, "KLGL shared context", nullptr, window_);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+    if (!context) throw std::runtime_error(fmt::format("Failed to create shared context"));
+
+    return context;
+}
+
+void Window::DestroySharedContext(GLFWwindow* context) noexcept
+{
+    if (context) glfwDestroyWindow(context);
+}
+
 void Window::SetSize(size_t width, size_t height)
 {
     glfwSetWindowSize(window_, static_cast<int>(width), static_cast<int>(height));
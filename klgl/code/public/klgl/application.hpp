@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <optional>
@@ -12,7 +13,11 @@ class EventManager;
 namespace klgl
 {
 
+struct GlFrameStats;
+class ResourceUploader;
 class Window;
+enum class GlErrorCheckMode : uint8_t;
+enum class GlDeletionMode : uint8_t;
 
 class Application
 {
@@ -33,13 +38,28 @@ public:
     virtual void InitializeReflectionTypes();
     virtual void SetAutoClear(bool enabled);
 
+    // Draws counters of the previous frame in the corner of the window
+    void SetFrameStatsOverlayVisible(bool visible);
+
+    // Draw calls, uploads and state changes of the last finished frame
+    [[nodiscard]] GlFrameStats GetFrameStats() const;
+
     [[nodiscard]] virtual bool WantsToClose() const;
 
     virtual std::tuple<int, int> GetOpenGLVersion() const { return {3, 3}; }
 
+    // Error check mode selected at startup. Checks each call in debug builds and once per frame in release builds
+    virtual GlErrorCheckMode GetGlErrorCheckMode() const;
+
+    // When objects released by GlObject are deleted. Waits for the GPU to finish the frame by default
+    virtual GlDeletionMode GetGlDeletionMode() const;
+
     Window& GetWindow();
     const Window& GetWindow() const;
 
+    // Loads textures and meshes on a background thread. Starts the thread on the first call
+    ResourceUploader& GetResourceUploader();
+
     const std::filesystem::path& GetExecutableDir() const;
     virtual std::filesystem::path GetContentDir() const;
     virtual std::filesystem::path GetShaderDir() const;
@@ -60,6 +80,15 @@ public:
 
     void SetTargetFramerate(std::optional<float> framerate);
 
+    // How many frames GPU may lag behind CPU. At the end of each frame CPU waits until GPU completes the frame
+    // submitted that many frames ago. Two by default
+    void SetMaxFramesInFlight(size_t frames);
+    size_t GetMaxFramesInFlight() const;
+
+    // Slot of the current frame in [0, GetMaxFramesInFlight()). Data written for this slot is not in use by GPU:
+    // commands of the frame that used the slot before have completed
+    size_t GetFrameInFlightIndex() const;
+
 private:
     std::unique_ptr<State> state_;
 };
@@ -3,6 +3,7 @@
 #include <memory>
 #include <span>
 
+#include "klgl/opengl/name_pool.hpp"
 #include "klgl/opengl/object.hpp"
 
 namespace klgl
@@ -22,15 +23,32 @@ public:
 
         auto mesh = std::make_unique<MeshOpenGL>();
 
-        mesh->vao = GlObject<GlVertexArrayId>::CreateFrom(OpenGl::GenVertexArray());
-        mesh->vbo = GlObject<GlBufferId>::CreateFrom(OpenGl::GenBuffer());
-        mesh->ebo = GlObject<GlBufferId>::CreateFrom(OpenGl::GenBuffer());
+        if (OpenGl::HasDirectStateAccess())
+        {
+            mesh->vao = GlObject<GlVertexArrayId>::CreateFrom(GlNamePool::CreateVertexArray());
+            mesh->vbo = GlObject<GlBufferId>::CreateFrom(GlNamePool::CreateBuffer());
+            mesh->ebo = GlObject<GlBufferId>::CreateFrom(GlNamePool::CreateBuffer());
 
-        mesh->Bind();
-        OpenGl::BindBuffer(GlBufferType::Array, mesh->vbo);
-        OpenGl::BufferData(GlBufferType::Array, vertices, GlUsage::StaticDraw);
-        OpenGl::BindBuffer(GlBufferType::ElementArray, mesh->ebo);
-        OpenGl::BufferData(GlBufferType::ElementArray, indices, GlUsage::StaticDraw);
+            OpenGl::NamedBufferData(mesh->vbo, vertices, GlUsage::StaticDraw);
+            OpenGl::NamedBufferData(mesh->ebo, indices, GlUsage::StaticDraw);
+            OpenGl::VertexArrayElementBuffer(mesh->vao, mesh->ebo);
+
+            // Callers register attributes with the bind-to-edit functions right after this call
+            mesh->Bind();
+            OpenGl::BindBuffer(GlBufferType::Array, mesh->vbo);
+        }
+        else
+        {
+            mesh->vao = GlObject<GlVertexArrayId>::CreateFrom(GlNamePool::GenVertexArray());
+            mesh->vbo = GlObject<GlBufferId>::CreateFrom(GlNamePool::GenBuffer());
+            mesh->ebo = GlObject<GlBufferId>::CreateFrom(GlNamePool::GenBuffer());
+
+            mesh->Bind();
+            OpenGl::BindBuffer(GlBufferType::Array, mesh->vbo);
+            OpenGl::BufferData(GlBufferType::Array, vertices, GlUsage::StaticDraw);
+            OpenGl::BindBuffer(GlBufferType::ElementArray, mesh->ebo);
+            OpenGl::BufferData(GlBufferType::ElementArray, indices, GlUsage::StaticDraw);
+        }
 
         mesh->elements_count = indices.size();
         mesh->topology = topology;
@@ -38,6 +56,10 @@ public:
         return mesh;
     }
 
+    // Vertex arrays are not shared between contexts, so meshes with buffers uploaded by another context get theirs
+    // here. Leaves the vertex array and the vertex buffer bound, like MakeFromData does
+    void CreateVertexArray();
+
     void Bind() const;
     void BindAndDraw() const;
     void Draw() const;
@@ -21,6 +21,7 @@ public:
     explicit Name(const char* strptr);
 
     std::string_view GetView() const;
+    [[nodiscard]] NameId GetId() const noexcept { return id_; }
 
     [[nodiscard]] friend inline bool operator==(const Name& a, const Name& b) noexcept { return a.id_ == b.id_; }
 
@@ -1,16 +1,68 @@
 #pragma once
 
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
 #include "klgl/opengl/gl_api.hpp"
 
 namespace klgl
 {
 
+enum class GlDebugSeverity : uint8_t
+{
+    Notification,
+    Low,
+    Medium,
+    High,
+};
+
+struct GlDebugMessengerSettings
+{
+    // Messages with lower severity are discarded
+    GlDebugSeverity min_severity = GlDebugSeverity::Low;
+
+    // Makes the driver invoke the callback on the thread that made the call, before the call returns.
+    // Slower, but the stack trace of the callback points to the call that caused the message
+    bool synchronous = false;
+};
+
+// Receives messages from the driver through KHR_debug callback. Messages are deduplicated by (source, type, id):
+// only the first occurrence is printed, repeats are counted. Messages can arrive from driver threads
 class GlDebugMessenger
 {
 public:
-    static void Start();
+    struct Message
+    {
+        GLenum source = 0;
+        GLenum type = 0;
+        GLuint id = 0;
+        GlDebugSeverity severity = GlDebugSeverity::Notification;
+        std::string text;
+        size_t count = 0;
+    };
+
+    // Returns false if the context supports neither OpenGL 4.3 nor KHR_debug
+    static bool Start(const GlDebugMessengerSettings& settings = {});
+    static void Stop();
+    [[nodiscard]] static bool IsStarted();
+
+    // Tells the driver to stop sending the message. Ids are unique only within source and type
+    static void IgnoreMessage(GLenum source, GLenum type, GLuint id);
+
+    // Visits distinct messages received since the last reset
+    static void ForEachMessage(const std::function<void(const Message&)>& visitor);
+
+    // Number of received error messages including repeats
+    [[nodiscard]] static size_t GetErrorsCount();
+
+    // Text of the last error message received since the previous call
+    [[nodiscard]] static std::optional<std::string> TakeNewError();
+
+    static void ResetCounters();
 
-    static void DebugProc(
+    static void APIENTRY DebugProc(
         GLenum source,
         GLenum type,
         GLuint id,
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+
+namespace klgl
+{
+
+struct GlFrameStats
+{
+    size_t draw_calls = 0;
+
+    // Draw calls that are not instanced count as one instance
+    size_t instances = 0;
+
+    // Vertices or indices of all draw calls multiplied by the number of instances
+    size_t vertices = 0;
+
+    // Bytes passed from client memory. Writes through mapped buffer pointers are not counted
+    size_t buffer_upload_bytes = 0;
+    size_t texture_upload_bytes = 0;
+
+    // glUseProgram and glBindProgramPipeline calls
+    size_t program_switches = 0;
+
+    // Binds, capability toggles and other fixed function state changes
+    size_t state_changes = 0;
+};
+
+// Counters fed by OpenGl wrappers, so Painter2d, MeshOpenGL, Texture and anything else built on top of them are
+// counted without extra code. Only calls that reach the driver are counted: calls skipped by GlStateCache are not,
+// neither are raw OpenGL calls made by the ImGui backend.
+// Thread safe: uploads made by the ResourceUploader thread are added to the frame in progress.
+class GlFrameStatsRegistry
+{
+public:
+    // Hooks called by OpenGl wrappers after the corresponding OpenGL call
+    static void OnDraw(size_t vertices, size_t instances) noexcept;
+    static void OnBufferUpload(size_t bytes) noexcept;
+    static void OnTextureUpload(size_t bytes) noexcept;
+    static void OnProgramSwitch() noexcept;
+    static void OnStateChange() noexcept;
+
+    // Counters of the frame in progress
+    [[nodiscard]] static GlFrameStats GetCurrent() noexcept;
+
+    // Counters of the last finished frame
+    [[nodiscard]] static GlFrameStats GetLastFrame() noexcept;
+
+    // Called by Application after each frame. Keeps the counters as the last frame and starts from zero
+    static void EndFrame() noexcept;
+
+    // Clears both the frame in progress and the last frame
+    static void Reset() noexcept;
+};
+
+}  // namespace klgl
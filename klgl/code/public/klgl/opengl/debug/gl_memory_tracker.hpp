@@ -0,0 +1,116 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include "klgl/opengl/enums.hpp"
+#include "magic_enum/magic_enum.hpp"
+
+namespace klgl
+{
+
+struct GlMemoryStats
+{
+    // Objects alive at the moment of the snapshot and bytes they hold
+    size_t objects = 0;
+    size_t bytes = 0;
+
+    // Running totals. Their difference between two snapshots shows churn even when the number of objects is stable
+    size_t created = 0;
+    size_t deleted = 0;
+    size_t allocated_bytes = 0;
+
+    GlMemoryStats& operator+=(const GlMemoryStats& other);
+};
+
+struct GlMemoryStatsDiff
+{
+    int64_t objects = 0;
+    int64_t bytes = 0;
+    size_t created = 0;
+    size_t deleted = 0;
+    size_t allocated_bytes = 0;
+
+    [[nodiscard]] static GlMemoryStatsDiff Compute(const GlMemoryStats& before, const GlMemoryStats& after);
+};
+
+template <typename Stats>
+struct GlMemoryStatsPerKind
+{
+    static constexpr size_t kKindsCount = magic_enum::enum_count<GlObjectKind>();
+
+    [[nodiscard]] const Stats& Get(GlObjectKind kind) const { return per_kind[static_cast<size_t>(kind)]; }
+    [[nodiscard]] Stats& Get(GlObjectKind kind) { return per_kind[static_cast<size_t>(kind)]; }
+
+    std::array<Stats, kKindsCount> per_kind{};
+    Stats total{};
+};
+
+using GlMemorySnapshot = GlMemoryStatsPerKind<GlMemoryStats>;
+using GlMemorySnapshotDiff = GlMemoryStatsPerKind<GlMemoryStatsDiff>;
+
+[[nodiscard]] GlMemorySnapshotDiff operator-(const GlMemorySnapshot& after, const GlMemorySnapshot& before);
+
+// Counts OpenGL objects created through OpenGl wrappers and estimates memory they hold: buffer data stores, texture
+// levels and renderbuffer storage. Texture sizes are estimates: drivers pad rows, compress and keep auxiliary data.
+// Objects created with raw OpenGL calls (the ImGui backend, for example) are not visible here.
+// Tracking is disabled by default in release builds: hooks return before taking the lock and cost one atomic load.
+class GlMemoryTracker
+{
+public:
+    // Only objects created while tracking is enabled are counted. Disabling forgets everything, like Reset
+    static void SetEnabled(bool enabled);
+    [[nodiscard]] static bool IsEnabled() noexcept;
+
+    // Hooks called by OpenGl wrappers after the corresponding OpenGL call.
+    // Bind-to-edit variants take the bound object from GlStateCache
+    static void OnCreated(GlObjectKind kind, std::span<const GLuint> names);
+    static void OnCreated(GlObjectKind kind, GLuint name) { OnCreated(kind, std::span{&name, 1}); }
+    static void OnDeleted(GlObjectKind kind, GLuint name);
+    static void OnBufferData(GlBufferType target, size_t size);
+    static void OnNamedBufferData(GLuint buffer, size_t size);
+    static void OnTexImage(
+        GlTargetTextureType target,
+        size_t level,
+        GLint internal_format,
+        size_t width,
+        size_t height);
+    static void OnTextureStorage(
+        GLuint texture,
+        size_t levels,
+        GlTextureInternalFormat format,
+        size_t width,
+        size_t height);
+    static void OnGenerateMipmap(GLenum target);
+    static void OnRenderbufferStorage(GlTextureInternalFormat format, size_t width, size_t height);
+
+    // Variants that take the object name explicitly and do not touch OpenGL
+    static void SetTextureLevel(
+        GLuint texture,
+        size_t level,
+        GlTextureInternalFormat format,
+        size_t width,
+        size_t height);
+    static void SetRenderbufferSize(GLuint renderbuffer, GlTextureInternalFormat format, size_t width, size_t height);
+
+    [[nodiscard]] static GlMemorySnapshot TakeSnapshot();
+
+    // Returns zero for objects that are not tracked
+    [[nodiscard]] static size_t GetObjectBytes(GlObjectKind kind, GLuint name);
+
+    // Visits objects that are alive
+    static void ForEachObject(const std::function<void(GlObjectKind kind, GLuint name, size_t bytes)>& visitor);
+
+    // Prints objects that are still alive. Returns their number
+    static size_t ReportLeaks();
+
+    // Forgets all objects and totals. For the case when the context is destroyed with objects in it
+    static void Reset();
+};
+
+}  // namespace klgl
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/enums.hpp"
+
+namespace klgl
+{
+
+enum class GlTraceOpcode : uint8_t
+{
+    FrameEnd,
+
+    // Objects
+    GenObjects,
+    DeleteObject,
+    CreateBuffer,
+    CreateVertexArray,
+    CreateTexture,
+
+    // Buffers
+    BindBuffer,
+    BindBufferBase,
+    BindBufferRange,
+    BufferData,
+    BufferSubData,
+    BufferStorage,
+    ClearBufferSubData,
+    CopyBufferSubData,
+    NamedBufferData,
+    NamedBufferSubData,
+
+    // Vertex arrays
+    BindVertexArray,
+    EnableVertexAttribArray,
+    VertexAttribPointer,
+    VertexAttribIPointer,
+    VertexAttribDivisor,
+    VertexArrayElementBuffer,
+    VertexArrayVertexBuffer,
+    VertexArrayAttribFormat,
+    VertexArrayAttribIFormat,
+    VertexArrayAttribBinding,
+    VertexArrayBindingDivisor,
+    EnableVertexArrayAttrib,
+
+    // Textures
+    ActiveTexture,
+    BindTexture,
+    TexParameter,
+    TextureParameter,
+    TexImage2d,
+    TexSubImage2d,
+    TextureStorage2d,
+    TextureSubImage2d,
+    GenerateMipmap,
+
+    // Framebuffers and renderbuffers
+    BindFramebuffer,
+    FramebufferTexture2d,
+    FramebufferRenderbuffer,
+    BindRenderbuffer,
+    RenderbufferStorage,
+
+    // Shaders and programs
+    CreateShader,
+    ShaderSource,
+    CompileShader,
+    CreateProgram,
+    AttachShader,
+    LinkProgram,
+    SetProgramSeparable,
+    UseProgram,
+    UniformBlockBinding,
+    BindProgramPipeline,
+    UseProgramStage,
+    ActiveShaderProgram,
+
+    // Uniforms. The value is stored as data
+    SetUniformInt,
+    SetUniformUInt,
+    SetUniformFloat,
+    SetUniformVec2f,
+    SetUniformVec3f,
+    SetUniformVec4f,
+    SetUniformMat3f,
+    SetUniformMat4f,
+
+    // Fixed function state
+    SetClearColor,
+    Clear,
+    SetViewport,
+    SetDepthTestEnabled,
+    SetBlendingEnabled,
+    SetBlendFunction,
+    EnableFaceCulling,
+    CullFace,
+    PolygonMode,
+    PointSize,
+    LineWidth,
+    InsertMemoryBarrier,
+
+    // Draw
+    DrawElements,
+    DrawElementsInstanced,
+    DrawArrays,
+    DrawArraysInstanced,
+};
+
+// Compact binary trace of OpenGL calls. Each call is stored as
+//     opcode: u8, arguments size: u8, data size: u32, arguments, data
+// Arguments are trivially copyable values written one after another. Data holds memory referenced by the call:
+// buffer contents, pixels, shader sources and uniform values.
+class GlTrace
+{
+public:
+    struct Call
+    {
+        GlTraceOpcode opcode;
+        std::span<const uint8_t> args;
+        std::span<const uint8_t> data;
+    };
+
+    // Reads arguments of a call in the order they were written
+    class ArgsReader
+    {
+    public:
+        explicit ArgsReader(std::span<const uint8_t> args) : args_(args) {}
+
+        template <typename T>
+            requires(std::is_trivially_copyable_v<T>)
+        [[nodiscard]] T Read()
+        {
+            ErrorHandling::Ensure(sizeof(T) <= args_.size(), "Unexpected end of GL trace call arguments");
+            T value;
+            std::memcpy(&value, args_.data(), sizeof(T));
+            args_ = args_.subspan(sizeof(T));
+            return value;
+        }
+
+    private:
+        std::span<const uint8_t> args_;
+    };
+
+    GlTrace() = default;
+    explicit GlTrace(std::vector<uint8_t> bytes) : bytes_(std::move(bytes)) {}
+
+    template <typename Callback>
+    void ForEachCall(Callback&& callback) const
+    {
+        std::span<const uint8_t> bytes = bytes_;
+        while (!bytes.empty())
+        {
+            callback(ReadCall(bytes));
+        }
+    }
+
+    [[nodiscard]] std::span<const uint8_t> GetBytes() const { return bytes_; }
+    [[nodiscard]] bool IsEmpty() const { return bytes_.empty(); }
+
+    void SaveToFile(const std::filesystem::path& path) const;
+    [[nodiscard]] static GlTrace LoadFromFile(const std::filesystem::path& path);
+
+private:
+    // Takes one call from the beginning of bytes
+    static Call ReadCall(std::span<const uint8_t>& bytes);
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+// Records calls made by OpenGl wrappers on the current thread while it is started. Only calls that reach the driver
+// are recorded: calls skipped by GlStateCache are not. Memory written through mapped buffer pointers is not recorded.
+class GlTraceRecorder
+{
+public:
+    GlTraceRecorder() = default;
+    GlTraceRecorder(const GlTraceRecorder&) = delete;
+    GlTraceRecorder(GlTraceRecorder&&) = delete;
+    ~GlTraceRecorder();
+
+    GlTraceRecorder& operator=(const GlTraceRecorder&) = delete;
+    GlTraceRecorder& operator=(GlTraceRecorder&&) = delete;
+
+    // Throws if another recorder is active on this thread
+    void Start();
+    [[nodiscard]] GlTrace Stop();
+    [[nodiscard]] bool IsRecording() const noexcept { return active_ == this; }
+
+    // Lets callers skip preparing data for the trace when nothing is recorded
+    [[nodiscard]] static bool IsActive() noexcept { return active_ != nullptr; }
+
+    template <typename... Args>
+    static void Record(GlTraceOpcode opcode, const Args&... args) noexcept
+    {
+        [[unlikely]] if (active_)
+        {
+            active_->Write(opcode, {}, args...);
+        }
+    }
+
+    template <typename... Args>
+    static void RecordWithData(GlTraceOpcode opcode, std::span<const uint8_t> data, const Args&... args) noexcept
+    {
+        [[unlikely]] if (active_)
+        {
+            active_->Write(opcode, data, args...);
+        }
+    }
+
+    template <typename T, size_t Extent, typename... Args>
+    static void RecordWithData(GlTraceOpcode opcode, std::span<const T, Extent> data, const Args&... args) noexcept
+        requires(!std::same_as<T, uint8_t>)
+    {
+        const std::span bytes{reinterpret_cast<const uint8_t*>(data.data()), data.size_bytes()};  // NOLINT
+        RecordWithData(opcode, bytes, args...);
+    }
+
+private:
+    template <typename... Args>
+    void Write(GlTraceOpcode opcode, std::span<const uint8_t> data, const Args&... args) noexcept
+    {
+        static_assert((std::is_trivially_copyable_v<Args> && ...));
+        constexpr size_t args_size = (sizeof(Args) + ... + 0);
+        static_assert(args_size <= 255);
+
+        const auto data_size = static_cast<uint32_t>(data.size());
+        const size_t begin = bytes_.size();
+        bytes_.resize(begin + 2 + sizeof(data_size) + args_size + data.size());
+        uint8_t* out = bytes_.data() + begin;
+        *out++ = static_cast<uint8_t>(opcode);
+        *out++ = static_cast<uint8_t>(args_size);
+        std::memcpy(out, &data_size, sizeof(data_size));
+        out += sizeof(data_size);
+        ((std::memcpy(out, &args, sizeof(Args)), out += sizeof(Args)), ...);
+        if (!data.empty()) std::memcpy(out, data.data(), data.size());
+    }
+
+private:
+    static inline thread_local GlTraceRecorder* active_ = nullptr;
+    std::vector<uint8_t> bytes_;
+};
+
+}  // namespace klgl
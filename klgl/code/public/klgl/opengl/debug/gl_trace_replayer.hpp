@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+
+#include "ankerl/unordered_dense.h"
+#include "klgl/opengl/debug/gl_trace.hpp"
+#include "magic_enum/magic_enum.hpp"
+
+namespace klgl
+{
+
+struct GlTraceStats
+{
+    [[nodiscard]] size_t GetCallsCount(GlTraceOpcode opcode) const noexcept
+    {
+        return calls_per_opcode[static_cast<size_t>(opcode)];
+    }
+
+    std::array<size_t, magic_enum::enum_count<GlTraceOpcode>()> calls_per_opcode{};
+    size_t calls = 0;
+    size_t draw_calls = 0;
+    size_t frames = 0;
+
+    // Bytes referenced by calls: buffer uploads, pixels, shader sources and uniform values
+    size_t data_bytes = 0;
+};
+
+class GlTraceReplayer
+{
+public:
+    // Counting null backend. Walks the trace without touching OpenGL, so it works without a context
+    [[nodiscard]] static GlTraceStats Count(const GlTrace& trace);
+
+    // Re-issues the trace against the context current on this thread. Object names from the trace are mapped to
+    // objects created during replay. on_frame_end is invoked at each frame boundary, usually to swap buffers.
+    // Uniform locations are used as recorded, so the trace has to be replayed on the same driver it was recorded on
+    void Replay(const GlTrace& trace, const std::function<void()>& on_frame_end = {});
+
+private:
+    [[nodiscard]] GLuint MapName(GlObjectKind kind, GLuint name) const;
+    void AddName(GlObjectKind kind, GLuint recorded, GLuint created);
+    void ReplayCall(const GlTrace::Call& call);
+
+private:
+    std::array<ankerl::unordered_dense::map<GLuint, GLuint>, magic_enum::enum_count<GlObjectKind>()> names_;
+};
+
+}  // namespace klgl
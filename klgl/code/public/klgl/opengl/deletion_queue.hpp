@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+#include "klgl/opengl/enums.hpp"
+#include "klgl/opengl/identifiers.hpp"
+
+namespace klgl
+{
+
+// Objects released by GlObject in the middle of a frame wait here and are deleted in batches: one glDelete* call per
+// object kind. In Fence mode a batch waits for the fence inserted at the end of its frame, so the driver does not
+// have to synchronize with commands that still use the objects.
+// Default mode is Immediate: nothing is queued until Application selects another mode.
+// Thread safe. Deletion happens on the thread that calls OnFrameEnd or Flush, so objects that are not shared between
+// contexts (vertex arrays) must be released on that thread too.
+class GlDeletionQueue
+{
+public:
+    // Switching to Immediate mode flushes the queue
+    static void SetMode(GlDeletionMode mode);
+    [[nodiscard]] static GlDeletionMode GetMode();
+
+    // Return false in Immediate mode, the caller has to delete the object itself
+    [[nodiscard]] static bool Enqueue(GlBufferId buffer);
+    [[nodiscard]] static bool Enqueue(GlVertexArrayId array);
+    [[nodiscard]] static bool Enqueue(GlTextureId texture);
+    [[nodiscard]] static bool Enqueue(GlShaderId shader);
+    [[nodiscard]] static bool Enqueue(GlProgramId program);
+    [[nodiscard]] static bool Enqueue(GlProgramPipelineId pipeline);
+
+    // Called by Application after the frame was submitted. Deletes objects released during the frame (FrameEnd mode)
+    // or objects of the frames that GPU has finished (Fence mode)
+    static void OnFrameEnd();
+
+    // Deletes all queued objects without waiting for fences
+    static void Flush();
+
+    // Number of objects waiting for deletion
+    [[nodiscard]] static size_t GetPendingCount();
+};
+
+}  // namespace klgl
@@ -5,7 +5,11 @@
 #include "identifiers_impl.hpp"
 #include "klgl/camera/viewport.hpp"
 #include "klgl/opengl/debug/annotations.hpp"
+#include "klgl/opengl/debug/gl_frame_stats.hpp"
+#include "klgl/opengl/debug/gl_memory_tracker.hpp"
+#include "klgl/opengl/debug/gl_trace.hpp"
 #include "klgl/opengl/detail/maps/gl_value_to_gl_error.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/active_uniform_int_parameter.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/buffer_type.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/cull_face_mode.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/depth_texture_compare_function.hpp"
@@ -13,9 +17,12 @@
 #include "klgl/opengl/detail/maps/to_gl_value/framebuffer_attachment.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/framebuffer_bind_target.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/index_buffer_element_type.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/pixel_buffer_channel_type.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/pixel_buffer_layout.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/polygon_mode.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/primitive_type.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/program_int_parameter.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/shader_stage_bit.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/shader_type.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/target_texture_type.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/texture_filter.hpp"
@@ -23,10 +30,12 @@
 #include "klgl/opengl/detail/maps/to_gl_value/texture_param_type.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/texture_wrap_axis.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/texture_wrap_mode.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/uniform_block_int_parameter.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/uniform_type.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/usage.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/vertex_attrib_component_type.hpp"
 #include "klgl/opengl/detail/maps/to_gl_value/vertex_attribute_type.hpp"
+#include "klgl/opengl/state_cache.hpp"
 #include "klgl/opengl/gl_api.hpp"
 #include "klgl/opengl/open_gl_error.hpp"
 
@@ -73,9 +82,55 @@ struct OpenGl::Internal
 
     [[nodiscard]] static constexpr GLboolean CastBool(bool value) noexcept { return static_cast<GLboolean>(value); }
 
+    // Texture parameters are stored in the trace as plain glTexParameteri arguments
+    static void TraceTexParameter(GlTargetTextureType target, GLenum parameter, GLint value) noexcept
+    {
+        GlTraceRecorder::Record(GlTraceOpcode::TexParameter, target, parameter, value);
+    }
+
+    static void TraceTextureParameter(GlTextureId texture, GLenum parameter, GLint value) noexcept
+    {
+        GlTraceRecorder::Record(GlTraceOpcode::TextureParameter, texture.GetValue(), parameter, value);
+    }
+
+    // Uniform values are stored as data so a single value and an array use the same opcode
+    template <typename T>
+    static void TraceUniform(GlTraceOpcode opcode, uint32_t location, const T& value, bool transpose) noexcept
+    {
+        TraceUniformArray(opcode, location, std::span<const T>{&value, 1}, transpose);
+    }
+
+    template <typename T>
+    static void
+    TraceUniformArray(GlTraceOpcode opcode, uint32_t location, std::span<const T> values, bool transpose) noexcept
+    {
+        GlTraceRecorder::RecordWithData(opcode, values, location, transpose);
+    }
+
+    // Sources are joined because the trace keeps one data block per call
+    static void TraceShaderSource(GlShaderId shader, std::span<const std::string_view> sources) noexcept
+    {
+        [[likely]] if (!GlTraceRecorder::IsActive()) return;
+
+        std::string joined;
+        for (const std::string_view& source : sources) joined.append(source);
+        GlTraceRecorder::RecordWithData(
+            GlTraceOpcode::ShaderSource,
+            std::span{reinterpret_cast<const uint8_t*>(joined.data()), joined.size()},  // NOLINT
+            shader.GetValue());
+    }
+
+    // In other modes errors are collected by OpenGl::CheckFrameErrors
+    [[nodiscard]] static bool ChecksEachCall() noexcept
+    {
+        return OpenGl::GetErrorCheckMode() == GlErrorCheckMode::PerCall;
+    }
+
     template <typename... Args>
     static void Check(fmt::format_string<Args...> format_string, Args&&... args)
     {
+        if (!ChecksEachCall()) return;
+
         [[unlikely]] if (const auto error = OpenGl::GetError(); error != GlError::NoError)
         {
             std::string message = fmt::format("OpenGL error: {}. Context: ", error);
@@ -84,6 +139,17 @@ struct OpenGl::Internal
         }
     }
 
+    // The cache assumed the state was changed by the failed call
+    [[nodiscard]] static std::optional<OpenGlError> InvalidateCacheOnError(std::optional<OpenGlError> error) noexcept
+    {
+        [[unlikely]] if (error.has_value())
+        {
+            GlStateCache::Get().Invalidate();
+        }
+
+        return error;
+    }
+
     static void ThrowIfError(std::optional<OpenGlError> error)
     {
         [[unlikely]] if (error.has_value())
@@ -111,6 +177,8 @@ struct OpenGl::Internal
     template <typename... Args>
     [[nodiscard]] static std::optional<OpenGlError> ConsumeError(fmt::format_string<Args...> format, Args&&... args)
     {
+        if (!ChecksEachCall()) return std::nullopt;
+
         if (GlError e = OpenGl::GetError(); e != GlError::NoError)
         {
             std::string message = fmt::format("OpenGL error: {}. Context: ", e);
@@ -125,6 +193,8 @@ struct OpenGl::Internal
     [[nodiscard]] static tl::expected<std::decay_t<T>, OpenGlError>
     ValueOrError(T&& value, fmt::format_string<Args...> format, Args&&... args) noexcept
     {
+        if (!ChecksEachCall()) return std::forward<T>(value);
+
         if (GlError e = OpenGl::GetError(); e != GlError::NoError)
         {
             return tl::unexpected{
@@ -142,16 +212,21 @@ struct OpenGl::Internal
             static_cast<GLsizei>(identifiers.size()),
             reinterpret_cast<Identifier::Repr*>(identifiers.data())  // NOLINT
         );
+        GlTraceRecorder::RecordWithData(
+            GlTraceOpcode::GenObjects,
+            std::span<const Identifier>{identifiers},
+            Traits::kind);
+        GlMemoryTracker::OnCreated(
+            Traits::kind,
+            std::span{reinterpret_cast<const Identifier::Repr*>(identifiers.data()), identifiers.size()}  // NOLINT
+        );
     }
 
     template <typename Identifier>
     [[nodiscard]] static std::optional<OpenGlError> GenManyCE(std::span<Identifier> identifiers)
     {
         using Traits = detail::IdTraits<Identifier>;
-        (*Traits::generator)(
-            static_cast<GLsizei>(identifiers.size()),
-            reinterpret_cast<Identifier::Repr*>(identifiers.data())  // NOLINT
-        );
+        GenManyNE(identifiers);
         return ConsumeError(
             "{}(n: {}, array: {})",
             Traits::generator_name,
@@ -223,7 +298,16 @@ GlError OpenGl::GetError() noexcept
 
 void OpenGl::ThrowIfError()
 {
-    Internal::ThrowIfError(Internal::ConsumeError(""));
+    // Explicit check, so it polls regardless of the error check mode
+    [[unlikely]] if (const GlError error = GetError(); error != GlError::NoError)
+    {
+        throw OpenGlError(error, fmt::format("OpenGL error: {}", error));
+    }
+}
+
+void OpenGl::InvalidateStateCache() noexcept
+{
+    GlStateCache::Get().Invalidate();
 }
 
 /************************************************** Buffers *******************************************************/
@@ -266,13 +350,22 @@ GlBufferId OpenGl::GenBuffer()
 
 void OpenGl::BindBufferNE(GlBufferType target, GlBufferId buffer) noexcept
 {
-    glBindBuffer(ToGlValue(target), buffer.GetValue());
+    if (GlStateCache::Get().BindBuffer(target, buffer))
+    {
+        glBindBuffer(ToGlValue(target), buffer.GetValue());
+        GlTraceRecorder::Record(GlTraceOpcode::BindBuffer, target, buffer.GetValue());
+        GlFrameStatsRegistry::OnStateChange();
+    }
 }
 
 std::optional<OpenGlError> OpenGl::BindBufferCE(GlBufferType target, GlBufferId buffer) noexcept
 {
-    BindBufferNE(target, buffer);
-    return Internal::ConsumeError("glBindBuffer(target: {}, buffer: {})", target, buffer.GetValue());
+    if (!GlStateCache::Get().BindBuffer(target, buffer)) return std::nullopt;
+    glBindBuffer(ToGlValue(target), buffer.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::BindBuffer, target, buffer.GetValue());
+    GlFrameStatsRegistry::OnStateChange();
+    return Internal::InvalidateCacheOnError(
+        Internal::ConsumeError("glBindBuffer(target: {}, buffer: {})", target, buffer.GetValue()));
 }
 
 void OpenGl::BindBuffer(GlBufferType target, GlBufferId buffer)
@@ -280,11 +373,81 @@ void OpenGl::BindBuffer(GlBufferType target, GlBufferId buffer)
     Internal::ThrowIfError(BindBufferCE(target, buffer));
 }
 
+// Bind base
+
+void OpenGl::BindBufferBaseNE(GlBufferType target, uint32_t index, GlBufferId buffer) noexcept
+{
+    glBindBufferBase(ToGlValue(target), index, buffer.GetValue());
+    GlStateCache::Get().OnBufferBoundToIndex(target, buffer);
+    GlTraceRecorder::Record(GlTraceOpcode::BindBufferBase, target, index, buffer.GetValue());
+    GlFrameStatsRegistry::OnStateChange();
+}
+
+std::optional<OpenGlError> OpenGl::BindBufferBaseCE(GlBufferType target, uint32_t index, GlBufferId buffer) noexcept
+{
+    BindBufferBaseNE(target, index, buffer);
+    return Internal::ConsumeError(
+        "glBindBufferBase(target: {}, index: {}, buffer: {})",
+        target,
+        index,
+        buffer.GetValue());
+}
+
+void OpenGl::BindBufferBase(GlBufferType target, uint32_t index, GlBufferId buffer)
+{
+    Internal::ThrowIfError(BindBufferBaseCE(target, index, buffer));
+}
+
+// Bind range
+
+void OpenGl::BindBufferRangeNE(
+    GlBufferType target,
+    uint32_t index,
+    GlBufferId buffer,
+    size_t offset,
+    size_t size) noexcept
+{
+    glBindBufferRange(
+        ToGlValue(target),
+        index,
+        buffer.GetValue(),
+        static_cast<GLintptr>(offset),
+        static_cast<GLsizeiptr>(size));
+    GlStateCache::Get().OnBufferBoundToIndex(target, buffer);
+    GlTraceRecorder::Record(GlTraceOpcode::BindBufferRange, target, index, buffer.GetValue(), offset, size);
+    GlFrameStatsRegistry::OnStateChange();
+}
+
+std::optional<OpenGlError> OpenGl::BindBufferRangeCE(
+    GlBufferType target,
+    uint32_t index,
+    GlBufferId buffer,
+    size_t offset,
+    size_t size) noexcept
+{
+    BindBufferRangeNE(target, index, buffer, offset, size);
+    return Internal::ConsumeError(
+        "glBindBufferRange(target: {}, index: {}, buffer: {}, offset: {}, size: {})",
+        target,
+        index,
+        buffer.GetValue(),
+        offset,
+        size);
+}
+
+void OpenGl::BindBufferRange(GlBufferType target, uint32_t index, GlBufferId buffer, size_t offset, size_t size)
+{
+    Internal::ThrowIfError(BindBufferRangeCE(target, index, buffer, offset, size));
+}
+
 // Buffer Data (with data)
 
 void OpenGl::BufferDataNE(GlBufferType target, std::span<const uint8_t> data, GlUsage usage) noexcept
 {
     glBufferData(ToGlValue(target), static_cast<GLsizei>(data.size()), data.data(), ToGlValue(usage));
+    GlTraceRecorder::RecordWithData(GlTraceOpcode::BufferData, data, target, data.size(), usage);
+    GlFrameStatsRegistry::OnBufferUpload(data.size());
+    GlMemoryTracker::OnBufferData(target, data.size());
 }
 
 std::optional<OpenGlError>
@@ -309,6 +472,8 @@ void OpenGl::BufferData(GlBufferType target, std::span<const uint8_t> data, GlUs
 void OpenGl::BufferDataNE(GlBufferType target, size_t buffer_size, GlUsage usage) noexcept
 {
     glBufferData(ToGlValue(target), static_cast<GLsizei>(buffer_size), nullptr, ToGlValue(usage));
+    GlTraceRecorder::Record(GlTraceOpcode::BufferData, target, buffer_size, usage);
+    GlMemoryTracker::OnBufferData(target, buffer_size);
 }
 
 std::optional<OpenGlError> OpenGl::BufferDataCE(GlBufferType target, size_t buffer_size, GlUsage usage) noexcept
@@ -335,6 +500,8 @@ void OpenGl::BufferSubDataNE(GlBufferType target, size_t offset_elements, std::s
         static_cast<GLintptr>(offset_elements),
         static_cast<GLsizeiptr>(data.size()),
         data.data());
+    GlTraceRecorder::RecordWithData(GlTraceOpcode::BufferSubData, data, target, offset_elements);
+    GlFrameStatsRegistry::OnBufferUpload(data.size());
 }
 
 std::optional<OpenGlError>
@@ -358,7 +525,7 @@ void OpenGl::BufferSubData(GlBufferType target, size_t offset_elements, std::spa
 
 void OpenGl::DeleteBufferNE(GlBufferId buffer) noexcept
 {
-    glDeleteBuffers(1, &buffer.GetValue());
+    DeleteBuffersNE(std::span{&buffer, 1});
 }
 
 std::optional<OpenGlError> OpenGl::DeleteBufferCE(GlBufferId buffer) noexcept
@@ -372,6 +539,190 @@ void OpenGl::DeleteBuffer(GlBufferId buffer)
     Internal::ThrowIfError(DeleteBufferCE(buffer));
 }
 
+void OpenGl::DeleteBuffersNE(std::span<const GlBufferId> buffers) noexcept
+{
+    for (const GlBufferId buffer : buffers)
+    {
+        GlStateCache::Get().OnBufferDeleted(buffer);
+    }
+
+    const auto* names = reinterpret_cast<const GLuint*>(buffers.data());  // NOLINT
+    glDeleteBuffers(static_cast<GLsizei>(buffers.size()), names);
+
+    for (const GlBufferId buffer : buffers)
+    {
+        GlTraceRecorder::Record(GlTraceOpcode::DeleteObject, GlObjectKind::Buffer, buffer.GetValue());
+        GlMemoryTracker::OnDeleted(GlObjectKind::Buffer, buffer.GetValue());
+    }
+}
+
+std::optional<OpenGlError> OpenGl::DeleteBuffersCE(std::span<const GlBufferId> buffers) noexcept
+{
+    DeleteBuffersNE(buffers);
+    return Internal::ConsumeError("glDeleteBuffers(n: {})", buffers.size());
+}
+
+void OpenGl::DeleteBuffers(std::span<const GlBufferId> buffers)
+{
+    Internal::ThrowIfError(DeleteBuffersCE(buffers));
+}
+
+// Buffer storage
+
+void OpenGl::BufferStorageNE(GlBufferType target, size_t buffer_size, const void* data, GLbitfield flags) noexcept
+{
+    glBufferStorage(ToGlValue(target), static_cast<GLsizeiptr>(buffer_size), data, flags);
+    GlTraceRecorder::RecordWithData(
+        GlTraceOpcode::BufferStorage,
+        data ? std::span{static_cast<const uint8_t*>(data), buffer_size} : std::span<const uint8_t>{},
+        target,
+        buffer_size,
+        flags);
+    if (data) GlFrameStatsRegistry::OnBufferUpload(buffer_size);
+    GlMemoryTracker::OnBufferData(target, buffer_size);
+}
+
+std::optional<OpenGlError>
+OpenGl::BufferStorageCE(GlBufferType target, size_t buffer_size, const void* data, GLbitfield flags) noexcept
+{
+    BufferStorageNE(target, buffer_size, data, flags);
+    return Internal::ConsumeError(
+        "glBufferStorage(target: {}, size: {}, data: {}, flags: {:#x})",
+        target,
+        buffer_size,
+        data,
+        flags);
+}
+
+void OpenGl::BufferStorage(GlBufferType target, size_t buffer_size, const void* data, GLbitfield flags)
+{
+    Internal::ThrowIfError(BufferStorageCE(target, buffer_size, data, flags));
+}
+
+// Map buffer range
+
+void* OpenGl::MapBufferRangeNE(GlBufferType target, size_t offset, size_t size, GLbitfield access) noexcept
+{
+    return glMapBufferRange(ToGlValue(target), static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), access);
+}
+
+tl::expected<void*, OpenGlError>
+OpenGl::MapBufferRangeCE(GlBufferType target, size_t offset, size_t size, GLbitfield access) noexcept
+{
+    return Internal::ValueOrError(
+        MapBufferRangeNE(target, offset, size, access),
+        "glMapBufferRange(target: {}, offset: {}, length: {}, access: {:#x})",
+        target,
+        offset,
+        size,
+        access);
+}
+
+void* OpenGl::MapBufferRange(GlBufferType target, size_t offset, size_t size, GLbitfield access)
+{
+    return Internal::TryTakeValue(MapBufferRangeCE(target, offset, size, access));
+}
+
+// Unmap buffer
+
+bool OpenGl::UnmapBufferNE(GlBufferType target) noexcept
+{
+    return glUnmapBuffer(ToGlValue(target)) == GL_TRUE;
+}
+
+tl::expected<bool, OpenGlError> OpenGl::UnmapBufferCE(GlBufferType target) noexcept
+{
+    return Internal::ValueOrError(UnmapBufferNE(target), "glUnmapBuffer(target: {})", target);
+}
+
+bool OpenGl::UnmapBuffer(GlBufferType target)
+{
+    return Internal::TryTakeValue(UnmapBufferCE(target));
+}
+
+// Clear buffer sub data
+
+void OpenGl::ClearBufferSubDataNE(GlBufferType target, size_t offset, size_t size) noexcept
+{
+    // Null data means the range is filled with zeros. Single byte format works for any offset and size
+    glClearBufferSubData(
+        ToGlValue(target),
+        GL_R8UI,
+        static_cast<GLintptr>(offset),
+        static_cast<GLsizeiptr>(size),
+        GL_RED_INTEGER,
+        GL_UNSIGNED_BYTE,
+        nullptr);
+    GlTraceRecorder::Record(GlTraceOpcode::ClearBufferSubData, target, offset, size);
+}
+
+std::optional<OpenGlError> OpenGl::ClearBufferSubDataCE(GlBufferType target, size_t offset, size_t size) noexcept
+{
+    ClearBufferSubDataNE(target, offset, size);
+    return Internal::ConsumeError(
+        "glClearBufferSubData(target: {}, internalformat: GL_R8UI, offset: {}, size: {}, format: GL_RED_INTEGER, "
+        "type: GL_UNSIGNED_BYTE, data: nullptr)",
+        target,
+        offset,
+        size);
+}
+
+void OpenGl::ClearBufferSubData(GlBufferType target, size_t offset, size_t size)
+{
+    Internal::ThrowIfError(ClearBufferSubDataCE(target, offset, size));
+}
+
+// Copy buffer sub data
+
+void OpenGl::CopyBufferSubDataNE(
+    GlBufferType read_target,
+    GlBufferType write_target,
+    size_t read_offset,
+    size_t write_offset,
+    size_t size) noexcept
+{
+    glCopyBufferSubData(
+        ToGlValue(read_target),
+        ToGlValue(write_target),
+        static_cast<GLintptr>(read_offset),
+        static_cast<GLintptr>(write_offset),
+        static_cast<GLsizeiptr>(size));
+    GlTraceRecorder::Record(
+        GlTraceOpcode::CopyBufferSubData,
+        read_target,
+        write_target,
+        read_offset,
+        write_offset,
+        size);
+}
+
+std::optional<OpenGlError> OpenGl::CopyBufferSubDataCE(
+    GlBufferType read_target,
+    GlBufferType write_target,
+    size_t read_offset,
+    size_t write_offset,
+    size_t size) noexcept
+{
+    CopyBufferSubDataNE(read_target, write_target, read_offset, write_offset, size);
+    return Internal::ConsumeError(
+        "glCopyBufferSubData(readTarget: {}, writeTarget: {}, readOffset: {}, writeOffset: {}, size: {})",
+        read_target,
+        write_target,
+        read_offset,
+        write_offset,
+        size);
+}
+
+void OpenGl::CopyBufferSubData(
+    GlBufferType read_target,
+    GlBufferType write_target,
+    size_t read_offset,
+    size_t write_offset,
+    size_t size)
+{
+    Internal::ThrowIfError(CopyBufferSubDataCE(read_target, write_target, read_offset, write_offset, size));
+}
+
 /*********************************************** Vertex Arrays ****************************************************/
 
 // Gen many
@@ -412,13 +763,22 @@ GlVertexArrayId OpenGl::GenVertexArray()
 
 void OpenGl::BindVertexArrayNE(GlVertexArrayId array) noexcept
 {
-    glBindVertexArray(array.GetValue());
+    if (GlStateCache::Get().BindVertexArray(array))
+    {
+        glBindVertexArray(array.GetValue());
+        GlTraceRecorder::Record(GlTraceOpcode::BindVertexArray, array.GetValue());
+        GlFrameStatsRegistry::OnStateChange();
+    }
 }
 
 std::optional<OpenGlError> OpenGl::BindVertexArrayCE(GlVertexArrayId array) noexcept
 {
-    BindVertexArrayNE(array);
-    return Internal::ConsumeError("glBindVertexArray(array: {})", array.GetValue());
+    if (!GlStateCache::Get().BindVertexArray(array)) return std::nullopt;
+    glBindVertexArray(array.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::BindVertexArray, array.GetValue());
+    GlFrameStatsRegistry::OnStateChange();
+    return Internal::InvalidateCacheOnError(
+        Internal::ConsumeError("glBindVertexArray(array: {})", array.GetValue()));
 }
 
 void OpenGl::BindVertexArray(GlVertexArrayId array)
@@ -430,7 +790,7 @@ void OpenGl::BindVertexArray(GlVertexArrayId array)
 
 void OpenGl::DeleteVertexArrayNE(GlVertexArrayId array) noexcept
 {
-    glDeleteVertexArrays(1, &array.GetValue());
+    DeleteVertexArraysNE(std::span{&array, 1});
 }
 
 std::optional<OpenGlError> OpenGl::DeleteVertexArrayCE(GlVertexArrayId array) noexcept
@@ -444,6 +804,34 @@ void OpenGl::DeleteVertexArray(GlVertexArrayId array)
     Internal::ThrowIfError(DeleteVertexArrayCE(array));
 }
 
+void OpenGl::DeleteVertexArraysNE(std::span<const GlVertexArrayId> arrays) noexcept
+{
+    for (const GlVertexArrayId array : arrays)
+    {
+        GlStateCache::Get().OnVertexArrayDeleted(array);
+    }
+
+    const auto* names = reinterpret_cast<const GLuint*>(arrays.data());  // NOLINT
+    glDeleteVertexArrays(static_cast<GLsizei>(arrays.size()), names);
+
+    for (const GlVertexArrayId array : arrays)
+    {
+        GlTraceRecorder::Record(GlTraceOpcode::DeleteObject, GlObjectKind::VertexArray, array.GetValue());
+        GlMemoryTracker::OnDeleted(GlObjectKind::VertexArray, array.GetValue());
+    }
+}
+
+std::optional<OpenGlError> OpenGl::DeleteVertexArraysCE(std::span<const GlVertexArrayId> arrays) noexcept
+{
+    DeleteVertexArraysNE(arrays);
+    return Internal::ConsumeError("glDeleteVertexArrays(n: {})", arrays.size());
+}
+
+void OpenGl::DeleteVertexArrays(std::span<const GlVertexArrayId> arrays)
+{
+    Internal::ThrowIfError(DeleteVertexArraysCE(arrays));
+}
+
 /************************************************* Textures *******************************************************/
 
 // Gen many
@@ -484,13 +872,22 @@ GlTextureId OpenGl::GenTexture()
 
 void OpenGl::BindTextureNE(GlTargetTextureType target, GlTextureId texture) noexcept
 {
-    glBindTexture(ToGlValue(target), texture.GetValue());
+    if (GlStateCache::Get().BindTexture(target, texture))
+    {
+        glBindTexture(ToGlValue(target), texture.GetValue());
+        GlTraceRecorder::Record(GlTraceOpcode::BindTexture, target, texture.GetValue());
+        GlFrameStatsRegistry::OnStateChange();
+    }
 }
 
 std::optional<OpenGlError> OpenGl::BindTextureCE(GlTargetTextureType target, GlTextureId texture) noexcept
 {
-    BindTextureNE(target, texture);
-    return Internal::ConsumeError("glBindTexture(target: {}, texture: {})", target, texture.GetValue());
+    if (!GlStateCache::Get().BindTexture(target, texture)) return std::nullopt;
+    glBindTexture(ToGlValue(target), texture.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::BindTexture, target, texture.GetValue());
+    GlFrameStatsRegistry::OnStateChange();
+    return Internal::InvalidateCacheOnError(
+        Internal::ConsumeError("glBindTexture(target: {}, texture: {})", target, texture.GetValue()));
 }
 
 void OpenGl::BindTexture(GlTargetTextureType target, GlTextureId texture)
@@ -498,11 +895,38 @@ void OpenGl::BindTexture(GlTargetTextureType target, GlTextureId texture)
     Internal::ThrowIfError(BindTextureCE(target, texture));
 }
 
+// Active texture
+
+void OpenGl::ActiveTextureNE(uint32_t unit) noexcept
+{
+    if (GlStateCache::Get().ActiveTexture(unit))
+    {
+        glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+        GlTraceRecorder::Record(GlTraceOpcode::ActiveTexture, unit);
+        GlFrameStatsRegistry::OnStateChange();
+    }
+}
+
+std::optional<OpenGlError> OpenGl::ActiveTextureCE(uint32_t unit) noexcept
+{
+    if (!GlStateCache::Get().ActiveTexture(unit)) return std::nullopt;
+    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+    GlTraceRecorder::Record(GlTraceOpcode::ActiveTexture, unit);
+    GlFrameStatsRegistry::OnStateChange();
+    return Internal::InvalidateCacheOnError(Internal::ConsumeError("glActiveTexture(texture: GL_TEXTURE0 + {})", unit));
+}
+
+void OpenGl::ActiveTexture(uint32_t unit)
+{
+    Internal::ThrowIfError(ActiveTextureCE(unit));
+}
+
 // Set base level
 
 void OpenGl::SetTextureBaseLevelNE(GlTargetTextureType target, size_t level) noexcept
 {
     glTexParameteri(ToGlValue(target), GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(level));
+    Internal::TraceTexParameter(target, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(level));
 }
 
 std::optional<OpenGlError> OpenGl::SetTextureBaseLevelCE(GlTargetTextureType target, size_t level) noexcept
@@ -546,6 +970,7 @@ void OpenGl::SetDepthTextureCompareFunctionNE(
     GlDepthTextureCompareFunction function) noexcept
 {
     glTexParameteri(ToGlValue(target), ToGlValue(GlTextureParameterType::ComapreFunction), ToGlValue(function));
+    Internal::TraceTexParameter(target, ToGlValue(GlTextureParameterType::ComapreFunction), ToGlValue(function));
 }
 
 [[nodiscard]] std::optional<OpenGlError> OpenGl::SetDepthTextureCompareFunctionCE(
@@ -681,6 +1106,7 @@ void OpenGl::SetTextureLODBias(GlTargetTextureType target, float bias)
 void OpenGl::SetTextureWrapNE(GlTargetTextureType target, GlTextureWrapAxis wrap, GlTextureWrapMode mode) noexcept
 {
     glTexParameteri(ToGlValue(target), ToGlValue(wrap), ToGlValue(mode));
+    Internal::TraceTexParameter(target, ToGlValue(wrap), ToGlValue(mode));
 }
 
 [[nodiscard]] std::optional<OpenGlError>
@@ -700,6 +1126,7 @@ void OpenGl::SetTextureWrap(GlTargetTextureType target, GlTextureWrapAxis wrap,
 void OpenGl::SetTextureMinFilterNE(GlTargetTextureType target, GlTextureFilter filter) noexcept
 {
     glTexParameteri(ToGlValue(target), ToGlValue(GlTextureParameterType::MinificationFilter), ToGlValue(filter));
+    Internal::TraceTexParameter(target, ToGlValue(GlTextureParameterType::MinificationFilter), ToGlValue(filter));
 }
 
 std::optional<OpenGlError> OpenGl::SetTextureMinFilterCE(GlTargetTextureType target, GlTextureFilter filter) noexcept
@@ -722,6 +1149,7 @@ void OpenGl::SetTextureMinFilter(GlTargetTextureType target, GlTextureFilter fil
 void OpenGl::SetTextureMagFilterNE(GlTargetTextureType target, GlTextureFilter filter) noexcept
 {
     glTexParameteri(ToGlValue(target), ToGlValue(GlTextureParameterType::MagnificationFilter), ToGlValue(filter));
+    Internal::TraceTexParameter(target, ToGlValue(GlTextureParameterType::MagnificationFilter), ToGlValue(filter));
 }
 
 std::optional<OpenGlError> OpenGl::SetTextureMagFilterCE(GlTargetTextureType target, GlTextureFilter filter) noexcept
@@ -761,6 +1189,18 @@ void OpenGl::TexImage2dNE(
         data_format,
         pixel_data_type,
         pixels);
+
+    // Size of pixel data is unknown here, so the trace keeps only the allocation
+    GlTraceRecorder::Record(
+        GlTraceOpcode::TexImage2d,
+        target,
+        level_of_detail,
+        internal_format,
+        width,
+        height,
+        data_format,
+        pixel_data_type);
+    GlMemoryTracker::OnTexImage(target, level_of_detail, internal_format, width, height);
 }
 
 std::optional<OpenGlError> OpenGl::TexImage2dCE(
@@ -801,11 +1241,84 @@ void OpenGl::TexImage2d(
         TexImage2dCE(target, level_of_detail, internal_format, width, height, data_format, pixel_data_type, pixels));
 }
 
+// Tex sub image 2d
+
+void OpenGl::TexSubImage2dNE(
+    GlTargetTextureType target,
+    size_t level_of_detail,
+    const edt::Vec2<size_t>& offset,
+    const edt::Vec2<size_t>& size,
+    GlPixelBufferLayout layout,
+    GlPixelBufferChannelType type,
+    std::span<const uint8_t> pixels) noexcept
+{
+    const auto offset_i = offset.Cast<GLint>();
+    const auto size_i = size.Cast<GLsizei>();
+    glTexSubImage2D(
+        ToGlValue(target),
+        static_cast<GLint>(level_of_detail),
+        offset_i.x(),
+        offset_i.y(),
+        size_i.x(),
+        size_i.y(),
+        ToGlValue(layout),
+        ToGlValue(type),
+        pixels.data());
+    GlTraceRecorder::RecordWithData(
+        GlTraceOpcode::TexSubImage2d,
+        pixels,
+        target,
+        level_of_detail,
+        offset.x(),
+        offset.y(),
+        size.x(),
+        size.y(),
+        layout,
+        type);
+    GlFrameStatsRegistry::OnTextureUpload(pixels.size());
+}
+
+std::optional<OpenGlError> OpenGl::TexSubImage2dCE(
+    GlTargetTextureType target,
+    size_t level_of_detail,
+    const edt::Vec2<size_t>& offset,
+    const edt::Vec2<size_t>& size,
+    GlPixelBufferLayout layout,
+    GlPixelBufferChannelType type,
+    std::span<const uint8_t> pixels) noexcept
+{
+    TexSubImage2dNE(target, level_of_detail, offset, size, layout, type, pixels);
+    return Internal::ConsumeError(
+        "glTexSubImage2D(target: {}, lod: {}, x: {}, y: {}, width: {}, height: {}, pixel_buffer_layout: {}, "
+        "pixel_buffer_type: {}, pixels: {})",
+        target,
+        level_of_detail,
+        offset.x(),
+        offset.y(),
+        size.x(),
+        size.y(),
+        layout,
+        type,
+        static_cast<const void*>(pixels.data()));
+}
+
+void OpenGl::TexSubImage2d(
+    GlTargetTextureType target,
+    size_t level_of_detail,
+    const edt::Vec2<size_t>& offset,
+    const edt::Vec2<size_t>& size,
+    GlPixelBufferLayout layout,
+    GlPixelBufferChannelType type,
+    std::span<const uint8_t> pixels)
+{
+    Internal::ThrowIfError(TexSubImage2dCE(target, level_of_detail, offset, size, layout, type, pixels));
+}
+
 // Delete
 
 void OpenGl::DeleteTextureNE(GlTextureId texture) noexcept
 {
-    glDeleteTextures(1, &texture.GetValue());
+    DeleteTexturesNE(std::span{&texture, 1});
 }
 
 std::optional<OpenGlError> OpenGl::DeleteTextureCE(GlTextureId texture) noexcept
@@ -819,63 +1332,736 @@ void OpenGl::DeleteTexture(GlTextureId texture)
     Internal::ThrowIfError(DeleteTextureCE(texture));
 }
 
-/************************************************** Framebuffers **************************************************/
+void OpenGl::DeleteTexturesNE(std::span<const GlTextureId> textures) noexcept
+{
+    for (const GlTextureId texture : textures)
+    {
+        GlStateCache::Get().OnTextureDeleted(texture);
+    }
 
-// Gen many
+    const auto* names = reinterpret_cast<const GLuint*>(textures.data());  // NOLINT
+    glDeleteTextures(static_cast<GLsizei>(textures.size()), names);
 
-void OpenGl::GenFramebuffersNE(const std::span<GlFramebufferId>& framebuffers) noexcept
-{
-    Internal::GenManyNE(framebuffers);
+    for (const GlTextureId texture : textures)
+    {
+        GlTraceRecorder::Record(GlTraceOpcode::DeleteObject, GlObjectKind::Texture, texture.GetValue());
+        GlMemoryTracker::OnDeleted(GlObjectKind::Texture, texture.GetValue());
+    }
 }
 
-std::optional<OpenGlError> OpenGl::GenFramebuffersCE(const std::span<GlFramebufferId>& framebuffers) noexcept
+std::optional<OpenGlError> OpenGl::DeleteTexturesCE(std::span<const GlTextureId> textures) noexcept
 {
-    return Internal::GenManyCE(framebuffers);
+    DeleteTexturesNE(textures);
+    return Internal::ConsumeError("glDeleteTextures(n: {})", textures.size());
 }
 
-void OpenGl::GenFramebuffers(const std::span<GlFramebufferId>& framebuffers)
+void OpenGl::DeleteTextures(std::span<const GlTextureId> textures)
 {
-    Internal::GenMany(framebuffers);
+    Internal::ThrowIfError(DeleteTexturesCE(textures));
 }
 
-// Gen one
+/********************************************* Direct State Access ************************************************/
 
-GlFramebufferId OpenGl::GenFramebufferNE() noexcept
+// Create buffer
+
+GlBufferId OpenGl::CreateBufferNE() noexcept
 {
-    return Internal::GenOneNE<GlFramebufferId>();
+    GlBufferId buffer{};
+    CreateBuffersNE(std::span{&buffer, 1});
+    return buffer;
 }
 
-tl::expected<GlFramebufferId, OpenGlError> OpenGl::GenFramebufferCE() noexcept
+tl::expected<GlBufferId, OpenGlError> OpenGl::CreateBufferCE() noexcept
 {
-    return Internal::GenOneCE<GlFramebufferId>();
+    return Internal::ValueOrError(CreateBufferNE(), "glCreateBuffers(n: 1)");
 }
 
-GlFramebufferId OpenGl::GenFramebuffer()
+GlBufferId OpenGl::CreateBuffer()
 {
-    return Internal::GenOne<GlFramebufferId>();
+    return Internal::TryTakeValue(CreateBufferCE());
 }
 
-// Bind
-
-void OpenGl::BindFramebufferNE(GlFramebufferBindTarget target, GlFramebufferId framebuffer) noexcept
+void OpenGl::CreateBuffersNE(const std::span<GlBufferId>& buffers) noexcept
 {
-    glBindFramebuffer(ToGlValue(target), framebuffer.GetValue());
+    auto* names = reinterpret_cast<GLuint*>(buffers.data());  // NOLINT
+    glCreateBuffers(static_cast<GLsizei>(buffers.size()), names);
+
+    // Replayer creates objects one by one, so the trace does not depend on how they were batched
+    for (const GLuint buffer : std::span{names, buffers.size()})
+    {
+        GlTraceRecorder::Record(GlTraceOpcode::CreateBuffer, buffer);
+    }
+
+    GlMemoryTracker::OnCreated(GlObjectKind::Buffer, std::span<const GLuint>{names, buffers.size()});
 }
 
-std::optional<OpenGlError> OpenGl::BindFramebufferCE(
-    GlFramebufferBindTarget target,
-    GlFramebufferId framebuffer) noexcept
+std::optional<OpenGlError> OpenGl::CreateBuffersCE(const std::span<GlBufferId>& buffers) noexcept
 {
-    BindFramebufferNE(target, framebuffer);
-    return Internal::ConsumeError("glBindFramebuffer(target: {}, framebuffer: {})", target, framebuffer.GetValue());
+    CreateBuffersNE(buffers);
+    return Internal::ConsumeError("glCreateBuffers(n: {})", buffers.size());
 }
 
-void OpenGl::BindFramebuffer(GlFramebufferBindTarget target, GlFramebufferId framebuffer)
+void OpenGl::CreateBuffers(const std::span<GlBufferId>& buffers)
 {
-    Internal::ThrowIfError(BindFramebufferCE(target, framebuffer));
+    Internal::ThrowIfError(CreateBuffersCE(buffers));
 }
 
-// Attach texture
+// Named buffer data (just size)
+
+void OpenGl::NamedBufferDataNE(GlBufferId buffer, size_t buffer_size, GlUsage usage) noexcept
+{
+    glNamedBufferData(buffer.GetValue(), static_cast<GLsizeiptr>(buffer_size), nullptr, ToGlValue(usage));
+    GlTraceRecorder::Record(GlTraceOpcode::NamedBufferData, buffer.GetValue(), buffer_size, usage);
+    GlMemoryTracker::OnNamedBufferData(buffer.GetValue(), buffer_size);
+}
+
+std::optional<OpenGlError> OpenGl::NamedBufferDataCE(GlBufferId buffer, size_t buffer_size, GlUsage usage) noexcept
+{
+    NamedBufferDataNE(buffer, buffer_size, usage);
+    return Internal::ConsumeError(
+        "glNamedBufferData(buffer: {}, size: {}, data: nullptr, usage: {})",
+        buffer.GetValue(),
+        buffer_size,
+        usage);
+}
+
+void OpenGl::NamedBufferData(GlBufferId buffer, size_t buffer_size, GlUsage usage)
+{
+    Internal::ThrowIfError(NamedBufferDataCE(buffer, buffer_size, usage));
+}
+
+// Named buffer data (with data)
+
+void OpenGl::NamedBufferDataNE(GlBufferId buffer, std::span<const uint8_t> data, GlUsage usage) noexcept
+{
+    glNamedBufferData(buffer.GetValue(), static_cast<GLsizeiptr>(data.size()), data.data(), ToGlValue(usage));
+    GlTraceRecorder::RecordWithData(GlTraceOpcode::NamedBufferData, data, buffer.GetValue(), data.size(), usage);
+    GlFrameStatsRegistry::OnBufferUpload(data.size());
+    GlMemoryTracker::OnNamedBufferData(buffer.GetValue(), data.size());
+}
+
+std::optional<OpenGlError>
+OpenGl::NamedBufferDataCE(GlBufferId buffer, std::span<const uint8_t> data, GlUsage usage) noexcept
+{
+    NamedBufferDataNE(buffer, data, usage);
+    return Internal::ConsumeError(
+        "glNamedBufferData(buffer: {}, size: {}, data: {}, usage: {})",
+        buffer.GetValue(),
+        data.size(),
+        static_cast<const void*>(data.data()),
+        usage);
+}
+
+void OpenGl::NamedBufferData(GlBufferId buffer, std::span<const uint8_t> data, GlUsage usage)
+{
+    Internal::ThrowIfError(NamedBufferDataCE(buffer, data, usage));
+}
+
+// Named buffer sub data
+
+void OpenGl::NamedBufferSubDataNE(GlBufferId buffer, size_t offset, std::span<const uint8_t> data) noexcept
+{
+    glNamedBufferSubData(
+        buffer.GetValue(),
+        static_cast<GLintptr>(offset),
+        static_cast<GLsizeiptr>(data.size()),
+        data.data());
+    GlTraceRecorder::RecordWithData(GlTraceOpcode::NamedBufferSubData, data, buffer.GetValue(), offset);
+    GlFrameStatsRegistry::OnBufferUpload(data.size());
+}
+
+std::optional<OpenGlError>
+OpenGl::NamedBufferSubDataCE(GlBufferId buffer, size_t offset, std::span<const uint8_t> data) noexcept
+{
+    NamedBufferSubDataNE(buffer, offset, data);
+    return Internal::ConsumeError(
+        "glNamedBufferSubData(buffer: {}, offset: {}, size: {}, data: {})",
+        buffer.GetValue(),
+        offset,
+        data.size(),
+        static_cast<const void*>(data.data()));
+}
+
+void OpenGl::NamedBufferSubData(GlBufferId buffer, size_t offset, std::span<const uint8_t> data)
+{
+    Internal::ThrowIfError(NamedBufferSubDataCE(buffer, offset, data));
+}
+
+// Create vertex array
+
+GlVertexArrayId OpenGl::CreateVertexArrayNE() noexcept
+{
+    GlVertexArrayId array{};
+    CreateVertexArraysNE(std::span{&array, 1});
+    return array;
+}
+
+tl::expected<GlVertexArrayId, OpenGlError> OpenGl::CreateVertexArrayCE() noexcept
+{
+    return Internal::ValueOrError(CreateVertexArrayNE(), "glCreateVertexArrays(n: 1)");
+}
+
+GlVertexArrayId OpenGl::CreateVertexArray()
+{
+    return Internal::TryTakeValue(CreateVertexArrayCE());
+}
+
+void OpenGl::CreateVertexArraysNE(const std::span<GlVertexArrayId>& arrays) noexcept
+{
+    auto* names = reinterpret_cast<GLuint*>(arrays.data());  // NOLINT
+    glCreateVertexArrays(static_cast<GLsizei>(arrays.size()), names);
+
+    for (const GLuint array : std::span{names, arrays.size()})
+    {
+        GlTraceRecorder::Record(GlTraceOpcode::CreateVertexArray, array);
+    }
+
+    GlMemoryTracker::OnCreated(GlObjectKind::VertexArray, std::span<const GLuint>{names, arrays.size()});
+}
+
+std::optional<OpenGlError> OpenGl::CreateVertexArraysCE(const std::span<GlVertexArrayId>& arrays) noexcept
+{
+    CreateVertexArraysNE(arrays);
+    return Internal::ConsumeError("glCreateVertexArrays(n: {})", arrays.size());
+}
+
+void OpenGl::CreateVertexArrays(const std::span<GlVertexArrayId>& arrays)
+{
+    Internal::ThrowIfError(CreateVertexArraysCE(arrays));
+}
+
+// Vertex array element buffer
+
+void OpenGl::VertexArrayElementBufferNE(GlVertexArrayId array, GlBufferId buffer) noexcept
+{
+    glVertexArrayElementBuffer(array.GetValue(), buffer.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::VertexArrayElementBuffer, array.GetValue(), buffer.GetValue());
+}
+
+std::optional<OpenGlError> OpenGl::VertexArrayElementBufferCE(GlVertexArrayId array, GlBufferId buffer) noexcept
+{
+    VertexArrayElementBufferNE(array, buffer);
+    return Internal::ConsumeError(
+        "glVertexArrayElementBuffer(vaobj: {}, buffer: {})",
+        array.GetValue(),
+        buffer.GetValue());
+}
+
+void OpenGl::VertexArrayElementBuffer(GlVertexArrayId array, GlBufferId buffer)
+{
+    Internal::ThrowIfError(VertexArrayElementBufferCE(array, buffer));
+}
+
+// Vertex array vertex buffer
+
+void OpenGl::VertexArrayVertexBufferNE(
+    GlVertexArrayId array,
+    size_t binding_index,
+    GlBufferId buffer,
+    size_t offset,
+    size_t stride) noexcept
+{
+    glVertexArrayVertexBuffer(
+        array.GetValue(),
+        static_cast<GLuint>(binding_index),
+        buffer.GetValue(),
+        static_cast<GLintptr>(offset),
+        static_cast<GLsizei>(stride));
+    GlTraceRecorder::Record(
+        GlTraceOpcode::VertexArrayVertexBuffer,
+        array.GetValue(),
+        binding_index,
+        buffer.GetValue(),
+        offset,
+        stride);
+}
+
+std::optional<OpenGlError> OpenGl::VertexArrayVertexBufferCE(
+    GlVertexArrayId array,
+    size_t binding_index,
+    GlBufferId buffer,
+    size_t offset,
+    size_t stride) noexcept
+{
+    VertexArrayVertexBufferNE(array, binding_index, buffer, offset, stride);
+    return Internal::ConsumeError(
+        "glVertexArrayVertexBuffer(vaobj: {}, bindingindex: {}, buffer: {}, offset: {}, stride: {})",
+        array.GetValue(),
+        binding_index,
+        buffer.GetValue(),
+        offset,
+        stride);
+}
+
+void OpenGl::VertexArrayVertexBuffer(
+    GlVertexArrayId array,
+    size_t binding_index,
+    GlBufferId buffer,
+    size_t offset,
+    size_t stride)
+{
+    Internal::ThrowIfError(VertexArrayVertexBufferCE(array, binding_index, buffer, offset, stride));
+}
+
+// Vertex array attribute format
+
+void OpenGl::VertexArrayAttribFormatNE(
+    GlVertexArrayId array,
+    size_t attribute_index,
+    size_t size,
+    GlVertexAttribComponentType type,
+    bool normalized,
+    size_t relative_offset) noexcept
+{
+    glVertexArrayAttribFormat(
+        array.GetValue(),
+        static_cast<GLuint>(attribute_index),
+        static_cast<GLint>(size),
+        ToGlValue(type),
+        Internal::CastBool(normalized),
+        static_cast<GLuint>(relative_offset));
+    GlTraceRecorder::Record(
+        GlTraceOpcode::VertexArrayAttribFormat,
+        array.GetValue(),
+        attribute_index,
+        size,
+        type,
+        normalized,
+        relative_offset);
+}
+
+std::optional<OpenGlError> OpenGl::VertexArrayAttribFormatCE(
+    GlVertexArrayId array,
+    size_t attribute_index,
+    size_t size,
+    GlVertexAttribComponentType type,
+    bool normalized,
+    size_t relative_offset) noexcept
+{
+    VertexArrayAttribFormatNE(array, attribute_index, size, type, normalized, relative_offset);
+    return Internal::ConsumeError(
+        "glVertexArrayAttribFormat(vaobj: {}, attribindex: {}, size: {}, type: {}, normalized: {}, "
+        "relativeoffset: {})",
+        array.GetValue(),
+        attribute_index,
+        size,
+        type,
+        normalized,
+        relative_offset);
+}
+
+void OpenGl::VertexArrayAttribFormat(
+    GlVertexArrayId array,
+    size_t attribute_index,
+    size_t size,
+    GlVertexAttribComponentType type,
+    bool normalized,
+    size_t relative_offset)
+{
+    Internal::ThrowIfError(VertexArrayAttribFormatCE(array, attribute_index, size, type, normalized, relative_offset));
+}
+
+// Vertex array integer attribute format
+
+void OpenGl::VertexArrayAttribIFormatNE(
+    GlVertexArrayId array,
+    size_t attribute_index,
+    size_t size,
+    GlVertexAttribComponentType type,
+    size_t relative_offset) noexcept
+{
+    glVertexArrayAttribIFormat(
+        array.GetValue(),
+        static_cast<GLuint>(attribute_index),
+        static_cast<GLint>(size),
+        ToGlValue(type),
+        static_cast<GLuint>(relative_offset));
+    GlTraceRecorder::Record(
+        GlTraceOpcode::VertexArrayAttribIFormat,
+        array.GetValue(),
+        attribute_index,
+        size,
+        type,
+        relative_offset);
+}
+
+std::optional<OpenGlError> OpenGl::VertexArrayAttribIFormatCE(
+    GlVertexArrayId array,
+    size_t attribute_index,
+    size_t size,
+    GlVertexAttribComponentType type,
+    size_t relative_offset) noexcept
+{
+    VertexArrayAttribIFormatNE(array, attribute_index, size, type, relative_offset);
+    return Internal::ConsumeError(
+        "glVertexArrayAttribIFormat(vaobj: {}, attribindex: {}, size: {}, type: {}, relativeoffset: {})",
+        array.GetValue(),
+        attribute_index,
+        size,
+        type,
+        relative_offset);
+}
+
+void OpenGl::VertexArrayAttribIFormat(
+    GlVertexArrayId array,
+    size_t attribute_index,
+    size_t size,
+    GlVertexAttribComponentType type,
+    size_t relative_offset)
+{
+    Internal::ThrowIfError(VertexArrayAttribIFormatCE(array, attribute_index, size, type, relative_offset));
+}
+
+// Vertex array attribute binding
+
+void OpenGl::VertexArrayAttribBindingNE(GlVertexArrayId array, size_t attribute_index, size_t binding_index) noexcept
+{
+    glVertexArrayAttribBinding(
+        array.GetValue(),
+        static_cast<GLuint>(attribute_index),
+        static_cast<GLuint>(binding_index));
+    GlTraceRecorder::Record(
+        GlTraceOpcode::VertexArrayAttribBinding,
+        array.GetValue(),
+        attribute_index,
+        binding_index);
+}
+
+std::optional<OpenGlError>
+OpenGl::VertexArrayAttribBindingCE(GlVertexArrayId array, size_t attribute_index, size_t binding_index) noexcept
+{
+    VertexArrayAttribBindingNE(array, attribute_index, binding_index);
+    return Internal::ConsumeError(
+        "glVertexArrayAttribBinding(vaobj: {}, attribindex: {}, bindingindex: {})",
+        array.GetValue(),
+        attribute_index,
+        binding_index);
+}
+
+void OpenGl::VertexArrayAttribBinding(GlVertexArrayId array, size_t attribute_index, size_t binding_index)
+{
+    Internal::ThrowIfError(VertexArrayAttribBindingCE(array, attribute_index, binding_index));
+}
+
+// Vertex array binding divisor
+
+void OpenGl::VertexArrayBindingDivisorNE(GlVertexArrayId array, size_t binding_index, size_t divisor) noexcept
+{
+    glVertexArrayBindingDivisor(array.GetValue(), static_cast<GLuint>(binding_index), static_cast<GLuint>(divisor));
+    GlTraceRecorder::Record(GlTraceOpcode::VertexArrayBindingDivisor, array.GetValue(), binding_index, divisor);
+}
+
+std::optional<OpenGlError>
+OpenGl::VertexArrayBindingDivisorCE(GlVertexArrayId array, size_t binding_index, size_t divisor) noexcept
+{
+    VertexArrayBindingDivisorNE(array, binding_index, divisor);
+    return Internal::ConsumeError(
+        "glVertexArrayBindingDivisor(vaobj: {}, bindingindex: {}, divisor: {})",
+        array.GetValue(),
+        binding_index,
+        divisor);
+}
+
+void OpenGl::VertexArrayBindingDivisor(GlVertexArrayId array, size_t binding_index, size_t divisor)
+{
+    Internal::ThrowIfError(VertexArrayBindingDivisorCE(array, binding_index, divisor));
+}
+
+// Enable vertex array attribute
+
+void OpenGl::EnableVertexArrayAttribNE(GlVertexArrayId array, size_t attribute_index) noexcept
+{
+    glEnableVertexArrayAttrib(array.GetValue(), static_cast<GLuint>(attribute_index));
+    GlTraceRecorder::Record(GlTraceOpcode::EnableVertexArrayAttrib, array.GetValue(), attribute_index);
+}
+
+std::optional<OpenGlError> OpenGl::EnableVertexArrayAttribCE(GlVertexArrayId array, size_t attribute_index) noexcept
+{
+    EnableVertexArrayAttribNE(array, attribute_index);
+    return Internal::ConsumeError(
+        "glEnableVertexArrayAttrib(vaobj: {}, index: {})",
+        array.GetValue(),
+        attribute_index);
+}
+
+void OpenGl::EnableVertexArrayAttrib(GlVertexArrayId array, size_t attribute_index)
+{
+    Internal::ThrowIfError(EnableVertexArrayAttribCE(array, attribute_index));
+}
+
+// Create texture
+
+GlTextureId OpenGl::CreateTextureNE(GlTargetTextureType target) noexcept
+{
+    GLuint texture = 0;
+    glCreateTextures(ToGlValue(target), 1, &texture);
+    GlTraceRecorder::Record(GlTraceOpcode::CreateTexture, target, texture);
+    GlMemoryTracker::OnCreated(GlObjectKind::Texture, texture);
+    return GlTextureId{texture};
+}
+
+tl::expected<GlTextureId, OpenGlError> OpenGl::CreateTextureCE(GlTargetTextureType target) noexcept
+{
+    return Internal::ValueOrError(CreateTextureNE(target), "glCreateTextures(target: {}, n: 1)", target);
+}
+
+GlTextureId OpenGl::CreateTexture(GlTargetTextureType target)
+{
+    return Internal::TryTakeValue(CreateTextureCE(target));
+}
+
+// Texture storage 2d
+
+void OpenGl::TextureStorage2dNE(
+    GlTextureId texture,
+    size_t levels,
+    GlTextureInternalFormat format,
+    const edt::Vec2<size_t>& size) noexcept
+{
+    const auto size_i = size.Cast<GLsizei>();
+    glTextureStorage2D(
+        texture.GetValue(),
+        static_cast<GLsizei>(levels),
+        static_cast<GLenum>(ToGlValue(format)),
+        size_i.x(),
+        size_i.y());
+    GlTraceRecorder::Record(GlTraceOpcode::TextureStorage2d, texture.GetValue(), levels, format, size.x(), size.y());
+    GlMemoryTracker::OnTextureStorage(texture.GetValue(), levels, format, size.x(), size.y());
+}
+
+std::optional<OpenGlError> OpenGl::TextureStorage2dCE(
+    GlTextureId texture,
+    size_t levels,
+    GlTextureInternalFormat format,
+    const edt::Vec2<size_t>& size) noexcept
+{
+    TextureStorage2dNE(texture, levels, format, size);
+    return Internal::ConsumeError(
+        "glTextureStorage2D(texture: {}, levels: {}, internal_format: {}, width: {}, height: {})",
+        texture.GetValue(),
+        levels,
+        format,
+        size.x(),
+        size.y());
+}
+
+void OpenGl::TextureStorage2d(
+    GlTextureId texture,
+    size_t levels,
+    GlTextureInternalFormat format,
+    const edt::Vec2<size_t>& size)
+{
+    Internal::ThrowIfError(TextureStorage2dCE(texture, levels, format, size));
+}
+
+// Texture sub image 2d
+
+void OpenGl::TextureSubImage2dNE(
+    GlTextureId texture,
+    size_t level_of_detail,
+    const edt::Vec2<size_t>& offset,
+    const edt::Vec2<size_t>& size,
+    GlPixelBufferLayout layout,
+    GlPixelBufferChannelType type,
+    std::span<const uint8_t> pixels) noexcept
+{
+    const auto offset_i = offset.Cast<GLint>();
+    const auto size_i = size.Cast<GLsizei>();
+    glTextureSubImage2D(
+        texture.GetValue(),
+        static_cast<GLint>(level_of_detail),
+        offset_i.x(),
+        offset_i.y(),
+        size_i.x(),
+        size_i.y(),
+        ToGlValue(layout),
+        ToGlValue(type),
+        pixels.data());
+    GlTraceRecorder::RecordWithData(
+        GlTraceOpcode::TextureSubImage2d,
+        pixels,
+        texture.GetValue(),
+        level_of_detail,
+        offset.x(),
+        offset.y(),
+        size.x(),
+        size.y(),
+        layout,
+        type);
+    GlFrameStatsRegistry::OnTextureUpload(pixels.size());
+}
+
+std::optional<OpenGlError> OpenGl::TextureSubImage2dCE(
+    GlTextureId texture,
+    size_t level_of_detail,
+    const edt::Vec2<size_t>& offset,
+    const edt::Vec2<size_t>& size,
+    GlPixelBufferLayout layout,
+    GlPixelBufferChannelType type,
+    std::span<const uint8_t> pixels) noexcept
+{
+    TextureSubImage2dNE(texture, level_of_detail, offset, size, layout, type, pixels);
+    return Internal::ConsumeError(
+        "glTextureSubImage2D(texture: {}, lod: {}, x: {}, y: {}, width: {}, height: {}, pixel_buffer_layout: {}, "
+        "pixel_buffer_type: {}, pixels: {})",
+        texture.GetValue(),
+        level_of_detail,
+        offset.x(),
+        offset.y(),
+        size.x(),
+        size.y(),
+        layout,
+        type,
+        static_cast<const void*>(pixels.data()));
+}
+
+void OpenGl::TextureSubImage2d(
+    GlTextureId texture,
+    size_t level_of_detail,
+    const edt::Vec2<size_t>& offset,
+    const edt::Vec2<size_t>& size,
+    GlPixelBufferLayout layout,
+    GlPixelBufferChannelType type,
+    std::span<const uint8_t> pixels)
+{
+    Internal::ThrowIfError(TextureSubImage2dCE(texture, level_of_detail, offset, size, layout, type, pixels));
+}
+
+// Set texture wrap mode by name
+
+void OpenGl::SetTextureWrapNE(GlTextureId texture, GlTextureWrapAxis wrap, GlTextureWrapMode mode) noexcept
+{
+    glTextureParameteri(texture.GetValue(), ToGlValue(wrap), ToGlValue(mode));
+    Internal::TraceTextureParameter(texture, ToGlValue(wrap), ToGlValue(mode));
+}
+
+std::optional<OpenGlError>
+OpenGl::SetTextureWrapCE(GlTextureId texture, GlTextureWrapAxis wrap, GlTextureWrapMode mode) noexcept
+{
+    SetTextureWrapNE(texture, wrap, mode);
+    return Internal::ConsumeError(
+        "glTextureParameteri(texture: {}, axis: {}, wrap: {})",
+        texture.GetValue(),
+        wrap,
+        mode);
+}
+
+void OpenGl::SetTextureWrap(GlTextureId texture, GlTextureWrapAxis wrap, GlTextureWrapMode mode)
+{
+    Internal::ThrowIfError(SetTextureWrapCE(texture, wrap, mode));
+}
+
+// Set texture minification filter by name
+
+void OpenGl::SetTextureMinFilterNE(GlTextureId texture, GlTextureFilter filter) noexcept
+{
+    glTextureParameteri(
+        texture.GetValue(),
+        ToGlValue(GlTextureParameterType::MinificationFilter),
+        ToGlValue(filter));
+    Internal::TraceTextureParameter(texture, ToGlValue(GlTextureParameterType::MinificationFilter), ToGlValue(filter));
+}
+
+std::optional<OpenGlError> OpenGl::SetTextureMinFilterCE(GlTextureId texture, GlTextureFilter filter) noexcept
+{
+    SetTextureMinFilterNE(texture, filter);
+    return Internal::ConsumeError(
+        "glTextureParameteri(texture: {}, parameter: {}, filter: {})",
+        texture.GetValue(),
+        GlTextureParameterType::MinificationFilter,
+        filter);
+}
+
+void OpenGl::SetTextureMinFilter(GlTextureId texture, GlTextureFilter filter)
+{
+    Internal::ThrowIfError(SetTextureMinFilterCE(texture, filter));
+}
+
+// Set texture magnification filter by name
+
+void OpenGl::SetTextureMagFilterNE(GlTextureId texture, GlTextureFilter filter) noexcept
+{
+    glTextureParameteri(
+        texture.GetValue(),
+        ToGlValue(GlTextureParameterType::MagnificationFilter),
+        ToGlValue(filter));
+    Internal::TraceTextureParameter(texture, ToGlValue(GlTextureParameterType::MagnificationFilter), ToGlValue(filter));
+}
+
+std::optional<OpenGlError> OpenGl::SetTextureMagFilterCE(GlTextureId texture, GlTextureFilter filter) noexcept
+{
+    SetTextureMagFilterNE(texture, filter);
+    return Internal::ConsumeError(
+        "glTextureParameteri(texture: {}, parameter: {}, filter: {})",
+        texture.GetValue(),
+        GlTextureParameterType::MagnificationFilter,
+        filter);
+}
+
+void OpenGl::SetTextureMagFilter(GlTextureId texture, GlTextureFilter filter)
+{
+    Internal::ThrowIfError(SetTextureMagFilterCE(texture, filter));
+}
+
+/************************************************** Framebuffers **************************************************/
+
+// Gen many
+
+void OpenGl::GenFramebuffersNE(const std::span<GlFramebufferId>& framebuffers) noexcept
+{
+    Internal::GenManyNE(framebuffers);
+}
+
+std::optional<OpenGlError> OpenGl::GenFramebuffersCE(const std::span<GlFramebufferId>& framebuffers) noexcept
+{
+    return Internal::GenManyCE(framebuffers);
+}
+
+void OpenGl::GenFramebuffers(const std::span<GlFramebufferId>& framebuffers)
+{
+    Internal::GenMany(framebuffers);
+}
+
+// Gen one
+
+GlFramebufferId OpenGl::GenFramebufferNE() noexcept
+{
+    return Internal::GenOneNE<GlFramebufferId>();
+}
+
+tl::expected<GlFramebufferId, OpenGlError> OpenGl::GenFramebufferCE() noexcept
+{
+    return Internal::GenOneCE<GlFramebufferId>();
+}
+
+GlFramebufferId OpenGl::GenFramebuffer()
+{
+    return Internal::GenOne<GlFramebufferId>();
+}
+
+// Bind
+
+void OpenGl::BindFramebufferNE(GlFramebufferBindTarget target, GlFramebufferId framebuffer) noexcept
+{
+    glBindFramebuffer(ToGlValue(target), framebuffer.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::BindFramebuffer, target, framebuffer.GetValue());
+    GlFrameStatsRegistry::OnStateChange();
+}
+
+std::optional<OpenGlError> OpenGl::BindFramebufferCE(
+    GlFramebufferBindTarget target,
+    GlFramebufferId framebuffer) noexcept
+{
+    BindFramebufferNE(target, framebuffer);
+    return Internal::ConsumeError("glBindFramebuffer(target: {}, framebuffer: {})", target, framebuffer.GetValue());
+}
+
+void OpenGl::BindFramebuffer(GlFramebufferBindTarget target, GlFramebufferId framebuffer)
+{
+    Internal::ThrowIfError(BindFramebufferCE(target, framebuffer));
+}
+
+// Attach texture
 
 void OpenGl::FramebufferTexture2DNE(
     GlFramebufferBindTarget target,
@@ -890,6 +2076,13 @@ void OpenGl::FramebufferTexture2DNE(
         ToGlValue(textarget),
         texture.GetValue(),
         static_cast<GLint>(level));
+    GlTraceRecorder::Record(
+        GlTraceOpcode::FramebufferTexture2d,
+        target,
+        attachment,
+        textarget,
+        texture.GetValue(),
+        level);
 }
 
 std::optional<OpenGlError> OpenGl::FramebufferTexture2DCE(
@@ -927,6 +2120,7 @@ void OpenGl::FramebufferRenderbufferNE(
     GlRenderbufferId renderbuffer) noexcept
 {
     glFramebufferRenderbuffer(ToGlValue(target), ToGlValue(attachment), GL_RENDERBUFFER, renderbuffer.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::FramebufferRenderbuffer, target, attachment, renderbuffer.GetValue());
 }
 
 std::optional<OpenGlError> OpenGl::FramebufferRenderbufferCE(
@@ -955,6 +2149,8 @@ void OpenGl::FramebufferRenderbuffer(
 void OpenGl::DeleteFramebufferNE(GlFramebufferId framebuffer) noexcept
 {
     glDeleteFramebuffers(1, &framebuffer.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::DeleteObject, GlObjectKind::Framebuffer, framebuffer.GetValue());
+    GlMemoryTracker::OnDeleted(GlObjectKind::Framebuffer, framebuffer.GetValue());
 }
 
 std::optional<OpenGlError> OpenGl::DeleteFramebufferCE(GlFramebufferId framebuffer) noexcept
@@ -1008,13 +2204,22 @@ GlRenderbufferId OpenGl::GenRenderbuffer()
 
 void OpenGl::BindRenderbufferNE(GlRenderbufferId renderbuffer) noexcept
 {
-    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer.GetValue());
+    if (GlStateCache::Get().BindRenderbuffer(renderbuffer))
+    {
+        glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer.GetValue());
+        GlTraceRecorder::Record(GlTraceOpcode::BindRenderbuffer, renderbuffer.GetValue());
+        GlFrameStatsRegistry::OnStateChange();
+    }
 }
 
 std::optional<OpenGlError> OpenGl::BindRenderbufferCE(GlRenderbufferId renderbuffer) noexcept
 {
-    BindRenderbufferNE(renderbuffer);
-    return Internal::ConsumeError("glBindRenderbuffer(renderbuffer: {})", renderbuffer.GetValue());
+    if (!GlStateCache::Get().BindRenderbuffer(renderbuffer)) return std::nullopt;
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::BindRenderbuffer, renderbuffer.GetValue());
+    GlFrameStatsRegistry::OnStateChange();
+    return Internal::InvalidateCacheOnError(
+        Internal::ConsumeError("glBindRenderbuffer(renderbuffer: {})", renderbuffer.GetValue()));
 }
 
 void OpenGl::BindRenderbuffer(GlRenderbufferId renderbuffer)
@@ -1028,6 +2233,8 @@ void OpenGl::RenderbufferStorageNE(GlTextureInternalFormat format, const edt::Ve
 {
     const auto size_i = size.Cast<GLsizei>();
     glRenderbufferStorage(GL_RENDERBUFFER, ToGlValue(format), size_i.x(), size_i.y());
+    GlTraceRecorder::Record(GlTraceOpcode::RenderbufferStorage, format, size.x(), size.y());
+    GlMemoryTracker::OnRenderbufferStorage(format, size.x(), size.y());
 }
 
 std::optional<OpenGlError> OpenGl::RenderbufferStorageCE(
@@ -1052,6 +2259,9 @@ void OpenGl::RenderbufferStorage(GlTextureInternalFormat format, const edt::Vec2
 void OpenGl::DeleteRenderbufferNE(GlRenderbufferId renderbuffer) noexcept
 {
     glDeleteRenderbuffers(1, &renderbuffer.GetValue());
+    GlStateCache::Get().OnRenderbufferDeleted(renderbuffer);
+    GlTraceRecorder::Record(GlTraceOpcode::DeleteObject, GlObjectKind::Renderbuffer, renderbuffer.GetValue());
+    GlMemoryTracker::OnDeleted(GlObjectKind::Renderbuffer, renderbuffer.GetValue());
 }
 
 std::optional<OpenGlError> OpenGl::DeleteRenderbufferCE(GlRenderbufferId renderbuffer) noexcept
@@ -1071,7 +2281,10 @@ void OpenGl::DeleteRenderbuffer(GlRenderbufferId renderbuffer)
 
 GlShaderId OpenGl::CreateShaderNE(GlShaderType type) noexcept
 {
-    return GlShaderId::FromValue(glCreateShader(ToGlValue(type)));
+    const auto shader = GlShaderId::FromValue(glCreateShader(ToGlValue(type)));
+    GlTraceRecorder::Record(GlTraceOpcode::CreateShader, type, shader.GetValue());
+    GlMemoryTracker::OnCreated(GlObjectKind::Shader, shader.GetValue());
+    return shader;
 }
 
 tl::expected<GlShaderId, OpenGlError> OpenGl::CreateShaderCE(GlShaderType type) noexcept
@@ -1091,6 +2304,7 @@ void OpenGl::ShaderSourceNE(GlShaderId shader, std::span<const std::string_view>
     Internal::ShaderSourceCollector<30> c;
     auto [sources_span, lengths_span] = c.Fill(sources);
     glShaderSource(shader.GetValue(), static_cast<GLsizei>(sources.size()), sources_span.data(), lengths_span.data());
+    Internal::TraceShaderSource(shader, sources);
 }
 
 std::optional<OpenGlError> OpenGl::ShaderSourceCE(GlShaderId shader, std::span<const std::string_view> sources) noexcept
@@ -1098,6 +2312,7 @@ std::optional<OpenGlError> OpenGl::ShaderSourceCE(GlShaderId shader, std::span<c
     Internal::ShaderSourceCollector<30> c;
     auto [sources_span, lengths_span] = c.Fill(sources);
     glShaderSource(shader.GetValue(), static_cast<GLsizei>(sources.size()), sources_span.data(), lengths_span.data());
+    Internal::TraceShaderSource(shader, sources);
     return Internal::ConsumeError(
         "glShaderSource(shader: {}, count: {}, strings: [{}], lengths: [{}])",
         shader.GetValue(),
@@ -1114,6 +2329,7 @@ void OpenGl::ShaderSource(GlShaderId shader, std::span<const std::string_view> s
 void OpenGl::CompileShaderNE(GlShaderId shader) noexcept
 {
     glCompileShader(shader.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::CompileShader, shader.GetValue());
 }
 
 // Compile shader
@@ -1202,6 +2418,7 @@ std::string OpenGl::GetShaderLog(GlShaderId shader)
 void OpenGl::SetUniformNE(uint32_t location, int32_t v) noexcept
 {
     glUniform1i(static_cast<GLint>(location), v);
+    Internal::TraceUniform(GlTraceOpcode::SetUniformInt, location, v, false);
 }
 
 std::optional<OpenGlError> OpenGl::SetUniformCE(uint32_t location, int32_t v) noexcept
@@ -1218,6 +2435,7 @@ void OpenGl::SetUniform(uint32_t location, int32_t v)
 void OpenGl::SetUniformNE(uint32_t location, uint32_t v) noexcept
 {
     glUniform1ui(static_cast<GLint>(location), v);
+    Internal::TraceUniform(GlTraceOpcode::SetUniformUInt, location, v, false);
 }
 
 std::optional<OpenGlError> OpenGl::SetUniformCE(uint32_t location, uint32_t v) noexcept
@@ -1234,6 +2452,7 @@ void OpenGl::SetUniform(uint32_t location, uint32_t v)
 void OpenGl::SetUniformNE(uint32_t location, const float& f) noexcept
 {
     glUniform1f(static_cast<GLint>(location), f);
+    Internal::TraceUniform(GlTraceOpcode::SetUniformFloat, location, f, false);
 }
 
 std::optional<OpenGlError> OpenGl::SetUniformCE(uint32_t location, const float& f) noexcept
@@ -1252,6 +2471,7 @@ void OpenGl::SetUniform(uint32_t location, const float& f)
 void OpenGl::SetUniformNE(uint32_t location, const Vec2f& v) noexcept
 {
     glUniform2f(static_cast<GLint>(location), v.x(), v.y());
+    Internal::TraceUniform(GlTraceOpcode::SetUniformVec2f, location, v, false);
 }
 
 std::optional<OpenGlError> OpenGl::SetUniformCE(uint32_t location, const Vec2f& v) noexcept
@@ -1270,6 +2490,7 @@ void OpenGl::SetUniform(uint32_t location, const Vec2f& v)
 void OpenGl::SetUniformNE(uint32_t location, const Vec3f& v) noexcept
 {
     glUniform3f(static_cast<GLint>(location), v.x(), v.y(), v.z());
+    Internal::TraceUniform(GlTraceOpcode::SetUniformVec3f, location, v, false);
 }
 
 std::optional<OpenGlError> OpenGl::SetUniformCE(uint32_t location, const Vec3f& v) noexcept
@@ -1289,6 +2510,7 @@ void OpenGl::SetUniform(uint32_t location, const Vec3f& v)
 void OpenGl::SetUniformNE(uint32_t location, const Vec4f& v) noexcept
 {
     glUniform4f(static_cast<GLint>(location), v.x(), v.y(), v.z(), v.w());
+    Internal::TraceUniform(GlTraceOpcode::SetUniformVec4f, location, v, false);
 }
 
 std::optional<OpenGlError> OpenGl::SetUniformCE(uint32_t location, const Vec4f& v) noexcept
@@ -1307,6 +2529,7 @@ void OpenGl::SetUniform(uint32_t location, const Vec4f& v)
 void OpenGl::SetUniformNE(uint32_t location, const Mat3f& m, bool transpose) noexcept
 {
     glUniformMatrix3fv(static_cast<GLint>(location), 1, Internal::CastBool(transpose), m.data());
+    Internal::TraceUniform(GlTraceOpcode::SetUniformMat3f, location, m, transpose);
 }
 
 std::optional<OpenGlError> OpenGl::SetUniformCE(uint32_t location, const Mat3f& m, bool transpose) noexcept
@@ -1329,6 +2552,7 @@ void OpenGl::SetUniform(uint32_t location, const Mat3f& m, bool transpose)
 void OpenGl::SetUniformNE(uint32_t location, const Mat4f& m, bool transpose) noexcept
 {
     glUniformMatrix4fv(static_cast<GLint>(location), 1, Internal::CastBool(transpose), m.data());
+    Internal::TraceUniform(GlTraceOpcode::SetUniformMat4f, location, m, transpose);
 }
 
 std::optional<OpenGlError> OpenGl::SetUniformCE(uint32_t location, const Mat4f& m, bool transpose) noexcept
@@ -1346,11 +2570,187 @@ void OpenGl::SetUniform(uint32_t location, const Mat4f& m, bool transpose)
     Internal::ThrowIfError(SetUniformCE(location, m, transpose));
 }
 
+// Set uniform arrays. Elements of a uniform array occupy consecutive locations, so location + i is element i
+
+void OpenGl::SetUniformArrayNE(uint32_t location, std::span<const int32_t> values) noexcept
+{
+    glUniform1iv(
+        static_cast<GLint>(location),
+        static_cast<GLsizei>(values.size()),
+        reinterpret_cast<const GLint*>(values.data()));  // NOLINT
+    Internal::TraceUniformArray(GlTraceOpcode::SetUniformInt, location, values, false);
+}
+
+std::optional<OpenGlError> OpenGl::SetUniformArrayCE(uint32_t location, std::span<const int32_t> values) noexcept
+{
+    SetUniformArrayNE(location, values);
+    return Internal::ConsumeError("glUniform1iv(location: {}, count: {})", location, values.size());
+}
+
+void OpenGl::SetUniformArray(uint32_t location, std::span<const int32_t> values)
+{
+    Internal::ThrowIfError(SetUniformArrayCE(location, values));
+}
+
+void OpenGl::SetUniformArrayNE(uint32_t location, std::span<const uint32_t> values) noexcept
+{
+    glUniform1uiv(
+        static_cast<GLint>(location),
+        static_cast<GLsizei>(values.size()),
+        reinterpret_cast<const GLuint*>(values.data()));  // NOLINT
+    Internal::TraceUniformArray(GlTraceOpcode::SetUniformUInt, location, values, false);
+}
+
+std::optional<OpenGlError> OpenGl::SetUniformArrayCE(uint32_t location, std::span<const uint32_t> values) noexcept
+{
+    SetUniformArrayNE(location, values);
+    return Internal::ConsumeError("glUniform1uiv(location: {}, count: {})", location, values.size());
+}
+
+void OpenGl::SetUniformArray(uint32_t location, std::span<const uint32_t> values)
+{
+    Internal::ThrowIfError(SetUniformArrayCE(location, values));
+}
+
+void OpenGl::SetUniformArrayNE(uint32_t location, std::span<const float> values) noexcept
+{
+    glUniform1fv(
+        static_cast<GLint>(location),
+        static_cast<GLsizei>(values.size()),
+        reinterpret_cast<const GLfloat*>(values.data()));  // NOLINT
+    Internal::TraceUniformArray(GlTraceOpcode::SetUniformFloat, location, values, false);
+}
+
+std::optional<OpenGlError> OpenGl::SetUniformArrayCE(uint32_t location, std::span<const float> values) noexcept
+{
+    SetUniformArrayNE(location, values);
+    return Internal::ConsumeError("glUniform1fv(location: {}, count: {})", location, values.size());
+}
+
+void OpenGl::SetUniformArray(uint32_t location, std::span<const float> values)
+{
+    Internal::ThrowIfError(SetUniformArrayCE(location, values));
+}
+
+void OpenGl::SetUniformArrayNE(uint32_t location, std::span<const Vec2f> values) noexcept
+{
+    glUniform2fv(
+        static_cast<GLint>(location),
+        static_cast<GLsizei>(values.size()),
+        reinterpret_cast<const GLfloat*>(values.data()));  // NOLINT
+    Internal::TraceUniformArray(GlTraceOpcode::SetUniformVec2f, location, values, false);
+}
+
+std::optional<OpenGlError> OpenGl::SetUniformArrayCE(uint32_t location, std::span<const Vec2f> values) noexcept
+{
+    SetUniformArrayNE(location, values);
+    return Internal::ConsumeError("glUniform2fv(location: {}, count: {})", location, values.size());
+}
+
+void OpenGl::SetUniformArray(uint32_t location, std::span<const Vec2f> values)
+{
+    Internal::ThrowIfError(SetUniformArrayCE(location, values));
+}
+
+void OpenGl::SetUniformArrayNE(uint32_t location, std::span<const Vec3f> values) noexcept
+{
+    glUniform3fv(
+        static_cast<GLint>(location),
+        static_cast<GLsizei>(values.size()),
+        reinterpret_cast<const GLfloat*>(values.data()));  // NOLINT
+    Internal::TraceUniformArray(GlTraceOpcode::SetUniformVec3f, location, values, false);
+}
+
+std::optional<OpenGlError> OpenGl::SetUniformArrayCE(uint32_t location, std::span<const Vec3f> values) noexcept
+{
+    SetUniformArrayNE(location, values);
+    return Internal::ConsumeError("glUniform3fv(location: {}, count: {})", location, values.size());
+}
+
+void OpenGl::SetUniformArray(uint32_t location, std::span<const Vec3f> values)
+{
+    Internal::ThrowIfError(SetUniformArrayCE(location, values));
+}
+
+void OpenGl::SetUniformArrayNE(uint32_t location, std::span<const Vec4f> values) noexcept
+{
+    glUniform4fv(
+        static_cast<GLint>(location),
+        static_cast<GLsizei>(values.size()),
+        reinterpret_cast<const GLfloat*>(values.data()));  // NOLINT
+    Internal::TraceUniformArray(GlTraceOpcode::SetUniformVec4f, location, values, false);
+}
+
+std::optional<OpenGlError> OpenGl::SetUniformArrayCE(uint32_t location, std::span<const Vec4f> values) noexcept
+{
+    SetUniformArrayNE(location, values);
+    return Internal::ConsumeError("glUniform4fv(location: {}, count: {})", location, values.size());
+}
+
+void OpenGl::SetUniformArray(uint32_t location, std::span<const Vec4f> values)
+{
+    Internal::ThrowIfError(SetUniformArrayCE(location, values));
+}
+
+void OpenGl::SetUniformArrayNE(uint32_t location, std::span<const Mat3f> values, bool transpose) noexcept
+{
+    glUniformMatrix3fv(
+        static_cast<GLint>(location),
+        static_cast<GLsizei>(values.size()),
+        Internal::CastBool(transpose),
+        reinterpret_cast<const GLfloat*>(values.data()));  // NOLINT
+    Internal::TraceUniformArray(GlTraceOpcode::SetUniformMat3f, location, values, transpose);
+}
+
+std::optional<OpenGlError>
+OpenGl::SetUniformArrayCE(uint32_t location, std::span<const Mat3f> values, bool transpose) noexcept
+{
+    SetUniformArrayNE(location, values, transpose);
+    return Internal::ConsumeError(
+        "glUniformMatrix3fv(location: {}, count: {}, transpose: {})",
+        location,
+        values.size(),
+        transpose);
+}
+
+void OpenGl::SetUniformArray(uint32_t location, std::span<const Mat3f> values, bool transpose)
+{
+    Internal::ThrowIfError(SetUniformArrayCE(location, values, transpose));
+}
+
+void OpenGl::SetUniformArrayNE(uint32_t location, std::span<const Mat4f> values, bool transpose) noexcept
+{
+    glUniformMatrix4fv(
+        static_cast<GLint>(location),
+        static_cast<GLsizei>(values.size()),
+        Internal::CastBool(transpose),
+        reinterpret_cast<const GLfloat*>(values.data()));  // NOLINT
+    Internal::TraceUniformArray(GlTraceOpcode::SetUniformMat4f, location, values, transpose);
+}
+
+std::optional<OpenGlError>
+OpenGl::SetUniformArrayCE(uint32_t location, std::span<const Mat4f> values, bool transpose) noexcept
+{
+    SetUniformArrayNE(location, values, transpose);
+    return Internal::ConsumeError(
+        "glUniformMatrix4fv(location: {}, count: {}, transpose: {})",
+        location,
+        values.size(),
+        transpose);
+}
+
+void OpenGl::SetUniformArray(uint32_t location, std::span<const Mat4f> values, bool transpose)
+{
+    Internal::ThrowIfError(SetUniformArrayCE(location, values, transpose));
+}
+
 // Delete
 
 void OpenGl::DeleteShaderNE(GlShaderId shader) noexcept
 {
     glDeleteShader(shader.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::DeleteObject, GlObjectKind::Shader, shader.GetValue());
+    GlMemoryTracker::OnDeleted(GlObjectKind::Shader, shader.GetValue());
 }
 
 std::optional<OpenGlError> OpenGl::DeleteShaderCE(GlShaderId shader) noexcept
@@ -1370,7 +2770,10 @@ void OpenGl::DeleteShader(GlShaderId shader)
 
 GlProgramId OpenGl::CreateProgramNE() noexcept
 {
-    return GlProgramId::FromValue(glCreateProgram());
+    const auto program = GlProgramId::FromValue(glCreateProgram());
+    GlTraceRecorder::Record(GlTraceOpcode::CreateProgram, program.GetValue());
+    GlMemoryTracker::OnCreated(GlObjectKind::Program, program.GetValue());
+    return program;
 }
 
 tl::expected<GlProgramId, OpenGlError> OpenGl::CreateProgramCE() noexcept
@@ -1388,6 +2791,7 @@ GlProgramId OpenGl::CreateProgram()
 void OpenGl::AttachShaderNE(GlProgramId program, GlShaderId shader) noexcept
 {
     glAttachShader(program.GetValue(), shader.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::AttachShader, program.GetValue(), shader.GetValue());
 }
 
 std::optional<OpenGlError> OpenGl::AttachShaderCE(GlProgramId program, GlShaderId shader) noexcept
@@ -1406,6 +2810,7 @@ void OpenGl::AttachShader(GlProgramId program, GlShaderId shader)
 void OpenGl::LinkProgramNE(GlProgramId program) noexcept
 {
     glLinkProgram(program.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::LinkProgram, program.GetValue());
 }
 
 std::optional<OpenGlError> OpenGl::LinkProgramCE(GlProgramId program) noexcept
@@ -1641,86 +3046,288 @@ size_t OpenGl::GetProgramActiveUniformMaxNameLengthNE(GlProgramId program) noexc
     return static_cast<size_t>(GetProgramIntParameterNE(program, GlProgramIntParameter::ActiveUniformMaxLength));
 }
 
-tl::expected<size_t, OpenGlError> OpenGl::GetProgramActiveUniformMaxNameLengthCE(GlProgramId program) noexcept
+tl::expected<size_t, OpenGlError> OpenGl::GetProgramActiveUniformMaxNameLengthCE(GlProgramId program) noexcept
+{
+    return GetProgramIntParameterCE(program, GlProgramIntParameter::ActiveUniformMaxLength)
+        .and_then(Internal::CastToSizeT);
+}
+
+size_t OpenGl::GetProgramActiveUniformMaxNameLength(GlProgramId program)
+{
+    return Internal::TryTakeValue(GetProgramActiveUniformMaxNameLengthCE(program));
+}
+
+// Get active uniform
+
+void OpenGl::GetActiveUniformNE(
+    GlProgramId program,
+    size_t uniform_index,
+    size_t name_buffer_size,
+    size_t& out_written_to_name_buffer,
+    size_t& out_uniform_size,
+    GlUniformType& out_uniform_type,
+    char* out_name_buffer) noexcept
+{
+    GLint size = 0;
+    GLenum type = ToGlValue(GlUniformType::Float);
+    GLint written = 0;
+    glGetActiveUniform(
+        program.GetValue(),
+        static_cast<GLuint>(uniform_index),
+        static_cast<GLsizei>(name_buffer_size),
+        &written,
+        &size,
+        &type,
+        out_name_buffer);
+
+    out_written_to_name_buffer = static_cast<size_t>(std::max<GLint>(0, written));
+    out_uniform_size = static_cast<size_t>(std::max<GLint>(0, size));
+    out_uniform_type = detail::kGlUniformTypeToGlValue.from_gl_enum.Get(type);
+}
+
+std::optional<OpenGlError> OpenGl::GetActiveUniformCE(
+    GlProgramId program,
+    size_t uniform_index,
+    size_t name_buffer_size,
+    size_t& out_written_to_name_buffer,
+    size_t& out_uniform_size,
+    GlUniformType& out_uniform_type,
+    char* out_name_buffer) noexcept
+{
+    GetActiveUniformNE(
+        program,
+        uniform_index,
+        name_buffer_size,
+        out_written_to_name_buffer,
+        out_uniform_size,
+        out_uniform_type,
+        out_name_buffer);
+    return Internal::ConsumeError(
+        "glGetActiveUniform(program: {}, index: {}, bufSize: {})",
+        program.GetValue(),
+        uniform_index,
+        name_buffer_size);
+}
+
+void OpenGl::GetActiveUniform(
+    GlProgramId program,
+    size_t uniform_index,
+    size_t name_buffer_size,
+    size_t& out_written_to_name_buffer,
+    size_t& out_uniform_size,
+    GlUniformType& out_uniform_type,
+    char* out_name_buffer) noexcept
+{
+    Internal::ThrowIfError(GetActiveUniformCE(
+        program,
+        uniform_index,
+        name_buffer_size,
+        out_written_to_name_buffer,
+        out_uniform_size,
+        out_uniform_type,
+        out_name_buffer));
+}
+
+// Get active uniforms parameter
+
+void OpenGl::GetActiveUniformsIntParameterNE(
+    GlProgramId program,
+    std::span<const uint32_t> uniform_indices,
+    GlActiveUniformIntParameter parameter,
+    std::span<int32_t> out_values) noexcept
+{
+    glGetActiveUniformsiv(
+        program.GetValue(),
+        static_cast<GLsizei>(std::min(uniform_indices.size(), out_values.size())),
+        uniform_indices.data(),
+        ToGlValue(parameter),
+        out_values.data());
+}
+
+std::optional<OpenGlError> OpenGl::GetActiveUniformsIntParameterCE(
+    GlProgramId program,
+    std::span<const uint32_t> uniform_indices,
+    GlActiveUniformIntParameter parameter,
+    std::span<int32_t> out_values) noexcept
+{
+    GetActiveUniformsIntParameterNE(program, uniform_indices, parameter, out_values);
+    return Internal::ConsumeError(
+        "glGetActiveUniformsiv(program: {}, uniformCount: {}, uniformIndices: {}, pname: {})",
+        program.GetValue(),
+        uniform_indices.size(),
+        uniform_indices,
+        parameter);
+}
+
+void OpenGl::GetActiveUniformsIntParameter(
+    GlProgramId program,
+    std::span<const uint32_t> uniform_indices,
+    GlActiveUniformIntParameter parameter,
+    std::span<int32_t> out_values)
+{
+    Internal::ThrowIfError(GetActiveUniformsIntParameterCE(program, uniform_indices, parameter, out_values));
+}
+
+// Get uniform blocks count
+
+size_t OpenGl::GetProgramActiveUniformBlocksCountNE(GlProgramId program) noexcept
+{
+    auto count = GetProgramIntParameterNE(program, GlProgramIntParameter::ActiveUniformBlocks);
+    return static_cast<size_t>(std::max<int32_t>(0, count));
+}
+
+tl::expected<size_t, OpenGlError> OpenGl::GetProgramActiveUniformBlocksCountCE(GlProgramId program) noexcept
+{
+    return GetProgramIntParameterCE(program, GlProgramIntParameter::ActiveUniformBlocks)
+        .and_then(Internal::CastToSizeT);
+}
+
+size_t OpenGl::GetProgramActiveUniformBlocksCount(GlProgramId program)
+{
+    return Internal::TryTakeValue(GetProgramActiveUniformBlocksCountCE(program));
+}
+
+// Uniform block int parameter
+
+int32_t OpenGl::GetActiveUniformBlockIntParameterNE(
+    GlProgramId program,
+    uint32_t block_index,
+    GlUniformBlockIntParameter parameter) noexcept
+{
+    int32_t value{};
+    glGetActiveUniformBlockiv(program.GetValue(), block_index, ToGlValue(parameter), &value);
+    return value;
+}
+
+tl::expected<int32_t, OpenGlError> OpenGl::GetActiveUniformBlockIntParameterCE(
+    GlProgramId program,
+    uint32_t block_index,
+    GlUniformBlockIntParameter parameter) noexcept
+{
+    return Internal::ValueOrError(
+        GetActiveUniformBlockIntParameterNE(program, block_index, parameter),
+        "glGetActiveUniformBlockiv(program: {}, uniformBlockIndex: {}, pname: {})",
+        program.GetValue(),
+        block_index,
+        parameter);
+}
+
+int32_t OpenGl::GetActiveUniformBlockIntParameter(
+    GlProgramId program,
+    uint32_t block_index,
+    GlUniformBlockIntParameter parameter)
+{
+    return Internal::TryTakeValue(GetActiveUniformBlockIntParameterCE(program, block_index, parameter));
+}
+
+// Uniform block uniform indices
+
+std::vector<uint32_t> OpenGl::GetActiveUniformBlockUniformIndicesNE(
+    GlProgramId program,
+    uint32_t block_index) noexcept
+{
+    const int32_t count =
+        GetActiveUniformBlockIntParameterNE(program, block_index, GlUniformBlockIntParameter::ActiveUniforms);
+    std::vector<GLint> indices(static_cast<size_t>(std::max<int32_t>(0, count)));
+    if (!indices.empty())
+    {
+        glGetActiveUniformBlockiv(
+            program.GetValue(),
+            block_index,
+            GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES,
+            indices.data());
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (const GLint index : indices)
+    {
+        result.push_back(static_cast<uint32_t>(index));
+    }
+
+    return result;
+}
+
+tl::expected<std::vector<uint32_t>, OpenGlError> OpenGl::GetActiveUniformBlockUniformIndicesCE(
+    GlProgramId program,
+    uint32_t block_index) noexcept
+{
+    return Internal::ValueOrError(
+        GetActiveUniformBlockUniformIndicesNE(program, block_index),
+        "glGetActiveUniformBlockiv(program: {}, uniformBlockIndex: {}, "
+        "pname: GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES)",
+        program.GetValue(),
+        block_index);
+}
+
+std::vector<uint32_t> OpenGl::GetActiveUniformBlockUniformIndices(GlProgramId program, uint32_t block_index)
+{
+    return Internal::TryTakeValue(GetActiveUniformBlockUniformIndicesCE(program, block_index));
+}
+
+// Uniform block name
+
+std::string OpenGl::GetActiveUniformBlockNameNE(GlProgramId program, uint32_t block_index) noexcept
+{
+    const int32_t length =
+        GetActiveUniformBlockIntParameterNE(program, block_index, GlUniformBlockIntParameter::NameLength);
+    std::string name;
+    name.resize(static_cast<size_t>(std::max<int32_t>(0, length)));
+
+    GLsizei written = 0;
+    if (!name.empty())
+    {
+        glGetActiveUniformBlockName(
+            program.GetValue(),
+            block_index,
+            static_cast<GLsizei>(name.size()),
+            &written,
+            name.data());
+    }
+
+    // Length includes null terminator
+    name.resize(static_cast<size_t>(std::max<GLsizei>(0, written)));
+    return name;
+}
+
+tl::expected<std::string, OpenGlError> OpenGl::GetActiveUniformBlockNameCE(
+    GlProgramId program,
+    uint32_t block_index) noexcept
 {
-    return GetProgramIntParameterCE(program, GlProgramIntParameter::ActiveUniformMaxLength)
-        .and_then(Internal::CastToSizeT);
+    return Internal::ValueOrError(
+        GetActiveUniformBlockNameNE(program, block_index),
+        "glGetActiveUniformBlockName(program: {}, uniformBlockIndex: {})",
+        program.GetValue(),
+        block_index);
 }
 
-size_t OpenGl::GetProgramActiveUniformMaxNameLength(GlProgramId program)
+std::string OpenGl::GetActiveUniformBlockName(GlProgramId program, uint32_t block_index)
 {
-    return Internal::TryTakeValue(GetProgramActiveUniformMaxNameLengthCE(program));
+    return Internal::TryTakeValue(GetActiveUniformBlockNameCE(program, block_index));
 }
 
-// Get active uniform
+// Uniform block binding
 
-void OpenGl::GetActiveUniformNE(
-    GlProgramId program,
-    size_t uniform_index,
-    size_t name_buffer_size,
-    size_t& out_written_to_name_buffer,
-    size_t& out_uniform_size,
-    GlUniformType& out_uniform_type,
-    char* out_name_buffer) noexcept
+void OpenGl::UniformBlockBindingNE(GlProgramId program, uint32_t block_index, uint32_t binding) noexcept
 {
-    GLint size = 0;
-    GLenum type = ToGlValue(GlUniformType::Float);
-    GLint written = 0;
-    glGetActiveUniform(
-        program.GetValue(),
-        static_cast<GLuint>(uniform_index),
-        static_cast<GLsizei>(name_buffer_size),
-        &written,
-        &size,
-        &type,
-        out_name_buffer);
-
-    out_written_to_name_buffer = static_cast<size_t>(std::max<GLint>(0, written));
-    out_uniform_size = static_cast<size_t>(std::max<GLint>(0, size));
-    out_uniform_type = detail::kGlUniformTypeToGlValue.from_gl_enum.Get(type);
+    glUniformBlockBinding(program.GetValue(), block_index, binding);
+    GlTraceRecorder::Record(GlTraceOpcode::UniformBlockBinding, program.GetValue(), block_index, binding);
 }
 
-std::optional<OpenGlError> OpenGl::GetActiveUniformCE(
-    GlProgramId program,
-    size_t uniform_index,
-    size_t name_buffer_size,
-    size_t& out_written_to_name_buffer,
-    size_t& out_uniform_size,
-    GlUniformType& out_uniform_type,
-    char* out_name_buffer) noexcept
+std::optional<OpenGlError>
+OpenGl::UniformBlockBindingCE(GlProgramId program, uint32_t block_index, uint32_t binding) noexcept
 {
-    GetActiveUniformNE(
-        program,
-        uniform_index,
-        name_buffer_size,
-        out_written_to_name_buffer,
-        out_uniform_size,
-        out_uniform_type,
-        out_name_buffer);
+    UniformBlockBindingNE(program, block_index, binding);
     return Internal::ConsumeError(
-        "glGetActiveUniform(program: {}, index: {}, bufSize: {})",
+        "glUniformBlockBinding(program: {}, uniformBlockIndex: {}, uniformBlockBinding: {})",
         program.GetValue(),
-        uniform_index,
-        name_buffer_size);
+        block_index,
+        binding);
 }
 
-void OpenGl::GetActiveUniform(
-    GlProgramId program,
-    size_t uniform_index,
-    size_t name_buffer_size,
-    size_t& out_written_to_name_buffer,
-    size_t& out_uniform_size,
-    GlUniformType& out_uniform_type,
-    char* out_name_buffer) noexcept
+void OpenGl::UniformBlockBinding(GlProgramId program, uint32_t block_index, uint32_t binding)
 {
-    Internal::ThrowIfError(GetActiveUniformCE(
-        program,
-        uniform_index,
-        name_buffer_size,
-        out_written_to_name_buffer,
-        out_uniform_size,
-        out_uniform_type,
-        out_name_buffer));
+    Internal::ThrowIfError(UniformBlockBindingCE(program, block_index, binding));
 }
 
 // Log length
@@ -1775,13 +3382,21 @@ std::string OpenGl::GetProgramLog(GlProgramId program)
 
 void OpenGl::UseProgramNE(GlProgramId program) noexcept
 {
-    glUseProgram(program.GetValue());
+    if (GlStateCache::Get().UseProgram(program))
+    {
+        glUseProgram(program.GetValue());
+        GlTraceRecorder::Record(GlTraceOpcode::UseProgram, program.GetValue());
+        GlFrameStatsRegistry::OnProgramSwitch();
+    }
 }
 
 std::optional<OpenGlError> OpenGl::UseProgramCE(GlProgramId program) noexcept
 {
-    UseProgramNE(program);
-    return Internal::ConsumeError("glUseProgram(program: {})", program.GetValue());
+    if (!GlStateCache::Get().UseProgram(program)) return std::nullopt;
+    glUseProgram(program.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::UseProgram, program.GetValue());
+    GlFrameStatsRegistry::OnProgramSwitch();
+    return Internal::InvalidateCacheOnError(Internal::ConsumeError("glUseProgram(program: {})", program.GetValue()));
 }
 
 void OpenGl::UseProgram(GlProgramId program)
@@ -1814,7 +3429,10 @@ GLint OpenGl::GetUniformLocation(GlProgramId program, const char* name)
 
 void OpenGl::DeleteProgramNE(GlProgramId program) noexcept
 {
+    GlStateCache::Get().OnProgramDeleted(program);
     glDeleteProgram(program.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::DeleteObject, GlObjectKind::Program, program.GetValue());
+    GlMemoryTracker::OnDeleted(GlObjectKind::Program, program.GetValue());
 }
 
 std::optional<OpenGlError> OpenGl::DeleteProgramCE(GlProgramId program) noexcept
@@ -1828,6 +3446,143 @@ void OpenGl::DeleteProgram(GlProgramId program)
     Internal::ThrowIfError(DeleteProgramCE(program));
 }
 
+// Separable
+
+void OpenGl::SetProgramSeparableNE(GlProgramId program, bool separable) noexcept
+{
+    glProgramParameteri(program.GetValue(), GL_PROGRAM_SEPARABLE, separable ? GL_TRUE : GL_FALSE);
+    GlTraceRecorder::Record(GlTraceOpcode::SetProgramSeparable, program.GetValue(), separable);
+}
+
+std::optional<OpenGlError> OpenGl::SetProgramSeparableCE(GlProgramId program, bool separable) noexcept
+{
+    SetProgramSeparableNE(program, separable);
+    return Internal::ConsumeError(
+        "glProgramParameteri(program: {}, pname: GL_PROGRAM_SEPARABLE, value: {})",
+        program.GetValue(),
+        separable);
+}
+
+void OpenGl::SetProgramSeparable(GlProgramId program, bool separable)
+{
+    Internal::ThrowIfError(SetProgramSeparableCE(program, separable));
+}
+
+/********************************************** Program Pipeline **************************************************/
+
+// Gen
+
+GlProgramPipelineId OpenGl::GenProgramPipelineNE() noexcept
+{
+    return Internal::GenOneNE<GlProgramPipelineId>();
+}
+
+tl::expected<GlProgramPipelineId, OpenGlError> OpenGl::GenProgramPipelineCE() noexcept
+{
+    return Internal::GenOneCE<GlProgramPipelineId>();
+}
+
+GlProgramPipelineId OpenGl::GenProgramPipeline()
+{
+    return Internal::GenOne<GlProgramPipelineId>();
+}
+
+// Bind
+
+void OpenGl::BindProgramPipelineNE(GlProgramPipelineId pipeline) noexcept
+{
+    if (GlStateCache::Get().BindProgramPipeline(pipeline))
+    {
+        glBindProgramPipeline(pipeline.GetValue());
+        GlTraceRecorder::Record(GlTraceOpcode::BindProgramPipeline, pipeline.GetValue());
+        GlFrameStatsRegistry::OnProgramSwitch();
+    }
+}
+
+std::optional<OpenGlError> OpenGl::BindProgramPipelineCE(GlProgramPipelineId pipeline) noexcept
+{
+    if (!GlStateCache::Get().BindProgramPipeline(pipeline)) return std::nullopt;
+    glBindProgramPipeline(pipeline.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::BindProgramPipeline, pipeline.GetValue());
+    GlFrameStatsRegistry::OnProgramSwitch();
+    return Internal::InvalidateCacheOnError(
+        Internal::ConsumeError("glBindProgramPipeline(pipeline: {})", pipeline.GetValue()));
+}
+
+void OpenGl::BindProgramPipeline(GlProgramPipelineId pipeline)
+{
+    Internal::ThrowIfError(BindProgramPipelineCE(pipeline));
+}
+
+// Use program stages
+
+void OpenGl::UseProgramStageNE(GlProgramPipelineId pipeline, GlShaderType stage, GlProgramId program) noexcept
+{
+    glUseProgramStages(pipeline.GetValue(), ToGlStageBit(stage), program.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::UseProgramStage, pipeline.GetValue(), stage, program.GetValue());
+    GlFrameStatsRegistry::OnStateChange();
+}
+
+std::optional<OpenGlError>
+OpenGl::UseProgramStageCE(GlProgramPipelineId pipeline, GlShaderType stage, GlProgramId program) noexcept
+{
+    UseProgramStageNE(pipeline, stage, program);
+    return Internal::ConsumeError(
+        "glUseProgramStages(pipeline: {}, stages: {}, program: {})",
+        pipeline.GetValue(),
+        stage,
+        program.GetValue());
+}
+
+void OpenGl::UseProgramStage(GlProgramPipelineId pipeline, GlShaderType stage, GlProgramId program)
+{
+    Internal::ThrowIfError(UseProgramStageCE(pipeline, stage, program));
+}
+
+// Active shader program
+
+void OpenGl::ActiveShaderProgramNE(GlProgramPipelineId pipeline, GlProgramId program) noexcept
+{
+    glActiveShaderProgram(pipeline.GetValue(), program.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::ActiveShaderProgram, pipeline.GetValue(), program.GetValue());
+    GlFrameStatsRegistry::OnStateChange();
+}
+
+std::optional<OpenGlError> OpenGl::ActiveShaderProgramCE(GlProgramPipelineId pipeline, GlProgramId program) noexcept
+{
+    ActiveShaderProgramNE(pipeline, program);
+    return Internal::ConsumeError(
+        "glActiveShaderProgram(pipeline: {}, program: {})",
+        pipeline.GetValue(),
+        program.GetValue());
+}
+
+void OpenGl::ActiveShaderProgram(GlProgramPipelineId pipeline, GlProgramId program)
+{
+    Internal::ThrowIfError(ActiveShaderProgramCE(pipeline, program));
+}
+
+// Delete
+
+void OpenGl::DeleteProgramPipelineNE(GlProgramPipelineId pipeline) noexcept
+{
+    GlStateCache::Get().OnProgramPipelineDeleted(pipeline);
+    glDeleteProgramPipelines(1, &pipeline.GetValue());
+    GlTraceRecorder::Record(GlTraceOpcode::DeleteObject, GlObjectKind::ProgramPipeline, pipeline.GetValue());
+    GlMemoryTracker::OnDeleted(GlObjectKind::ProgramPipeline, pipeline.GetValue());
+}
+
+std::optional<OpenGlError> OpenGl::DeleteProgramPipelineCE(GlProgramPipelineId pipeline) noexcept
+{
+    DeleteProgramPipelineNE(pipeline);
+    return Internal::ConsumeError("glDeleteProgramPipelines(n: 1, pipelines: {})", pipeline.GetValue());
+}
+
+void OpenGl::DeleteProgramPipeline(GlProgramPipelineId pipeline)
+{
+    Internal::ThrowIfError(DeleteProgramPipelineCE(pipeline));
+}
+
 /*************************************************** Clear ********************************************************/
 
 // Set clear color
@@ -1835,6 +3590,7 @@ void OpenGl::DeleteProgram(GlProgramId program)
 void OpenGl::SetClearColorNE(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) noexcept
 {
     glClearColor(red, green, blue, alpha);
+    GlTraceRecorder::Record(GlTraceOpcode::SetClearColor, red, green, blue, alpha);
 }
 
 std::optional<OpenGlError> OpenGl::SetClearColorCE(GLfloat r, GLfloat g, GLfloat b, GLfloat a) noexcept
@@ -1870,6 +3626,7 @@ void OpenGl::SetClearColor(const Vec4f& color)
 void OpenGl::ClearNE(GLbitfield mask) noexcept
 {
     glClear(mask);
+    GlTraceRecorder::Record(GlTraceOpcode::Clear, mask);
 }
 
 std::optional<OpenGlError> OpenGl::ClearCE(GLbitfield mask) noexcept
@@ -1897,6 +3654,9 @@ void OpenGl::EnableFaceCullingNE(bool value) noexcept
     {
         glDisable(GL_CULL_FACE);
     }
+
+    GlTraceRecorder::Record(GlTraceOpcode::EnableFaceCulling, value);
+    GlFrameStatsRegistry::OnStateChange();
 }
 
 std::optional<OpenGlError> OpenGl::EnableFaceCullingCE(bool value) noexcept
@@ -1915,6 +3675,8 @@ void OpenGl::EnableFaceCulling(bool value)
 void OpenGl::CullFaceNE(GlCullFaceMode mode) noexcept
 {
     glCullFace(ToGlValue(mode));
+    GlTraceRecorder::Record(GlTraceOpcode::CullFace, mode);
+    GlFrameStatsRegistry::OnStateChange();
 }
 
 std::optional<OpenGlError> OpenGl::CullFaceCE(GlCullFaceMode mode) noexcept
@@ -1945,6 +3707,14 @@ void OpenGl::VertexAttribPointerNE(
         Internal::CastBool(normalized),
         static_cast<GLsizei>(stride),
         pointer);
+    GlTraceRecorder::Record(
+        GlTraceOpcode::VertexAttribPointer,
+        index,
+        size,
+        type,
+        normalized,
+        stride,
+        reinterpret_cast<uintptr_t>(pointer));  // NOLINT
 }
 
 std::optional<OpenGlError> OpenGl::VertexAttribPointerCE(
@@ -1992,6 +3762,13 @@ void OpenGl::VertexAttribIPointerNE(
         ToGlValue(type),
         static_cast<GLsizei>(stride),
         pointer);
+    GlTraceRecorder::Record(
+        GlTraceOpcode::VertexAttribIPointer,
+        index,
+        size,
+        type,
+        stride,
+        reinterpret_cast<uintptr_t>(pointer));  // NOLINT
 }
 
 std::optional<OpenGlError> OpenGl::VertexAttribIPointerCE(
@@ -2021,6 +3798,25 @@ void OpenGl::VertexAttribIPointer(
     Internal::ThrowIfError(VertexAttribIPointerCE(index, size, type, stride, pointer));
 }
 
+// Divisor
+
+void OpenGl::VertexAttribDivisorNE(size_t index, size_t divisor) noexcept
+{
+    glVertexAttribDivisor(static_cast<GLuint>(index), static_cast<GLuint>(divisor));
+    GlTraceRecorder::Record(GlTraceOpcode::VertexAttribDivisor, index, divisor);
+}
+
+std::optional<OpenGlError> OpenGl::VertexAttribDivisorCE(size_t index, size_t divisor) noexcept
+{
+    VertexAttribDivisorNE(index, divisor);
+    return Internal::ConsumeError("glVertexAttribDivisor(index: {}, divisor: {})", index, divisor);
+}
+
+void OpenGl::VertexAttribDivisor(size_t index, size_t divisor)
+{
+    Internal::ThrowIfError(VertexAttribDivisorCE(index, divisor));
+}
+
 /****************************************************** Draw ******************************************************/
 
 // Draw elements
@@ -2033,6 +3829,13 @@ void OpenGl::DrawElementsNE(
 {
     ScopeAnnotation annotation("OpenGl::Draw");
     glDrawElements(ToGlValue(mode), static_cast<GLsizei>(num), ToGlValue(indices_type), indices);
+    GlTraceRecorder::Record(
+        GlTraceOpcode::DrawElements,
+        mode,
+        num,
+        indices_type,
+        reinterpret_cast<uintptr_t>(indices));
+    GlFrameStatsRegistry::OnDraw(num, 1);  // NOLINT
 }
 
 std::optional<OpenGlError> OpenGl::DrawElementsCE(
@@ -2071,6 +3874,14 @@ void OpenGl::DrawElementsInstancedNE(
         ToGlValue(indices_type),
         indices,
         static_cast<GLsizei>(num_instances));
+    GlTraceRecorder::Record(
+        GlTraceOpcode::DrawElementsInstanced,
+        mode,
+        num,
+        indices_type,
+        reinterpret_cast<uintptr_t>(indices),  // NOLINT
+        num_instances);
+    GlFrameStatsRegistry::OnDraw(num, num_instances);
 }
 
 std::optional<OpenGlError> OpenGl::DrawElementsInstancedCE(
@@ -2105,6 +3916,8 @@ void OpenGl::DrawElementsInstanced(
 void OpenGl::DrawArraysNE(GlPrimitiveType mode, size_t first_index, size_t indices_count) noexcept
 {
     glDrawArrays(ToGlValue(mode), static_cast<GLint>(first_index), static_cast<GLsizei>(indices_count));
+    GlTraceRecorder::Record(GlTraceOpcode::DrawArrays, mode, first_index, indices_count);
+    GlFrameStatsRegistry::OnDraw(indices_count, 1);
 }
 
 std::optional<OpenGlError> OpenGl::DrawArraysCE(GlPrimitiveType mode, size_t first_index, size_t indices_count) noexcept
@@ -2131,6 +3944,8 @@ void OpenGl::DrawArraysInstancedNE(
         static_cast<GLint>(first_index),
         static_cast<GLsizei>(indices_count),
         static_cast<GLsizei>(instances_count));
+    GlTraceRecorder::Record(GlTraceOpcode::DrawArraysInstanced, mode, first_index, indices_count, instances_count);
+    GlFrameStatsRegistry::OnDraw(indices_count, instances_count);
 }
 
 std::optional<OpenGlError> OpenGl::DrawArraysInstancedCE(
@@ -2153,11 +3968,90 @@ void OpenGl::DrawArraysInstanced(GlPrimitiveType mode, size_t first_index, size_
     Internal::ThrowIfError(DrawArraysInstancedCE(mode, first_index, indices_count, instances_count));
 }
 
+/************************************************ Synchronization *************************************************/
+
+// Memory barrier
+
+void OpenGl::InsertMemoryBarrierNE(GLbitfield barriers) noexcept
+{
+    glMemoryBarrier(barriers);
+    GlTraceRecorder::Record(GlTraceOpcode::InsertMemoryBarrier, barriers);
+}
+
+std::optional<OpenGlError> OpenGl::InsertMemoryBarrierCE(GLbitfield barriers) noexcept
+{
+    InsertMemoryBarrierNE(barriers);
+    return Internal::ConsumeError("glMemoryBarrier(barriers: {:#x})", barriers);
+}
+
+void OpenGl::InsertMemoryBarrier(GLbitfield barriers)
+{
+    Internal::ThrowIfError(InsertMemoryBarrierCE(barriers));
+}
+
+// Fence sync
+
+GLsync OpenGl::FenceSyncNE() noexcept
+{
+    return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+tl::expected<GLsync, OpenGlError> OpenGl::FenceSyncCE() noexcept
+{
+    return Internal::ValueOrError(FenceSyncNE(), "glFenceSync(condition: GL_SYNC_GPU_COMMANDS_COMPLETE, flags: 0)");
+}
+
+GLsync OpenGl::FenceSync()
+{
+    return Internal::TryTakeValue(FenceSyncCE());
+}
+
+// Client wait sync
+
+GLenum OpenGl::ClientWaitSyncNE(GLsync sync, GLbitfield flags, uint64_t timeout_ns) noexcept
+{
+    return glClientWaitSync(sync, flags, timeout_ns);
+}
+
+tl::expected<GLenum, OpenGlError> OpenGl::ClientWaitSyncCE(GLsync sync, GLbitfield flags, uint64_t timeout_ns) noexcept
+{
+    return Internal::ValueOrError(
+        ClientWaitSyncNE(sync, flags, timeout_ns),
+        "glClientWaitSync(sync: {}, flags: {:#x}, timeout: {})",
+        static_cast<const void*>(sync),
+        flags,
+        timeout_ns);
+}
+
+GLenum OpenGl::ClientWaitSync(GLsync sync, GLbitfield flags, uint64_t timeout_ns)
+{
+    return Internal::TryTakeValue(ClientWaitSyncCE(sync, flags, timeout_ns));
+}
+
+// Delete sync
+
+void OpenGl::DeleteSyncNE(GLsync sync) noexcept
+{
+    glDeleteSync(sync);
+}
+
+std::optional<OpenGlError> OpenGl::DeleteSyncCE(GLsync sync) noexcept
+{
+    DeleteSyncNE(sync);
+    return Internal::ConsumeError("glDeleteSync(sync: {})", static_cast<const void*>(sync));
+}
+
+void OpenGl::DeleteSync(GLsync sync)
+{
+    Internal::ThrowIfError(DeleteSyncCE(sync));
+}
+
 /******************************************************************************************************************/
 
 void OpenGl::EnableVertexAttribArrayNE(size_t index) noexcept
 {
     glEnableVertexAttribArray(static_cast<GLuint>(index));
+    GlTraceRecorder::Record(GlTraceOpcode::EnableVertexAttribArray, index);
 }
 
 std::optional<OpenGlError> OpenGl::EnableVertexAttribArrayCE(size_t index) noexcept
@@ -2171,54 +4065,136 @@ void OpenGl::EnableVertexAttribArray(size_t index)
     Internal::ThrowIfError(EnableVertexAttribArrayCE(index));
 }
 
+void OpenGl::SetDepthTestEnabledNE(bool enabled) noexcept
+{
+    if (GlStateCache::Get().SetDepthTestEnabled(enabled))
+    {
+        enabled ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
+        GlTraceRecorder::Record(GlTraceOpcode::SetDepthTestEnabled, enabled);
+        GlFrameStatsRegistry::OnStateChange();
+    }
+}
+
+std::optional<OpenGlError> OpenGl::SetDepthTestEnabledCE(bool enabled) noexcept
+{
+    if (!GlStateCache::Get().SetDepthTestEnabled(enabled)) return std::nullopt;
+    enabled ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
+    GlTraceRecorder::Record(GlTraceOpcode::SetDepthTestEnabled, enabled);
+    GlFrameStatsRegistry::OnStateChange();
+    return Internal::InvalidateCacheOnError(
+        Internal::ConsumeError("{}(GL_DEPTH_TEST)", enabled ? "glEnable" : "glDisable"));
+}
+
+void OpenGl::SetDepthTestEnabled(bool enabled)
+{
+    Internal::ThrowIfError(SetDepthTestEnabledCE(enabled));
+}
+
 void OpenGl::EnableDepthTestNE() noexcept
 {
-    glEnable(GL_DEPTH_TEST);
+    SetDepthTestEnabledNE(true);
 }
 
 std::optional<OpenGlError> OpenGl::EnableDepthTestCE() noexcept
 {
-    EnableDepthTestNE();
-    return Internal::ConsumeError("glEnable(GL_DEPTH_TEST)");
+    return SetDepthTestEnabledCE(true);
 }
 
 void OpenGl::EnableDepthTest()
 {
-    Internal::ThrowIfError(EnableDepthTestCE());
+    SetDepthTestEnabled(true);
+}
+
+void OpenGl::SetBlendingEnabledNE(bool enabled) noexcept
+{
+    if (GlStateCache::Get().SetBlendingEnabled(enabled))
+    {
+        enabled ? glEnable(GL_BLEND) : glDisable(GL_BLEND);
+        GlTraceRecorder::Record(GlTraceOpcode::SetBlendingEnabled, enabled);
+        GlFrameStatsRegistry::OnStateChange();
+    }
+}
+
+std::optional<OpenGlError> OpenGl::SetBlendingEnabledCE(bool enabled) noexcept
+{
+    if (!GlStateCache::Get().SetBlendingEnabled(enabled)) return std::nullopt;
+    enabled ? glEnable(GL_BLEND) : glDisable(GL_BLEND);
+    GlTraceRecorder::Record(GlTraceOpcode::SetBlendingEnabled, enabled);
+    GlFrameStatsRegistry::OnStateChange();
+    return Internal::InvalidateCacheOnError(Internal::ConsumeError("{}(GL_BLEND)", enabled ? "glEnable" : "glDisable"));
+}
+
+void OpenGl::SetBlendingEnabled(bool enabled)
+{
+    Internal::ThrowIfError(SetBlendingEnabledCE(enabled));
 }
 
 void OpenGl::EnableBlendingNE() noexcept
 {
-    glEnable(GL_BLEND);
+    SetBlendingEnabledNE(true);
 }
 
 std::optional<OpenGlError> OpenGl::EnableBlendingCE() noexcept
 {
-    EnableBlendingNE();
-    return Internal::ConsumeError("glEnable(GL_BLEND)");
+    return SetBlendingEnabledCE(true);
 }
 
 void OpenGl::EnableBlending()
 {
-    Internal::ThrowIfError(EnableBlendingCE());
+    SetBlendingEnabled(true);
+}
+
+void OpenGl::SetBlendFunctionNE(GLenum source_factor, GLenum destination_factor) noexcept
+{
+    if (GlStateCache::Get().SetBlendFunction(source_factor, destination_factor))
+    {
+        glBlendFunc(source_factor, destination_factor);
+        GlTraceRecorder::Record(GlTraceOpcode::SetBlendFunction, source_factor, destination_factor);
+        GlFrameStatsRegistry::OnStateChange();
+    }
+}
+
+std::optional<OpenGlError> OpenGl::SetBlendFunctionCE(GLenum source_factor, GLenum destination_factor) noexcept
+{
+    if (!GlStateCache::Get().SetBlendFunction(source_factor, destination_factor)) return std::nullopt;
+    glBlendFunc(source_factor, destination_factor);
+    GlTraceRecorder::Record(GlTraceOpcode::SetBlendFunction, source_factor, destination_factor);
+    GlFrameStatsRegistry::OnStateChange();
+    return Internal::InvalidateCacheOnError(
+        Internal::ConsumeError("glBlendFunc(sfactor: {:#x}, dfactor: {:#x})", source_factor, destination_factor));
+}
+
+void OpenGl::SetBlendFunction(GLenum source_factor, GLenum destination_factor)
+{
+    Internal::ThrowIfError(SetBlendFunctionCE(source_factor, destination_factor));
 }
 
 void OpenGl::SetViewportNE(const Viewport& viewport) noexcept
 {
-    auto p = viewport.position.Cast<GLint>();
-    auto s = viewport.size.Cast<GLsizei>();
-    glViewport(p.x(), p.y(), s.x(), s.y());
+    if (GlStateCache::Get().SetViewport(viewport))
+    {
+        auto p = viewport.position.Cast<GLint>();
+        auto s = viewport.size.Cast<GLsizei>();
+        glViewport(p.x(), p.y(), s.x(), s.y());
+        GlTraceRecorder::Record(GlTraceOpcode::SetViewport, p.x(), p.y(), s.x(), s.y());
+        GlFrameStatsRegistry::OnStateChange();
+    }
 }
 
 std::optional<OpenGlError> OpenGl::SetViewportCE(const Viewport& viewport) noexcept
 {
-    SetViewportNE(viewport);
-    return Internal::ConsumeError(
+    if (!GlStateCache::Get().SetViewport(viewport)) return std::nullopt;
+    auto p = viewport.position.Cast<GLint>();
+    auto s = viewport.size.Cast<GLsizei>();
+    glViewport(p.x(), p.y(), s.x(), s.y());
+    GlTraceRecorder::Record(GlTraceOpcode::SetViewport, p.x(), p.y(), s.x(), s.y());
+    GlFrameStatsRegistry::OnStateChange();
+    return Internal::InvalidateCacheOnError(Internal::ConsumeError(
         "glViewport(x: {}, y: {}, width: {}, height {})",
         viewport.position.x(),
         viewport.position.y(),
         viewport.size.x(),
-        viewport.size.y());
+        viewport.size.y()));
 }
 
 void OpenGl::SetViewport(const klgl::Viewport& viewport)
@@ -2229,6 +4205,8 @@ void OpenGl::SetViewport(const klgl::Viewport& viewport)
 void OpenGl::GenerateMipmapNE(GLenum target) noexcept
 {
     glGenerateMipmap(target);
+    GlTraceRecorder::Record(GlTraceOpcode::GenerateMipmap, target);
+    GlMemoryTracker::OnGenerateMipmap(target);
 }
 
 void OpenGl::GenerateMipmap(GLenum target)
@@ -2240,6 +4218,8 @@ void OpenGl::GenerateMipmap(GLenum target)
 void OpenGl::PolygonModeNE(GlPolygonMode mode) noexcept
 {
     glPolygonMode(GL_FRONT_AND_BACK, ToGlValue(mode));
+    GlTraceRecorder::Record(GlTraceOpcode::PolygonMode, mode);
+    GlFrameStatsRegistry::OnStateChange();
 }
 
 void OpenGl::PolygonMode(GlPolygonMode mode)
@@ -2251,6 +4231,8 @@ void OpenGl::PolygonMode(GlPolygonMode mode)
 void OpenGl::PointSizeNE(float size) noexcept
 {
     glPointSize(size);
+    GlTraceRecorder::Record(GlTraceOpcode::PointSize, size);
+    GlFrameStatsRegistry::OnStateChange();
 }
 
 void OpenGl::PointSize(float size)
@@ -2262,6 +4244,8 @@ void OpenGl::PointSize(float size)
 void OpenGl::LineWidthNE(float width) noexcept
 {
     glLineWidth(width);
+    GlTraceRecorder::Record(GlTraceOpcode::LineWidth, width);
+    GlFrameStatsRegistry::OnStateChange();
 }
 
 void OpenGl::LineWidth(float width)
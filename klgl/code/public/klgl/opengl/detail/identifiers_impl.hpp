@@ -1,5 +1,6 @@
 #include <string_view>
 
+#include "klgl/opengl/enums.hpp"
 #include "klgl/opengl/identifiers.hpp"
 
 namespace klgl::detail
@@ -12,6 +13,7 @@ struct IdTraits<GlTextureId>
 {
     static constexpr auto generator = &glGenTextures;
     static constexpr std::string_view generator_name = "glGenTextures";
+    static constexpr GlObjectKind kind = GlObjectKind::Texture;
 };
 
 template <>
@@ -19,6 +21,7 @@ struct IdTraits<GlBufferId>
 {
     static constexpr auto generator = &glGenBuffers;
     static constexpr std::string_view generator_name = "glGenBuffers";
+    static constexpr GlObjectKind kind = GlObjectKind::Buffer;
 };
 
 template <>
@@ -26,6 +29,15 @@ struct IdTraits<GlVertexArrayId>
 {
     static constexpr auto generator = &glGenVertexArrays;
     static constexpr std::string_view generator_name = "glGenVertexArrays";
+    static constexpr GlObjectKind kind = GlObjectKind::VertexArray;
+};
+
+template <>
+struct IdTraits<GlProgramPipelineId>
+{
+    static constexpr auto generator = &glGenProgramPipelines;
+    static constexpr std::string_view generator_name = "glGenProgramPipelines";
+    static constexpr GlObjectKind kind = GlObjectKind::ProgramPipeline;
 };
 
 template <>
@@ -33,6 +45,7 @@ struct IdTraits<GlFramebufferId>
 {
     static constexpr auto generator = &glGenFramebuffers;
     static constexpr std::string_view generator_name = "glGenFramebuffers";
+    static constexpr GlObjectKind kind = GlObjectKind::Framebuffer;
 };
 
 template <>
@@ -40,6 +53,7 @@ struct IdTraits<GlRenderbufferId>
 {
     static constexpr auto generator = &glGenRenderbuffers;
     static constexpr std::string_view generator_name = "glGenRenderbuffers";
+    static constexpr GlObjectKind kind = GlObjectKind::Renderbuffer;
 };
 
 }  // namespace klgl::detail
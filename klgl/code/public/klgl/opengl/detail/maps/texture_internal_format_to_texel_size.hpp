@@ -0,0 +1,100 @@
+#pragma once
+
+#include <ass/enum_map.hpp>
+
+#include "klgl/macro/ensure_enum_size.hpp"
+#include "klgl/opengl/enums.hpp"
+
+namespace klgl::detail
+{
+// Bytes per texel as drivers usually store them. Three component formats with 8 bit and 16 bit components are
+// padded to four components, unsized formats are assumed to have 8 bits per component
+inline constexpr auto kTextureInternalFormatToTexelSize = []
+{
+    ass::EnumMap<GlTextureInternalFormat, uint8_t> map;
+
+    auto add = [&](auto key, uint8_t value)
+    {
+        assert(!map.Contains(key));
+        map.GetOrAdd(key) = value;
+    };
+
+    KLGL_ENSURE_ENUM_SIZE(GlTextureInternalFormat, 73);
+    add(GlTextureInternalFormat::DEPTH_COMPONENT, 4);
+    add(GlTextureInternalFormat::DEPTH_STENCIL, 4);
+    add(GlTextureInternalFormat::RED, 1);
+    add(GlTextureInternalFormat::RG, 2);
+    add(GlTextureInternalFormat::RGB, 4);
+    add(GlTextureInternalFormat::RGBA, 4);
+    add(GlTextureInternalFormat::R8, 1);
+    add(GlTextureInternalFormat::R8_SNORM, 1);
+    add(GlTextureInternalFormat::R16, 2);
+    add(GlTextureInternalFormat::R16_SNORM, 2);
+    add(GlTextureInternalFormat::RG8, 2);
+    add(GlTextureInternalFormat::RG8_SNORM, 2);
+    add(GlTextureInternalFormat::RG16, 4);
+    add(GlTextureInternalFormat::RG16_SNORM, 4);
+    add(GlTextureInternalFormat::R3_G3_B2, 1);
+    add(GlTextureInternalFormat::RGB4, 2);
+    add(GlTextureInternalFormat::RGB5, 2);
+    add(GlTextureInternalFormat::RGB8, 4);
+    add(GlTextureInternalFormat::RGB8_SNORM, 4);
+    add(GlTextureInternalFormat::RGB10, 4);
+    add(GlTextureInternalFormat::RGB12, 8);
+    add(GlTextureInternalFormat::RGB16_SNORM, 8);
+    add(GlTextureInternalFormat::RGBA2, 1);
+    add(GlTextureInternalFormat::RGBA4, 2);
+    add(GlTextureInternalFormat::RGB5_A1, 2);
+    add(GlTextureInternalFormat::RGBA8, 4);
+    add(GlTextureInternalFormat::RGBA8_SNORM, 4);
+    add(GlTextureInternalFormat::RGB10_A2, 4);
+    add(GlTextureInternalFormat::RGB10_A2UI, 4);
+    add(GlTextureInternalFormat::RGBA12, 8);
+    add(GlTextureInternalFormat::RGBA16, 8);
+    add(GlTextureInternalFormat::SRGB8, 4);
+    add(GlTextureInternalFormat::SRGB8_ALPHA8, 4);
+    add(GlTextureInternalFormat::R16F, 2);
+    add(GlTextureInternalFormat::RG16F, 4);
+    add(GlTextureInternalFormat::RGB16F, 8);
+    add(GlTextureInternalFormat::RGBA16F, 8);
+    add(GlTextureInternalFormat::R32F, 4);
+    add(GlTextureInternalFormat::RG32F, 8);
+    add(GlTextureInternalFormat::RGB32F, 12);
+    add(GlTextureInternalFormat::RGBA32F, 16);
+    add(GlTextureInternalFormat::R11F_G11F_B10F, 4);
+    add(GlTextureInternalFormat::RGB9_E5, 4);
+    add(GlTextureInternalFormat::R8I, 1);
+    add(GlTextureInternalFormat::R8UI, 1);
+    add(GlTextureInternalFormat::R16I, 2);
+    add(GlTextureInternalFormat::R16UI, 2);
+    add(GlTextureInternalFormat::R32I, 4);
+    add(GlTextureInternalFormat::R32UI, 4);
+    add(GlTextureInternalFormat::RG8I, 2);
+    add(GlTextureInternalFormat::RG8UI, 2);
+    add(GlTextureInternalFormat::RG16I, 4);
+    add(GlTextureInternalFormat::RG16UI, 4);
+    add(GlTextureInternalFormat::RG32I, 8);
+    add(GlTextureInternalFormat::RG32UI, 8);
+    add(GlTextureInternalFormat::RGB8I, 4);
+    add(GlTextureInternalFormat::RGB8UI, 4);
+    add(GlTextureInternalFormat::RGB16I, 8);
+    add(GlTextureInternalFormat::RGB16UI, 8);
+    add(GlTextureInternalFormat::RGB32I, 12);
+    add(GlTextureInternalFormat::RGB32UI, 12);
+    add(GlTextureInternalFormat::RGBA8I, 4);
+    add(GlTextureInternalFormat::RGBA8UI, 4);
+    add(GlTextureInternalFormat::RGBA16I, 8);
+    add(GlTextureInternalFormat::RGBA16UI, 8);
+    add(GlTextureInternalFormat::RGBA32I, 16);
+    add(GlTextureInternalFormat::RGBA32UI, 16);
+    add(GlTextureInternalFormat::DEPTH16, 2);
+    add(GlTextureInternalFormat::DEPTH24, 4);
+    add(GlTextureInternalFormat::DEPTH32F, 4);
+    add(GlTextureInternalFormat::DEPTH24_STENCIL8, 4);
+    add(GlTextureInternalFormat::DEPTH32F_STENCIL8, 8);
+    add(GlTextureInternalFormat::STENCIL_INDEX8, 1);
+
+    return map;
+}();
+
+}  // namespace klgl::detail
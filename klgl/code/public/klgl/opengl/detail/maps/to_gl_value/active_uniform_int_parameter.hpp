@@ -0,0 +1,35 @@
+#pragma once
+
+#include "klgl/macro/ensure_enum_size.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/opengl_value_converter.hpp"
+#include "klgl/opengl/enums.hpp"
+
+namespace klgl::detail
+{
+inline constexpr auto kGlActiveUniformIntParameterToGlValue = []
+{
+    using T = GlActiveUniformIntParameter;
+    OpenGlValueConverter<T, GLenum> c;
+
+    KLGL_ENSURE_ENUM_SIZE(T, 8);
+    c.Add(T::Type, GL_UNIFORM_TYPE);
+    c.Add(T::Size, GL_UNIFORM_SIZE);
+    c.Add(T::NameLength, GL_UNIFORM_NAME_LENGTH);
+    c.Add(T::BlockIndex, GL_UNIFORM_BLOCK_INDEX);
+    c.Add(T::Offset, GL_UNIFORM_OFFSET);
+    c.Add(T::ArrayStride, GL_UNIFORM_ARRAY_STRIDE);
+    c.Add(T::MatrixStride, GL_UNIFORM_MATRIX_STRIDE);
+    c.Add(T::IsRowMajor, GL_UNIFORM_IS_ROW_MAJOR);
+
+    return c;
+}();
+}  // namespace klgl::detail
+namespace klgl
+{
+
+[[nodiscard]] constexpr GLenum ToGlValue(GlActiveUniformIntParameter parameter) noexcept
+{
+    return detail::kGlActiveUniformIntParameterToGlValue.to_gl_value.Get(parameter);
+}
+
+}  // namespace klgl
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "klgl/macro/ensure_enum_size.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/opengl_value_converter.hpp"
+#include "klgl/opengl/enums.hpp"
+
+namespace klgl::detail
+{
+inline constexpr auto kGlShaderTypeToGlStageBit = []
+{
+    using T = GlShaderType;
+    OpenGlValueConverter<T, GLbitfield> c;
+
+    KLGL_ENSURE_ENUM_SIZE(T, 6);
+    c.Add(T::Compute, GL_COMPUTE_SHADER_BIT);
+    c.Add(T::Vertex, GL_VERTEX_SHADER_BIT);
+    c.Add(T::TesselationControl, GL_TESS_CONTROL_SHADER_BIT);
+    c.Add(T::TesselationEvaluation, GL_TESS_EVALUATION_SHADER_BIT);
+    c.Add(T::Geometry, GL_GEOMETRY_SHADER_BIT);
+    c.Add(T::Fragment, GL_FRAGMENT_SHADER_BIT);
+
+    return c;
+}();
+}  // namespace klgl::detail
+namespace klgl
+{
+
+// Bit used by glUseProgramStages for the stage
+[[nodiscard]] constexpr GLbitfield ToGlStageBit(GlShaderType shader_type) noexcept
+{
+    return detail::kGlShaderTypeToGlStageBit.to_gl_value.Get(shader_type);
+}
+
+}  // namespace klgl
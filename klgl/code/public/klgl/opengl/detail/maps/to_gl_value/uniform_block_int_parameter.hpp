@@ -0,0 +1,37 @@
+#pragma once
+
+#include "klgl/macro/ensure_enum_size.hpp"
+#include "klgl/opengl/detail/maps/to_gl_value/opengl_value_converter.hpp"
+#include "klgl/opengl/enums.hpp"
+
+namespace klgl::detail
+{
+inline constexpr auto kGlUniformBlockIntParameterToGlValue = []
+{
+    using T = GlUniformBlockIntParameter;
+    OpenGlValueConverter<T, GLenum> c;
+
+    KLGL_ENSURE_ENUM_SIZE(T, 10);
+    c.Add(T::Binding, GL_UNIFORM_BLOCK_BINDING);
+    c.Add(T::DataSize, GL_UNIFORM_BLOCK_DATA_SIZE);
+    c.Add(T::NameLength, GL_UNIFORM_BLOCK_NAME_LENGTH);
+    c.Add(T::ActiveUniforms, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS);
+    c.Add(T::ReferencedByVertexShader, GL_UNIFORM_BLOCK_REFERENCED_BY_VERTEX_SHADER);
+    c.Add(T::ReferencedByTessControlShader, GL_UNIFORM_BLOCK_REFERENCED_BY_TESS_CONTROL_SHADER);
+    c.Add(T::ReferencedByTessEvaluationShader, GL_UNIFORM_BLOCK_REFERENCED_BY_TESS_EVALUATION_SHADER);
+    c.Add(T::ReferencedByGeometryShader, GL_UNIFORM_BLOCK_REFERENCED_BY_GEOMETRY_SHADER);
+    c.Add(T::ReferencedByFragmentShader, GL_UNIFORM_BLOCK_REFERENCED_BY_FRAGMENT_SHADER);
+    c.Add(T::ReferencedByComputeShader, GL_UNIFORM_BLOCK_REFERENCED_BY_COMPUTE_SHADER);
+
+    return c;
+}();
+}  // namespace klgl::detail
+namespace klgl
+{
+
+[[nodiscard]] constexpr GLenum ToGlValue(GlUniformBlockIntParameter parameter) noexcept
+{
+    return detail::kGlUniformBlockIntParameterToGlValue.to_gl_value.Get(parameter);
+}
+
+}  // namespace klgl
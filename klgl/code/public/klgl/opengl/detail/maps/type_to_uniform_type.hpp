@@ -0,0 +1,37 @@
+#pragma once
+
+#include "EverydayTools/Math/Matrix.hpp"
+#include "klgl/opengl/enums.hpp"
+
+#ifdef KLGL_MAPPER
+#pragma error "Error: macro already dfined"
+#else
+#define KLGL_MAPPER(Type, Value)                      \
+    template <>                                       \
+    struct TypeToGlUniformType<Type>                  \
+    {                                                 \
+        static constexpr GlUniformType value = Value; \
+    }
+#endif
+
+namespace klgl::detail
+{
+template <typename T>
+struct TypeToGlUniformType;
+
+KLGL_MAPPER(float, GlUniformType::Float);
+KLGL_MAPPER(int32_t, GlUniformType::Int);
+KLGL_MAPPER(uint32_t, GlUniformType::UnsignedInt);
+KLGL_MAPPER(edt::Vec2f, GlUniformType::FloatVec2);
+KLGL_MAPPER(edt::Vec3f, GlUniformType::FloatVec3);
+KLGL_MAPPER(edt::Vec4f, GlUniformType::FloatVec4);
+KLGL_MAPPER(edt::Vec2i, GlUniformType::IntVec2);
+KLGL_MAPPER(edt::Vec3i, GlUniformType::IntVec3);
+KLGL_MAPPER(edt::Vec2u32, GlUniformType::UnsignedIntVec2);
+KLGL_MAPPER(edt::Mat2f, GlUniformType::FloatMat2);
+KLGL_MAPPER(edt::Mat3f, GlUniformType::FloatMat3);
+KLGL_MAPPER(edt::Mat4f, GlUniformType::FloatMat4);
+
+}  // namespace klgl::detail
+
+#undef KLGL_MAPPER
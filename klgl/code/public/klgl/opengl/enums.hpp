@@ -19,6 +19,48 @@ enum class GlError : uint8_t
     Unknown
 };
 
+// How OpenGl wrappers detect errors. See OpenGl::SetErrorCheckMode
+enum class GlErrorCheckMode : uint8_t
+{
+    // Errors are not checked
+    Off,
+
+    // glGetError after each checked call. Errors are reported by the call that caused them
+    PerCall,
+
+    // glGetError once per frame. Errors of the whole frame are reported together
+    PerFrame,
+
+    // Driver reports errors through KHR_debug callback, frame end reports them
+    DebugCallback,
+};
+
+// When objects released by GlObject are deleted. See GlDeletionQueue
+enum class GlDeletionMode : uint8_t
+{
+    // Destructor deletes the object right away
+    Immediate,
+
+    // Objects are deleted at the end of the frame, one glDelete* call per kind
+    FrameEnd,
+
+    // Objects are deleted after the fence inserted at the end of their frame signals
+    Fence,
+};
+
+// Kind of object whose names are generated by OpenGL
+enum class GlObjectKind : uint8_t
+{
+    Buffer,
+    VertexArray,
+    Texture,
+    Framebuffer,
+    Renderbuffer,
+    ProgramPipeline,
+    Shader,
+    Program,
+};
+
 enum class GlPixelBufferLayout : uint8_t
 {
     R,
@@ -500,11 +542,46 @@ enum class GlFramebufferAttachment : uint8_t
     DepthStencil
 };
 
+enum class GlActiveUniformIntParameter : uint8_t
+{
+    Type,
+    Size,
+    NameLength,
+    BlockIndex,
+    Offset,
+    ArrayStride,
+    MatrixStride,
+    IsRowMajor
+};
+
+enum class GlUniformBlockIntParameter : uint8_t
+{
+    Binding,
+    DataSize,
+    NameLength,
+    ActiveUniforms,
+    ReferencedByVertexShader,
+    ReferencedByTessControlShader,
+    ReferencedByTessEvaluationShader,
+    ReferencedByGeometryShader,
+    ReferencedByFragmentShader,
+    ReferencedByComputeShader
+};
+
 }  // namespace klgl
 
 KLGL_ENUM_AS_INDEX_MAGIC_ENUM(GlError);
 KLGL_MAKE_ENUM_FORMATTER(GlError);
 
+KLGL_ENUM_AS_INDEX_MAGIC_ENUM(GlErrorCheckMode);
+KLGL_MAKE_ENUM_FORMATTER(GlErrorCheckMode);
+
+KLGL_ENUM_AS_INDEX_MAGIC_ENUM(GlDeletionMode);
+KLGL_MAKE_ENUM_FORMATTER(GlDeletionMode);
+
+KLGL_ENUM_AS_INDEX_MAGIC_ENUM(GlObjectKind);
+KLGL_MAKE_ENUM_FORMATTER(GlObjectKind);
+
 KLGL_ENUM_AS_INDEX_MAGIC_ENUM(GlPixelBufferLayout);
 KLGL_MAKE_ENUM_FORMATTER(GlPixelBufferLayout);
 
@@ -573,3 +650,9 @@ KLGL_MAKE_ENUM_FORMATTER(GlFramebufferBindTarget);
 
 KLGL_ENUM_AS_INDEX_MAGIC_ENUM(GlFramebufferAttachment);
 KLGL_MAKE_ENUM_FORMATTER(GlFramebufferAttachment);
+
+KLGL_ENUM_AS_INDEX_MAGIC_ENUM(GlActiveUniformIntParameter);
+KLGL_MAKE_ENUM_FORMATTER(GlActiveUniformIntParameter);
+
+KLGL_ENUM_AS_INDEX_MAGIC_ENUM(GlUniformBlockIntParameter);
+KLGL_MAKE_ENUM_FORMATTER(GlUniformBlockIntParameter);
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace klgl
+{
+
+// Unique fence sync object. Becomes signaled when all commands issued before it complete
+class GlFence
+{
+public:
+    GlFence() noexcept = default;
+    GlFence(const GlFence&) = delete;
+    GlFence(GlFence&& other) noexcept { MoveFrom(other); }
+    ~GlFence() { Reset(); }
+
+    GlFence& operator=(const GlFence&) = delete;
+    GlFence& operator=(GlFence&& other) noexcept
+    {
+        MoveFrom(other);
+        return *this;
+    }
+
+    [[nodiscard]] static GlFence Insert();
+
+    [[nodiscard]] bool IsValid() const noexcept { return sync_ != nullptr; }
+
+    // Does not block. Empty fence is considered signaled. Signaled fence is deleted right away
+    [[nodiscard]] bool IsSignaled();
+
+    // Blocks until the fence is signaled. Does nothing for empty fence
+    void Wait();
+
+    void Reset() noexcept;
+
+private:
+    void MoveFrom(GlFence& other) noexcept;
+
+    // Fence has to be flushed once, otherwise it may never reach GPU and waiting for it would not end
+    [[nodiscard]] GLbitfield TakeWaitFlags() noexcept;
+
+private:
+    GLsync sync_ = nullptr;
+    bool flushed_ = false;
+};
+
+// One fence per frame in flight. Limits how many frames GPU may lag behind CPU: after NextFrame returns, commands of
+// the frame that used the current slot before are complete, so data kept per slot (regions of a persistently mapped
+// buffer, for example) can be overwritten.
+class GlFenceRing
+{
+public:
+    explicit GlFenceRing(size_t frames_in_flight = 2);
+
+    // Waits for all fences before changing the number of slots
+    void Resize(size_t frames_in_flight);
+    [[nodiscard]] size_t GetSize() const noexcept { return fences_.size(); }
+
+    // Slot of the frame that is being recorded
+    [[nodiscard]] size_t GetCurrentIndex() const noexcept { return current_; }
+
+    // Fences commands of the current frame, moves to the next slot and waits for the frame that used it before
+    void NextFrame();
+
+    void WaitAll();
+
+private:
+    std::vector<GlFence> fences_;
+    size_t current_ = 0;
+};
+
+}  // namespace klgl
@@ -2,9 +2,12 @@
 
 #include <glad/glad.h>
 
+#include <atomic>
 #include <optional>
 #include <span>
+#include <string>
 #include <tl/expected.hpp>
+#include <vector>
 
 #include "EverydayTools/Math/Matrix.hpp"
 #include "enums.hpp"
@@ -26,6 +29,10 @@ using namespace edt::lazy_matrix_aliases;  // NOLINT
 // - CE - stands for "Consume Errors" checks for errors but does not throw them as exception but returns them as
 // OpenGlError (or tl::expected with OpenGlError if function has return value)
 // - no suffix. Checks for errors and throws an exception with error code, stack trace and raw opengl call description
+// CE and throwing variants call glGetError only when the error check mode is PerCall. In other modes they behave
+// like NE and errors are reported by CheckFrameErrors.
+// Binding and enable/disable calls consult GlStateCache and are skipped when they would not change the state.
+// Call InvalidateStateCache after changing the state with raw OpenGL calls.
 
 class OpenGl
 {
@@ -34,6 +41,19 @@ class OpenGl
 public:
     [[nodiscard]] KLGL_OGL_INLINE static GlError GetError() noexcept;
     KLGL_OGL_INLINE static void ThrowIfError();
+    KLGL_OGL_INLINE static void InvalidateStateCache() noexcept;
+
+    // Selects how errors are detected. DebugCallback starts GlDebugMessenger and falls back to PerFrame when the
+    // context does not support KHR_debug. Returns the mode that was actually selected
+    static GlErrorCheckMode SetErrorCheckMode(GlErrorCheckMode mode);
+    [[nodiscard]] static GlErrorCheckMode GetErrorCheckMode() noexcept
+    {
+        return error_check_mode_.load(std::memory_order_relaxed);
+    }
+
+    // Called at the end of each frame. Does nothing in Off mode. Otherwise invalidates the state cache if errors
+    // happened during the frame, and in PerFrame and DebugCallback modes also throws
+    static void CheckFrameErrors();
 
     /************************************************** Buffers *******************************************************/
 
@@ -52,6 +72,29 @@ public:
         GlBufferId buffer) noexcept;
     KLGL_OGL_INLINE static void BindBuffer(GlBufferType target, GlBufferId buffer);
 
+    // Binds the buffer to indexed binding point of the target (uniform, shader storage, etc.)
+    KLGL_OGL_INLINE static void BindBufferBaseNE(GlBufferType target, uint32_t index, GlBufferId buffer) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    BindBufferBaseCE(GlBufferType target, uint32_t index, GlBufferId buffer) noexcept;
+    KLGL_OGL_INLINE static void BindBufferBase(GlBufferType target, uint32_t index, GlBufferId buffer);
+
+    // Binds a range of the buffer to indexed binding point. Offset must respect the alignment of the target
+    // (GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT for uniform buffers).
+    KLGL_OGL_INLINE static void BindBufferRangeNE(
+        GlBufferType target,
+        uint32_t index,
+        GlBufferId buffer,
+        size_t offset,
+        size_t size) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> BindBufferRangeCE(
+        GlBufferType target,
+        uint32_t index,
+        GlBufferId buffer,
+        size_t offset,
+        size_t size) noexcept;
+    KLGL_OGL_INLINE static void
+    BindBufferRange(GlBufferType target, uint32_t index, GlBufferId buffer, size_t offset, size_t size);
+
     // This overload allows you to initalize buffer without data
     KLGL_OGL_INLINE static void BufferDataNE(GlBufferType target, size_t buffer_size, GlUsage usage) noexcept;
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
@@ -107,6 +150,57 @@ public:
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> DeleteBufferCE(GlBufferId buffer) noexcept;
     KLGL_OGL_INLINE static void DeleteBuffer(GlBufferId buffer);
 
+    KLGL_OGL_INLINE static void DeleteBuffersNE(std::span<const GlBufferId> buffers) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> DeleteBuffersCE(
+        std::span<const GlBufferId> buffers) noexcept;
+    KLGL_OGL_INLINE static void DeleteBuffers(std::span<const GlBufferId> buffers);
+
+    // Creates an immutable data store for the bound buffer. flags is a combination of GL_MAP_*_BIT and
+    // GL_DYNAMIC_STORAGE_BIT. Requires OpenGL 4.4
+    KLGL_OGL_INLINE static void
+    BufferStorageNE(GlBufferType target, size_t buffer_size, const void* data, GLbitfield flags) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    BufferStorageCE(GlBufferType target, size_t buffer_size, const void* data, GLbitfield flags) noexcept;
+    KLGL_OGL_INLINE static void
+    BufferStorage(GlBufferType target, size_t buffer_size, const void* data, GLbitfield flags);
+
+    [[nodiscard]] KLGL_OGL_INLINE static void*
+    MapBufferRangeNE(GlBufferType target, size_t offset, size_t size, GLbitfield access) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<void*, OpenGlError>
+    MapBufferRangeCE(GlBufferType target, size_t offset, size_t size, GLbitfield access) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static void*
+    MapBufferRange(GlBufferType target, size_t offset, size_t size, GLbitfield access);
+
+    // Returns false if the content of the data store became corrupt while it was mapped
+    KLGL_OGL_INLINE static bool UnmapBufferNE(GlBufferType target) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<bool, OpenGlError> UnmapBufferCE(GlBufferType target) noexcept;
+    KLGL_OGL_INLINE static bool UnmapBuffer(GlBufferType target);
+
+    // Fills the range of the data store of the bound buffer with zeros. Requires OpenGL 4.3
+    KLGL_OGL_INLINE static void ClearBufferSubDataNE(GlBufferType target, size_t offset, size_t size) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    ClearBufferSubDataCE(GlBufferType target, size_t offset, size_t size) noexcept;
+    KLGL_OGL_INLINE static void ClearBufferSubData(GlBufferType target, size_t offset, size_t size);
+
+    KLGL_OGL_INLINE static void CopyBufferSubDataNE(
+        GlBufferType read_target,
+        GlBufferType write_target,
+        size_t read_offset,
+        size_t write_offset,
+        size_t size) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> CopyBufferSubDataCE(
+        GlBufferType read_target,
+        GlBufferType write_target,
+        size_t read_offset,
+        size_t write_offset,
+        size_t size) noexcept;
+    KLGL_OGL_INLINE static void CopyBufferSubData(
+        GlBufferType read_target,
+        GlBufferType write_target,
+        size_t read_offset,
+        size_t write_offset,
+        size_t size);
+
     template <typename T, size_t Extent>
         requires(!std::same_as<std::remove_const_t<T>, uint8_t>)
     KLGL_OGL_INLINE static void
@@ -153,6 +247,11 @@ public:
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> DeleteVertexArrayCE(GlVertexArrayId array) noexcept;
     KLGL_OGL_INLINE static void DeleteVertexArray(GlVertexArrayId array);
 
+    KLGL_OGL_INLINE static void DeleteVertexArraysNE(std::span<const GlVertexArrayId> arrays) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> DeleteVertexArraysCE(
+        std::span<const GlVertexArrayId> arrays) noexcept;
+    KLGL_OGL_INLINE static void DeleteVertexArrays(std::span<const GlVertexArrayId> arrays);
+
     /************************************************* Textures *******************************************************/
 
     KLGL_OGL_INLINE static void GenTexturesNE(const std::span<GlTextureId>& textures) noexcept;
@@ -170,6 +269,11 @@ public:
         GlTextureId texture) noexcept;
     KLGL_OGL_INLINE static void BindTexture(GlTargetTextureType target, GlTextureId texture);
 
+    // Selects the texture unit that subsequent BindTexture calls affect
+    KLGL_OGL_INLINE static void ActiveTextureNE(uint32_t unit) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> ActiveTextureCE(uint32_t unit) noexcept;
+    KLGL_OGL_INLINE static void ActiveTexture(uint32_t unit);
+
     // Specifies the index of the lowest defined mipmap level. The initial value is 0.
     KLGL_OGL_INLINE static void SetTextureBaseLevelNE(GlTargetTextureType target, size_t level) noexcept;
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> SetTextureBaseLevelCE(
@@ -288,10 +392,293 @@ public:
         GLenum pixel_data_type,
         const void* pixels);
 
+    KLGL_OGL_INLINE static void TexSubImage2dNE(
+        GlTargetTextureType target,
+        size_t level_of_detail,
+        const edt::Vec2<size_t>& offset,
+        const edt::Vec2<size_t>& size,
+        GlPixelBufferLayout layout,
+        GlPixelBufferChannelType type,
+        std::span<const uint8_t> pixels) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> TexSubImage2dCE(
+        GlTargetTextureType target,
+        size_t level_of_detail,
+        const edt::Vec2<size_t>& offset,
+        const edt::Vec2<size_t>& size,
+        GlPixelBufferLayout layout,
+        GlPixelBufferChannelType type,
+        std::span<const uint8_t> pixels) noexcept;
+    KLGL_OGL_INLINE static void TexSubImage2d(
+        GlTargetTextureType target,
+        size_t level_of_detail,
+        const edt::Vec2<size_t>& offset,
+        const edt::Vec2<size_t>& size,
+        GlPixelBufferLayout layout,
+        GlPixelBufferChannelType type,
+        std::span<const uint8_t> pixels);
+
     KLGL_OGL_INLINE static void DeleteTextureNE(GlTextureId texture) noexcept;
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> DeleteTextureCE(GlTextureId texture) noexcept;
     KLGL_OGL_INLINE static void DeleteTexture(GlTextureId texture);
 
+    KLGL_OGL_INLINE static void DeleteTexturesNE(std::span<const GlTextureId> textures) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> DeleteTexturesCE(
+        std::span<const GlTextureId> textures) noexcept;
+    KLGL_OGL_INLINE static void DeleteTextures(std::span<const GlTextureId> textures);
+
+    /********************************************* Direct State Access ************************************************/
+    // These functions edit objects by name without binding them. They require OpenGL 4.5 or ARB_direct_state_access
+    // and objects made by Create* functions: a name returned by Gen* does not refer to an object until it is bound.
+    // Callers check HasDirectStateAccess and fall back to bind-to-edit functions above when it returns false.
+
+    [[nodiscard]] static bool HasDirectStateAccess() noexcept;
+
+    // Makes HasDirectStateAccess return false even if the context supports it. Used to test the fallback path
+    static void SetDirectStateAccessAllowed(bool allowed) noexcept;
+
+    [[nodiscard]] KLGL_OGL_INLINE static GlBufferId CreateBufferNE() noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<GlBufferId, OpenGlError> CreateBufferCE() noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static GlBufferId CreateBuffer();
+
+    KLGL_OGL_INLINE static void CreateBuffersNE(const std::span<GlBufferId>& buffers) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> CreateBuffersCE(
+        const std::span<GlBufferId>& buffers) noexcept;
+    KLGL_OGL_INLINE static void CreateBuffers(const std::span<GlBufferId>& buffers);
+
+    KLGL_OGL_INLINE static void NamedBufferDataNE(GlBufferId buffer, size_t buffer_size, GlUsage usage) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    NamedBufferDataCE(GlBufferId buffer, size_t buffer_size, GlUsage usage) noexcept;
+    KLGL_OGL_INLINE static void NamedBufferData(GlBufferId buffer, size_t buffer_size, GlUsage usage);
+
+    KLGL_OGL_INLINE static void
+    NamedBufferDataNE(GlBufferId buffer, std::span<const uint8_t> data, GlUsage usage) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    NamedBufferDataCE(GlBufferId buffer, std::span<const uint8_t> data, GlUsage usage) noexcept;
+    KLGL_OGL_INLINE static void NamedBufferData(GlBufferId buffer, std::span<const uint8_t> data, GlUsage usage);
+
+    template <typename T, size_t Extent>
+        requires(!std::same_as<std::remove_const_t<T>, uint8_t>)
+    KLGL_OGL_INLINE static void
+    NamedBufferDataNE(GlBufferId buffer, const std::span<T, Extent>& data, GlUsage usage) noexcept
+    {
+        std::span bytes{reinterpret_cast<const uint8_t*>(data.data()), data.size_bytes()};  // NOLINT
+        NamedBufferDataNE(buffer, bytes, usage);
+    }
+
+    template <typename T, size_t Extent>
+        requires(!std::same_as<std::remove_const_t<T>, uint8_t>)
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    NamedBufferDataCE(GlBufferId buffer, const std::span<T, Extent>& data, GlUsage usage) noexcept
+    {
+        std::span bytes{reinterpret_cast<const uint8_t*>(data.data()), data.size_bytes()};  // NOLINT
+        return NamedBufferDataCE(buffer, bytes, usage);
+    }
+
+    template <typename T, size_t Extent>
+        requires(!std::same_as<std::remove_const_t<T>, uint8_t>)
+    KLGL_OGL_INLINE static void NamedBufferData(GlBufferId buffer, const std::span<T, Extent>& data, GlUsage usage)
+    {
+        std::span bytes{reinterpret_cast<const uint8_t*>(data.data()), data.size_bytes()};  // NOLINT
+        NamedBufferData(buffer, bytes, usage);
+    }
+
+    KLGL_OGL_INLINE static void
+    NamedBufferSubDataNE(GlBufferId buffer, size_t offset, std::span<const uint8_t> data) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    NamedBufferSubDataCE(GlBufferId buffer, size_t offset, std::span<const uint8_t> data) noexcept;
+    KLGL_OGL_INLINE static void NamedBufferSubData(GlBufferId buffer, size_t offset, std::span<const uint8_t> data);
+
+    // Same as BufferSubData: the offset is measured in elements of T
+    template <typename T, size_t Extent>
+        requires(!std::same_as<std::remove_const_t<T>, uint8_t>)
+    KLGL_OGL_INLINE static void
+    NamedBufferSubDataNE(GlBufferId buffer, size_t offset_elements, const std::span<T, Extent>& data) noexcept
+    {
+        std::span bytes{reinterpret_cast<const uint8_t*>(data.data()), data.size_bytes()};  // NOLINT
+        NamedBufferSubDataNE(buffer, offset_elements * sizeof(T), bytes);
+    }
+
+    template <typename T, size_t Extent>
+        requires(!std::same_as<std::remove_const_t<T>, uint8_t>)
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    NamedBufferSubDataCE(GlBufferId buffer, size_t offset_elements, const std::span<T, Extent>& data) noexcept
+    {
+        std::span bytes{reinterpret_cast<const uint8_t*>(data.data()), data.size_bytes()};  // NOLINT
+        return NamedBufferSubDataCE(buffer, offset_elements * sizeof(T), bytes);
+    }
+
+    template <typename T, size_t Extent>
+        requires(!std::same_as<std::remove_const_t<T>, uint8_t>)
+    KLGL_OGL_INLINE static void
+    NamedBufferSubData(GlBufferId buffer, size_t offset_elements, const std::span<T, Extent>& data)
+    {
+        std::span bytes{reinterpret_cast<const uint8_t*>(data.data()), data.size_bytes()};  // NOLINT
+        NamedBufferSubData(buffer, offset_elements * sizeof(T), bytes);
+    }
+
+    [[nodiscard]] KLGL_OGL_INLINE static GlVertexArrayId CreateVertexArrayNE() noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<GlVertexArrayId, OpenGlError> CreateVertexArrayCE() noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static GlVertexArrayId CreateVertexArray();
+
+    KLGL_OGL_INLINE static void CreateVertexArraysNE(const std::span<GlVertexArrayId>& arrays) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> CreateVertexArraysCE(
+        const std::span<GlVertexArrayId>& arrays) noexcept;
+    KLGL_OGL_INLINE static void CreateVertexArrays(const std::span<GlVertexArrayId>& arrays);
+
+    KLGL_OGL_INLINE static void VertexArrayElementBufferNE(GlVertexArrayId array, GlBufferId buffer) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> VertexArrayElementBufferCE(
+        GlVertexArrayId array,
+        GlBufferId buffer) noexcept;
+    KLGL_OGL_INLINE static void VertexArrayElementBuffer(GlVertexArrayId array, GlBufferId buffer);
+
+    // Attaches the buffer to the binding index of the vertex array. Attributes read from the binding index
+    // assigned by VertexArrayAttribBinding
+    KLGL_OGL_INLINE static void VertexArrayVertexBufferNE(
+        GlVertexArrayId array,
+        size_t binding_index,
+        GlBufferId buffer,
+        size_t offset,
+        size_t stride) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> VertexArrayVertexBufferCE(
+        GlVertexArrayId array,
+        size_t binding_index,
+        GlBufferId buffer,
+        size_t offset,
+        size_t stride) noexcept;
+    KLGL_OGL_INLINE static void VertexArrayVertexBuffer(
+        GlVertexArrayId array,
+        size_t binding_index,
+        GlBufferId buffer,
+        size_t offset,
+        size_t stride);
+
+    // Specifies the layout of the attribute. relative_offset is the offset from the start of the vertex
+    KLGL_OGL_INLINE static void VertexArrayAttribFormatNE(
+        GlVertexArrayId array,
+        size_t attribute_index,
+        size_t size,
+        GlVertexAttribComponentType type,
+        bool normalized,
+        size_t relative_offset) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> VertexArrayAttribFormatCE(
+        GlVertexArrayId array,
+        size_t attribute_index,
+        size_t size,
+        GlVertexAttribComponentType type,
+        bool normalized,
+        size_t relative_offset) noexcept;
+    KLGL_OGL_INLINE static void VertexArrayAttribFormat(
+        GlVertexArrayId array,
+        size_t attribute_index,
+        size_t size,
+        GlVertexAttribComponentType type,
+        bool normalized,
+        size_t relative_offset);
+
+    // Integer attributes that are not converted to floats
+    KLGL_OGL_INLINE static void VertexArrayAttribIFormatNE(
+        GlVertexArrayId array,
+        size_t attribute_index,
+        size_t size,
+        GlVertexAttribComponentType type,
+        size_t relative_offset) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> VertexArrayAttribIFormatCE(
+        GlVertexArrayId array,
+        size_t attribute_index,
+        size_t size,
+        GlVertexAttribComponentType type,
+        size_t relative_offset) noexcept;
+    KLGL_OGL_INLINE static void VertexArrayAttribIFormat(
+        GlVertexArrayId array,
+        size_t attribute_index,
+        size_t size,
+        GlVertexAttribComponentType type,
+        size_t relative_offset);
+
+    KLGL_OGL_INLINE static void
+    VertexArrayAttribBindingNE(GlVertexArrayId array, size_t attribute_index, size_t binding_index) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    VertexArrayAttribBindingCE(GlVertexArrayId array, size_t attribute_index, size_t binding_index) noexcept;
+    KLGL_OGL_INLINE static void
+    VertexArrayAttribBinding(GlVertexArrayId array, size_t attribute_index, size_t binding_index);
+
+    KLGL_OGL_INLINE static void
+    VertexArrayBindingDivisorNE(GlVertexArrayId array, size_t binding_index, size_t divisor) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    VertexArrayBindingDivisorCE(GlVertexArrayId array, size_t binding_index, size_t divisor) noexcept;
+    KLGL_OGL_INLINE static void VertexArrayBindingDivisor(GlVertexArrayId array, size_t binding_index, size_t divisor);
+
+    KLGL_OGL_INLINE static void EnableVertexArrayAttribNE(GlVertexArrayId array, size_t attribute_index) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> EnableVertexArrayAttribCE(
+        GlVertexArrayId array,
+        size_t attribute_index) noexcept;
+    KLGL_OGL_INLINE static void EnableVertexArrayAttrib(GlVertexArrayId array, size_t attribute_index);
+
+    [[nodiscard]] KLGL_OGL_INLINE static GlTextureId CreateTextureNE(GlTargetTextureType target) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<GlTextureId, OpenGlError> CreateTextureCE(
+        GlTargetTextureType target) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static GlTextureId CreateTexture(GlTargetTextureType target);
+
+    // Allocates immutable storage for all levels of the texture
+    KLGL_OGL_INLINE static void TextureStorage2dNE(
+        GlTextureId texture,
+        size_t levels,
+        GlTextureInternalFormat format,
+        const edt::Vec2<size_t>& size) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> TextureStorage2dCE(
+        GlTextureId texture,
+        size_t levels,
+        GlTextureInternalFormat format,
+        const edt::Vec2<size_t>& size) noexcept;
+    KLGL_OGL_INLINE static void TextureStorage2d(
+        GlTextureId texture,
+        size_t levels,
+        GlTextureInternalFormat format,
+        const edt::Vec2<size_t>& size);
+
+    KLGL_OGL_INLINE static void TextureSubImage2dNE(
+        GlTextureId texture,
+        size_t level_of_detail,
+        const edt::Vec2<size_t>& offset,
+        const edt::Vec2<size_t>& size,
+        GlPixelBufferLayout layout,
+        GlPixelBufferChannelType type,
+        std::span<const uint8_t> pixels) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> TextureSubImage2dCE(
+        GlTextureId texture,
+        size_t level_of_detail,
+        const edt::Vec2<size_t>& offset,
+        const edt::Vec2<size_t>& size,
+        GlPixelBufferLayout layout,
+        GlPixelBufferChannelType type,
+        std::span<const uint8_t> pixels) noexcept;
+    KLGL_OGL_INLINE static void TextureSubImage2d(
+        GlTextureId texture,
+        size_t level_of_detail,
+        const edt::Vec2<size_t>& offset,
+        const edt::Vec2<size_t>& size,
+        GlPixelBufferLayout layout,
+        GlPixelBufferChannelType type,
+        std::span<const uint8_t> pixels);
+
+    KLGL_OGL_INLINE static void
+    SetTextureWrapNE(GlTextureId texture, GlTextureWrapAxis wrap, GlTextureWrapMode mode) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetTextureWrapCE(GlTextureId texture, GlTextureWrapAxis wrap, GlTextureWrapMode mode) noexcept;
+    KLGL_OGL_INLINE static void SetTextureWrap(GlTextureId texture, GlTextureWrapAxis wrap, GlTextureWrapMode mode);
+
+    KLGL_OGL_INLINE static void SetTextureMinFilterNE(GlTextureId texture, GlTextureFilter filter) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> SetTextureMinFilterCE(
+        GlTextureId texture,
+        GlTextureFilter filter) noexcept;
+    KLGL_OGL_INLINE static void SetTextureMinFilter(GlTextureId texture, GlTextureFilter filter);
+
+    KLGL_OGL_INLINE static void SetTextureMagFilterNE(GlTextureId texture, GlTextureFilter filter) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> SetTextureMagFilterCE(
+        GlTextureId texture,
+        GlTextureFilter filter) noexcept;
+    KLGL_OGL_INLINE static void SetTextureMagFilter(GlTextureId texture, GlTextureFilter filter);
+
     /************************************************** Framebuffers **************************************************/
 
     KLGL_OGL_INLINE static void GenFramebuffersNE(const std::span<GlFramebufferId>& framebuffers) noexcept;
@@ -531,6 +918,68 @@ public:
         GlUniformType& out_uniform_type,
         char* out_name_buffer) noexcept;
 
+    // Queries one parameter for every uniform in uniform_indices. out_values must have the same size as uniform_indices
+    KLGL_OGL_INLINE static void GetActiveUniformsIntParameterNE(
+        GlProgramId program,
+        std::span<const uint32_t> uniform_indices,
+        GlActiveUniformIntParameter parameter,
+        std::span<int32_t> out_values) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> GetActiveUniformsIntParameterCE(
+        GlProgramId program,
+        std::span<const uint32_t> uniform_indices,
+        GlActiveUniformIntParameter parameter,
+        std::span<int32_t> out_values) noexcept;
+    KLGL_OGL_INLINE static void GetActiveUniformsIntParameter(
+        GlProgramId program,
+        std::span<const uint32_t> uniform_indices,
+        GlActiveUniformIntParameter parameter,
+        std::span<int32_t> out_values);
+
+    [[nodiscard]] KLGL_OGL_INLINE static size_t GetProgramActiveUniformBlocksCountNE(GlProgramId program) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<size_t, OpenGlError> GetProgramActiveUniformBlocksCountCE(
+        GlProgramId program) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static size_t GetProgramActiveUniformBlocksCount(GlProgramId program);
+
+    [[nodiscard]] KLGL_OGL_INLINE static int32_t GetActiveUniformBlockIntParameterNE(
+        GlProgramId program,
+        uint32_t block_index,
+        GlUniformBlockIntParameter parameter) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<int32_t, OpenGlError> GetActiveUniformBlockIntParameterCE(
+        GlProgramId program,
+        uint32_t block_index,
+        GlUniformBlockIntParameter parameter) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static int32_t GetActiveUniformBlockIntParameter(
+        GlProgramId program,
+        uint32_t block_index,
+        GlUniformBlockIntParameter parameter);
+
+    // Indices of uniforms that belong to the block. Can be used with GetActiveUniform
+    [[nodiscard]] KLGL_OGL_INLINE static std::vector<uint32_t> GetActiveUniformBlockUniformIndicesNE(
+        GlProgramId program,
+        uint32_t block_index) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<std::vector<uint32_t>, OpenGlError>
+    GetActiveUniformBlockUniformIndicesCE(GlProgramId program, uint32_t block_index) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::vector<uint32_t> GetActiveUniformBlockUniformIndices(
+        GlProgramId program,
+        uint32_t block_index);
+
+    [[nodiscard]] KLGL_OGL_INLINE static std::string GetActiveUniformBlockNameNE(
+        GlProgramId program,
+        uint32_t block_index) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<std::string, OpenGlError> GetActiveUniformBlockNameCE(
+        GlProgramId program,
+        uint32_t block_index) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::string GetActiveUniformBlockName(
+        GlProgramId program,
+        uint32_t block_index);
+
+    // Assigns uniform buffer binding point to the uniform block of the program
+    KLGL_OGL_INLINE static void
+    UniformBlockBindingNE(GlProgramId program, uint32_t block_index, uint32_t binding) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    UniformBlockBindingCE(GlProgramId program, uint32_t block_index, uint32_t binding) noexcept;
+    KLGL_OGL_INLINE static void UniformBlockBinding(GlProgramId program, uint32_t block_index, uint32_t binding);
+
     [[nodiscard]] KLGL_OGL_INLINE static size_t GetProgramLogLengthNE(GlProgramId program) noexcept;
     [[nodiscard]] KLGL_OGL_INLINE static tl::expected<size_t, OpenGlError> GetProgramLogLengthCE(
         GlProgramId program) noexcept;
@@ -595,10 +1044,92 @@ public:
     SetUniformCE(uint32_t location, const Mat4f& m, bool transpose = false) noexcept;
     KLGL_OGL_INLINE static void SetUniform(uint32_t location, const Mat4f& m, bool transpose = false);
 
+    KLGL_OGL_INLINE static void SetUniformArrayNE(uint32_t location, std::span<const int32_t> values) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetUniformArrayCE(uint32_t location, std::span<const int32_t> values) noexcept;
+    KLGL_OGL_INLINE static void SetUniformArray(uint32_t location, std::span<const int32_t> values);
+
+    KLGL_OGL_INLINE static void SetUniformArrayNE(uint32_t location, std::span<const uint32_t> values) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetUniformArrayCE(uint32_t location, std::span<const uint32_t> values) noexcept;
+    KLGL_OGL_INLINE static void SetUniformArray(uint32_t location, std::span<const uint32_t> values);
+
+    KLGL_OGL_INLINE static void SetUniformArrayNE(uint32_t location, std::span<const float> values) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetUniformArrayCE(uint32_t location, std::span<const float> values) noexcept;
+    KLGL_OGL_INLINE static void SetUniformArray(uint32_t location, std::span<const float> values);
+
+    KLGL_OGL_INLINE static void SetUniformArrayNE(uint32_t location, std::span<const Vec2f> values) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetUniformArrayCE(uint32_t location, std::span<const Vec2f> values) noexcept;
+    KLGL_OGL_INLINE static void SetUniformArray(uint32_t location, std::span<const Vec2f> values);
+
+    KLGL_OGL_INLINE static void SetUniformArrayNE(uint32_t location, std::span<const Vec3f> values) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetUniformArrayCE(uint32_t location, std::span<const Vec3f> values) noexcept;
+    KLGL_OGL_INLINE static void SetUniformArray(uint32_t location, std::span<const Vec3f> values);
+
+    KLGL_OGL_INLINE static void SetUniformArrayNE(uint32_t location, std::span<const Vec4f> values) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetUniformArrayCE(uint32_t location, std::span<const Vec4f> values) noexcept;
+    KLGL_OGL_INLINE static void SetUniformArray(uint32_t location, std::span<const Vec4f> values);
+
+    KLGL_OGL_INLINE static void
+    SetUniformArrayNE(uint32_t location, std::span<const Mat3f> values, bool transpose = false) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetUniformArrayCE(uint32_t location, std::span<const Mat3f> values, bool transpose = false) noexcept;
+    KLGL_OGL_INLINE static void
+    SetUniformArray(uint32_t location, std::span<const Mat3f> values, bool transpose = false);
+
+    KLGL_OGL_INLINE static void
+    SetUniformArrayNE(uint32_t location, std::span<const Mat4f> values, bool transpose = false) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetUniformArrayCE(uint32_t location, std::span<const Mat4f> values, bool transpose = false) noexcept;
+    KLGL_OGL_INLINE static void
+    SetUniformArray(uint32_t location, std::span<const Mat4f> values, bool transpose = false);
+
     KLGL_OGL_INLINE static void DeleteProgramNE(GlProgramId program) noexcept;
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> DeleteProgramCE(GlProgramId program) noexcept;
     KLGL_OGL_INLINE static void DeleteProgram(GlProgramId program);
 
+    // Program has to be marked as separable before linking to be used in a program pipeline
+    KLGL_OGL_INLINE static void SetProgramSeparableNE(GlProgramId program, bool separable) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> SetProgramSeparableCE(
+        GlProgramId program,
+        bool separable) noexcept;
+    KLGL_OGL_INLINE static void SetProgramSeparable(GlProgramId program, bool separable);
+
+    /********************************************** Program Pipeline **************************************************/
+
+    [[nodiscard]] KLGL_OGL_INLINE static GlProgramPipelineId GenProgramPipelineNE() noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<GlProgramPipelineId, OpenGlError>
+    GenProgramPipelineCE() noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static GlProgramPipelineId GenProgramPipeline();
+
+    KLGL_OGL_INLINE static void BindProgramPipelineNE(GlProgramPipelineId pipeline) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> BindProgramPipelineCE(
+        GlProgramPipelineId pipeline) noexcept;
+    KLGL_OGL_INLINE static void BindProgramPipeline(GlProgramPipelineId pipeline);
+
+    // Uses the specified stage of the separable program in the pipeline
+    KLGL_OGL_INLINE static void
+    UseProgramStageNE(GlProgramPipelineId pipeline, GlShaderType stage, GlProgramId program) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    UseProgramStageCE(GlProgramPipelineId pipeline, GlShaderType stage, GlProgramId program) noexcept;
+    KLGL_OGL_INLINE static void UseProgramStage(GlProgramPipelineId pipeline, GlShaderType stage, GlProgramId program);
+
+    // glUniform* calls modify the active program of the bound pipeline when there is no current program
+    KLGL_OGL_INLINE static void ActiveShaderProgramNE(GlProgramPipelineId pipeline, GlProgramId program) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> ActiveShaderProgramCE(
+        GlProgramPipelineId pipeline,
+        GlProgramId program) noexcept;
+    KLGL_OGL_INLINE static void ActiveShaderProgram(GlProgramPipelineId pipeline, GlProgramId program);
+
+    KLGL_OGL_INLINE static void DeleteProgramPipelineNE(GlProgramPipelineId pipeline) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> DeleteProgramPipelineCE(
+        GlProgramPipelineId pipeline) noexcept;
+    KLGL_OGL_INLINE static void DeleteProgramPipeline(GlProgramPipelineId pipeline);
+
     /*************************************************** Clear ********************************************************/
 
     KLGL_OGL_INLINE static void SetClearColorNE(GLfloat r, GLfloat g, GLfloat b, GLfloat a) noexcept;
@@ -668,6 +1199,12 @@ public:
         size_t stride,
         const void* pointer);
 
+    KLGL_OGL_INLINE static void VertexAttribDivisorNE(size_t index, size_t divisor) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> VertexAttribDivisorCE(
+        size_t index,
+        size_t divisor) noexcept;
+    KLGL_OGL_INLINE static void VertexAttribDivisor(size_t index, size_t divisor);
+
     /****************************************************** Draw ******************************************************/
 
     KLGL_OGL_INLINE static void DrawElementsNE(
@@ -729,6 +1266,29 @@ public:
     KLGL_OGL_INLINE static void
     DrawArraysInstanced(GlPrimitiveType mode, size_t first_index, size_t indices_count, size_t instances_count);
 
+    /************************************************ Synchronization *************************************************/
+
+    // Named differently from glMemoryBarrier because windows headers define MemoryBarrier macro
+    KLGL_OGL_INLINE static void InsertMemoryBarrierNE(GLbitfield barriers) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> InsertMemoryBarrierCE(GLbitfield barriers) noexcept;
+    KLGL_OGL_INLINE static void InsertMemoryBarrier(GLbitfield barriers);
+
+    // Inserts a fence that becomes signaled when all previously issued commands complete
+    [[nodiscard]] KLGL_OGL_INLINE static GLsync FenceSyncNE() noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<GLsync, OpenGlError> FenceSyncCE() noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static GLsync FenceSync();
+
+    // Returns GL_ALREADY_SIGNALED, GL_CONDITION_SATISFIED, GL_TIMEOUT_EXPIRED or GL_WAIT_FAILED
+    [[nodiscard]] KLGL_OGL_INLINE static GLenum
+    ClientWaitSyncNE(GLsync sync, GLbitfield flags, uint64_t timeout_ns) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static tl::expected<GLenum, OpenGlError>
+    ClientWaitSyncCE(GLsync sync, GLbitfield flags, uint64_t timeout_ns) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static GLenum ClientWaitSync(GLsync sync, GLbitfield flags, uint64_t timeout_ns);
+
+    KLGL_OGL_INLINE static void DeleteSyncNE(GLsync sync) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> DeleteSyncCE(GLsync sync) noexcept;
+    KLGL_OGL_INLINE static void DeleteSync(GLsync sync);
+
     /******************************************************************************************************************/
 
     KLGL_OGL_INLINE static void
@@ -748,14 +1308,28 @@ public:
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> EnableVertexAttribArrayCE(size_t index) noexcept;
     KLGL_OGL_INLINE static void EnableVertexAttribArray(size_t index);
 
+    KLGL_OGL_INLINE static void SetDepthTestEnabledNE(bool enabled) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> SetDepthTestEnabledCE(bool enabled) noexcept;
+    KLGL_OGL_INLINE static void SetDepthTestEnabled(bool enabled);
+
     KLGL_OGL_INLINE static void EnableDepthTestNE() noexcept;
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> EnableDepthTestCE() noexcept;
     KLGL_OGL_INLINE static void EnableDepthTest();
 
+    KLGL_OGL_INLINE static void SetBlendingEnabledNE(bool enabled) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> SetBlendingEnabledCE(bool enabled) noexcept;
+    KLGL_OGL_INLINE static void SetBlendingEnabled(bool enabled);
+
     KLGL_OGL_INLINE static void EnableBlendingNE() noexcept;
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> EnableBlendingCE() noexcept;
     KLGL_OGL_INLINE static void EnableBlending();
 
+    // Factors are GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, etc.
+    KLGL_OGL_INLINE static void SetBlendFunctionNE(GLenum source_factor, GLenum destination_factor) noexcept;
+    [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError>
+    SetBlendFunctionCE(GLenum source_factor, GLenum destination_factor) noexcept;
+    KLGL_OGL_INLINE static void SetBlendFunction(GLenum source_factor, GLenum destination_factor);
+
     KLGL_OGL_INLINE static void SetViewportNE(const Viewport& viewport) noexcept;
     [[nodiscard]] KLGL_OGL_INLINE static std::optional<OpenGlError> SetViewportCE(const Viewport& viewport) noexcept;
     KLGL_OGL_INLINE static void SetViewport(const Viewport& viewport);
@@ -771,6 +1345,9 @@ public:
 
     KLGL_OGL_INLINE static void LineWidthNE(float width) noexcept;
     KLGL_OGL_INLINE static void LineWidth(float width);
+
+private:
+    static inline std::atomic<GlErrorCheckMode> error_check_mode_ = GlErrorCheckMode::PerCall;
 };
 
 }  // namespace klgl
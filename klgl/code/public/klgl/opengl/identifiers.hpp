@@ -8,6 +8,7 @@ namespace klgl::tags
 {
 struct GlShaderIdTag;
 struct GlProgramIdTag;
+struct GlProgramPipelineIdTag;
 struct GlBufferIdTag;
 struct GlVertexArrayIdTag;
 struct GlTextureIdTag;
@@ -19,6 +20,7 @@ namespace klgl
 {
 using GlShaderId = edt::TaggedIdentifier<tags::GlShaderIdTag, GLuint, 0>;
 using GlProgramId = edt::TaggedIdentifier<tags::GlProgramIdTag, GLuint, 0>;
+using GlProgramPipelineId = edt::TaggedIdentifier<tags::GlProgramPipelineIdTag, GLuint, 0>;
 using GlBufferId = edt::TaggedIdentifier<tags::GlBufferIdTag, GLuint, 0>;
 using GlVertexArrayId = edt::TaggedIdentifier<tags::GlVertexArrayIdTag, GLuint, 0>;
 using GlTextureId = edt::TaggedIdentifier<tags::GlTextureIdTag, GLuint, 0>;
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+#include "klgl/opengl/identifiers.hpp"
+
+namespace klgl
+{
+
+// Hands out object names generated in batches: one glGen* or glCreate* call per batch instead of one call per object.
+// Names are always fresh, deleted names are never given out again, so objects do not inherit state of previous owners.
+// Names that were not handed out yet count as created objects in GlMemoryTracker until Clear is called.
+// Thread safe. Vertex arrays are not shared between contexts, so vertex array names must be taken on the thread of
+// the main context.
+class GlNamePool
+{
+public:
+    static constexpr size_t kDefaultBatchSize = 32;
+
+    // Names reserved by glGen*. The object is created by the first glBind*
+    [[nodiscard]] static GlBufferId GenBuffer();
+    [[nodiscard]] static GlVertexArrayId GenVertexArray();
+    [[nodiscard]] static GlTextureId GenTexture();
+
+    // Objects created by glCreate*. Require direct state access
+    [[nodiscard]] static GlBufferId CreateBuffer();
+    [[nodiscard]] static GlVertexArrayId CreateVertexArray();
+
+    // Applies to the next refill
+    static void SetBatchSize(size_t batch_size);
+    [[nodiscard]] static size_t GetBatchSize();
+
+    // Deletes names that were not handed out. Must be called before the context is destroyed
+    static void Clear();
+};
+
+}  // namespace klgl
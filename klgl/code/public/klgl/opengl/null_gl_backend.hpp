@@ -0,0 +1,70 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace klgl
+{
+
+struct NullGlSettings
+{
+    // Reported by glGetString(GL_VERSION). GLAD loads entry points up to this version, so versions below 4.5 make
+    // OpenGl wrappers take bind-to-edit paths instead of direct state access
+    int major_version = 4;
+    int minor_version = 6;
+};
+
+struct NullGlStats
+{
+    size_t calls = 0;
+    size_t draw_calls = 0;
+
+    // Vertices or indices of all draw calls multiplied by the number of instances
+    size_t vertices = 0;
+
+    // Bytes passed to buffers and textures from client memory. Writes to mapped buffers are not counted
+    size_t uploaded_bytes = 0;
+
+    // Bytes written to client memory by glGetTexImage and glReadPixels
+    size_t downloaded_bytes = 0;
+
+    size_t errors = 0;
+};
+
+// OpenGL implementation without a GPU. Load points GLAD entry points to functions that keep objects in CPU memory,
+// so code that goes through OpenGl wrappers runs without a window or a context: unit tests and CPU overhead
+// benchmarks in containers.
+// Calls are validated like a strict driver would do it: unknown names, missing bindings, out of range accesses and
+// uniform type mismatches set the glGetError code and are sent to the debug callback. Nothing is rendered: draw calls
+// are validated and counted, buffers keep their contents, textures keep only their sizes and read back as zeros.
+// Program introspection comes from scanning shader sources for uniforms of the default block and vertex inputs;
+// uniform blocks and storage blocks are not reported. Entry points that are not implemented stay null.
+// Not thread safe, like a context that is current on one thread.
+class NullGlBackend
+{
+public:
+    // Replaces GLAD entry points and resets the state. Can be called again to start over
+    static void Load(const NullGlSettings& settings = {});
+    [[nodiscard]] static bool IsLoaded();
+
+    [[nodiscard]] static const NullGlStats& GetStats();
+
+    // Takes names with the prefix: "glBufferData"
+    [[nodiscard]] static size_t GetCallsCount(std::string_view function);
+    static void ResetStats();
+
+    // Contents of the buffer data store. Empty for unknown names
+    [[nodiscard]] static std::span<const uint8_t> GetBufferData(GLuint buffer);
+
+    // The last value set to the uniform location of the program. Empty if it was never set
+    [[nodiscard]] static std::span<const uint8_t> GetUniformValue(GLuint program, GLint location);
+
+    // Description of the most recent error
+    [[nodiscard]] static std::string_view GetLastErrorMessage();
+};
+
+}  // namespace klgl
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "deletion_queue.hpp"
 #include "gl_api.hpp"
 
 namespace klgl::detail
@@ -7,7 +8,11 @@ namespace klgl::detail
 template <typename Id, auto fn>
 struct GlObjectDeleterImpl
 {
-    [[nodiscard]] std::optional<OpenGlError> operator()(Id id) noexcept { return fn(id); }
+    [[nodiscard]] std::optional<OpenGlError> operator()(Id id) noexcept
+    {
+        if (GlDeletionQueue::Enqueue(id)) return std::nullopt;
+        return fn(id);
+    }
 };
 }  // namespace klgl::detail
 
@@ -37,6 +42,12 @@ struct GlObjectDeleter<GlProgramId> : detail::GlObjectDeleterImpl<GlProgramId, O
 {
 };
 
+template <>
+struct GlObjectDeleter<GlProgramPipelineId>
+    : detail::GlObjectDeleterImpl<GlProgramPipelineId, OpenGl::DeleteProgramPipelineCE>
+{
+};
+
 template <>
 struct GlObjectDeleter<GlVertexArrayId> : detail::GlObjectDeleterImpl<GlVertexArrayId, OpenGl::DeleteVertexArrayCE>
 {
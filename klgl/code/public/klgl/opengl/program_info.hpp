@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "klgl/opengl/detail/maps/type_to_vertex_attribute_type.hpp"
 #include "klgl/opengl/enums.hpp"
@@ -26,10 +28,64 @@ struct GlUniformInfo
     GlUniformType type{};
 };
 
+struct GlUniformBlockMemberInfo
+{
+    // Array members are stored without "[0]" suffix
+    std::string name;
+    size_t index{};
+    // Number of array elements. Zero for non-array members
+    size_t array_size{};
+    size_t offset{};
+    size_t array_stride{};
+    size_t matrix_stride{};
+    GlUniformType type{};
+    bool row_major = false;
+};
+
+struct GlUniformBlockInfo
+{
+    std::string name;
+    size_t index{};
+    size_t binding{};
+    size_t data_size{};
+    std::vector<GlUniformBlockMemberInfo> members;
+};
+
+struct GlStorageBlockMemberInfo
+{
+    // Array members are stored without "[0]" suffix
+    std::string name;
+    size_t index{};
+    // Number of array elements. Zero for non-array members and for runtime sized arrays
+    size_t array_size{};
+    size_t offset{};
+    size_t array_stride{};
+    size_t matrix_stride{};
+    // Describe the outermost array the member belongs to. For runtime sized arrays the size is zero and the stride
+    // is the size of one element of that array
+    size_t top_level_array_size{};
+    size_t top_level_array_stride{};
+    GlUniformType type{};
+    bool row_major = false;
+};
+
+struct GlStorageBlockInfo
+{
+    std::string name;
+    size_t index{};
+    size_t binding{};
+    size_t data_size{};
+    std::vector<GlStorageBlockMemberInfo> members;
+};
+
 struct GlProgramInfo
 {
     void FetchVertexAttributes(GlProgramId program);
+    // Fetches uniforms of the default block. Members of uniform blocks are fetched by FetchUniformBlocks
     void FetchUniforms(GlProgramId program);
+    void FetchUniformBlocks(GlProgramId program);
+    // Requires OpenGL 4.3. Leaves storage blocks empty in older contexts
+    void FetchStorageBlocks(GlProgramId program);
     void PrintStorageBlocks(GlProgramId program);
 
     [[nodiscard]] size_t VerifyAndGetVertexAttributeLocation(std::string_view name, GlVertexAttributeType type) const;
@@ -40,7 +96,12 @@ struct GlProgramInfo
         return VerifyAndGetVertexAttributeLocation(name, detail::TypeVertAttribTypeEnum<T>::value);
     }
 
+    [[nodiscard]] const GlUniformBlockInfo* FindUniformBlock(std::string_view name) const;
+    [[nodiscard]] const GlStorageBlockInfo* FindStorageBlock(std::string_view name) const;
+
     std::vector<GlVertexAttributeInfo> vertex_attributes;
     std::vector<GlUniformInfo> uniforms;
+    std::vector<GlUniformBlockInfo> uniform_blocks;
+    std::vector<GlStorageBlockInfo> storage_blocks;
 };
 }  // namespace klgl
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "klgl/camera/viewport.hpp"
+#include "klgl/opengl/enums.hpp"
+#include "klgl/opengl/identifiers.hpp"
+#include "magic_enum/magic_enum.hpp"
+
+namespace klgl
+{
+
+// Shadow copy of the OpenGL state changed by OpenGl wrappers. Wrappers ask the cache before issuing a call and skip
+// calls that would set the value which is already set.
+// Each thread has its own instance because the state belongs to the context that is current on the calling thread.
+// Code that changes the state with raw OpenGL calls (ImGui backend, third party libraries) must call Invalidate
+// afterwards, otherwise the cache may skip a call that is actually required.
+class GlStateCache
+{
+public:
+    // Units above this limit are not cached
+    static constexpr uint32_t kMaxTextureUnits = 32;
+
+    struct Counters
+    {
+        size_t issued = 0;
+        size_t skipped = 0;
+    };
+
+    [[nodiscard]] static GlStateCache& Get() noexcept;
+
+    // Each of these methods returns true if the call has to be issued and remembers the new value
+    [[nodiscard]] bool UseProgram(GlProgramId program) noexcept { return Change(program_, program.GetValue()); }
+    [[nodiscard]] bool BindProgramPipeline(GlProgramPipelineId pipeline) noexcept
+    {
+        return Change(program_pipeline_, pipeline.GetValue());
+    }
+    [[nodiscard]] bool BindVertexArray(GlVertexArrayId array) noexcept;
+    [[nodiscard]] bool BindBuffer(GlBufferType target, GlBufferId buffer) noexcept
+    {
+        return Change(buffers_[static_cast<size_t>(target)], buffer.GetValue());
+    }
+    [[nodiscard]] bool ActiveTexture(uint32_t unit) noexcept;
+    [[nodiscard]] bool BindTexture(GlTargetTextureType target, GlTextureId texture) noexcept;
+    [[nodiscard]] bool BindRenderbuffer(GlRenderbufferId renderbuffer) noexcept
+    {
+        return Change(renderbuffer_, renderbuffer.GetValue());
+    }
+    [[nodiscard]] bool SetDepthTestEnabled(bool enabled) noexcept { return Change(depth_test_, enabled); }
+    [[nodiscard]] bool SetBlendingEnabled(bool enabled) noexcept { return Change(blending_, enabled); }
+    [[nodiscard]] bool SetBlendFunction(GLenum source_factor, GLenum destination_factor) noexcept
+    {
+        return Change(blend_function_, BlendFunction{source_factor, destination_factor});
+    }
+    [[nodiscard]] bool SetViewport(const Viewport& viewport) noexcept { return Change(viewport_, viewport); }
+
+    // glBindBufferBase and glBindBufferRange also bind the buffer to the generic binding point of the target
+    void OnBufferBoundToIndex(GlBufferType target, GlBufferId buffer) noexcept
+    {
+        buffers_[static_cast<size_t>(target)] = buffer.GetValue();
+    }
+
+    // OpenGL unbinds deleted objects and may reuse their names, so deleted objects must be forgotten
+    void OnProgramDeleted(GlProgramId program) noexcept { Forget(program_, program.GetValue()); }
+    void OnProgramPipelineDeleted(GlProgramPipelineId pipeline) noexcept
+    {
+        Forget(program_pipeline_, pipeline.GetValue());
+    }
+    void OnVertexArrayDeleted(GlVertexArrayId array) noexcept;
+    void OnBufferDeleted(GlBufferId buffer) noexcept;
+    void OnTextureDeleted(GlTextureId texture) noexcept;
+    void OnRenderbufferDeleted(GlRenderbufferId renderbuffer) noexcept
+    {
+        Forget(renderbuffer_, renderbuffer.GetValue());
+    }
+
+    // Bound objects as far as the cache knows. Empty when the binding was not set since the last invalidation.
+    // Values are remembered even when the cache is disabled
+    [[nodiscard]] std::optional<GLuint> GetBoundBuffer(GlBufferType target) const noexcept
+    {
+        return buffers_[static_cast<size_t>(target)];
+    }
+    [[nodiscard]] std::optional<GLuint> GetBoundTexture(GlTargetTextureType target) const noexcept;
+    [[nodiscard]] std::optional<GLuint> GetBoundRenderbuffer() const noexcept { return renderbuffer_; }
+
+    // Forgets everything. The next call of each kind is issued unconditionally
+    void Invalidate() noexcept;
+
+    // Disabled cache issues every call. Useful to check whether some rendering issue is caused by the cache
+    void SetEnabled(bool enabled) noexcept
+    {
+        enabled_ = enabled;
+        Invalidate();
+    }
+    [[nodiscard]] bool IsEnabled() const noexcept { return enabled_; }
+
+    [[nodiscard]] const Counters& GetCounters() const noexcept { return counters_; }
+    void ResetCounters() noexcept { counters_ = {}; }
+
+private:
+    struct BlendFunction
+    {
+        GLenum source = GL_ONE;
+        GLenum destination = GL_ZERO;
+
+        [[nodiscard]] constexpr bool operator==(const BlendFunction&) const noexcept = default;
+    };
+
+    using TextureUnitState = std::array<std::optional<GLuint>, magic_enum::enum_count<GlTargetTextureType>()>;
+
+    template <typename T>
+    [[nodiscard]] bool Change(std::optional<T>& cached, const T& value) noexcept
+    {
+        if (enabled_ && cached == value)
+        {
+            ++counters_.skipped;
+            return false;
+        }
+
+        cached = value;
+        ++counters_.issued;
+        return true;
+    }
+
+    template <typename T>
+    static void Forget(std::optional<T>& cached, const T& value) noexcept
+    {
+        if (cached == value) cached.reset();
+    }
+
+private:
+    std::optional<GLuint> program_;
+    std::optional<GLuint> program_pipeline_;
+    std::optional<GLuint> vertex_array_;
+    std::array<std::optional<GLuint>, magic_enum::enum_count<GlBufferType>()> buffers_{};
+    std::optional<uint32_t> active_texture_unit_;
+    std::array<TextureUnitState, kMaxTextureUnits> textures_{};
+    std::optional<GLuint> renderbuffer_;
+    std::optional<bool> depth_test_;
+    std::optional<bool> blending_;
+    std::optional<BlendFunction> blend_function_;
+    std::optional<Viewport> viewport_;
+    Counters counters_{};
+    bool enabled_ = true;
+};
+
+}  // namespace klgl
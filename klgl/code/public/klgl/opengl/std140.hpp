@@ -0,0 +1,158 @@
+#pragma once
+
+#include <optional>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/enums.hpp"
+
+namespace klgl
+{
+
+// Scalars and vectors have one column. Matrices are stored as arrays of column vectors
+struct GlUniformTypeShape
+{
+    size_t component_size = 0;
+    size_t rows = 0;
+    size_t columns = 0;
+
+    [[nodiscard]] constexpr size_t GetColumnSize() const { return component_size * rows; }
+    [[nodiscard]] constexpr size_t GetTightSize() const { return GetColumnSize() * columns; }
+};
+
+// Returns nullopt for opaque types (samplers, images, atomic counters)
+[[nodiscard]] constexpr std::optional<GlUniformTypeShape> GetUniformTypeShape(GlUniformType type)
+{
+    using T = GlUniformType;
+    constexpr size_t s = 4;
+    constexpr size_t d = 8;
+    switch (type)
+    {
+    case T::Float:
+    case T::Int:
+    case T::UnsignedInt:
+    case T::Bool:
+        return GlUniformTypeShape{s, 1, 1};
+    case T::FloatVec2:
+    case T::IntVec2:
+    case T::UnsignedIntVec2:
+    case T::BoolVec2:
+        return GlUniformTypeShape{s, 2, 1};
+    case T::FloatVec3:
+    case T::IntVec3:
+    case T::UnsignedIntVec3:
+    case T::BoolVec3:
+        return GlUniformTypeShape{s, 3, 1};
+    case T::FloatVec4:
+    case T::IntVec4:
+    case T::UnsignedIntVec4:
+    case T::BoolVec4:
+        return GlUniformTypeShape{s, 4, 1};
+    case T::Double:
+        return GlUniformTypeShape{d, 1, 1};
+    case T::DoubleVec2:
+        return GlUniformTypeShape{d, 2, 1};
+    case T::DoubleVec3:
+        return GlUniformTypeShape{d, 3, 1};
+    case T::DoubleVec4:
+        return GlUniformTypeShape{d, 4, 1};
+    case T::FloatMat2:
+        return GlUniformTypeShape{s, 2, 2};
+    case T::FloatMat3:
+        return GlUniformTypeShape{s, 3, 3};
+    case T::FloatMat4:
+        return GlUniformTypeShape{s, 4, 4};
+    case T::FloatMat2x3:
+        return GlUniformTypeShape{s, 3, 2};
+    case T::FloatMat2x4:
+        return GlUniformTypeShape{s, 4, 2};
+    case T::FloatMat3x2:
+        return GlUniformTypeShape{s, 2, 3};
+    case T::FloatMat3x4:
+        return GlUniformTypeShape{s, 4, 3};
+    case T::FloatMat4x2:
+        return GlUniformTypeShape{s, 2, 4};
+    case T::FloatMat4x3:
+        return GlUniformTypeShape{s, 3, 4};
+    case T::DoubleMat2:
+        return GlUniformTypeShape{d, 2, 2};
+    case T::DoubleMat3:
+        return GlUniformTypeShape{d, 3, 3};
+    case T::DoubleMat4:
+        return GlUniformTypeShape{d, 4, 4};
+    case T::DoubleMat2x3:
+        return GlUniformTypeShape{d, 3, 2};
+    case T::DoubleMat2x4:
+        return GlUniformTypeShape{d, 4, 2};
+    case T::DoubleMat3x2:
+        return GlUniformTypeShape{d, 2, 3};
+    case T::DoubleMat3x4:
+        return GlUniformTypeShape{d, 4, 3};
+    case T::DoubleMat4x2:
+        return GlUniformTypeShape{d, 2, 4};
+    case T::DoubleMat4x3:
+        return GlUniformTypeShape{d, 3, 4};
+    default:
+        return std::nullopt;
+    }
+}
+
+// Location of a member inside of the block. Strides are zero for non-array and non-matrix members,
+// the same way OpenGL reports them.
+struct Std140Member
+{
+    size_t offset = 0;
+    size_t array_stride = 0;
+    size_t matrix_stride = 0;
+};
+
+// Computes offsets of uniform block members declared with layout(std140), in declaration order
+class Std140LayoutBuilder
+{
+public:
+    static constexpr size_t kVec4Alignment = 16;
+
+    // array_size is zero for non-array members. Matrices are column-major
+    constexpr Std140Member Add(GlUniformType type, size_t array_size = 0)
+    {
+        const std::optional<GlUniformTypeShape> shape = GetUniformTypeShape(type);
+        ErrorHandling::Ensure(shape.has_value(), "Type {} can not be a member of uniform block", type);
+
+        // Two and four component vectors are aligned to their size, three component vectors - as four component
+        const size_t n = shape->component_size;
+        size_t alignment = shape->rows == 1 ? n : (shape->rows == 2 ? 2 * n : 4 * n);
+        size_t size = shape->GetColumnSize();
+
+        Std140Member member;
+        if (shape->columns > 1)
+        {
+            member.matrix_stride = AlignUp(alignment, kVec4Alignment);
+            alignment = member.matrix_stride;
+            size = member.matrix_stride * shape->columns;
+        }
+
+        if (array_size != 0)
+        {
+            alignment = AlignUp(alignment, kVec4Alignment);
+            member.array_stride = AlignUp(size, alignment);
+            size = member.array_stride * array_size;
+        }
+
+        member.offset = AlignUp(size_, alignment);
+        size_ = member.offset + size;
+        return member;
+    }
+
+    // Size of the block is rounded up to the base alignment of vec4
+    [[nodiscard]] constexpr size_t GetSize() const { return AlignUp(size_, kVec4Alignment); }
+
+private:
+    [[nodiscard]] static constexpr size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+private:
+    size_t size_ = 0;
+};
+
+}  // namespace klgl
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "klgl/opengl/detail/maps/type_to_uniform_type.hpp"
+#include "klgl/opengl/enums.hpp"
+#include "klgl/opengl/identifiers.hpp"
+#include "klgl/opengl/object.hpp"
+
+namespace klgl
+{
+
+struct GlStorageBlockInfo;
+
+// Untyped part of StorageBuffer. Works with byte ranges so the implementation does not live in the header.
+// In OpenGL 4.4+ contexts the buffer has immutable storage that stays mapped with persistent coherent mapping for
+// the whole lifetime of the object: writes go directly to memory visible to GPU and read back does not need to map
+// the buffer. In older contexts writes that replace the whole buffer orphan the data store with glBufferData and
+// other writes use glBufferSubData.
+class StorageBufferBase
+{
+public:
+    StorageBufferBase() = default;
+    StorageBufferBase(StorageBufferBase&& other) noexcept;
+    StorageBufferBase& operator=(StorageBufferBase&& other) noexcept;
+    ~StorageBufferBase() = default;
+
+    // Binds the whole buffer to the shader storage binding point
+    void Bind(uint32_t binding) const;
+
+    [[nodiscard]] bool IsPersistentlyMapped() const { return mapped_ != nullptr; }
+    [[nodiscard]] size_t GetSizeBytes() const { return size_; }
+    [[nodiscard]] GlBufferId GetBuffer() const { return buffer_.GetId(); }
+
+protected:
+    explicit StorageBufferBase(std::span<const uint8_t> initial_data);
+
+    void WriteBytes(size_t offset, std::span<const uint8_t> data);
+
+    // Makes shader writes visible, waits for a fence inserted after them and copies the range to out
+    void ReadBytes(size_t offset, std::span<uint8_t> out) const;
+
+    void ClearBytes(size_t offset, size_t size);
+    void CopyBytes(const StorageBufferBase& source, size_t source_offset, size_t offset, size_t size);
+
+    // Throws if the block does not consist of one runtime sized array with elements of element_size bytes.
+    // element_type is the type of the element when it is a scalar, vector or matrix. Four component vector elements
+    // also match three component vectors of the same component type, which std430 pads to the same stride.
+    void EnsureElementLayout(
+        const GlStorageBlockInfo& block,
+        size_t element_size,
+        std::optional<GlUniformType> element_type) const;
+
+    void EnsureRange(size_t offset, size_t size) const;
+
+private:
+    GlObject<GlBufferId> buffer_;
+    uint8_t* mapped_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Typed shader storage buffer with elements of T laid out by std430 rules, i.e. declared in shader as
+//     layout(std430, binding = N) buffer Name { T elements[]; };
+// T must be trivially copyable and its size must match the array stride of the block
+// (for example vec3 arrays have 16 bytes stride, so they should be mapped to Vec4f).
+// Writes to a persistently mapped buffer are not synchronized with GPU: do not overwrite elements that are used
+// by commands which are still in flight. GlFence or per frame slots of Application can tell when they complete.
+template <typename T>
+class StorageBuffer : public StorageBufferBase
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    StorageBuffer() = default;
+
+    // Creates a buffer with count zero initialized elements
+    [[nodiscard]] static StorageBuffer Create(size_t count)
+    {
+        std::vector<uint8_t> zeros(count * sizeof(T), 0);
+        return StorageBuffer(zeros);
+    }
+
+    [[nodiscard]] static StorageBuffer Create(std::span<const T> elements) { return StorageBuffer(AsBytes(elements)); }
+
+    [[nodiscard]] size_t GetCount() const { return GetSizeBytes() / sizeof(T); }
+
+    void Write(std::span<const T> elements, size_t first = 0) { WriteBytes(first * sizeof(T), AsBytes(elements)); }
+
+    void Read(std::span<T> out, size_t first = 0) const
+    {
+        ReadBytes(first * sizeof(T), std::span{reinterpret_cast<uint8_t*>(out.data()), out.size_bytes()});  // NOLINT
+    }
+
+    [[nodiscard]] std::vector<T> Read() const
+    {
+        std::vector<T> elements(GetCount());
+        Read(elements);
+        return elements;
+    }
+
+    // Fills elements with zero bytes
+    void Clear() { ClearBytes(0, GetSizeBytes()); }
+    void Clear(size_t first, size_t count) { ClearBytes(first * sizeof(T), count * sizeof(T)); }
+
+    void CopyFrom(const StorageBuffer& source, size_t source_first, size_t first, size_t count)
+    {
+        CopyBytes(source, source_first * sizeof(T), first * sizeof(T), count * sizeof(T));
+    }
+
+    // Throws if the block declared in shader does not match the layout of T
+    void EnsureCompatible(const GlStorageBlockInfo& block) const
+    {
+        std::optional<GlUniformType> element_type;
+        if constexpr (requires { detail::TypeToGlUniformType<T>::value; })
+        {
+            element_type = detail::TypeToGlUniformType<T>::value;
+        }
+
+        EnsureElementLayout(block, sizeof(T), element_type);
+    }
+
+private:
+    explicit StorageBuffer(std::span<const uint8_t> initial_data) : StorageBufferBase(initial_data) {}
+
+    [[nodiscard]] static std::span<const uint8_t> AsBytes(std::span<const T> elements)
+    {
+        return {reinterpret_cast<const uint8_t*>(elements.data()), elements.size_bytes()};  // NOLINT
+    }
+};
+
+}  // namespace klgl
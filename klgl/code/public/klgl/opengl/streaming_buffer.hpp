@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "klgl/opengl/fence.hpp"
+#include "klgl/opengl/identifiers.hpp"
+#include "klgl/opengl/object.hpp"
+
+namespace klgl
+{
+
+template <typename T>
+struct StreamingBufferAllocation
+{
+    // Memory to write to. Valid until the next call of NextFrame or Reserve
+    std::span<T> data;
+
+    // Offset of the first element from the beginning of the buffer, as passed to vertex buffer bindings, indexed
+    // draws or glBindBufferRange
+    size_t offset = 0;
+};
+
+// Buffer for data that CPU writes once and GPU reads once, like per frame vertex or instance data.
+// The buffer is split into regions, one per frame in flight. Allocations are taken from the current region and
+// NextFrame moves to the next region after waiting until GPU finishes the commands that read it last time.
+// In OpenGL 4.4+ contexts the buffer stays mapped with persistent coherent mapping and allocations point directly to
+// its memory. In older contexts allocations point to CPU memory which Flush uploads, orphaning the data store on the
+// first upload after NextFrame.
+// Writes to mapped memory are not recorded by GlTraceRecorder.
+class StreamingBuffer
+{
+public:
+    // Vertex buffer offsets must be multiples of 4
+    static constexpr size_t kMinAlignment = 4;
+
+    // Regions start at multiples of this value, so allocations may be aligned up to it (uniform buffer ranges)
+    static constexpr size_t kMaxAlignment = 256;
+
+    StreamingBuffer() = default;
+    explicit StreamingBuffer(size_t region_size, size_t regions = 2);
+    StreamingBuffer(StreamingBuffer&& other) noexcept;
+    StreamingBuffer& operator=(StreamingBuffer&& other) noexcept;
+    ~StreamingBuffer() = default;
+
+    // Grows regions to at least region_size bytes (at least twice of the current size to make growth amortized).
+    // Recreates the buffer, so allocations of the current region are lost and the buffer name changes
+    void Reserve(size_t region_size);
+
+    // Throws if the current region does not have enough space. Alignment must be a power of two
+    [[nodiscard]] StreamingBufferAllocation<uint8_t> AllocateBytes(size_t size, size_t alignment = kMinAlignment);
+
+    template <typename T>
+        requires(std::is_trivially_copyable_v<T>)
+    [[nodiscard]] StreamingBufferAllocation<T> Allocate(size_t count, size_t alignment = alignof(T))
+    {
+        const auto bytes = AllocateBytes(count * sizeof(T), std::max(alignment, kMinAlignment));
+        return {std::span{reinterpret_cast<T*>(bytes.data.data()), count}, bytes.offset};  // NOLINT
+    }
+
+    // Allocates and copies values. Returns the offset of the copy
+    template <typename T>
+        requires(std::is_trivially_copyable_v<T>)
+    size_t Write(std::span<const T> values, size_t alignment = alignof(T))
+    {
+        const auto allocation = Allocate<T>(values.size(), alignment);
+        if (!values.empty()) std::memcpy(allocation.data.data(), values.data(), values.size_bytes());
+        return allocation.offset;
+    }
+
+    // Makes allocations written since the previous flush visible to GPU. Call before issuing commands that read them
+    void Flush();
+
+    // Fences commands that read the current region, moves to the next one and waits until GPU finishes the commands
+    // that read it last time. Call it exactly once per frame, after the last command that reads allocations of the
+    // frame. Extra calls within a frame wait for commands issued moments ago, so CPU stalls until GPU catches up.
+    // Allocations of several passes in one frame share the region: Reserve enough space for all of them instead
+    void NextFrame();
+
+    [[nodiscard]] GlBufferId GetBuffer() const { return buffer_.GetId(); }
+    [[nodiscard]] bool IsPersistentlyMapped() const { return mapped_ != nullptr; }
+    [[nodiscard]] size_t GetRegionSize() const { return region_size_; }
+    [[nodiscard]] size_t GetRegionsCount() const { return regions_; }
+
+    // Bytes allocated from the current region
+    [[nodiscard]] size_t GetUsedBytes() const { return head_; }
+
+private:
+    [[nodiscard]] size_t GetRegionBegin() const;
+
+private:
+    GlObject<GlBufferId> buffer_;
+    GlFenceRing fences_;
+    uint8_t* mapped_ = nullptr;
+    std::vector<uint8_t> staging_;
+    size_t region_size_ = 0;
+    size_t regions_ = 0;
+    size_t head_ = 0;
+    size_t flushed_ = 0;
+};
+
+}  // namespace klgl
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "klgl/opengl/detail/maps/type_to_uniform_type.hpp"
+#include "klgl/opengl/enums.hpp"
+#include "klgl/opengl/identifiers.hpp"
+#include "klgl/opengl/object.hpp"
+
+namespace klgl
+{
+
+struct GlUniformBlockInfo;
+
+// CPU copy of a uniform block and the buffer object it is uploaded to.
+// Setters only write to the CPU copy and extend the dirty byte range, Upload sends that range with one
+// glBufferSubData. One buffer can be bound to blocks of different programs if their layouts match,
+// declare such blocks with layout(std140) so the layout does not depend on the program.
+class UniformBuffer
+{
+public:
+    struct MemberDescription
+    {
+        std::string name;
+        GlUniformType type{};
+        // Zero for non-array members
+        size_t array_size = 0;
+    };
+
+    struct Member
+    {
+        std::string name;
+        GlUniformType type{};
+        size_t array_size = 0;
+        size_t offset = 0;
+        size_t array_stride = 0;
+        size_t matrix_stride = 0;
+    };
+
+    // Computes the layout using std140 rules. Members are placed in the order they are specified
+    [[nodiscard]] static UniformBuffer CreateStd140(std::span<const MemberDescription> members);
+
+    // Uses the layout reported for the block of a linked program
+    [[nodiscard]] static UniformBuffer CreateFromBlock(const GlUniformBlockInfo& block);
+
+    [[nodiscard]] std::optional<size_t> FindMember(std::string_view name) const;
+    [[nodiscard]] size_t GetMember(std::string_view name) const;
+    [[nodiscard]] std::span<const Member> GetMembers() const { return members_; }
+
+    template <typename T>
+    void Set(size_t member_index, const T& value, size_t array_index = 0)
+    {
+        SetArray(member_index, std::span<const T>{&value, 1}, array_index);
+    }
+
+    // Writes values to array elements starting from first_element
+    template <typename T>
+    void SetArray(size_t member_index, std::span<const T> values, size_t first_element = 0)
+    {
+        WriteElements(
+            member_index,
+            detail::TypeToGlUniformType<T>::value,
+            std::span{reinterpret_cast<const uint8_t*>(values.data()), values.size_bytes()},  // NOLINT
+            values.size(),
+            first_element);
+    }
+
+    // Sends the dirty range to the buffer object. Does nothing if there were no changes since the previous upload
+    void Upload();
+
+    // Binds the buffer to the uniform buffer binding point
+    void Bind(uint32_t binding) const;
+
+    // Throws if the layout of the block in some program does not match the layout of this buffer
+    void EnsureCompatible(const GlUniformBlockInfo& block) const;
+
+    [[nodiscard]] bool IsDirty() const { return dirty_begin_ < dirty_end_; }
+    [[nodiscard]] std::span<const uint8_t> GetData() const { return data_; }
+    [[nodiscard]] GlBufferId GetBuffer() const { return buffer_.GetId(); }
+
+private:
+    UniformBuffer(std::vector<Member> members, size_t size);
+
+    void WriteElements(
+        size_t member_index,
+        GlUniformType type,
+        std::span<const uint8_t> values,
+        size_t count,
+        size_t first_element);
+
+private:
+    std::vector<Member> members_;
+    std::vector<uint8_t> data_;
+    GlObject<GlBufferId> buffer_;
+    size_t dirty_begin_ = 0;
+    size_t dirty_end_ = 0;
+};
+
+}  // namespace klgl
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "klgl/opengl/gl_api.hpp"
 
 namespace klgl::detail
@@ -39,6 +41,18 @@ struct GlComponentTraits<T>
     static constexpr auto ComponentType = GlVertexAttribComponentType::UnsignedInt;
 };
 
+template <>
+struct GlComponentTraits<int16_t>
+{
+    static constexpr auto ComponentType = GlVertexAttribComponentType::Short;
+};
+
+template <>
+struct GlComponentTraits<uint16_t>
+{
+    static constexpr auto ComponentType = GlVertexAttribComponentType::UnsignedShort;
+};
+
 template <>
 struct GlComponentTraits<int8_t>
 {
@@ -50,6 +64,19 @@ struct GlComponentTraits<uint8_t>
 {
     static constexpr auto ComponentType = GlVertexAttribComponentType::UnsignedByte;
 };
+
+template <typename T>
+struct AttributeComponent
+{
+    using Type = T;
+};
+
+template <typename T>
+    requires(edt::IsMatrix<T>)
+struct AttributeComponent<T>
+{
+    using Type = typename T::Component;
+};
 }  // namespace klgl::detail
 
 namespace klgl
@@ -205,7 +232,7 @@ struct VertexBufferHelper
     {
         for (GLuint i = 0; i != kLocationsCount; ++i)
         {
-            glVertexAttribDivisor(static_cast<GLuint>(location + i), divisor);
+            OpenGl::VertexAttribDivisor(location + i, static_cast<size_t>(divisor));
         }
     }
 
@@ -217,13 +244,69 @@ struct VertexBufferHelper
         }
     }
 
+    static constexpr size_t kComponentsPerLocation = []() -> size_t
+    {
+        if constexpr (edt::IsMatrix<T>)
+        {
+            return T::IsVector() ? T::Size() : T::NumRows();
+        }
+
+        return 1;
+    }();
+
     static void EnableVertexArrayAttrib(GlVertexArrayId vao, size_t location)
     {
         for (GLuint i = 0; i != kLocationsCount; ++i)
         {
-            glEnableVertexArrayAttrib(vao.GetValue(), static_cast<GLuint>(location + i));
+            klgl::OpenGl::EnableVertexArrayAttrib(vao, location + i);
         }
     }
+
+    // Direct state access counterpart of AttributePointerAs* functions. Describes the attribute in the vertex array
+    // without binding it. All locations of the attribute read from the binding index (equal to location by default),
+    // so the buffer has to be attached with OpenGl::VertexArrayVertexBuffer(vao, binding, ...). Attributes of an
+    // interleaved struct share one binding and differ by member_offset
+    static void AttributeFormat(
+        GlVertexArrayId vao,
+        size_t location,
+        bool normalize,
+        bool to_float,
+        size_t member_offset = 0,
+        std::optional<size_t> binding = std::nullopt)
+    {
+        using Component = typename detail::AttributeComponent<T>::Type;
+        constexpr auto component_type = detail::GlComponentTraits<Component>::ComponentType;
+        for (size_t i = 0; i != kLocationsCount; ++i)
+        {
+            const size_t relative_offset = member_offset + sizeof(Component) * i * kComponentsPerLocation;
+            if (to_float)
+            {
+                klgl::OpenGl::VertexArrayAttribFormat(
+                    vao,
+                    location + i,
+                    kComponentsPerLocation,
+                    component_type,
+                    normalize,
+                    relative_offset);
+            }
+            else
+            {
+                klgl::OpenGl::VertexArrayAttribIFormat(
+                    vao,
+                    location + i,
+                    kComponentsPerLocation,
+                    component_type,
+                    relative_offset);
+            }
+
+            klgl::OpenGl::VertexArrayAttribBinding(vao, location + i, binding.value_or(location));
+        }
+    }
+
+    static void BindingDivisor(GlVertexArrayId vao, size_t location, size_t divisor)
+    {
+        klgl::OpenGl::VertexArrayBindingDivisor(vao, location, divisor);
+    }
 };
 
 // Provides a function with a single interface
@@ -253,6 +336,20 @@ struct VertexBufferHelperStatic
     {
         VertexBufferHelper<T>::EnableVertexArrayAttrib(vao, location);
     }
+
+    static void AttributeFormat(
+        GlVertexArrayId vao,
+        size_t location,
+        size_t member_offset = 0,
+        std::optional<size_t> binding = std::nullopt)
+    {
+        VertexBufferHelper<T>::AttributeFormat(vao, location, normalize, convert_to_float, member_offset, binding);
+    }
+
+    static void BindingDivisor(GlVertexArrayId vao, size_t location, size_t divisor)
+    {
+        VertexBufferHelper<T>::BindingDivisor(vao, location, divisor);
+    }
 };
 
 }  // namespace klgl
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "EverydayTools/Math/Matrix.hpp"
 
@@ -9,8 +12,13 @@ namespace klgl
 
 using namespace edt::lazy_matrix_aliases;  // NOLINT
 
+class Painter2dLayer;
+class TextureAtlas;
+struct TextureAtlasRegion;
+
 // This class allows you to paint simple figures every frame.
-// It uses alpha channel but it will not sort entities by the distance to the camera automatically
+// It uses alpha channel but it will not sort entities by the distance to the camera automatically.
+// Primitives are drawn in the order they were added, including primitives of submitted command lists
 class Painter2d
 {
 public:
@@ -57,9 +65,91 @@ public:
         float outer = 0;
     };
 
+    // Layout of the instance buffer. Primitives of all types are drawn from it by one instanced draw
+    struct Instance
+    {
+        Mat3f transform;  // Transposed
+        Vec2f params;
+        edt::Matrix<uint16_t, 4, 1> uv;  // Sprite region: min and max texture coordinates normalized to 16 bits
+        Vec4u8 color;
+        uint8_t type = 0;
+    };
+
+    // Instance data of a primitive, as recorded by drawing functions
+    [[nodiscard]] static Instance MakeInstance(const Rect2d& rect);
+    [[nodiscard]] static Instance MakeInstance(const Rect2d& rect, LineWidth line_width);
+    [[nodiscard]] static Instance MakeInstance(const Circle2d& circle);
+    [[nodiscard]] static Instance MakeInstance(const Triangle2d& triangle);
+    [[nodiscard]] static Instance MakeInstance(const Triangle2d& triangle, LineWidth line_width);
+    [[nodiscard]] static Instance MakeInstance(const Line2d& line);
+    [[nodiscard]] static Instance MakeInstance(const Rect2d& rect, const TextureAtlasRegion& region);
+
+    // Primitives recorded without OpenGL calls, so lists can be filled on worker threads (one thread per list at a
+    // time) and submitted to the painter on the main thread. Keeps its capacity after Clear
+    class CommandList
+    {
+    public:
+        void RectLines(const Rect2d& rect, LineWidth line_width) { Add(MakeInstance(rect, line_width)); }
+        void TriangleLines(const Triangle2d& triangle, LineWidth line_width)
+        {
+            Add(MakeInstance(triangle, line_width));
+        }
+
+        void FillRect(const Rect2d& rect) { Add(MakeInstance(rect)); }
+        void FillCircle(const Circle2d& circle) { Add(MakeInstance(circle)); }
+        void FillTriangle(const Triangle2d& triangle) { Add(MakeInstance(triangle)); }
+        void DrawLine(const Line2d& line) { Add(MakeInstance(line)); }
+        void DrawSprite(const Rect2d& rect, const TextureAtlasRegion& region) { Add(MakeInstance(rect, region)); }
+
+        void Add(const Instance& instance) { instances_.push_back(instance); }
+
+        // Bulk versions of the functions above: storage grows once per call instead of once per primitive
+        void FillRects(std::span<const Rect2d> rects);
+        void FillCircles(std::span<const Circle2d> circles);
+        void DrawLines(std::span<const Line2d> lines);
+
+        // Appends primitives of another list after primitives of this one
+        void Append(const CommandList& other);
+
+        // Removes primitives that are entirely outside of the clip space. The view matrix has the layout passed to
+        // SetViewMatrix. Order of the remaining primitives is kept. Outlines are never removed because their width
+        // is not bounded by the transform. Returns the number of removed primitives
+        size_t Cull(const Mat3f& view);
+
+        void Clear() { instances_.clear(); }
+        void Reserve(size_t primitives) { instances_.reserve(primitives); }
+
+        [[nodiscard]] size_t GetSize() const { return instances_.size(); }
+        [[nodiscard]] bool IsEmpty() const { return instances_.empty(); }
+        [[nodiscard]] std::span<const Instance> GetInstances() const { return instances_; }
+
+    private:
+        // Appends count instances to be overwritten by the caller
+        [[nodiscard]] std::span<Instance> Grow(size_t count);
+
+    private:
+        std::vector<Instance> instances_;
+    };
+
+    // Moves the instance buffer to the region of the next frame, waiting for GPU to finish the frame that used it.
+    // Call once per frame before the first drawing session. Without it sessions keep appending to one region and the
+    // buffer grows
+    void NextFrame();
+
+    // A frame may have several drawing sessions. Their primitives are uploaded to the region selected by NextFrame
     void BeginDraw();
     void EndDraw();
 
+    // Adds primitives of the lists to the current drawing session after primitives added before. Lists are merged
+    // in the order they are passed, so the result does not depend on which worker finished first. Lists are not
+    // copied: EndDraw writes them straight to the instance buffer, so they must not change until then
+    void Submit(const CommandList& list);
+    void Submit(std::span<const CommandList> lists);
+
+    // Uploads changes of the layer and draws it right away with the current view matrix. Primitives of a drawing
+    // session are drawn by EndDraw, so the layer is below them if it is drawn before EndDraw
+    void DrawLayer(Painter2dLayer& layer);
+
     void RectLines(const Rect2d& rect, LineWidth line_width);
     void TriangleLines(const Triangle2d& triangle, LineWidth line_width);
 
@@ -68,8 +158,25 @@ public:
     void FillTriangle(const Triangle2d& triangle);
     void DrawLine(const Line2d& line);
 
+    // Draws the region of the atlas set by SetTextureAtlas in the rect. The color of the rect multiplies texels
+    void DrawSprite(const Rect2d& rect, const TextureAtlasRegion& region);
+
+    void FillRects(std::span<const Rect2d> rects);
+    void FillCircles(std::span<const Circle2d> circles);
+    void DrawLines(std::span<const Line2d> lines);
+
     void SetViewMatrix(const Mat3f& view_matrix);
 
+    // Texture of sprites. Sprites of one draw come from one atlas, so drawing sprites of several atlases takes a
+    // drawing session per atlas. The atlas must outlive its use by the painter
+    void SetTextureAtlas(const TextureAtlas* atlas);
+
+    // Off by default. When enabled, EndDraw removes primitives outside of the view before uploading them
+    void SetCullingEnabled(bool enabled);
+
+    // Primitives removed by culling during the last EndDraw
+    [[nodiscard]] size_t GetCulledCount() const;
+
 private:
     std::unique_ptr<Impl> self;
 };
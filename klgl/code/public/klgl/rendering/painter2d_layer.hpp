@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "klgl/opengl/identifiers.hpp"
+#include "klgl/opengl/object.hpp"
+#include "klgl/rendering/painter2d.hpp"
+
+namespace klgl
+{
+
+// Retained primitives of Painter2d. Each primitive lives in a slot of a persistent instance buffer and is addressed
+// by a handle that stays valid until the primitive is removed. Changes are tracked as one range of slots that is
+// uploaded when the layer is drawn, so a layer that did not change costs no uploads.
+// Primitives are drawn in slot order. Removed slots are hidden by a degenerate transform and reused by next additions.
+// Adding, updating and removing primitives does not call OpenGL, uploads happen on the thread that draws the layer.
+class Painter2dLayer
+{
+public:
+    using Instance = Painter2d::Instance;
+
+    struct Handle
+    {
+        static constexpr uint32_t kInvalidSlot = std::numeric_limits<uint32_t>::max();
+
+        [[nodiscard]] bool IsValid() const { return slot != kInvalidSlot; }
+
+        uint32_t slot = kInvalidSlot;
+        uint32_t generation = 0;
+    };
+
+    Handle Add(const Instance& instance);
+    Handle AddRect(const Painter2d::Rect2d& rect) { return Add(Painter2d::MakeInstance(rect)); }
+    Handle AddCircle(const Painter2d::Circle2d& circle) { return Add(Painter2d::MakeInstance(circle)); }
+    Handle AddTriangle(const Painter2d::Triangle2d& triangle) { return Add(Painter2d::MakeInstance(triangle)); }
+    Handle AddLine(const Painter2d::Line2d& line) { return Add(Painter2d::MakeInstance(line)); }
+    Handle AddSprite(const Painter2d::Rect2d& rect, const TextureAtlasRegion& region)
+    {
+        return Add(Painter2d::MakeInstance(rect, region));
+    }
+
+    // Throws if the handle does not refer to a primitive of the layer
+    void Update(Handle handle, const Instance& instance);
+    void Update(Handle handle, const Painter2d::Rect2d& rect) { Update(handle, Painter2d::MakeInstance(rect)); }
+    void Update(Handle handle, const Painter2d::Circle2d& circle) { Update(handle, Painter2d::MakeInstance(circle)); }
+    void Update(Handle handle, const Painter2d::Line2d& line) { Update(handle, Painter2d::MakeInstance(line)); }
+    void Update(Handle handle, const Painter2d::Triangle2d& triangle)
+    {
+        Update(handle, Painter2d::MakeInstance(triangle));
+    }
+
+    void Remove(Handle handle);
+    [[nodiscard]] bool Contains(Handle handle) const;
+
+    // Live primitives
+    [[nodiscard]] size_t GetSize() const { return instances_.size() - free_slots_.size(); }
+
+    // Live primitives and removed ones whose slots were not reused yet. This many instances are drawn
+    [[nodiscard]] size_t GetSlotsCount() const { return instances_.size(); }
+
+    [[nodiscard]] bool HasChanges() const { return dirty_begin_ < dirty_end_; }
+
+    // Writes changed slots to the instance buffer, growing it if needed. Called by Painter2d::DrawLayer
+    void Upload();
+
+    // Invalid until the first upload. Changes when the buffer grows
+    [[nodiscard]] GlBufferId GetBuffer() const { return buffer_.GetId(); }
+
+private:
+    void EnsureContains(Handle handle) const;
+    void MarkDirty(size_t slot);
+
+private:
+    std::vector<Instance> instances_;
+    std::vector<uint32_t> generations_;
+    std::vector<uint32_t> free_slots_;
+    size_t dirty_begin_ = 0;
+    size_t dirty_end_ = 0;
+    size_t buffer_capacity_ = 0;
+    GlObject<GlBufferId> buffer_;
+};
+
+}  // namespace klgl
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/enums.hpp"
+#include "klgl/texture/texture_format_helper.hpp"
+
+struct GLFWwindow;
+
+namespace klgl
+{
+
+class MeshOpenGL;
+class Texture;
+class Window;
+
+namespace detail
+{
+template <typename T>
+struct UploadState
+{
+    std::atomic<bool> ready = false;
+    std::optional<T> value;
+    std::exception_ptr error;
+
+    // Runs on the thread that takes the value. Finishes what can not be done by the loader context
+    std::function<void(T&)> finalize;
+};
+}  // namespace detail
+
+// Result of an upload started by ResourceUploader. The value can be taken once the upload is ready: commands that
+// upload data are complete by then, so the main context sees the objects after binding them
+template <typename T>
+class UploadHandle
+{
+public:
+    UploadHandle() = default;
+    explicit UploadHandle(std::shared_ptr<detail::UploadState<T>> state) : state_(std::move(state)) {}
+
+    [[nodiscard]] bool IsValid() const noexcept { return state_ != nullptr; }
+
+    // Does not block
+    [[nodiscard]] bool IsReady() const noexcept { return state_ && state_->ready.load(std::memory_order_acquire); }
+
+    void Wait() const
+    {
+        ErrorHandling::Ensure(IsValid(), "Waiting for an empty upload handle");
+        state_->ready.wait(false, std::memory_order_acquire);
+    }
+
+    // Call on the main thread once the upload is ready. Rethrows the exception if the upload failed
+    [[nodiscard]] T Take()
+    {
+        ErrorHandling::Ensure(IsReady(), "Taking the result of an upload that is not ready");
+        auto state = std::move(state_);
+        if (state->error) std::rethrow_exception(state->error);
+
+        T value = std::move(*state->value);
+        if (state->finalize) state->finalize(value);
+        return value;
+    }
+
+private:
+    std::shared_ptr<detail::UploadState<T>> state_;
+};
+
+struct TextureUpload
+{
+    Vec2<size_t> resolution{};
+    GlTextureInternalFormat format = GlTextureInternalFormat::RGBA8;
+
+    // Texture is only allocated if there are no pixels
+    PixelBufferFormat pixel_format{};
+    std::vector<uint8_t> pixels;
+};
+
+struct MeshUpload
+{
+    std::vector<uint8_t> vertices;
+    std::vector<uint32_t> indices;
+    GlPrimitiveType topology = GlPrimitiveType::Triangles;
+};
+
+// Uploads textures and meshes on a loader thread with its own context that shares objects with the window, so big
+// uploads do not stall the frame. Each upload ends with a fence that the loader waits for before reporting the upload
+// as ready. Vertex arrays are not shared between contexts: meshes get them when the main thread takes the result.
+// Uploads run one by one in the order they were requested.
+class ResourceUploader
+{
+public:
+    // Creates the shared context and starts the loader thread. Must be called on the main thread
+    explicit ResourceUploader(Window& window);
+
+    // Takes ownership of the context, which must share objects with the main one. Without a context the loader thread
+    // calls entry points as they are, which is enough for NullGlBackend
+    explicit ResourceUploader(GLFWwindow* context);
+
+    // Finishes queued uploads before the loader thread exits. Must be called on the main thread
+    ~ResourceUploader();
+
+    ResourceUploader(const ResourceUploader&) = delete;
+    ResourceUploader& operator=(const ResourceUploader&) = delete;
+
+    [[nodiscard]] UploadHandle<std::unique_ptr<Texture>> UploadTexture(TextureUpload upload);
+    [[nodiscard]] UploadHandle<std::unique_ptr<MeshOpenGL>> UploadMesh(MeshUpload upload);
+
+    // Uploads that have not started yet
+    [[nodiscard]] size_t GetQueueSize() const;
+
+private:
+    template <typename T>
+    UploadHandle<T> Enqueue(std::function<T()> upload, std::function<void(T&)> finalize = {});
+
+    void ThreadMain();
+
+    // Waits for the commands of the upload and reports errors that were not checked per call
+    static void FinishUpload();
+
+    // State cache of the loader thread does not see objects deleted by the main thread, and the driver may give their
+    // names to new objects. So each job starts with unknown state and leaves nothing bound
+    static void ResetContextState() noexcept;
+
+private:
+    GLFWwindow* context_ = nullptr;
+    mutable std::mutex mutex_;
+    std::condition_variable has_jobs_;
+    std::deque<std::function<void()>> jobs_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+}  // namespace klgl
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <span>
+
+#include "klgl/rendering/painter2d.hpp"
+
+namespace klgl
+{
+
+class Image;
+
+// Draws Painter2d primitives into an image on the CPU, so the output of painter can be produced without OpenGL.
+// Primitives are recorded with Painter2d::CommandList and rasterized with the semantics of painter2d.geom and
+// painter2d.frag: pixels are covered when their centers are inside of a triangle, edges shared by two triangles
+// cover a pixel once, and colors are blended over the image as with glBlendFunc(SRC_ALPHA, ONE_MINUS_SRC_ALPHA).
+// The image is split into tiles. Primitives are split into convex polygons that are binned to the tiles they overlap,
+// and tiles are rasterized by several threads, each in the order of primitives, so the result does not depend on the
+// number of threads
+class SoftwareRasterizer2d
+{
+public:
+    class Impl;
+
+    struct Settings
+    {
+        // Side of a square tile in pixels
+        size_t tile_size = 64;
+
+        // Zero means std::thread::hardware_concurrency
+        size_t threads_count = 0;
+    };
+
+    SoftwareRasterizer2d();
+    explicit SoftwareRasterizer2d(const Settings& settings);
+    ~SoftwareRasterizer2d();
+
+    // The matrix has the layout passed to Painter2d::SetViewMatrix
+    void SetViewMatrix(const Mat3f& view_matrix);
+
+    // CPU copy of the texture atlas sprites refer to. Sampled with the nearest filter. Sprites are skipped without it
+    void SetAtlasImage(const Image* atlas);
+
+    void Draw(Image& image, std::span<const Painter2d::Instance> instances);
+    void Draw(Image& image, const Painter2d::CommandList& list) { Draw(image, list.GetInstances()); }
+
+private:
+    std::unique_ptr<Impl> self;
+};
+
+}  // namespace klgl
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <limits>
+#include <memory>
 #include <optional>
 #include <span>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "CppReflection/GetStaticTypeInfo.hpp"
+#include "ankerl/unordered_dense.h"
 #include "klgl/opengl/identifiers.hpp"
 #include "klgl/opengl/object.hpp"
 #include "klgl/opengl/program_info.hpp"
@@ -17,6 +24,7 @@ namespace klgl
 
 class ShaderDefine;
 class ShaderUniform;
+struct SeparableStage;
 class Texture;
 
 class Shader
@@ -37,6 +45,7 @@ public:
         std::string buffer;
         Compile(buffer);
     }
+    // Locations are looked up in the monolithic program. Not applicable to separable shaders.
     [[nodiscard]] std::optional<uint32_t> FindUniformLocation(const char*) const noexcept;
     [[nodiscard]] uint32_t GetUniformLocation(const char*) const;
     void DrawDetails();
@@ -56,9 +65,35 @@ public:
             std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&value), sizeof(T)));  // NOLINT
     }
 
+    // Assigns values to elements [first_element, first_element + values.size()) of an array uniform.
+    // Only the modified range is sent to OpenGL, with one glUniform*v call.
+    void SetUniformArray(
+        UniformHandle& handle,
+        edt::GUID type_guid,
+        std::span<const uint8_t> values,
+        size_t first_element = 0);
+
+    template <typename T>
+    void SetUniformArray(UniformHandle& handle, std::span<const T> values, size_t first_element = 0)
+    {
+        SetUniformArray(
+            handle,
+            cppreflection::GetStaticTypeInfo<T>().guid,
+            std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(values.data()), values.size_bytes()),  // NOLINT
+            first_element);
+    }
+
+    // Number of elements in the uniform. One for uniforms that are not arrays.
+    [[nodiscard]] size_t GetUniformArraySize(UniformHandle& handle) const;
+
+    // Sends values of uniforms that were modified since the last send
     void SendUniforms();
     void SendUniform(UniformHandle&);
 
+    // Assigns uniform buffer binding point to the uniform block. Reapplied after every recompilation.
+    // Blocks that are not active in the current program are ignored.
+    void SetUniformBlockBinding(std::string_view block_name, uint32_t binding);
+
     template <typename T>
     const T& GetDefineValue(DefineHandle& handle) const;
     std::span<const uint8_t> GetDefineValue(DefineHandle& handle, edt::GUID type_guid) const;
@@ -76,36 +111,72 @@ public:
             std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&value), sizeof(T)));  // NOLINT
     }
 
+    // Invalid for separable shaders: they use a program pipeline instead
     GlProgramId GetProgramId() const { return program_.GetId(); }
 
+    // Shader is separable if "separable": true is specified in the shader json and OpenGL 4.1 is available.
+    // Every stage is linked into its own program and programs are combined through a program pipeline.
+    // Stages with exactly the same code (including defines) are shared between shaders.
+    [[nodiscard]] bool IsSeparable() const noexcept { return pipeline_.IsValid(); }
+
 protected:
     ShaderUniform& GetUniform(UniformHandle& handle);
     const ShaderUniform& GetUniform(UniformHandle& handle) const;
     std::span<const uint8_t> GetUniformValueViewRaw(UniformHandle& handle, edt::GUID type_guid) const;
-    void UpdateUniformHandle(UniformHandle& handle) const;
+    // Returns index of the uniform in uniforms_. Updates the handle if it refers to a different uniform.
+    [[nodiscard]] size_t ResolveUniformIndex(UniformHandle& handle) const;
     void UpdateDefineHandle(DefineHandle& handle) const;
 
     template <typename T>
     const T& GetUniformValue(UniformHandle& handle)
     {
         std::span<const uint8_t> view = GetUniformValueViewRaw(handle, cppreflection::GetStaticTypeInfo<T>().guid);
-        assert(view.size() == sizeof(T));
+        assert(view.size() >= sizeof(T));
         return *reinterpret_cast<const T*>(view.data());  // NOLINT
     }
 
 private:
+    static uint64_t GenerateInstanceId();
     void UpdateInfo();
     void UpdateUniforms();
+    void SendUniformValue(size_t index, size_t& active_stage);
+    void ClaimSeparableStages();
+    void ApplyUniformBlockBinding(std::string_view block_name, uint32_t binding);
+    [[nodiscard]] std::optional<size_t> FindUniformIndex(Name name) const noexcept;
+    void SetUniformValue(size_t index, std::span<const uint8_t> value, size_t first_element = 0);
+    [[nodiscard]] std::span<const uint8_t> GetUniformValueView(size_t index) const;
+    void MarkUniformDirty(size_t index) { dirty_uniforms_[index / 64] |= uint64_t{1} << (index % 64); }
+    void MarkUniformClean(size_t index) { dirty_uniforms_[index / 64] &= ~(uint64_t{1} << (index % 64)); }
+    [[nodiscard]] bool IsUniformDirty(size_t index) const
+    {
+        return (dirty_uniforms_[index / 64] >> (index % 64)) & uint64_t{1};
+    }
+    void ApplyUniformBlockBindings();
 
 public:
     static std::filesystem::path shaders_dir_;
 
 private:
     std::filesystem::path path_;
+    static constexpr uint32_t kInactiveUniformSlot = std::numeric_limits<uint32_t>::max();
+
     std::vector<ShaderDefine> defines_;
+    ankerl::unordered_dense::map<Name::NameId, uint32_t> define_indices_;
     std::vector<ShaderUniform> uniforms_;
+    // Uniform handles store a slot instead of an index in uniforms_. A slot is assigned to a uniform name once
+    // and is never reused, so handles stay valid when recompilation changes the set or the order of uniforms.
+    ankerl::unordered_dense::map<Name::NameId, uint32_t> uniform_slots_;
+    std::vector<uint32_t> uniform_slot_to_index_;
+    // Values of all uniforms packed together. Each uniform knows its offset in this arena.
+    std::vector<uint8_t> uniform_values_;
+    // One bit per uniform: value was modified but was not sent yet
+    std::vector<uint64_t> dirty_uniforms_;
+    std::vector<std::pair<std::string, uint32_t>> uniform_block_bindings_;
     GlProgramInfo info_;
     GlObject<GlProgramId> program_;
+    GlObject<GlProgramPipelineId> pipeline_;
+    std::vector<std::shared_ptr<SeparableStage>> stages_;
+    uint64_t instance_id_ = 0;
     bool definitions_initialized_ : 1 = false;
     bool need_recompile_ : 1 = true;
 };
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace klgl
+{
+
+// Keeps shader sources in memory. The root directory is indexed once (recursively) and every file
+// is read only the first time it is requested, so recompiling a shader does not touch the filesystem.
+// Revalidate compares modification times of cached files and picks up changes made on disk.
+class ShaderSourceCache
+{
+public:
+    // Process-wide instance used by Shader
+    static ShaderSourceCache& Get();
+
+    ShaderSourceCache() = default;
+    ShaderSourceCache(const ShaderSourceCache&) = delete;
+    ShaderSourceCache& operator=(const ShaderSourceCache&) = delete;
+
+    // Drops everything cached so far if the root differs from the current one
+    void SetRootDirectory(const std::filesystem::path& root);
+    [[nodiscard]] std::filesystem::path GetRootDirectory() const;
+
+    // Files located directly in the specified directory (not recursive), sorted by path.
+    // Throws if the directory is not a part of the indexed root.
+    [[nodiscard]] std::vector<std::filesystem::path> GetDirectoryFiles(const std::filesystem::path& directory);
+
+    // Returns a copy because other threads may revalidate the cache while the caller uses the content
+    [[nodiscard]] std::string GetFileContent(const std::filesystem::path& path);
+
+    // Appends the content of the file to the buffer and expands #include "file" directives.
+    // Include paths are resolved relative to the including file first and then relative to the root.
+    // Each file gets its own GLSL source string number in #line directives, so compiler logs point to
+    // the right file: source_files[N] is the file with number N. A file is included at most once.
+    void AppendPreprocessed(
+        const std::filesystem::path& path,
+        std::string& buffer,
+        std::vector<std::filesystem::path>& source_files);
+
+    // Re-indexes the root directory and re-reads files that were modified since they were cached
+    void Revalidate();
+
+private:
+    struct CachedFile
+    {
+        std::filesystem::file_time_type write_time;
+        std::string content;
+    };
+
+    void EnsureIndexed();
+    void Index();
+    [[nodiscard]] bool IsIndexedFile(const std::filesystem::path& path) const;
+    [[nodiscard]] const std::string& GetFileContentNoLock(const std::filesystem::path& path);
+    [[nodiscard]] std::filesystem::path ResolveInclude(
+        const std::filesystem::path& including_file,
+        std::string_view include_path) const;
+    void AppendPreprocessedNoLock(
+        const std::filesystem::path& path,
+        std::string& buffer,
+        std::vector<std::filesystem::path>& source_files);
+
+private:
+    mutable std::mutex mutex_;
+    std::filesystem::path root_;
+    std::unordered_map<std::string, std::vector<std::filesystem::path>> directories_;
+    std::unordered_map<std::string, CachedFile> files_;
+    bool indexed_ = false;
+};
+
+}  // namespace klgl
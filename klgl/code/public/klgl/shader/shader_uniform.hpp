@@ -1,7 +1,9 @@
 #pragma once
 
-#include <span>
-#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string_view>
 
 #include "EverydayTools/GUID.hpp"
 #include "klgl/name_cache/name.hpp"
@@ -9,44 +11,77 @@
 namespace klgl
 {
 
+// Describes one uniform of a linked program. The value itself lives in the value arena owned by Shader.
+// Size, alignment and the function that sends the value to OpenGL are resolved once in SetType, so sending
+// a value is a single indirect call without any type lookups.
+// Arrays are represented by a single uniform with count elements stored one after another.
 class ShaderUniform
 {
 public:
-    ShaderUniform();
-    ~ShaderUniform();
-    ShaderUniform(const ShaderUniform&) = delete;
-    ShaderUniform(ShaderUniform&& another) noexcept;
-    void MoveFrom(ShaderUniform& another);
-    void SendValue() const;
-    void SetValue(std::span<const uint8_t> new_value);
-    void SetType(edt::GUID type_guid);
+    using SendFunction = void (*)(uint32_t location, uint32_t count, const uint8_t* values);
+
+    // Throws if uniforms of this type are not supported
+    void SetType(edt::GUID type_guid, uint32_t count = 1);
     void SetName(Name name) { name_ = name; }
     void SetLocation(uint32_t location) { location_ = location; }
+    void SetValueOffset(uint32_t offset) { value_offset_ = offset; }
+    void SetStage(uint8_t stage) { stage_ = stage; }
+    void SetNextAlias(uint32_t index) { next_alias_ = index; }
     void EnsureTypeMatch(edt::GUID type_guid) const;
 
-    [[nodiscard]] bool IsEmpty() const noexcept;
-    [[nodiscard]] std::string_view GetNameView() { return GetName().GetView(); }
+    // Extends the range of elements that will be sent by the next SendDirtyRange call
+    void MarkDirty(uint32_t first, uint32_t count)
+    {
+        dirty_begin_ = std::min(dirty_begin_, first);
+        dirty_end_ = std::max(dirty_end_, first + count);
+    }
+    void MarkDirty() { MarkDirty(0, count_); }
+
+    // Sends modified elements of the value that is stored in the arena at the value offset with one call
+    void SendDirtyRange(const uint8_t* values_arena)
+    {
+        if (dirty_begin_ < dirty_end_)
+        {
+            const uint8_t* first_element = values_arena + value_offset_ + dirty_begin_ * element_size_;
+            send_function_(location_ + dirty_begin_, dirty_end_ - dirty_begin_, first_element);
+        }
+
+        dirty_begin_ = count_;
+        dirty_end_ = 0;
+    }
+
+    [[nodiscard]] std::string_view GetNameView() const { return GetName().GetView(); }
 
     [[nodiscard]] Name GetName() const noexcept { return name_; }
     [[nodiscard]] edt::GUID GetTypeGUID() const noexcept { return type_guid_; }
     [[nodiscard]] uint32_t GetLocation() const noexcept { return location_; }
+    [[nodiscard]] uint32_t GetValueOffset() const noexcept { return value_offset_; }
+    [[nodiscard]] uint32_t GetValueSize() const noexcept { return element_size_ * count_; }
+    [[nodiscard]] uint32_t GetValueAlignment() const noexcept { return value_alignment_; }
+    [[nodiscard]] uint32_t GetElementSize() const noexcept { return element_size_; }
+    [[nodiscard]] uint32_t GetCount() const noexcept { return count_; }
 
-    //[[nodiscard]] std::span<uint8_t> GetValue() noexcept { return value_; }
-    [[nodiscard]] std::span<const uint8_t> GetValue() const noexcept { return value_; }
-
-    ShaderUniform& operator=(const ShaderUniform&) = delete;
-    ShaderUniform& operator=(ShaderUniform&& another) noexcept;
+    // Index of the program in a separable pipeline this uniform belongs to. Always zero for monolithic programs.
+    [[nodiscard]] uint8_t GetStage() const noexcept { return stage_; }
 
-private:
-    void Clear();
-    void CheckNotEmpty() const;
+    // Uniforms with the same name in different stages of a separable pipeline share the value. This is the index
+    // of the next uniform that shares the value or kNoAlias.
+    [[nodiscard]] uint32_t GetNextAlias() const noexcept { return next_alias_; }
+    static constexpr uint32_t kNoAlias = std::numeric_limits<uint32_t>::max();
 
 private:
-    std::vector<uint8_t> value_;
     Name name_;
     uint32_t location_{};
+    uint32_t value_offset_{};
+    uint32_t element_size_{};
+    uint32_t count_{1};
+    uint32_t value_alignment_{1};
+    uint32_t dirty_begin_{};
+    uint32_t dirty_end_{};
+    uint32_t next_alias_ = kNoAlias;
     edt::GUID type_guid_;
-    mutable bool sent_ = false;
+    SendFunction send_function_ = nullptr;
+    uint8_t stage_ = 0;
 };
 
 }  // namespace klgl
@@ -12,6 +12,7 @@ public:
     explicit UniformHandle(std::string_view name) : name(Name(name)) {}
     UniformHandle(uint32_t in_index, Name in_name) : index(in_index), name(in_name) {}
 
+    // Slot in the shader's remapping table. Stays valid across recompilations of the shader.
     uint32_t index = 0;
     Name name{};
 };
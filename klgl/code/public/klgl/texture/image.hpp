@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "EverydayTools/Math/Matrix.hpp"
+
+namespace klgl
+{
+
+using namespace edt::lazy_matrix_aliases;  // NOLINT
+
+// RGBA8 pixels in CPU memory. Rows go from bottom to top like in textures and framebuffers
+class Image
+{
+public:
+    Image() = default;
+    explicit Image(const Vec2<size_t>& size, const Vec4u8& fill = {}) : size_(size), pixels_(size.x() * size.y(), fill)
+    {
+    }
+
+    [[nodiscard]] Vec2<size_t> GetSize() const { return size_; }
+    [[nodiscard]] size_t GetWidth() const { return size_.x(); }
+    [[nodiscard]] size_t GetHeight() const { return size_.y(); }
+
+    [[nodiscard]] Vec4u8& At(size_t x, size_t y) { return pixels_[y * size_.x() + x]; }
+    [[nodiscard]] const Vec4u8& At(size_t x, size_t y) const { return pixels_[y * size_.x() + x]; }
+
+    [[nodiscard]] std::span<Vec4u8> GetPixels() { return pixels_; }
+    [[nodiscard]] std::span<const Vec4u8> GetPixels() const { return pixels_; }
+
+    void Fill(const Vec4u8& color) { std::ranges::fill(pixels_, color); }
+
+private:
+    Vec2<size_t> size_{};
+    std::vector<Vec4u8> pixels_;
+};
+
+}  // namespace klgl
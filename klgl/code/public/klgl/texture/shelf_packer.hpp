@@ -0,0 +1,45 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "EverydayTools/Math/Matrix.hpp"
+
+namespace klgl
+{
+
+using namespace edt::lazy_matrix_aliases;  // NOLINT
+
+// Packs rectangles into an area row by row. Each shelf is a row as high as the first rectangle placed in it;
+// a rectangle goes to the shelf that wastes the least height, or starts a new shelf below the others.
+// Works well for images of similar heights like glyphs and sprites. Space of rectangles is never freed, Clear
+// starts over
+class ShelfPacker
+{
+public:
+    explicit ShelfPacker(const Vec2<size_t>& size);
+
+    // Returns the position of the top left corner or nothing if there is no space left
+    [[nodiscard]] std::optional<Vec2<size_t>> Insert(const Vec2<size_t>& size);
+
+    void Clear();
+
+    [[nodiscard]] Vec2<size_t> GetSize() const { return size_; }
+
+    // Height of the area covered by shelves
+    [[nodiscard]] size_t GetUsedHeight() const { return used_height_; }
+
+private:
+    struct Shelf
+    {
+        size_t y = 0;
+        size_t height = 0;
+        size_t used_width = 0;
+    };
+
+    std::vector<Shelf> shelves_;
+    Vec2<size_t> size_;
+    size_t used_height_ = 0;
+};
+
+}  // namespace klgl
@@ -58,13 +58,28 @@ public:
         );
     }
 
+    // Pixel format known at runtime. Data has to cover the whole texture
+    void SetPixels(const PixelBufferFormat& format, std::span<const uint8_t> data);
+
+    // Updates a region of the texture. Data has to cover the region, rows are tightly packed
+    void SetPixels(
+        const PixelBufferFormat& format,
+        const Vec2<size_t>& offset,
+        const Vec2<size_t>& size,
+        std::span<const uint8_t> data);
+
     Vec2<size_t> GetSize() const { return resolution_; }
     size_t GetWidth() const { return GetSize().x(); }
     size_t GetHeight() const { return GetSize().y(); }
     GlTextureId GetTexture() const { return texture_; }
 
 private:
-    void SetPixels(const PixelBufferFormat& format, std::span<const uint8_t> data);
+    // Pixel data format and type are only used by the bind-to-edit path that allocates mutable storage
+    static std::unique_ptr<Texture> Create(
+        const Vec2<size_t>& resolution,
+        const GlTextureInternalFormat format,
+        const GLint pixel_data_format,
+        const GLenum pixel_data_type);
 
 private:
     GlObject<GlTextureId> texture_;
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <span>
+
+#include "klgl/texture/shelf_packer.hpp"
+
+namespace klgl
+{
+
+class Texture;
+
+// Texture coordinates of an image in the atlas
+struct TextureAtlasRegion
+{
+    Vec2f uv_min{};
+    Vec2f uv_max{};
+};
+
+// RGBA8 texture that keeps many small images, so primitives that use different images can be drawn together.
+// Images are placed by ShelfPacker with a pixel of padding between them and stay until Clear.
+// Rows of image data go from bottom to top like in the rest of textures
+class TextureAtlas
+{
+public:
+    static constexpr size_t kPadding = 1;
+
+    explicit TextureAtlas(const Vec2<size_t>& size);
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Copies the image to free space of the texture. Returns nothing if there is no space left
+    [[nodiscard]] std::optional<TextureAtlasRegion> Add(const Vec2<size_t>& size, std::span<const Vec4u8> pixels);
+
+    // Forgets all images. Regions returned before are overwritten by next additions
+    void Clear() { packer_.Clear(); }
+
+    [[nodiscard]] const Texture& GetTexture() const { return *texture_; }
+
+private:
+    std::unique_ptr<Texture> texture_;
+    ShelfPacker packer_;
+};
+
+}  // namespace klgl
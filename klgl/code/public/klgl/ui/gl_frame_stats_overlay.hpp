@@ -0,0 +1,15 @@
+#pragma once
+
+namespace klgl
+{
+
+// Small ImGui window pinned to the top right corner of the main viewport with counters of the last finished frame
+// from GlFrameStatsRegistry
+class GlFrameStatsOverlay
+{
+public:
+    // Must be called between ImGui::NewFrame and ImGui::Render
+    void Draw();
+};
+
+}  // namespace klgl
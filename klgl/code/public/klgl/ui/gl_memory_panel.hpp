@@ -0,0 +1,25 @@
+#pragma once
+
+#include <optional>
+
+#include "klgl/opengl/debug/gl_memory_tracker.hpp"
+
+namespace klgl
+{
+
+// ImGui table with objects and memory tracked by GlMemoryTracker. A captured baseline adds the difference
+// between the baseline and the current state, which makes growth between two moments easy to spot
+class GlMemoryPanel
+{
+public:
+    // Draws widgets into the current ImGui window
+    void Draw();
+
+    void CaptureBaseline() { baseline_ = GlMemoryTracker::TakeSnapshot(); }
+    void ClearBaseline() { baseline_.reset(); }
+
+private:
+    std::optional<GlMemorySnapshot> baseline_;
+};
+
+}  // namespace klgl
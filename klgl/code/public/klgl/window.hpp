@@ -42,6 +42,11 @@ public:
 
     void SwapBuffers() noexcept;
 
+    // Creates a hidden window with a context that shares objects with this one, so it can load resources on another
+    // thread. Like any GLFW window it has to be created and destroyed on the main thread
+    [[nodiscard]] GLFWwindow* CreateSharedContext() const;
+    static void DestroySharedContext(GLFWwindow* context) noexcept;
+
     bool IsKeyPressed(int key) const;
 
 private:
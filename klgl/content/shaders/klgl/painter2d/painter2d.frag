@@ -1,6 +1,9 @@
 flat in uint gs_type;
 flat in vec4 gs_color;
 in vec2 gs_tex_coord;
+in vec2 gs_atlas_coord;
+
+uniform sampler2D u_atlas;
 
 out vec4 FragColor;
 
@@ -34,6 +37,11 @@ void main()
         FragColor = gs_color;
         break;
 
+    // Sprite tinted by the color
+    case 5u:
+        FragColor = texture(u_atlas, gs_atlas_coord) * gs_color;
+        break;
+
     // Draw yellow grid pattern to show bad area
     default:
         int k = int(gs_tex_coord.x * 10) + int(gs_tex_coord.y * 10);
@@ -2,11 +2,13 @@ in mat3 a_transform;
 in uint a_type;
 in vec4 a_color;
 in vec2 a_params;
+in vec4 a_uv;
 
 out mat3 vs_transform;
 out vec4 vs_color;
 out uint vs_type;
 out vec2 vs_params;
+out vec4 vs_uv;
 
 void main()
 {
@@ -14,4 +16,5 @@ void main()
     vs_color = a_color;
     vs_type = a_type;
     vs_params = a_params;
+    vs_uv = a_uv;
 }
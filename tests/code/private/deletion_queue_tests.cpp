@@ -0,0 +1,92 @@
+#include <array>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/deletion_queue.hpp"
+#include "klgl/opengl/name_pool.hpp"
+#include "klgl/opengl/null_gl_backend.hpp"
+#include "klgl/opengl/object.hpp"
+
+namespace klgl
+{
+
+TEST(GlDeletionQueueTest, FrameEndModeBatchesDeletions)
+{
+    NullGlBackend::Load();
+    GlDeletionQueue::SetMode(GlDeletionMode::FrameEnd);
+
+    std::array<GlObject<GlBufferId>, 3> buffers;
+    for (auto& buffer : buffers) buffer = GlObject<GlBufferId>::CreateFrom(OpenGl::CreateBuffer());
+    const GlBufferId name = buffers[0].GetId();
+    for (auto& buffer : buffers) ASSERT_FALSE(buffer.Reset().has_value());
+
+    // Released objects stay alive until the end of the frame
+    ASSERT_EQ(GlDeletionQueue::GetPendingCount(), 3);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glDeleteBuffers"), 0);
+    OpenGl::NamedBufferData(name, 16, GlUsage::StaticDraw);
+
+    GlDeletionQueue::OnFrameEnd();
+    ASSERT_EQ(GlDeletionQueue::GetPendingCount(), 0);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glDeleteBuffers"), 1);
+    ASSERT_THROW(OpenGl::NamedBufferData(name, 16, GlUsage::StaticDraw), OpenGlError);
+
+    GlDeletionQueue::SetMode(GlDeletionMode::Immediate);
+}
+
+TEST(GlDeletionQueueTest, FenceModeWaitsForFence)
+{
+    NullGlBackend::Load();
+    GlDeletionQueue::SetMode(GlDeletionMode::Fence);
+
+    auto array = GlObject<GlVertexArrayId>::CreateFrom(OpenGl::CreateVertexArray());
+    auto texture = GlObject<GlTextureId>::CreateFrom(OpenGl::GenTexture());
+    ASSERT_FALSE(array.Reset().has_value());
+    ASSERT_FALSE(texture.Reset().has_value());
+    ASSERT_EQ(GlDeletionQueue::GetPendingCount(), 2);
+
+    // Null backend completes commands right away, so the fence is signaled when it is checked
+    GlDeletionQueue::OnFrameEnd();
+    ASSERT_EQ(GlDeletionQueue::GetPendingCount(), 0);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glFenceSync"), 1);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glDeleteVertexArrays"), 1);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glDeleteTextures"), 1);
+
+    // Nothing to fence
+    GlDeletionQueue::OnFrameEnd();
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glFenceSync"), 1);
+
+    GlDeletionQueue::SetMode(GlDeletionMode::Immediate);
+}
+
+TEST(GlDeletionQueueTest, ImmediateModeDeletesRightAway)
+{
+    NullGlBackend::Load();
+    ASSERT_EQ(GlDeletionQueue::GetMode(), GlDeletionMode::Immediate);
+
+    auto buffer = GlObject<GlBufferId>::CreateFrom(OpenGl::CreateBuffer());
+    ASSERT_FALSE(buffer.Reset().has_value());
+    ASSERT_EQ(GlDeletionQueue::GetPendingCount(), 0);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glDeleteBuffers"), 1);
+}
+
+TEST(GlNamePoolTest, GeneratesNamesInBatches)
+{
+    NullGlBackend::Load();
+    GlNamePool::SetBatchSize(4);
+
+    std::array<GlBufferId, 5> buffers;
+    for (auto& buffer : buffers) buffer = GlNamePool::CreateBuffer();
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glCreateBuffers"), 2);
+
+    // Names are unique and given out in the order they were created
+    for (size_t i = 1; i != buffers.size(); ++i) ASSERT_LT(buffers[i - 1].GetValue(), buffers[i].GetValue());
+
+    // Three names left in the pool are deleted with one call
+    GlNamePool::Clear();
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glDeleteBuffers"), 1);
+    OpenGl::DeleteBuffers(buffers);
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0);
+
+    GlNamePool::SetBatchSize(GlNamePool::kDefaultBatchSize);
+}
+
+}  // namespace klgl
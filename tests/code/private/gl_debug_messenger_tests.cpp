@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/debug/gl_debug_messenger.hpp"
+
+namespace klgl
+{
+
+static void SendMessage(GLenum type, GLuint id, std::string_view text)
+{
+    GlDebugMessenger::DebugProc(
+        GL_DEBUG_SOURCE_API,
+        type,
+        id,
+        GL_DEBUG_SEVERITY_HIGH,
+        static_cast<GLsizei>(text.size()),
+        text.data(),
+        nullptr);
+}
+
+TEST(GlDebugMessengerTest, DeduplicatesMessages)
+{
+    GlDebugMessenger::ResetCounters();
+
+    SendMessage(GL_DEBUG_TYPE_PERFORMANCE, 1, "slow path");
+    SendMessage(GL_DEBUG_TYPE_PERFORMANCE, 1, "slow path");
+    SendMessage(GL_DEBUG_TYPE_PERFORMANCE, 1, "slow path");
+    SendMessage(GL_DEBUG_TYPE_PORTABILITY, 1, "not portable");
+
+    std::vector<GlDebugMessenger::Message> messages;
+    GlDebugMessenger::ForEachMessage([&](const GlDebugMessenger::Message& message) { messages.push_back(message); });
+    std::ranges::sort(messages, std::less{}, &GlDebugMessenger::Message::type);
+
+    ASSERT_EQ(messages.size(), 2);
+    ASSERT_EQ(messages[0].type, GL_DEBUG_TYPE_PORTABILITY);
+    ASSERT_EQ(messages[0].count, 1);
+    ASSERT_EQ(messages[1].type, GL_DEBUG_TYPE_PERFORMANCE);
+    ASSERT_EQ(messages[1].count, 3);
+    ASSERT_EQ(messages[1].text, "slow path");
+    ASSERT_EQ(messages[1].severity, GlDebugSeverity::High);
+    ASSERT_EQ(GlDebugMessenger::GetErrorsCount(), 0);
+    ASSERT_FALSE(GlDebugMessenger::TakeNewError().has_value());
+}
+
+TEST(GlDebugMessengerTest, CountsErrors)
+{
+    GlDebugMessenger::ResetCounters();
+
+    SendMessage(GL_DEBUG_TYPE_ERROR, 1280, "invalid enum");
+    SendMessage(GL_DEBUG_TYPE_ERROR, 1280, "invalid enum");
+    ASSERT_EQ(GlDebugMessenger::GetErrorsCount(), 2);
+
+    // Error is taken once, then the next frame starts clean
+    ASSERT_EQ(GlDebugMessenger::TakeNewError(), "invalid enum");
+    ASSERT_FALSE(GlDebugMessenger::TakeNewError().has_value());
+
+    GlDebugMessenger::ResetCounters();
+    ASSERT_EQ(GlDebugMessenger::GetErrorsCount(), 0);
+}
+
+}  // namespace klgl
@@ -0,0 +1,54 @@
+#include <array>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/debug/gl_frame_stats.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/null_gl_backend.hpp"
+
+namespace klgl
+{
+
+TEST(GlFrameStatsTest, CountsCallsThatReachDriver)
+{
+    NullGlBackend::Load();
+
+    const std::array<uint8_t, 64> data{};
+    const GlBufferId buffer = OpenGl::CreateBuffer();
+    OpenGl::NamedBufferData(buffer, std::span<const uint8_t>{data}, GlUsage::StaticDraw);
+    OpenGl::NamedBufferSubData(buffer, 16, std::span<const uint8_t>{data}.first(16));
+
+    // The second bind is skipped by the state cache
+    const GlVertexArrayId vertex_array = OpenGl::CreateVertexArray();
+    OpenGl::BindVertexArray(vertex_array);
+    OpenGl::BindVertexArray(vertex_array);
+
+    OpenGl::DrawArrays(GlPrimitiveType::Triangles, 0, 6);
+    OpenGl::DrawArraysInstanced(GlPrimitiveType::Triangles, 0, 3, 10);
+
+    const GlFrameStats stats = GlFrameStatsRegistry::GetCurrent();
+    ASSERT_EQ(stats.draw_calls, 2);
+    ASSERT_EQ(stats.instances, 11);
+    ASSERT_EQ(stats.vertices, 36);
+    ASSERT_EQ(stats.buffer_upload_bytes, 80);
+    ASSERT_EQ(stats.texture_upload_bytes, 0);
+    ASSERT_EQ(stats.state_changes, 1);
+}
+
+TEST(GlFrameStatsTest, EndFrameKeepsLastFrame)
+{
+    NullGlBackend::Load();
+
+    OpenGl::BindVertexArray(OpenGl::CreateVertexArray());
+    OpenGl::DrawArrays(GlPrimitiveType::Points, 0, 4);
+    GlFrameStatsRegistry::EndFrame();
+
+    ASSERT_EQ(GlFrameStatsRegistry::GetLastFrame().draw_calls, 1);
+    ASSERT_EQ(GlFrameStatsRegistry::GetLastFrame().vertices, 4);
+    ASSERT_EQ(GlFrameStatsRegistry::GetCurrent().draw_calls, 0);
+
+    // Empty frame replaces the previous one
+    GlFrameStatsRegistry::EndFrame();
+    ASSERT_EQ(GlFrameStatsRegistry::GetLastFrame().draw_calls, 0);
+}
+
+}  // namespace klgl
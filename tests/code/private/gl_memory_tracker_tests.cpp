@@ -0,0 +1,139 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/debug/gl_memory_tracker.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/null_gl_backend.hpp"
+
+namespace klgl
+{
+
+TEST(GlMemoryTrackerTest, TracksObjectsAndBytes)
+{
+    GlMemoryTracker::SetEnabled(true);
+    GlMemoryTracker::Reset();
+
+    const std::vector<GLuint> buffers{1, 2};
+    GlMemoryTracker::OnCreated(GlObjectKind::Buffer, buffers);
+    GlMemoryTracker::OnNamedBufferData(1, 100);
+    GlMemoryTracker::OnNamedBufferData(2, 50);
+
+    // Reallocation replaces the data store
+    GlMemoryTracker::OnNamedBufferData(1, 200);
+
+    GlMemorySnapshot snapshot = GlMemoryTracker::TakeSnapshot();
+    ASSERT_EQ(snapshot.Get(GlObjectKind::Buffer).objects, 2);
+    ASSERT_EQ(snapshot.Get(GlObjectKind::Buffer).bytes, 250);
+    ASSERT_EQ(snapshot.Get(GlObjectKind::Buffer).allocated_bytes, 350);
+    ASSERT_EQ(GlMemoryTracker::GetObjectBytes(GlObjectKind::Buffer, 1), 200);
+
+    GlMemoryTracker::OnDeleted(GlObjectKind::Buffer, 1);
+    snapshot = GlMemoryTracker::TakeSnapshot();
+    ASSERT_EQ(snapshot.Get(GlObjectKind::Buffer).objects, 1);
+    ASSERT_EQ(snapshot.Get(GlObjectKind::Buffer).bytes, 50);
+    ASSERT_EQ(snapshot.Get(GlObjectKind::Buffer).created, 2);
+    ASSERT_EQ(snapshot.Get(GlObjectKind::Buffer).deleted, 1);
+    ASSERT_EQ(GlMemoryTracker::GetObjectBytes(GlObjectKind::Buffer, 1), 0);
+
+    // Objects that were not created through the tracker are ignored
+    GlMemoryTracker::OnNamedBufferData(3, 1000);
+    GlMemoryTracker::OnDeleted(GlObjectKind::Buffer, 3);
+    ASSERT_EQ(GlMemoryTracker::TakeSnapshot().total.bytes, 50);
+}
+
+TEST(GlMemoryTrackerTest, EstimatesTextureLevels)
+{
+    GlMemoryTracker::SetEnabled(true);
+    GlMemoryTracker::Reset();
+
+    GlMemoryTracker::OnCreated(GlObjectKind::Texture, 7);
+    GlMemoryTracker::SetTextureLevel(7, 0, GlTextureInternalFormat::RGBA8, 4, 2);
+    ASSERT_EQ(GlMemoryTracker::GetObjectBytes(GlObjectKind::Texture, 7), 32);
+
+    // 2x1 and 1x1 levels
+    GlMemoryTracker::SetTextureLevel(7, 1, GlTextureInternalFormat::RGBA8, 2, 1);
+    GlMemoryTracker::SetTextureLevel(7, 2, GlTextureInternalFormat::RGBA8, 1, 1);
+    ASSERT_EQ(GlMemoryTracker::GetObjectBytes(GlObjectKind::Texture, 7), 44);
+
+    GlMemoryTracker::OnCreated(GlObjectKind::Renderbuffer, 3);
+    GlMemoryTracker::SetRenderbufferSize(3, GlTextureInternalFormat::DEPTH24_STENCIL8, 8, 8);
+    ASSERT_EQ(GlMemoryTracker::GetObjectBytes(GlObjectKind::Renderbuffer, 3), 256);
+
+    const GlMemorySnapshot snapshot = GlMemoryTracker::TakeSnapshot();
+    ASSERT_EQ(snapshot.total.objects, 2);
+    ASSERT_EQ(snapshot.total.bytes, 300);
+}
+
+TEST(GlMemoryTrackerTest, SnapshotDiff)
+{
+    GlMemoryTracker::SetEnabled(true);
+    GlMemoryTracker::Reset();
+
+    GlMemoryTracker::OnCreated(GlObjectKind::Buffer, 1);
+    GlMemoryTracker::OnNamedBufferData(1, 64);
+    const GlMemorySnapshot before = GlMemoryTracker::TakeSnapshot();
+
+    GlMemoryTracker::OnDeleted(GlObjectKind::Buffer, 1);
+    GlMemoryTracker::OnCreated(GlObjectKind::Buffer, 2);
+    GlMemoryTracker::OnCreated(GlObjectKind::Buffer, 3);
+    GlMemoryTracker::OnNamedBufferData(2, 16);
+    GlMemoryTracker::OnCreated(GlObjectKind::Shader, 4);
+
+    const GlMemorySnapshotDiff diff = GlMemoryTracker::TakeSnapshot() - before;
+    ASSERT_EQ(diff.Get(GlObjectKind::Buffer).objects, 1);
+    ASSERT_EQ(diff.Get(GlObjectKind::Buffer).bytes, -48);
+    ASSERT_EQ(diff.Get(GlObjectKind::Buffer).created, 2);
+    ASSERT_EQ(diff.Get(GlObjectKind::Buffer).deleted, 1);
+    ASSERT_EQ(diff.Get(GlObjectKind::Buffer).allocated_bytes, 16);
+    ASSERT_EQ(diff.total.objects, 2);
+
+    size_t visited = 0;
+    GlMemoryTracker::ForEachObject([&](GlObjectKind, GLuint, size_t) { ++visited; });
+    ASSERT_EQ(visited, 3);
+    ASSERT_EQ(GlMemoryTracker::ReportLeaks(), 3);
+
+    GlMemoryTracker::Reset();
+    ASSERT_EQ(GlMemoryTracker::ReportLeaks(), 0);
+}
+
+TEST(GlMemoryTrackerTest, DisabledTrackerIgnoresHooks)
+{
+    GlMemoryTracker::SetEnabled(true);
+    GlMemoryTracker::OnCreated(GlObjectKind::Buffer, 1);
+
+    // Disabling forgets objects, so they are not reported as leaks after tracking is enabled again
+    GlMemoryTracker::SetEnabled(false);
+    ASSERT_EQ(GlMemoryTracker::TakeSnapshot().total.objects, 0);
+
+    GlMemoryTracker::OnCreated(GlObjectKind::Buffer, 2);
+    GlMemoryTracker::OnNamedBufferData(2, 100);
+    ASSERT_EQ(GlMemoryTracker::TakeSnapshot().total.objects, 0);
+
+    GlMemoryTracker::SetEnabled(true);
+    GlMemoryTracker::OnNamedBufferData(2, 100);
+    ASSERT_EQ(GlMemoryTracker::TakeSnapshot().total.bytes, 0);
+}
+
+TEST(GlMemoryTrackerTest, BindToEditHooksUseStateCache)
+{
+    NullGlBackend::Load();
+    GlMemoryTracker::SetEnabled(true);
+
+    const GlBufferId buffer = OpenGl::GenBuffer();
+    OpenGl::BindBuffer(GlBufferType::Array, buffer);
+    OpenGl::BufferData(GlBufferType::Array, 64, GlUsage::StaticDraw);
+    ASSERT_EQ(GlMemoryTracker::GetObjectBytes(GlObjectKind::Buffer, buffer.GetValue()), 64);
+
+    const GlRenderbufferId renderbuffer = OpenGl::GenRenderbuffer();
+    OpenGl::BindRenderbuffer(renderbuffer);
+    OpenGl::RenderbufferStorage(GlTextureInternalFormat::RGBA8, {4, 4});
+    ASSERT_EQ(GlMemoryTracker::GetObjectBytes(GlObjectKind::Renderbuffer, renderbuffer.GetValue()), 64);
+
+    // Bound objects are known without asking OpenGL
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glGetIntegerv"), 0);
+
+    OpenGl::DeleteRenderbuffer(renderbuffer);
+    OpenGl::DeleteBuffer(buffer);
+}
+
+}  // namespace klgl
@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include "klgl/opengl/state_cache.hpp"
+
+namespace klgl
+{
+
+TEST(GlStateCacheTest, SkipsRedundantCalls)
+{
+    GlStateCache cache;
+    ASSERT_TRUE(cache.UseProgram(GlProgramId{1}));
+    ASSERT_FALSE(cache.UseProgram(GlProgramId{1}));
+    ASSERT_TRUE(cache.UseProgram(GlProgramId{2}));
+
+    ASSERT_TRUE(cache.SetBlendingEnabled(true));
+    ASSERT_FALSE(cache.SetBlendingEnabled(true));
+    ASSERT_TRUE(cache.SetBlendingEnabled(false));
+
+    ASSERT_TRUE(cache.SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+    ASSERT_FALSE(cache.SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+
+    ASSERT_EQ(cache.GetCounters().issued, 5);
+    ASSERT_EQ(cache.GetCounters().skipped, 3);
+}
+
+TEST(GlStateCacheTest, BuffersAreTrackedPerTarget)
+{
+    GlStateCache cache;
+    ASSERT_TRUE(cache.BindBuffer(GlBufferType::Array, GlBufferId{1}));
+    ASSERT_TRUE(cache.BindBuffer(GlBufferType::Uniform, GlBufferId{1}));
+    ASSERT_FALSE(cache.BindBuffer(GlBufferType::Array, GlBufferId{1}));
+
+    // Indexed binding changes the generic binding point too
+    cache.OnBufferBoundToIndex(GlBufferType::Uniform, GlBufferId{2});
+    ASSERT_TRUE(cache.BindBuffer(GlBufferType::Uniform, GlBufferId{1}));
+
+    // Element array binding belongs to the vertex array
+    ASSERT_TRUE(cache.BindBuffer(GlBufferType::ElementArray, GlBufferId{3}));
+    ASSERT_TRUE(cache.BindVertexArray(GlVertexArrayId{1}));
+    ASSERT_TRUE(cache.BindBuffer(GlBufferType::ElementArray, GlBufferId{3}));
+
+    // Deleted names may be reused by new objects
+    cache.OnBufferDeleted(GlBufferId{1});
+    ASSERT_TRUE(cache.BindBuffer(GlBufferType::Array, GlBufferId{1}));
+}
+
+TEST(GlStateCacheTest, TexturesAreTrackedPerUnit)
+{
+    GlStateCache cache;
+
+    // Active unit is unknown so the call can not be skipped
+    ASSERT_TRUE(cache.BindTexture(GlTargetTextureType::Texture2d, GlTextureId{1}));
+    ASSERT_TRUE(cache.BindTexture(GlTargetTextureType::Texture2d, GlTextureId{1}));
+
+    ASSERT_TRUE(cache.ActiveTexture(0));
+    ASSERT_TRUE(cache.BindTexture(GlTargetTextureType::Texture2d, GlTextureId{1}));
+    ASSERT_FALSE(cache.BindTexture(GlTargetTextureType::Texture2d, GlTextureId{1}));
+
+    ASSERT_TRUE(cache.ActiveTexture(1));
+    ASSERT_TRUE(cache.BindTexture(GlTargetTextureType::Texture2d, GlTextureId{1}));
+
+    ASSERT_TRUE(cache.ActiveTexture(0));
+    ASSERT_FALSE(cache.BindTexture(GlTargetTextureType::Texture2d, GlTextureId{1}));
+
+    cache.OnTextureDeleted(GlTextureId{1});
+    ASSERT_TRUE(cache.BindTexture(GlTargetTextureType::Texture2d, GlTextureId{1}));
+}
+
+TEST(GlStateCacheTest, Invalidate)
+{
+    GlStateCache cache;
+    const Viewport viewport{.position = {}, .size = {800, 600}};
+    ASSERT_TRUE(cache.SetViewport(viewport));
+    ASSERT_FALSE(cache.SetViewport(viewport));
+    ASSERT_TRUE(cache.SetDepthTestEnabled(true));
+
+    cache.Invalidate();
+    ASSERT_TRUE(cache.SetViewport(viewport));
+    ASSERT_TRUE(cache.SetDepthTestEnabled(true));
+
+    cache.SetEnabled(false);
+    ASSERT_TRUE(cache.SetViewport(viewport));
+    ASSERT_TRUE(cache.SetViewport(viewport));
+}
+
+}  // namespace klgl
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <tuple>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/debug/gl_trace.hpp"
+#include "klgl/opengl/debug/gl_trace_replayer.hpp"
+#include "klgl/opengl/enums.hpp"
+
+namespace klgl
+{
+
+TEST(GlTraceTest, RecordsOnlyWhileStarted)
+{
+    GlTraceRecorder::Record(GlTraceOpcode::Clear, uint32_t{1});
+
+    GlTraceRecorder recorder;
+    recorder.Start();
+    ASSERT_TRUE(recorder.IsRecording());
+    ASSERT_TRUE(GlTraceRecorder::IsActive());
+
+    // Only one recorder may be active on a thread
+    GlTraceRecorder another;
+    ASSERT_ANY_THROW(another.Start());
+
+    GlTraceRecorder::Record(GlTraceOpcode::Clear, uint32_t{2});
+    const GlTrace trace = recorder.Stop();
+    ASSERT_FALSE(GlTraceRecorder::IsActive());
+
+    GlTraceRecorder::Record(GlTraceOpcode::Clear, uint32_t{3});
+
+    size_t calls = 0;
+    trace.ForEachCall(
+        [&](const GlTrace::Call& call)
+        {
+            ASSERT_EQ(call.opcode, GlTraceOpcode::Clear);
+            GlTrace::ArgsReader args(call.args);
+            ASSERT_EQ(args.Read<uint32_t>(), 2);
+            ++calls;
+        });
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(GlTraceTest, ArgumentsAndData)
+{
+    GlTraceRecorder recorder;
+    recorder.Start();
+
+    const std::array<float, 3> values{1.f, 2.f, 3.f};
+    GlTraceRecorder::RecordWithData(
+        GlTraceOpcode::SetUniformFloat,
+        std::span<const float>{values},
+        uint32_t{7},
+        false);
+    const GlTrace trace = recorder.Stop();
+
+    trace.ForEachCall(
+        [&](const GlTrace::Call& call)
+        {
+            ASSERT_EQ(call.opcode, GlTraceOpcode::SetUniformFloat);
+            GlTrace::ArgsReader args(call.args);
+            ASSERT_EQ(args.Read<uint32_t>(), 7);
+            ASSERT_EQ(args.Read<bool>(), false);
+            ASSERT_ANY_THROW(std::ignore = args.Read<uint8_t>());
+
+            ASSERT_EQ(call.data.size(), sizeof(values));
+            std::array<float, 3> read{};
+            std::memcpy(read.data(), call.data.data(), sizeof(read));
+            ASSERT_EQ(read, values);
+        });
+}
+
+TEST(GlTraceTest, CountingBackend)
+{
+    GlTraceRecorder recorder;
+    recorder.Start();
+    for (size_t frame = 0; frame != 2; ++frame)
+    {
+        const std::array<uint8_t, 16> vertices{};
+        GlTraceRecorder::RecordWithData(GlTraceOpcode::BufferSubData, vertices, GlBufferType::Array, size_t{0});
+        GlTraceRecorder::Record(GlTraceOpcode::DrawArrays, GlPrimitiveType::Triangles, size_t{0}, size_t{3});
+        GlTraceRecorder::Record(GlTraceOpcode::DrawArrays, GlPrimitiveType::Triangles, size_t{3}, size_t{3});
+        GlTraceRecorder::Record(GlTraceOpcode::FrameEnd);
+    }
+
+    const GlTraceStats stats = GlTraceReplayer::Count(recorder.Stop());
+    ASSERT_EQ(stats.calls, 8);
+    ASSERT_EQ(stats.frames, 2);
+    ASSERT_EQ(stats.draw_calls, 4);
+    ASSERT_EQ(stats.data_bytes, 32);
+    ASSERT_EQ(stats.GetCallsCount(GlTraceOpcode::BufferSubData), 2);
+    ASSERT_EQ(stats.GetCallsCount(GlTraceOpcode::UseProgram), 0);
+}
+
+TEST(GlTraceTest, SaveAndLoad)
+{
+    GlTraceRecorder recorder;
+    recorder.Start();
+    GlTraceRecorder::Record(GlTraceOpcode::Clear, uint32_t{42});
+    GlTraceRecorder::Record(GlTraceOpcode::FrameEnd);
+    const GlTrace trace = recorder.Stop();
+
+    const auto path = std::filesystem::temp_directory_path() / "klgl_gl_trace_test.bin";
+    trace.SaveToFile(path);
+    const GlTrace loaded = GlTrace::LoadFromFile(path);
+    std::filesystem::remove(path);
+
+    ASSERT_TRUE(std::ranges::equal(trace.GetBytes(), loaded.GetBytes()));
+}
+
+}  // namespace klgl
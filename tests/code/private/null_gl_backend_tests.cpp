@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <ranges>
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/null_gl_backend.hpp"
+#include "klgl/opengl/program_info.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+GlShaderId MakeShader(GlShaderType type, std::string_view source)
+{
+    const GlShaderId shader = OpenGl::CreateShader(type);
+    OpenGl::ShaderSource(shader, std::array{source});
+    OpenGl::CompileShader(shader);
+    EXPECT_TRUE(OpenGl::GetShaderCompileStatus(shader));
+    return shader;
+}
+
+GlProgramId MakeProgram(std::string_view vertex_source, std::string_view fragment_source)
+{
+    const GlProgramId program = OpenGl::CreateProgram();
+    OpenGl::AttachShader(program, MakeShader(GlShaderType::Vertex, vertex_source));
+    OpenGl::AttachShader(program, MakeShader(GlShaderType::Fragment, fragment_source));
+    OpenGl::LinkProgram(program);
+    EXPECT_TRUE(OpenGl::GetProgramLinkStatus(program));
+    return program;
+}
+}  // namespace
+
+TEST(NullGlBackendTest, KeepsBufferContents)
+{
+    NullGlBackend::Load();
+    ASSERT_TRUE(OpenGl::HasDirectStateAccess());
+
+    const std::array<uint8_t, 6> data{1, 2, 3, 4, 5, 6};
+    const GlBufferId buffer = OpenGl::CreateBuffer();
+    OpenGl::NamedBufferData(buffer, std::span<const uint8_t>{data}, GlUsage::StaticDraw);
+
+    ASSERT_TRUE(std::ranges::equal(NullGlBackend::GetBufferData(buffer.GetValue()), data));
+    ASSERT_EQ(NullGlBackend::GetStats().uploaded_bytes, data.size());
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glNamedBufferData"), 1);
+
+    OpenGl::DeleteBuffer(buffer);
+    ASSERT_TRUE(NullGlBackend::GetBufferData(buffer.GetValue()).empty());
+}
+
+TEST(NullGlBackendTest, ReportsInvalidCalls)
+{
+    NullGlBackend::Load();
+
+    // Nothing is bound to the target
+    ASSERT_THROW(OpenGl::BufferData(GlBufferType::Array, 16, GlUsage::StaticDraw), OpenGlError);
+    ASSERT_FALSE(NullGlBackend::GetLastErrorMessage().empty());
+
+    // Draw calls require a vertex array
+    ASSERT_THROW(OpenGl::DrawArrays(GlPrimitiveType::Triangles, 0, 3), OpenGlError);
+
+    const GlVertexArrayId vertex_array = OpenGl::GenVertexArray();
+    OpenGl::BindVertexArray(vertex_array);
+    OpenGl::DrawArrays(GlPrimitiveType::Triangles, 0, 3);
+
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 2);
+    ASSERT_EQ(NullGlBackend::GetStats().draw_calls, 1);
+    ASSERT_EQ(NullGlBackend::GetStats().vertices, 3);
+}
+
+TEST(NullGlBackendTest, FrameErrorsInvalidateStateCache)
+{
+    for (const GlErrorCheckMode mode : {GlErrorCheckMode::PerCall, GlErrorCheckMode::PerFrame})
+    {
+        NullGlBackend::Load();
+        OpenGl::SetErrorCheckMode(mode);
+
+        // Program does not exist, but the cache remembers it as current
+        OpenGl::UseProgramNE(GlProgramId{42});
+        if (mode == GlErrorCheckMode::PerFrame)
+        {
+            ASSERT_THROW(OpenGl::CheckFrameErrors(), OpenGlError);
+        }
+        else
+        {
+            OpenGl::CheckFrameErrors();
+        }
+
+        ASSERT_EQ(OpenGl::GetError(), GlError::NoError);
+
+        NullGlBackend::ResetStats();
+        OpenGl::UseProgramNE(GlProgramId{42});
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glUseProgram"), 1);
+        ASSERT_NE(OpenGl::GetError(), GlError::NoError);
+    }
+
+    // Off mode does not poll errors
+    NullGlBackend::Load();
+    OpenGl::SetErrorCheckMode(GlErrorCheckMode::Off);
+    OpenGl::UseProgramNE(GlProgramId{42});
+    NullGlBackend::ResetStats();
+    OpenGl::CheckFrameErrors();
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glGetError"), 0);
+    ASSERT_NE(OpenGl::GetError(), GlError::NoError);
+
+    OpenGl::SetErrorCheckMode(GlErrorCheckMode::PerCall);
+}
+
+TEST(NullGlBackendTest, IntrospectsShaderSources)
+{
+    NullGlBackend::Load();
+
+    const GlProgramId program = MakeProgram(
+        R"(
+        #version 330 core
+        layout(location = 1) in vec2 a_position;
+        uniform vec3 u_color;
+        uniform float u_weights[4];
+        void main() { gl_Position = vec4(a_position, 0.0, 1.0); }
+        )",
+        R"(
+        #version 330 core
+        uniform vec3 u_color;
+        uniform sampler2D u_texture;
+        out vec4 out_color;
+        void main() { out_color = vec4(u_color, 1.0); }
+        )");
+
+    GlProgramInfo info;
+    info.FetchVertexAttributes(program);
+    info.FetchUniforms(program);
+
+    ASSERT_EQ(info.vertex_attributes.size(), 1);
+    ASSERT_EQ(info.vertex_attributes[0].location, 1);
+    ASSERT_EQ(info.vertex_attributes[0].type, GlVertexAttributeType::FloatVec2);
+
+    // Uniforms used by several stages are reported once. Arrays take a location per element
+    ASSERT_EQ(info.uniforms.size(), 3);
+    ASSERT_EQ(info.uniforms[0].name, "u_color");
+    ASSERT_EQ(info.uniforms[0].type, GlUniformType::FloatVec3);
+    ASSERT_EQ(info.uniforms[1].name, "u_weights[0]");
+    ASSERT_EQ(info.uniforms[1].size, 4);
+    ASSERT_EQ(info.uniforms[2].location, 5);
+
+    OpenGl::UseProgram(program);
+    OpenGl::SetUniform(0, Vec3f{1, 2, 3});
+    const std::array<float, 3> expected{1, 2, 3};
+    const auto value = NullGlBackend::GetUniformValue(program.GetValue(), 0);
+    ASSERT_EQ(value.size(), sizeof(expected));
+    ASSERT_EQ(std::memcmp(value.data(), expected.data(), value.size()), 0);
+
+    // Type must match the declaration
+    ASSERT_THROW(OpenGl::SetUniform(0, int32_t{1}), OpenGlError);
+    OpenGl::SetUniform(5, int32_t{1});
+}
+
+TEST(NullGlBackendTest, VersionSelectsCodePaths)
+{
+    NullGlBackend::Load({.major_version = 3, .minor_version = 3});
+    ASSERT_FALSE(OpenGl::HasDirectStateAccess());
+
+    // Bind-to-edit path works the same way
+    const GlBufferId buffer = OpenGl::GenBuffer();
+    OpenGl::BindBuffer(GlBufferType::Array, buffer);
+    OpenGl::BufferData(GlBufferType::Array, 16, GlUsage::DynamicDraw);
+    ASSERT_EQ(NullGlBackend::GetBufferData(buffer.GetValue()).size(), 16);
+
+    NullGlBackend::Load();
+    ASSERT_TRUE(OpenGl::HasDirectStateAccess());
+}
+
+}  // namespace klgl
@@ -0,0 +1,190 @@
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "EverydayTools/Math/Math.hpp"
+#include "gtest/gtest.h"
+#include "klgl/rendering/painter2d.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+Painter2d::Rect2d MakeRect(float x)
+{
+    return {.center = {x, 0.f}, .size = {2.f, 2.f}};
+}
+
+// Member by member, so padding bytes do not take part
+template <typename T>
+bool SameBytes(const T& a, const T& b)
+{
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+bool SameInstance(const Painter2d::Instance& a, const Painter2d::Instance& b)
+{
+    return SameBytes(a.transform, b.transform) && SameBytes(a.params, b.params) && SameBytes(a.uv, b.uv) &&
+           SameBytes(a.color, b.color) && a.type == b.type;
+}
+
+// Applies the transform of the instance to a point of the [-1, 1] square
+Vec2f TransformPoint(const Painter2d::Instance& instance, const Vec2f& p)
+{
+    // Transform is stored transposed
+    const Mat3f& t = instance.transform;
+    return {
+        t(0, 0) * p.x() + t(1, 0) * p.y() + t(2, 0),
+        t(0, 1) * p.x() + t(1, 1) * p.y() + t(2, 1),
+    };
+}
+}  // namespace
+
+TEST(Painter2dCommandListTest, RecordsPrimitivesInOrder)
+{
+    Painter2d::CommandList list;
+    list.FillRect(MakeRect(3.f));
+    list.FillCircle({.center = {}, .size = {1.f, 1.f}});
+    list.RectLines(MakeRect(0.f), {.inner = 0.1f, .outer = 0.2f});
+
+    const auto instances = list.GetInstances();
+    ASSERT_EQ(instances.size(), 3);
+    ASSERT_EQ(instances[0].type, 0);
+    ASSERT_EQ(instances[1].type, 1);
+    ASSERT_EQ(instances[2].type, 3);
+    ASSERT_FLOAT_EQ(instances[2].params.y(), 0.2f);
+
+    // Transform is stored transposed, so translation is in the last row
+    ASSERT_FLOAT_EQ(instances[0].transform(2, 0), 3.f);
+
+    list.Clear();
+    ASSERT_TRUE(list.IsEmpty());
+}
+
+TEST(Painter2dCommandListTest, AppendKeepsListOrder)
+{
+    constexpr size_t kThreads = 4;
+    constexpr size_t kPerThread = 1000;
+
+    std::vector<Painter2d::CommandList> lists(kThreads);
+    std::vector<std::thread> threads;
+    for (size_t thread_index = 0; thread_index != kThreads; ++thread_index)
+    {
+        threads.emplace_back(
+            [&list = lists[thread_index], thread_index]
+            {
+                for (size_t i = 0; i != kPerThread; ++i)
+                {
+                    list.FillRect(MakeRect(static_cast<float>(thread_index * kPerThread + i)));
+                }
+            });
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    Painter2d::CommandList merged;
+    for (const auto& list : lists) merged.Append(list);
+
+    const auto instances = merged.GetInstances();
+    ASSERT_EQ(instances.size(), kThreads * kPerThread);
+    for (size_t i = 0; i != instances.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(instances[i].transform(2, 0), static_cast<float>(i));
+    }
+
+    // Appending to itself duplicates the contents
+    merged.Append(merged);
+    ASSERT_EQ(merged.GetSize(), 2 * kThreads * kPerThread);
+    ASSERT_FLOAT_EQ(merged.GetInstances().back().transform(2, 0), static_cast<float>(kThreads * kPerThread - 1));
+}
+
+TEST(Painter2dCommandListTest, CullRemovesPrimitivesOutsideOfView)
+{
+    Painter2d::CommandList list;
+    list.FillRect(MakeRect(0.f));
+    list.FillRect(MakeRect(5.f));
+    list.FillRect(MakeRect(1.9f));  // Partially visible
+    list.FillCircle({.center = {-5.f, 0.f}, .size = {1.f, 1.f}});
+    list.RectLines(MakeRect(5.f), {.inner = 0.1f, .outer = 0.1f});
+
+    // Identity view: clip space is [-1, 1]
+    Painter2d::CommandList identity = list;
+    ASSERT_EQ(identity.Cull(Mat3f::Identity()), 2);
+    ASSERT_EQ(identity.GetSize(), 3);
+    ASSERT_FLOAT_EQ(identity.GetInstances()[1].transform(2, 0), 1.9f);
+    ASSERT_EQ(identity.GetInstances()[2].type, 3);
+
+    // View moves x = 5 to the center. Translation is in the last row because the view matrix is transposed
+    Mat3f view = Mat3f::Identity();
+    view(2, 0) = -5.f;
+    Painter2d::CommandList moved = list;
+    ASSERT_EQ(moved.Cull(view), 3);
+    ASSERT_EQ(moved.GetSize(), 2);
+    ASSERT_FLOAT_EQ(moved.GetInstances()[0].transform(2, 0), 5.f);
+}
+
+TEST(Painter2dCommandListTest, BulkFunctionsMatchSingleOnes)
+{
+    std::vector<Painter2d::Rect2d> rects;
+    std::vector<Painter2d::Line2d> lines;
+    for (size_t i = 0; i != 10; ++i)
+    {
+        const float x = static_cast<float>(i);
+        rects.push_back({.center = {x, -x}, .size = {1.f, x + 1.f}, .rotation_degrees = x * 30.f});
+        lines.push_back({.a = {x, 0.f}, .b = {0.f, x + 1.f}});
+    }
+
+    Painter2d::CommandList single;
+    for (const auto& rect : rects) single.FillRect(rect);
+    for (const auto& line : lines) single.DrawLine(line);
+    ASSERT_EQ(single.GetSize(), rects.size() + lines.size());
+
+    Painter2d::CommandList bulk;
+    bulk.FillRects(rects);
+    bulk.DrawLines(lines);
+
+    ASSERT_EQ(bulk.GetSize(), single.GetSize());
+    for (size_t i = 0; i != bulk.GetSize(); ++i)
+    {
+        ASSERT_TRUE(SameInstance(bulk.GetInstances()[i], single.GetInstances()[i])) << "instance " << i;
+    }
+
+    // Rect transform is translation * rotation * scale
+    const auto& rect = rects[3];
+    const Mat3f expected = edt::Math::TranslationMatrix(rect.center)
+                               .MatMul(edt::Math::RotationMatrix2d(edt::Math::DegToRad(rect.rotation_degrees)))
+                               .MatMul(edt::Math::ScaleMatrix(rect.size / 2.f));
+    for (size_t row = 0; row != 3; ++row)
+    {
+        for (size_t column = 0; column != 3; ++column)
+        {
+            ASSERT_NEAR(bulk.GetInstances()[3].transform(column, row), expected(row, column), 1e-5f);
+        }
+    }
+
+    // Line is a rect from a to b, 2 * width thick. Checked through points it maps the square to, so the expectation
+    // does not repeat how the transform is built
+    for (size_t i = 0; i != lines.size(); ++i)
+    {
+        const Painter2d::Line2d& line = lines[i];
+        const Painter2d::Instance& instance = bulk.GetInstances()[rects.size() + i];
+        ASSERT_EQ(instance.type, 0);  // Drawn as a filled rect
+
+        const Vec2f a = TransformPoint(instance, {-1.f, 0.f});
+        const Vec2f b = TransformPoint(instance, {1.f, 0.f});
+        ASSERT_NEAR(a.x(), line.a.x(), 1e-5f);
+        ASSERT_NEAR(a.y(), line.a.y(), 1e-5f);
+        ASSERT_NEAR(b.x(), line.b.x(), 1e-5f);
+        ASSERT_NEAR(b.y(), line.b.y(), 1e-5f);
+
+        const Vec2f center = (line.a + line.b) / 2.f;
+        const Vec2f side = TransformPoint(instance, {0.f, 1.f}) - center;
+        const Vec2f ab = line.b - line.a;
+        ASSERT_NEAR(side.x() * ab.x() + side.y() * ab.y(), 0.f, 1e-5f);
+        ASSERT_NEAR(std::sqrt(side.x() * side.x() + side.y() * side.y()), line.width, 1e-5f);
+    }
+}
+
+}  // namespace klgl
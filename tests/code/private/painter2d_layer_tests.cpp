@@ -0,0 +1,77 @@
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "klgl/error_handling.hpp"
+#include "klgl/opengl/null_gl_backend.hpp"
+#include "klgl/rendering/painter2d_layer.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+Painter2d::Rect2d MakeRect(float x)
+{
+    return {.center = {x, 0.f}, .size = {2.f, 2.f}};
+}
+
+Painter2d::Instance ReadInstance(const Painter2dLayer& layer, size_t slot)
+{
+    const auto data = NullGlBackend::GetBufferData(layer.GetBuffer().GetValue());
+    Painter2d::Instance instance;
+    std::memcpy(&instance, data.data() + slot * sizeof(instance), sizeof(instance));
+    return instance;
+}
+}  // namespace
+
+TEST(Painter2dLayerTest, UploadsOnlyChangedSlots)
+{
+    NullGlBackend::Load();
+
+    Painter2dLayer layer;
+    layer.AddRect(MakeRect(0.f));
+    const auto handle = layer.AddRect(MakeRect(1.f));
+    layer.AddCircle({.center = {2.f, 0.f}, .size = {1.f, 1.f}});
+    ASSERT_TRUE(layer.HasChanges());
+
+    NullGlBackend::ResetStats();
+    layer.Upload();
+    ASSERT_FALSE(layer.HasChanges());
+    ASSERT_EQ(NullGlBackend::GetStats().uploaded_bytes, 3 * sizeof(Painter2d::Instance));
+    ASSERT_FLOAT_EQ(ReadInstance(layer, 2).transform(2, 0), 2.f);
+
+    // Nothing changed
+    NullGlBackend::ResetStats();
+    layer.Upload();
+    ASSERT_EQ(NullGlBackend::GetStats().uploaded_bytes, 0);
+
+    layer.Update(handle, MakeRect(5.f));
+    layer.Upload();
+    ASSERT_EQ(NullGlBackend::GetStats().uploaded_bytes, sizeof(Painter2d::Instance));
+    ASSERT_FLOAT_EQ(ReadInstance(layer, 1).transform(2, 0), 5.f);
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0);
+}
+
+TEST(Painter2dLayerTest, RemovedSlotsAreReused)
+{
+    Painter2dLayer layer;
+    const auto a = layer.AddRect(MakeRect(0.f));
+    const auto b = layer.AddRect(MakeRect(1.f));
+    layer.Remove(a);
+
+    ASSERT_FALSE(layer.Contains(a));
+    ASSERT_TRUE(layer.Contains(b));
+    ASSERT_EQ(layer.GetSize(), 1);
+    ASSERT_EQ(layer.GetSlotsCount(), 2);
+    ASSERT_THROW(layer.Update(a, MakeRect(2.f)), cpptrace::runtime_error);
+    ASSERT_THROW(layer.Remove(a), cpptrace::runtime_error);
+
+    // The new primitive takes the slot but the old handle stays invalid
+    const auto c = layer.AddRect(MakeRect(2.f));
+    ASSERT_EQ(c.slot, a.slot);
+    ASSERT_FALSE(layer.Contains(a));
+    ASSERT_TRUE(layer.Contains(c));
+    ASSERT_EQ(layer.GetSlotsCount(), 2);
+}
+
+}  // namespace klgl
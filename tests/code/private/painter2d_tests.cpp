@@ -0,0 +1,200 @@
+#include <array>
+#include <cstring>
+#include <optional>
+#include <tuple>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/debug/gl_trace.hpp"
+#include "klgl/opengl/debug/gl_trace_replayer.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/null_gl_backend.hpp"
+#include "klgl/platform/os/os.hpp"
+#include "klgl/reflection/register_types.hpp"
+#include "klgl/rendering/painter2d.hpp"
+#include "klgl/shader/shader.hpp"
+#include "klgl/texture/texture.hpp"
+#include "klgl/texture/texture_atlas.hpp"
+
+namespace klgl
+{
+
+class Painter2dTest : public ::testing::TestWithParam<NullGlSettings>
+{
+protected:
+    void SetUp() override
+    {
+        RegisterReflectionTypes();
+        NullGlBackend::Load(GetParam());
+
+        // Content of klgl is copied next to executables
+        Shader::shaders_dir_ = os::GetExecutableDir() / "content" / "shaders";
+    }
+};
+
+TEST_P(Painter2dTest, DrawsSessions)
+{
+    Painter2d painter;
+    painter.SetViewMatrix(Mat3f::Identity());
+    NullGlBackend::ResetStats();
+
+    painter.BeginDraw();
+    painter.FillRect({.center = {}, .size = {1.f, 1.f}});
+    painter.FillCircle({.center = {0.5f, 0.f}, .size = {0.5f, 0.5f}});
+    painter.DrawLine({.a = {-1.f, -1.f}, .b = {1.f, 1.f}});
+    painter.EndDraw();
+
+    // One point per primitive, expanded by the geometry shader
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+    ASSERT_EQ(NullGlBackend::GetStats().draw_calls, 1);
+    ASSERT_EQ(NullGlBackend::GetStats().vertices, 3);
+
+    // Empty session does not draw
+    painter.BeginDraw();
+    painter.EndDraw();
+    ASSERT_EQ(NullGlBackend::GetStats().draw_calls, 1);
+
+    painter.BeginDraw();
+    painter.FillTriangle({.a = {0.f, 0.f}, .b = {1.f, 0.f}, .c = {0.f, 1.f}});
+    painter.EndDraw();
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+    ASSERT_EQ(NullGlBackend::GetStats().draw_calls, 2);
+    ASSERT_EQ(NullGlBackend::GetStats().vertices, 4);
+
+    ASSERT_ANY_THROW(painter.EndDraw());
+}
+
+TEST_P(Painter2dTest, MovesToNextRegionOnlyInNextFrame)
+{
+    Painter2d painter;
+
+    // Regions of the instance buffer are fenced only when it is persistently mapped
+    const bool persistent = GetParam().major_version > 4 || GetParam().minor_version >= 4;
+    const size_t fences_per_frame = persistent ? 1 : 0;
+
+    // Sessions of the frame are placed in one region of the instance buffer, so they do not fence
+    const size_t fences_before = NullGlBackend::GetCallsCount("glFenceSync");
+    painter.NextFrame();
+    for (size_t session = 0; session != 3; ++session)
+    {
+        painter.BeginDraw();
+        painter.FillRect({.center = {}, .size = {1.f, 1.f}});
+        painter.EndDraw();
+    }
+
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glFenceSync") - fences_before, fences_per_frame);
+
+    painter.NextFrame();
+    painter.BeginDraw();
+    painter.FillRect({.center = {}, .size = {1.f, 1.f}});
+    ASSERT_ANY_THROW(painter.NextFrame());
+    painter.EndDraw();
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glFenceSync") - fences_before, 2 * fences_per_frame);
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+}
+
+TEST_P(Painter2dTest, UploadsSubmittedListsInOrder)
+{
+    Painter2d painter;
+    painter.SetCullingEnabled(true);
+
+    Painter2d::CommandList first;
+    first.FillRect({.center = {0.1f, 0.f}, .size = {0.1f, 0.1f}});
+    first.FillRect({.center = {5.f, 0.f}, .size = {0.1f, 0.1f}});
+    std::array<Painter2d::CommandList, 2> lists;
+    lists[1].FillCircle({.center = {0.3f, 0.f}, .size = {0.1f, 0.1f}});
+
+    painter.BeginDraw();
+    painter.FillTriangle({.a = {0.f, 0.f}, .b = {0.1f, 0.f}, .c = {0.f, 0.1f}});
+    painter.Submit(first);
+    painter.FillRect({.center = {0.2f, 0.f}, .size = {0.1f, 0.1f}});
+    painter.Submit(lists);
+    painter.EndDraw();
+
+    // Lists are culled on the way to the instance buffer and keep their primitives
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+    ASSERT_EQ(painter.GetCulledCount(), 1);
+    ASSERT_EQ(NullGlBackend::GetStats().vertices, 4);
+    ASSERT_EQ(first.GetSize(), 2);
+
+    // Bind-to-edit path leaves the instance buffer bound
+    if (OpenGl::HasDirectStateAccess()) return;
+    GLint buffer = 0;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &buffer);
+    const auto data = NullGlBackend::GetBufferData(static_cast<GLuint>(buffer));
+    ASSERT_GE(data.size(), 4 * sizeof(Painter2d::Instance));
+
+    // The first session of the frame starts at the beginning of the region
+    const std::array<float, 4> expected_x{0.05f, 0.1f, 0.2f, 0.3f};
+    for (size_t i = 0; i != expected_x.size(); ++i)
+    {
+        Painter2d::Instance instance;
+        std::memcpy(&instance, data.data() + i * sizeof(instance), sizeof(instance));
+        ASSERT_FLOAT_EQ(instance.transform(2, 0), expected_x[i]);
+    }
+}
+
+TEST_P(Painter2dTest, TraceKeepsAtlasSampler)
+{
+    TextureAtlas atlas({16, 16});
+    const std::array<Vec4u8, 4> pixels{};
+    const auto region = atlas.Add({2, 2}, pixels);
+    ASSERT_TRUE(region.has_value());
+
+    Painter2d painter;
+    painter.SetTextureAtlas(&atlas);
+
+    // Replay starts from unknown state, so the trace must have every binding the draw depends on
+    OpenGl::InvalidateStateCache();
+    NullGlBackend::ResetStats();
+    GlTraceRecorder recorder;
+    recorder.Start();
+    painter.BeginDraw();
+    painter.DrawSprite({.center = {}, .size = {1.f, 1.f}}, *region);
+    painter.EndDraw();
+    const GlTrace trace = recorder.Stop();
+
+    const GlTraceStats stats = GlTraceReplayer::Count(trace);
+    ASSERT_EQ(stats.draw_calls, 1);
+    ASSERT_EQ(stats.GetCallsCount(GlTraceOpcode::SetUniformInt), NullGlBackend::GetCallsCount("glUniform1i"));
+    ASSERT_EQ(stats.GetCallsCount(GlTraceOpcode::SetUniformInt), 1);
+
+    // The sampler is set to the unit the atlas texture is bound to
+    std::optional<uint32_t> active_unit;
+    std::optional<uint32_t> atlas_unit;
+    std::optional<int32_t> sampler_value;
+    trace.ForEachCall(
+        [&](const GlTrace::Call& call)
+        {
+            GlTrace::ArgsReader args(call.args);
+            if (call.opcode == GlTraceOpcode::ActiveTexture)
+            {
+                active_unit = args.Read<uint32_t>();
+            }
+            else if (call.opcode == GlTraceOpcode::BindTexture)
+            {
+                std::ignore = args.Read<GlTargetTextureType>();
+                if (args.Read<GLuint>() == atlas.GetTexture().GetTexture().GetValue()) atlas_unit = active_unit;
+            }
+            else if (call.opcode == GlTraceOpcode::SetUniformInt)
+            {
+                ASSERT_EQ(call.data.size(), sizeof(int32_t));
+                sampler_value.emplace();
+                std::memcpy(&*sampler_value, call.data.data(), sizeof(int32_t));
+            }
+        });
+
+    ASSERT_TRUE(atlas_unit.has_value());
+    ASSERT_TRUE(sampler_value.has_value());
+    ASSERT_EQ(*sampler_value, static_cast<int32_t>(*atlas_unit));
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+}
+
+// Direct state access and persistent mapping in 4.6, bind-to-edit and orphaning in 3.3
+INSTANTIATE_TEST_SUITE_P(
+    NullGlVersions,
+    Painter2dTest,
+    ::testing::Values(
+        NullGlSettings{.major_version = 4, .minor_version = 6},
+        NullGlSettings{.major_version = 3, .minor_version = 3}));
+
+}  // namespace klgl
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+
+#include "gtest/gtest.h"
+#include "klgl/mesh/mesh_data.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/null_gl_backend.hpp"
+#include "klgl/rendering/resource_uploader.hpp"
+#include "klgl/texture/texture.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+GLint GetBinding(GLenum query)
+{
+    GLint value = -1;
+    glGetIntegerv(query, &value);
+    return value;
+}
+
+template <typename T>
+T TakeUpload(UploadHandle<T> handle)
+{
+    handle.Wait();
+    return handle.Take();
+}
+}  // namespace
+
+TEST(ResourceUploaderTest, BindToEditUploadsLeaveNothingBound)
+{
+    // Bind-to-edit path. Null backend does not need a context, and the main thread makes no calls during uploads
+    NullGlBackend::Load({.major_version = 3, .minor_version = 3});
+
+    const std::array<float, 6> vertices{0.f, 0.f, 1.f, 0.f, 0.f, 1.f};
+    const std::array<uint32_t, 3> indices{0, 1, 2};
+    const auto vertex_bytes = std::as_bytes(std::span{vertices});
+    const auto index_bytes = std::as_bytes(std::span{indices});
+
+    {
+        ResourceUploader uploader(nullptr);
+
+        MeshUpload upload;
+        upload.vertices.resize(vertex_bytes.size());
+        std::memcpy(upload.vertices.data(), vertex_bytes.data(), vertex_bytes.size());
+        upload.indices.assign(indices.begin(), indices.end());
+
+        auto first = TakeUpload(uploader.UploadMesh(upload));
+        ASSERT_EQ(GetBinding(GL_COPY_WRITE_BUFFER_BINDING), 0);
+
+        // Buffers bound by the loader can be deleted by the main thread. The next upload must not rely on bindings
+        // remembered by the loader thread
+        first.reset();
+        NullGlBackend::ResetStats();
+        auto second = TakeUpload(uploader.UploadMesh(upload));
+        ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+        ASSERT_EQ(GetBinding(GL_COPY_WRITE_BUFFER_BINDING), 0);
+
+        const auto vbo_data = NullGlBackend::GetBufferData(second->vbo.GetId().GetValue());
+        const auto ebo_data = NullGlBackend::GetBufferData(second->ebo.GetId().GetValue());
+        ASSERT_TRUE(std::ranges::equal(std::as_bytes(vbo_data), vertex_bytes));
+        ASSERT_TRUE(std::ranges::equal(std::as_bytes(ebo_data), index_bytes));
+
+        // Vertex array is created by the main thread when the result is taken
+        ASSERT_TRUE(second->vao.IsValid());
+
+        auto texture = TakeUpload(uploader.UploadTexture({.resolution = {4, 4}}));
+        ASSERT_EQ(texture->GetSize(), (Vec2<size_t>{4, 4}));
+        ASSERT_EQ(GetBinding(GL_TEXTURE_BINDING_2D), 0);
+        ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+    }
+}
+
+}  // namespace klgl
@@ -0,0 +1,114 @@
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "klgl/filesystem/filesystem.hpp"
+#include "klgl/shader/shader_source_cache.hpp"
+
+namespace klgl
+{
+
+class ShaderSourceCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        root_ = std::filesystem::temp_directory_path() / "klgl_shader_source_cache_tests";
+        std::filesystem::remove_all(root_);
+        std::filesystem::create_directories(root_ / "shader");
+        std::filesystem::create_directories(root_ / "common");
+    }
+
+    void TearDown() override { std::filesystem::remove_all(root_); }
+
+    void Write(const std::filesystem::path& relative_path, std::string_view content) const
+    {
+        Filesystem::WriteFile(root_ / relative_path, content);
+    }
+
+    std::filesystem::path root_;
+};
+
+TEST_F(ShaderSourceCacheTest, ExpandsIncludes)
+{
+    Write("common/a.glsl", "float a() { return 1.0; }\n");
+    Write("shader/b.glsl", "#include \"../common/a.glsl\"\nfloat b() { return a(); }\n");
+    Write("shader/shader.frag", "#include \"b.glsl\"\n  #  include \"common/a.glsl\"\nvoid main() {}\n");
+
+    ShaderSourceCache cache;
+    cache.SetRootDirectory(root_);
+
+    std::string buffer;
+    std::vector<std::filesystem::path> source_files;
+    cache.AppendPreprocessed(root_ / "shader/shader.frag", buffer, source_files);
+
+    const std::string expected =
+        "#line 1 0\n"
+        "#line 1 1\n"
+        "#line 1 2\n"
+        "float a() { return 1.0; }\n"
+        "#line 2 1\n"
+        "float b() { return a(); }\n"
+        "#line 2 0\n"
+        "#line 3 0\n"
+        "void main() {}\n";
+    ASSERT_EQ(buffer, expected);
+
+    const std::vector<std::filesystem::path> expected_files{
+        (root_ / "shader/shader.frag").lexically_normal(),
+        (root_ / "shader/b.glsl").lexically_normal(),
+        (root_ / "common/a.glsl").lexically_normal(),
+    };
+    ASSERT_EQ(source_files, expected_files);
+}
+
+TEST_F(ShaderSourceCacheTest, IndexesDirectoryOnce)
+{
+    Write("shader/shader.vert", "void main() {}\n");
+
+    ShaderSourceCache cache;
+    cache.SetRootDirectory(root_);
+    ASSERT_EQ(cache.GetDirectoryFiles(root_ / "shader").size(), 1);
+
+    // Not visible until revalidation
+    Write("shader/shader.frag", "void main() {}\n");
+    ASSERT_EQ(cache.GetDirectoryFiles(root_ / "shader").size(), 1);
+
+    cache.Revalidate();
+    ASSERT_EQ(cache.GetDirectoryFiles(root_ / "shader").size(), 2);
+}
+
+TEST_F(ShaderSourceCacheTest, FileContentOutlivesRevalidation)
+{
+    Write("shader/config.json", "{}");
+
+    ShaderSourceCache cache;
+    cache.SetRootDirectory(root_);
+    const std::string content = cache.GetFileContent(root_ / "shader/config.json");
+
+    // Move the write time explicitly because file system timestamps may be too coarse to see the change
+    const auto path = root_ / "shader/config.json";
+    const auto write_time = std::filesystem::last_write_time(path);
+    Write("shader/config.json", "{\"defines\": []}");
+    std::filesystem::last_write_time(path, write_time + std::chrono::seconds(1));
+    cache.Revalidate();
+
+    ASSERT_EQ(content, "{}");
+    ASSERT_EQ(cache.GetFileContent(path), "{\"defines\": []}");
+}
+
+TEST_F(ShaderSourceCacheTest, ThrowsOnUnresolvedInclude)
+{
+    Write("shader/shader.frag", "#include \"missing.glsl\"\n");
+
+    ShaderSourceCache cache;
+    cache.SetRootDirectory(root_);
+
+    std::string buffer;
+    std::vector<std::filesystem::path> source_files;
+    ASSERT_ANY_THROW(cache.AppendPreprocessed(root_ / "shader/shader.frag", buffer, source_files));
+}
+
+}  // namespace klgl
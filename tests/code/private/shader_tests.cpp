@@ -0,0 +1,160 @@
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include "klgl/filesystem/filesystem.hpp"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/null_gl_backend.hpp"
+#include "klgl/reflection/register_types.hpp"
+#include "klgl/shader/shader.hpp"
+
+namespace klgl
+{
+
+class ShaderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        RegisterReflectionTypes();
+        NullGlBackend::Load();
+
+        root_ = std::filesystem::temp_directory_path() / "klgl_shader_tests";
+        std::filesystem::remove_all(root_);
+        Shader::shaders_dir_ = root_;
+    }
+
+    void TearDown() override { std::filesystem::remove_all(root_); }
+
+    void Write(const std::filesystem::path& relative_path, std::string_view content) const
+    {
+        std::filesystem::create_directories((root_ / relative_path).parent_path());
+        Filesystem::WriteFile(root_ / relative_path, content);
+    }
+
+    template <typename T, size_t N>
+    static bool HasUniformValue(GLuint program, uint32_t location, const std::array<T, N>& expected)
+    {
+        const auto value = NullGlBackend::GetUniformValue(program, static_cast<GLint>(location));
+        return value.size() == sizeof(expected) && std::memcmp(value.data(), expected.data(), value.size()) == 0;
+    }
+
+    std::filesystem::path root_;
+};
+
+TEST_F(ShaderTest, SendsModifiedUniforms)
+{
+    Write(
+        "uniforms/uniforms.vert",
+        "layout(location = 0) in vec2 a_position;\n"
+        "uniform vec3 u_color;\n"
+        "void main() { gl_Position = vec4(a_position, 0.0, 1.0); }\n");
+    Write(
+        "uniforms/uniforms.frag",
+        "uniform vec3 u_color;\n"
+        "uniform float u_weights[4];\n"
+        "out vec4 out_color;\n"
+        "void main() { out_color = vec4(u_color * u_weights[0], 1.0); }\n");
+
+    Shader shader("uniforms");
+    ASSERT_FALSE(shader.IsSeparable());
+    shader.Use();
+
+    // New program gets all values, defaults included
+    shader.SendUniforms();
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0);
+
+    UniformHandle u_color("u_color");
+    UniformHandle u_weights("u_weights");
+    ASSERT_EQ(shader.GetUniformArraySize(u_weights), 4);
+
+    shader.SetUniform(u_color, Vec3f{1, 2, 3});
+    const std::array<float, 2> weights{0.5f, 0.25f};
+    shader.SetUniformArray(u_weights, std::span<const float>{weights}, 1);
+
+    NullGlBackend::ResetStats();
+    shader.SendUniforms();
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glUniform3f"), 1);
+
+    // Only the modified range of the array is sent
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glUniform1fv"), 1);
+
+    const GLuint program = shader.GetProgramId().GetValue();
+    const uint32_t weights_location = shader.GetUniformLocation("u_weights[0]");
+    ASSERT_TRUE(HasUniformValue(program, shader.GetUniformLocation("u_color"), std::array{1.f, 2.f, 3.f}));
+    ASSERT_TRUE(HasUniformValue(program, weights_location, std::array{0.f}));
+    ASSERT_TRUE(HasUniformValue(program, weights_location + 1, std::array{0.5f}));
+    ASSERT_TRUE(HasUniformValue(program, weights_location + 2, std::array{0.25f}));
+
+    // Nothing changed since the last send
+    NullGlBackend::ResetStats();
+    shader.SendUniforms();
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glUniform3f"), 0);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glUniform1fv"), 0);
+
+    // Values of the wrong type are rejected before they reach OpenGL
+    ASSERT_ANY_THROW(shader.SetUniform(u_color, 1.f));
+}
+
+TEST_F(ShaderTest, SharesSeparableStages)
+{
+    constexpr std::string_view config = R"({"separable": true, "glsl_version": "410 core"})";
+    constexpr std::string_view vertex_source =
+        "layout(location = 0) in vec2 a_position;\n"
+        "uniform vec2 u_offset;\n"
+        "void main() { gl_Position = vec4(a_position + u_offset, 0.0, 1.0); }\n";
+    Write("separable_a/separable_a.json", config);
+    Write("separable_a/separable_a.vert", vertex_source);
+    Write("separable_a/separable_a.frag", "out vec4 out_color;\nvoid main() { out_color = vec4(1.0); }\n");
+    Write("separable_b/separable_b.json", config);
+    Write("separable_b/separable_b.vert", vertex_source);
+    Write("separable_b/separable_b.frag", "out vec4 out_color;\nvoid main() { out_color = vec4(0.5); }\n");
+
+    Shader a("separable_a");
+    Shader b("separable_b");
+    ASSERT_TRUE(a.IsSeparable());
+    ASSERT_TRUE(b.IsSeparable());
+
+    // Vertex stage has the same code in both shaders, so it is compiled and linked once
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glCreateShader"), 3);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glCreateProgram"), 3);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glGenProgramPipelines"), 2);
+
+    // Pipeline is bound instead of a program
+    a.Use();
+    GLint current_program = -1;
+    GLint current_pipeline = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &current_program);
+    glGetIntegerv(GL_PROGRAM_PIPELINE_BINDING, &current_pipeline);
+    ASSERT_EQ(current_program, 0);
+    ASSERT_NE(current_pipeline, 0);
+
+    UniformHandle u_offset("u_offset");
+    a.SetUniform(u_offset, Vec2f{1, 2});
+    a.SendUniforms();
+
+    b.Use();
+    GLint other_pipeline = 0;
+    glGetIntegerv(GL_PROGRAM_PIPELINE_BINDING, &other_pipeline);
+    ASSERT_NE(other_pipeline, current_pipeline);
+    b.SetUniform(u_offset, Vec2f{3, 4});
+    b.SendUniforms();
+
+    // The other shader overwrote the value in the shared stage, so it is sent again
+    a.Use();
+    NullGlBackend::ResetStats();
+    a.SendUniforms();
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glActiveShaderProgram"), 1);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glUniform2f"), 1);
+
+    NullGlBackend::ResetStats();
+    a.SendUniforms();
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glUniform2f"), 0);
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+}
+
+}  // namespace klgl
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "klgl/rendering/software_rasterizer_2d.hpp"
+#include "klgl/texture/image.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+const Vec4u8 kBlack{0, 0, 0, 255};
+const Vec4u8 kRed{255, 0, 0, 255};
+
+bool SamePixel(const Vec4u8& a, const Vec4u8& b)
+{
+    return std::memcmp(&a, &b, sizeof(Vec4u8)) == 0;
+}
+
+size_t CountPixels(const Image& image, const Vec4u8& color)
+{
+    return static_cast<size_t>(
+        std::ranges::count_if(image.GetPixels(), [&](const Vec4u8& pixel) { return SamePixel(pixel, color); }));
+}
+}  // namespace
+
+TEST(SoftwareRasterizer2dTest, CoversPixelCenters)
+{
+    Image image({8, 8}, kBlack);
+    Painter2d::CommandList list;
+    list.FillRect({.center = {}, .size = {1.f, 1.f}, .color = kRed});
+
+    // The rect spans pixels [2, 6) along both axes
+    SoftwareRasterizer2d rasterizer;
+    rasterizer.Draw(image, list);
+    ASSERT_EQ(CountPixels(image, kRed), 16);
+    ASSERT_TRUE(SamePixel(image.At(2, 2), kRed));
+    ASSERT_TRUE(SamePixel(image.At(5, 5), kRed));
+    ASSERT_TRUE(SamePixel(image.At(1, 2), kBlack));
+    ASSERT_TRUE(SamePixel(image.At(6, 5), kBlack));
+}
+
+TEST(SoftwareRasterizer2dTest, BlendsTranslucentRectOnce)
+{
+    Image image({16, 16}, kBlack);
+    Painter2d::CommandList list;
+    list.FillRect({.center = {}, .size = {2.f, 2.f}, .color = {255, 255, 255, 128}});
+
+    // Pixels on the diagonal are shared by both triangles of the quad
+    SoftwareRasterizer2d rasterizer;
+    rasterizer.Draw(image, list);
+    ASSERT_EQ(image.At(0, 0).x(), 128);
+    ASSERT_EQ(CountPixels(image, image.At(0, 0)), image.GetPixels().size());
+}
+
+TEST(SoftwareRasterizer2dTest, ShadesPrimitiveTypes)
+{
+    Image image({32, 32}, kBlack);
+    Painter2d::CommandList list;
+    list.FillCircle({.center = {-0.5f, -0.5f}, .size = {1.f, 1.f}, .color = kRed});
+    list.FillTriangle({.a = {0.f, -1.f}, .b = {1.f, -1.f}, .c = {0.f, 0.f}, .color = kRed});
+    list.RectLines({.center = {0.f, 0.5f}, .size = {1.f, 1.f}, .color = kRed}, {.inner = 0.1f, .outer = 0.f});
+
+    SoftwareRasterizer2d rasterizer;
+    rasterizer.Draw(image, list);
+
+    // Circle covers the center of its quad but not corners
+    ASSERT_TRUE(SamePixel(image.At(8, 8), kRed));
+    ASSERT_TRUE(SamePixel(image.At(0, 0), kBlack));
+
+    // Triangle covers the half of its quad below the diagonal
+    ASSERT_TRUE(SamePixel(image.At(17, 1), kRed));
+    ASSERT_TRUE(SamePixel(image.At(30, 14), kBlack));
+
+    // Outline covers the border of the rect but not its interior
+    ASSERT_TRUE(SamePixel(image.At(8, 16), kRed));
+    ASSERT_TRUE(SamePixel(image.At(16, 24), kBlack));
+}
+
+TEST(SoftwareRasterizer2dTest, ResultDoesNotDependOnTilesAndThreads)
+{
+    Painter2d::CommandList list;
+    for (size_t i = 0; i != 100; ++i)
+    {
+        const float k = static_cast<float>(i) / 100.f;
+        const Vec4u8 color{static_cast<uint8_t>(i * 2), 100, static_cast<uint8_t>(255 - i), 160};
+        list.FillRect({
+            .center = {k - 0.5f, 0.3f - k},
+            .size = {0.3f, 0.2f},
+            .color = color,
+            .rotation_degrees = k * 90,
+        });
+        list.FillCircle({.center = {0.5f - k, k - 0.5f}, .size = {0.2f, 0.4f}, .color = color});
+        list.DrawLine({.a = {-1.f, k}, .b = {1.f, -k}, .color = color});
+        list.TriangleLines(
+            {.a = {-k, -k}, .b = {k, -k}, .c = {0.f, k}, .color = color},
+            {.inner = 0.02f, .outer = 0.01f});
+    }
+
+    Image expected({100, 70}, kBlack);
+    SoftwareRasterizer2d({.tile_size = 128, .threads_count = 1}).Draw(expected, list);
+
+    Image image({100, 70}, kBlack);
+    SoftwareRasterizer2d({.tile_size = 7, .threads_count = 4}).Draw(image, list);
+    ASSERT_EQ(std::memcmp(image.GetPixels().data(), expected.GetPixels().data(), image.GetPixels().size_bytes()), 0);
+}
+
+}  // namespace klgl
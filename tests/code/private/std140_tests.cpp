@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "klgl/opengl/std140.hpp"
+
+namespace klgl
+{
+
+TEST(Std140Test, ScalarsAndVectors)
+{
+    Std140LayoutBuilder layout;
+    ASSERT_EQ(layout.Add(GlUniformType::Float).offset, 0);
+    ASSERT_EQ(layout.Add(GlUniformType::FloatVec3).offset, 16);
+    // A scalar fills the gap after vec3
+    ASSERT_EQ(layout.Add(GlUniformType::Float).offset, 28);
+    ASSERT_EQ(layout.Add(GlUniformType::FloatVec2).offset, 32);
+    ASSERT_EQ(layout.Add(GlUniformType::Int).offset, 40);
+    ASSERT_EQ(layout.Add(GlUniformType::FloatVec4).offset, 48);
+    ASSERT_EQ(layout.Add(GlUniformType::DoubleVec3).offset, 64);
+    ASSERT_EQ(layout.GetSize(), 96);
+}
+
+TEST(Std140Test, Arrays)
+{
+    Std140LayoutBuilder layout;
+    layout.Add(GlUniformType::Float);
+
+    const Std140Member floats = layout.Add(GlUniformType::Float, 3);
+    ASSERT_EQ(floats.offset, 16);
+    ASSERT_EQ(floats.array_stride, 16);
+    ASSERT_EQ(floats.matrix_stride, 0);
+
+    const Std140Member vectors = layout.Add(GlUniformType::FloatVec3, 2);
+    ASSERT_EQ(vectors.offset, 64);
+    ASSERT_EQ(vectors.array_stride, 16);
+
+    ASSERT_EQ(layout.Add(GlUniformType::Float).offset, 96);
+    ASSERT_EQ(layout.GetSize(), 112);
+}
+
+TEST(Std140Test, Matrices)
+{
+    Std140LayoutBuilder layout;
+    layout.Add(GlUniformType::Float);
+
+    const Std140Member mat3 = layout.Add(GlUniformType::FloatMat3);
+    ASSERT_EQ(mat3.offset, 16);
+    ASSERT_EQ(mat3.matrix_stride, 16);
+    ASSERT_EQ(mat3.array_stride, 0);
+
+    const Std140Member mat2x3 = layout.Add(GlUniformType::FloatMat2x3, 2);
+    ASSERT_EQ(mat2x3.offset, 64);
+    ASSERT_EQ(mat2x3.matrix_stride, 16);
+    ASSERT_EQ(mat2x3.array_stride, 32);
+
+    const Std140Member dmat3 = layout.Add(GlUniformType::DoubleMat3);
+    ASSERT_EQ(dmat3.offset, 128);
+    ASSERT_EQ(dmat3.matrix_stride, 32);
+
+    ASSERT_EQ(layout.GetSize(), 224);
+}
+
+TEST(Std140Test, OpaqueTypesAreRejected)
+{
+    Std140LayoutBuilder layout;
+    ASSERT_ANY_THROW(layout.Add(GlUniformType::Sampler2d));
+}
+
+}  // namespace klgl
@@ -0,0 +1,160 @@
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/gl_api.hpp"
+#include "klgl/opengl/null_gl_backend.hpp"
+#include "klgl/opengl/program_info.hpp"
+#include "klgl/opengl/storage_buffer.hpp"
+
+namespace klgl
+{
+
+namespace
+{
+// Block with one runtime sized array of a scalar, vector or matrix, as reported by glGetProgramResourceiv
+GlStorageBlockInfo MakeArrayBlock(GlUniformType type, size_t stride, size_t matrix_stride = 0, bool row_major = false)
+{
+    GlStorageBlockInfo block{.name = "Elements", .data_size = stride};
+    block.members.push_back({
+        .name = "Elements.values",
+        .array_stride = stride,
+        .matrix_stride = matrix_stride,
+        .top_level_array_stride = stride,
+        .type = type,
+        .row_major = row_major,
+    });
+    return block;
+}
+
+struct Particle
+{
+    Vec2f position;
+    Vec2f velocity;
+};
+
+GlStorageBlockInfo MakeParticlesBlock(size_t velocity_offset)
+{
+    GlStorageBlockInfo block{.name = "Particles", .data_size = sizeof(Particle)};
+    for (const auto& [name, offset] : {std::pair{"position", size_t{0}}, std::pair{"velocity", velocity_offset}})
+    {
+        block.members.push_back({
+            .name = std::string{"Particles.particles."} + name,
+            .offset = offset,
+            .top_level_array_stride = sizeof(Particle),
+            .type = GlUniformType::FloatVec2,
+        });
+    }
+    return block;
+}
+}  // namespace
+
+TEST(StorageBufferLayoutTest, RejectsStrideMismatch)
+{
+    const auto block = MakeArrayBlock(GlUniformType::Float, sizeof(float));
+    ASSERT_NO_THROW(StorageBuffer<float>{}.EnsureCompatible(block));
+    ASSERT_ANY_THROW(StorageBuffer<Vec2f>{}.EnsureCompatible(block));
+    ASSERT_ANY_THROW(StorageBuffer<Particle>{}.EnsureCompatible(block));
+}
+
+TEST(StorageBufferLayoutTest, MapsVec3ArraysToVec4f)
+{
+    // vec3 array elements are padded to 16 bytes in std430 layout
+    const auto block = MakeArrayBlock(GlUniformType::FloatVec3, sizeof(Vec4f));
+    ASSERT_NO_THROW(StorageBuffer<Vec4f>{}.EnsureCompatible(block));
+    ASSERT_ANY_THROW(StorageBuffer<Vec3f>{}.EnsureCompatible(block));
+
+    // Padding keeps the component type
+    const auto int_block = MakeArrayBlock(GlUniformType::IntVec3, sizeof(Vec4f));
+    ASSERT_ANY_THROW(StorageBuffer<Vec4f>{}.EnsureCompatible(int_block));
+}
+
+TEST(StorageBufferLayoutTest, RejectsRowMajorMatrices)
+{
+    constexpr size_t kColumnSize = sizeof(Vec4f);
+    const auto column_major = MakeArrayBlock(GlUniformType::FloatMat4, sizeof(Mat4f), kColumnSize);
+    ASSERT_NO_THROW(StorageBuffer<Mat4f>{}.EnsureCompatible(column_major));
+
+    const auto row_major = MakeArrayBlock(GlUniformType::FloatMat4, sizeof(Mat4f), kColumnSize, true);
+    ASSERT_ANY_THROW(StorageBuffer<Mat4f>{}.EnsureCompatible(row_major));
+}
+
+TEST(StorageBufferLayoutTest, RejectsMembersOutsideOfElement)
+{
+    ASSERT_NO_THROW(StorageBuffer<Particle>{}.EnsureCompatible(MakeParticlesBlock(sizeof(Vec2f))));
+
+    // velocity would end at byte 20 of a 16 bytes element
+    ASSERT_ANY_THROW(StorageBuffer<Particle>{}.EnsureCompatible(MakeParticlesBlock(12)));
+
+    // Members of a struct do not have the layout of a single vector
+    ASSERT_ANY_THROW(StorageBuffer<Vec4f>{}.EnsureCompatible(MakeParticlesBlock(sizeof(Vec2f))));
+}
+
+class StorageBufferTest : public ::testing::TestWithParam<NullGlSettings>
+{
+protected:
+    void SetUp() override { NullGlBackend::Load(GetParam()); }
+
+    [[nodiscard]] bool ExpectsPersistentMapping() const { return GetParam().minor_version >= 4; }
+};
+
+TEST_P(StorageBufferTest, WritesAndReads)
+{
+    const std::array<uint32_t, 4> initial{1, 2, 3, 4};
+    auto buffer = StorageBuffer<uint32_t>::Create(initial);
+    ASSERT_EQ(buffer.IsPersistentlyMapped(), ExpectsPersistentMapping());
+    ASSERT_EQ(buffer.GetCount(), initial.size());
+    ASSERT_EQ(buffer.Read(), (std::vector<uint32_t>{1, 2, 3, 4}));
+
+    NullGlBackend::ResetStats();
+
+    // Partial write
+    const std::array<uint32_t, 2> middle{20, 30};
+    buffer.Write(middle, 1);
+    ASSERT_EQ(buffer.Read(), (std::vector<uint32_t>{1, 20, 30, 4}));
+
+    // Write of the whole buffer
+    const std::array<uint32_t, 4> whole{5, 6, 7, 8};
+    buffer.Write(whole);
+    ASSERT_EQ(buffer.Read(), (std::vector<uint32_t>{5, 6, 7, 8}));
+
+    std::array<uint32_t, 2> tail{};
+    buffer.Read(tail, 2);
+    ASSERT_EQ(tail, (std::array<uint32_t, 2>{7, 8}));
+
+    if (ExpectsPersistentMapping())
+    {
+        // Writes and reads use the mapped memory
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glBufferData"), 0);
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glBufferSubData"), 0);
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glMapBufferRange"), 0);
+    }
+    else
+    {
+        // Whole buffer writes orphan the data store, reads map the range
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glBufferData"), 1);
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glBufferSubData"), 1);
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glMapBufferRange"), 3);
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glUnmapBuffer"), 3);
+    }
+
+    // Every read waits until GPU finishes writing
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glMemoryBarrier"), 3);
+    ASSERT_EQ(NullGlBackend::GetCallsCount("glFenceSync"), 3);
+
+    ASSERT_ANY_THROW(buffer.Write(middle, 3));
+    ASSERT_ANY_THROW(buffer.Read(tail, 3));
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+}
+
+// Persistent mapping in 4.6, orphaning and mapping on read in 4.3 (the first version with storage buffers)
+INSTANTIATE_TEST_SUITE_P(
+    NullGlVersions,
+    StorageBufferTest,
+    ::testing::Values(
+        NullGlSettings{.major_version = 4, .minor_version = 6},
+        NullGlSettings{.major_version = 4, .minor_version = 3}));
+
+}  // namespace klgl
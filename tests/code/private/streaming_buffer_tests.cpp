@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <array>
+#include <span>
+#include <tuple>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/null_gl_backend.hpp"
+#include "klgl/opengl/streaming_buffer.hpp"
+
+namespace klgl
+{
+
+class StreamingBufferTest : public ::testing::TestWithParam<NullGlSettings>
+{
+protected:
+    void SetUp() override { NullGlBackend::Load(GetParam()); }
+
+    [[nodiscard]] bool ExpectsPersistentMapping() const
+    {
+        return GetParam().major_version > 4 || GetParam().minor_version >= 4;
+    }
+};
+
+TEST_P(StreamingBufferTest, AlignsAllocations)
+{
+    StreamingBuffer buffer(1000);
+    ASSERT_EQ(buffer.IsPersistentlyMapped(), ExpectsPersistentMapping());
+
+    // Region size is rounded up so every region starts at the maximal alignment
+    ASSERT_EQ(buffer.GetRegionSize(), 1024);
+    ASSERT_EQ(buffer.GetRegionsCount(), 2);
+
+    // Alignments below the minimal one are raised to it
+    ASSERT_EQ(buffer.AllocateBytes(1, 1).offset, 0);
+    ASSERT_EQ(buffer.AllocateBytes(1, 1).offset, StreamingBuffer::kMinAlignment);
+    ASSERT_EQ(buffer.Allocate<uint16_t>(3).offset, 2 * StreamingBuffer::kMinAlignment);
+    ASSERT_EQ(buffer.GetUsedBytes(), 14);
+
+    const auto aligned = buffer.AllocateBytes(8, StreamingBuffer::kMaxAlignment);
+    ASSERT_EQ(aligned.offset % StreamingBuffer::kMaxAlignment, 0);
+    ASSERT_EQ(aligned.data.size(), 8);
+    ASSERT_EQ(buffer.GetUsedBytes(), StreamingBuffer::kMaxAlignment + 8);
+
+    ASSERT_ANY_THROW(std::ignore = buffer.AllocateBytes(4, 3));
+    ASSERT_ANY_THROW(std::ignore = buffer.AllocateBytes(4, 2 * StreamingBuffer::kMaxAlignment));
+
+    // The second region starts at the region size, so offsets keep their alignment
+    buffer.NextFrame();
+    const size_t region_begin = ExpectsPersistentMapping() ? buffer.GetRegionSize() : 0;
+    ASSERT_EQ(buffer.GetUsedBytes(), 0);
+    ASSERT_EQ(buffer.AllocateBytes(4, StreamingBuffer::kMaxAlignment).offset, region_begin);
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+}
+
+TEST_P(StreamingBufferTest, ThrowsWhenRegionOverflows)
+{
+    StreamingBuffer buffer(StreamingBuffer::kMaxAlignment);
+    std::ignore = buffer.AllocateBytes(StreamingBuffer::kMaxAlignment - 8);
+    std::ignore = buffer.AllocateBytes(8);
+    ASSERT_EQ(buffer.GetUsedBytes(), buffer.GetRegionSize());
+
+    ASSERT_ANY_THROW(std::ignore = buffer.AllocateBytes(1));
+
+    // Failed allocation does not move the head, and the next frame has the whole region again
+    ASSERT_EQ(buffer.GetUsedBytes(), buffer.GetRegionSize());
+    buffer.NextFrame();
+    ASSERT_EQ(buffer.AllocateBytes(buffer.GetRegionSize()).data.size(), buffer.GetRegionSize());
+}
+
+TEST_P(StreamingBufferTest, ReserveKeepsRegions)
+{
+    StreamingBuffer buffer(StreamingBuffer::kMaxAlignment, 3);
+    const GLuint old_buffer = buffer.GetBuffer().GetValue();
+    std::ignore = buffer.AllocateBytes(16);
+
+    // Smaller sizes are ignored
+    buffer.Reserve(StreamingBuffer::kMaxAlignment / 2);
+    ASSERT_EQ(buffer.GetBuffer().GetValue(), old_buffer);
+    ASSERT_EQ(buffer.GetUsedBytes(), 16);
+
+    // Growth is at least twice of the current size and keeps the number of frames in flight
+    buffer.Reserve(StreamingBuffer::kMaxAlignment + 1);
+    ASSERT_EQ(buffer.GetRegionSize(), 2 * StreamingBuffer::kMaxAlignment);
+    ASSERT_EQ(buffer.GetRegionsCount(), 3);
+    ASSERT_EQ(buffer.IsPersistentlyMapped(), ExpectsPersistentMapping());
+    ASSERT_NE(buffer.GetBuffer().GetValue(), old_buffer);
+    ASSERT_EQ(buffer.GetUsedBytes(), 0);
+
+    buffer.Reserve(5 * StreamingBuffer::kMaxAlignment);
+    ASSERT_EQ(buffer.GetRegionSize(), 5 * StreamingBuffer::kMaxAlignment);
+    ASSERT_EQ(buffer.GetRegionsCount(), 3);
+
+    // The whole ring is usable after growth
+    for (size_t frame = 0; frame != 2 * buffer.GetRegionsCount(); ++frame)
+    {
+        const auto allocation = buffer.AllocateBytes(buffer.GetRegionSize());
+        ASSERT_EQ(allocation.data.size(), buffer.GetRegionSize());
+        if (ExpectsPersistentMapping())
+        {
+            ASSERT_EQ(allocation.offset, (frame % buffer.GetRegionsCount()) * buffer.GetRegionSize());
+        }
+        buffer.Flush();
+        buffer.NextFrame();
+    }
+
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+}
+
+TEST_P(StreamingBufferTest, SynchronizesOncePerFrame)
+{
+    StreamingBuffer buffer(StreamingBuffer::kMaxAlignment);
+    NullGlBackend::ResetStats();
+
+    const std::array<uint32_t, 4> storage{1, 2, 3, 4};
+    const std::span<const uint32_t> values{storage};
+    constexpr size_t kFrames = 3;
+    for (size_t frame = 0; frame != kFrames; ++frame)
+    {
+        // Several flushes of one frame
+        const size_t first = buffer.Write(values);
+        buffer.Flush();
+        const size_t second = buffer.Write(values);
+        buffer.Flush();
+        buffer.Flush();
+
+        const auto data = NullGlBackend::GetBufferData(buffer.GetBuffer().GetValue());
+        const auto bytes = std::as_bytes(values);
+        ASSERT_TRUE(std::ranges::equal(std::as_bytes(data.subspan(first, bytes.size())), bytes));
+        ASSERT_TRUE(std::ranges::equal(std::as_bytes(data.subspan(second, bytes.size())), bytes));
+
+        buffer.NextFrame();
+    }
+
+    if (ExpectsPersistentMapping())
+    {
+        // Writes go to mapped memory directly. Every frame fences its region
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glFenceSync"), kFrames);
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glBufferData"), 0);
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glBufferSubData"), 0);
+    }
+    else
+    {
+        // The data store is orphaned by the first upload of the frame, and empty flushes do not upload
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glFenceSync"), 0);
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glBufferData"), kFrames);
+        ASSERT_EQ(NullGlBackend::GetCallsCount("glBufferSubData"), 2 * kFrames);
+    }
+
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0) << NullGlBackend::GetLastErrorMessage();
+}
+
+// Persistent mapping with fences in 4.6, orphaning in 3.3
+INSTANTIATE_TEST_SUITE_P(
+    NullGlVersions,
+    StreamingBufferTest,
+    ::testing::Values(
+        NullGlSettings{.major_version = 4, .minor_version = 6},
+        NullGlSettings{.major_version = 3, .minor_version = 3}));
+
+}  // namespace klgl
@@ -0,0 +1,68 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "klgl/opengl/null_gl_backend.hpp"
+#include "klgl/rendering/painter2d.hpp"
+#include "klgl/texture/texture_atlas.hpp"
+
+namespace klgl
+{
+
+TEST(ShelfPackerTest, FillsShelvesBeforeOpeningNewOnes)
+{
+    ShelfPacker packer({10, 10});
+    ASSERT_EQ(packer.Insert({4, 3}), (Vec2<size_t>{0, 0}));
+    ASSERT_EQ(packer.Insert({4, 5}), (Vec2<size_t>{0, 3}));
+
+    // Goes to the lowest shelf that fits
+    ASSERT_EQ(packer.Insert({4, 2}), (Vec2<size_t>{4, 0}));
+    ASSERT_EQ(packer.Insert({4, 4}), (Vec2<size_t>{4, 3}));
+    ASSERT_EQ(packer.GetUsedHeight(), 8);
+
+    // Neither shelves nor the space below them fit
+    ASSERT_FALSE(packer.Insert({3, 3}).has_value());
+    ASSERT_FALSE(packer.Insert({11, 1}).has_value());
+    ASSERT_EQ(packer.Insert({3, 2}), (Vec2<size_t>{0, 8}));
+
+    packer.Clear();
+    ASSERT_EQ(packer.Insert({10, 10}), (Vec2<size_t>{0, 0}));
+}
+
+TEST(TextureAtlasTest, ReturnsRegionsOfImages)
+{
+    NullGlBackend::Load();
+
+    TextureAtlas atlas({16, 16});
+    const std::vector<Vec4u8> pixels(4 * 2, Vec4u8{} + 255);
+
+    NullGlBackend::ResetStats();
+    const auto a = atlas.Add({4, 2}, pixels);
+    const auto b = atlas.Add({4, 2}, pixels);
+    ASSERT_TRUE(a.has_value() && b.has_value());
+    ASSERT_EQ(NullGlBackend::GetStats().uploaded_bytes, 2 * pixels.size() * sizeof(Vec4u8));
+    ASSERT_EQ(NullGlBackend::GetStats().errors, 0);
+
+    ASSERT_FLOAT_EQ(a->uv_min.x(), 0.f);
+    ASSERT_FLOAT_EQ(a->uv_max.x(), 4.f / 16.f);
+    ASSERT_FLOAT_EQ(a->uv_max.y(), 2.f / 16.f);
+
+    // Images are separated by padding
+    ASSERT_FLOAT_EQ(b->uv_min.x(), 5.f / 16.f);
+
+    ASSERT_FALSE(atlas.Add({16, 16}, std::vector<Vec4u8>(16 * 16)).has_value());
+}
+
+TEST(TextureAtlasTest, SpriteStoresRegion)
+{
+    Painter2d::CommandList list;
+    list.DrawSprite({.center = {}, .size = {1.f, 1.f}}, {.uv_min = {0.f, 0.5f}, .uv_max = {0.25f, 1.f}});
+
+    const auto& instance = list.GetInstances().front();
+    ASSERT_EQ(instance.type, 5);
+    ASSERT_EQ(instance.uv.x(), 0);
+    ASSERT_EQ(instance.uv.y(), 32768);
+    ASSERT_EQ(instance.uv.z(), 16384);
+    ASSERT_EQ(instance.uv.w(), 65535);
+}
+
+}  // namespace klgl